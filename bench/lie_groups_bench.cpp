@@ -0,0 +1,577 @@
+#include <Eigen/Dense>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include "lie_groups/state.h"
+#include "lie_groups/group_array.h"
+#include "lie_groups/compose_scan.h"
+#include "lie_groups/transform_points.h"
+#include "lie_groups/lie_groups/any_group.h"
+
+/**
+ * Micro benchmarks for the kernels of the Lie algebras. Every kernel is timed in both
+ * float and double, once with inputs close to the identity element (Taylor series branch)
+ * and once with inputs far from the identity element (Rodriguez formula branch).
+ *
+ * Usage: lie_groups_bench [repetitions]
+ */
+
+namespace lie_groups { namespace bench {
+
+constexpr int kNumSamples = 1024;               /** < The number of distinct inputs a kernel is evaluated on per repetition. */
+constexpr double kNearIdentityScale = 1e-9;      /** < Scale of the inputs that fall in the near identity branch. */
+constexpr double kRodriguezScale = 1.0;          /** < Scale of the inputs that fall in the Rodriguez branch. */
+constexpr int kNumTrajectoryPoses = 1 << 20;     /** < The length of the trajectories the compose scans are timed on. */
+constexpr int kNumCloudPoints = 300000;          /** < The size of the point clouds the group actions are timed on. */
+
+volatile double sink_;                           /** < Prevents the compiler from removing the benchmarked code. */
+volatile int first_pair_ = 1;                    /** < Read by every run so that the compiler cannot hoist a run out of the repetitions. */
+
+/**
+ * Writes the sum of the coefficients of the results to the sink so that the compiler cannot
+ * remove the benchmarked code.
+ */
+template<typename tMat>
+void Sink(const std::vector<tMat, Eigen::aligned_allocator<tMat>>& results) {
+    double acc = 0;
+    for (const tMat& m : results) {
+        acc += static_cast<double>(m.sum());
+    }
+    sink_ = acc;
+}
+
+/**
+ * Runs the kernel over all of the samples repetitions times and prints the ns/op and ops/s.
+ * @param algebra The name of the Lie algebra.
+ * @param type The name of the scalar type.
+ * @param branch The name of the branch being exercised.
+ * @param op The name of the kernel.
+ * @param repetitions The number of times to run the kernel over all of the samples.
+ * @param kernel Functor taking the sample index. It must store its result in results.
+ * @param results The storage the kernel writes its results to.
+ */
+template<typename tKernel, typename tMat>
+void Run(const char* algebra, const char* type, const char* branch, const char* op, int repetitions, tKernel kernel, const std::vector<tMat, Eigen::aligned_allocator<tMat>>& results) {
+
+    // Warm up
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        kernel(ii);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int rr = 0; rr < repetitions; ++rr) {
+        for (int ii = 0; ii < kNumSamples; ++ii) {
+            kernel(ii);
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+    Sink(results);
+
+    double ns = std::chrono::duration<double, std::nano>(stop-start).count()/(static_cast<double>(repetitions)*kNumSamples);
+    std::printf("%-5s %-7s %-14s %-12s %12.2f %16.0f\n", algebra, type, branch, op, ns, 1e9/ns);
+}
+
+/**
+ * Benchmarks the kernels of a Lie algebra for the inputs of a single branch.
+ * @param algebra The name of the Lie algebra.
+ * @param type The name of the scalar type.
+ * @param branch The name of the branch being exercised.
+ * @param scale The scale of the random inputs.
+ * @param repetitions The number of times to run the kernel over all of the samples.
+ */
+template<typename tAlgebra>
+void BenchAlgebraBranch(const char* algebra, const char* type, const char* branch, double scale, int repetitions) {
+
+    typedef decltype(tAlgebra().data_) Mat_C;
+    typedef typename Mat_C::Scalar DataType;
+    typedef decltype(tAlgebra::Exp(Mat_C())) Mat_G;
+    typedef decltype(tAlgebra::Wedge(Mat_C())) Mat_A;
+    typedef decltype(tAlgebra().Jl()) Mat_J;
+    typedef decltype(tAlgebra().Adjoint()) Mat_Adj;
+
+    std::vector<tAlgebra, Eigen::aligned_allocator<tAlgebra>> u(kNumSamples);
+    std::vector<Mat_G, Eigen::aligned_allocator<Mat_G>> g(kNumSamples);
+    std::vector<Mat_A, Eigen::aligned_allocator<Mat_A>> a(kNumSamples);
+    std::vector<Mat_C, Eigen::aligned_allocator<Mat_C>> c(kNumSamples);
+    std::vector<Mat_J, Eigen::aligned_allocator<Mat_J>> j(kNumSamples);
+    std::vector<Mat_Adj, Eigen::aligned_allocator<Mat_Adj>> adj(kNumSamples);
+
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        u[ii].data_ = Mat_C::Random()*static_cast<DataType>(scale);
+        g[ii] = tAlgebra::Exp(u[ii].data_);
+        a[ii] = tAlgebra::Wedge(u[ii].data_);
+    }
+
+    // The inputs are copied to separate storage so that the results of Exp and Wedge don't overwrite them.
+    std::vector<Mat_G, Eigen::aligned_allocator<Mat_G>> g_out(g);
+    std::vector<Mat_A, Eigen::aligned_allocator<Mat_A>> a_out(a);
+
+    Run(algebra, type, branch, "Exp",     repetitions, [&](int ii) {g_out[ii] = tAlgebra::Exp(u[ii].data_);}, g_out);
+    Run(algebra, type, branch, "Log",     repetitions, [&](int ii) {c[ii] = tAlgebra::Log(g[ii]);}, c);
+    Run(algebra, type, branch, "Jl",      repetitions, [&](int ii) {j[ii] = u[ii].Jl();}, j);
+    Run(algebra, type, branch, "Jr",      repetitions, [&](int ii) {j[ii] = u[ii].Jr();}, j);
+    Run(algebra, type, branch, "JlInv",   repetitions, [&](int ii) {j[ii] = u[ii].JlInv();}, j);
+    Run(algebra, type, branch, "JrInv",   repetitions, [&](int ii) {j[ii] = u[ii].JrInv();}, j);
+    Run(algebra, type, branch, "ExpWithJl", repetitions, [&](int ii) {g_out[ii] = tAlgebra::ExpWithJl(u[ii].data_,j[ii]);}, j);
+    Run(algebra, type, branch, "ExpWithJr", repetitions, [&](int ii) {g_out[ii] = tAlgebra::ExpWithJr(u[ii].data_,j[ii]);}, j);
+    Run(algebra, type, branch, "LogWithJlInv", repetitions, [&](int ii) {c[ii] = tAlgebra::LogWithJlInv(g[ii],j[ii]);}, j);
+    Run(algebra, type, branch, "LogWithJrInv", repetitions, [&](int ii) {c[ii] = tAlgebra::LogWithJrInv(g[ii],j[ii]);}, j);
+    Run(algebra, type, branch, "Adjoint", repetitions, [&](int ii) {adj[ii] = u[ii].Adjoint();}, adj);
+    Run(algebra, type, branch, "Wedge",   repetitions, [&](int ii) {a_out[ii] = tAlgebra::Wedge(u[ii].data_);}, a_out);
+    Run(algebra, type, branch, "Vee",     repetitions, [&](int ii) {c[ii] = tAlgebra::Vee(a[ii]);}, c);
+}
+
+/**
+ * Benchmarks applying the Jacobians to vectors by forming the matrices first and with the matrix-free kernels.
+ */
+template<typename tAlgebra>
+void BenchApplyJacobian(const char* algebra, const char* type, int repetitions) {
+
+    typedef decltype(tAlgebra().data_) Mat_C;
+    typedef typename Mat_C::Scalar DataType;
+
+    std::vector<tAlgebra, Eigen::aligned_allocator<tAlgebra>> u(kNumSamples), v(kNumSamples);
+    std::vector<Mat_C, Eigen::aligned_allocator<Mat_C>> c(kNumSamples);
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        u[ii].data_ = Mat_C::Random()*static_cast<DataType>(kRodriguezScale);
+        v[ii].data_ = Mat_C::Random();
+    }
+
+    Run(algebra, type, "matrix", "Jl*v",    repetitions, [&](int ii) {c[ii] = u[ii].Jl()*v[ii].data_;}, c);
+    Run(algebra, type, "apply",  "Jl(v)",   repetitions, [&](int ii) {c[ii] = u[ii].Jl(v[ii]).data_;}, c);
+    Run(algebra, type, "matrix", "JrInv*v", repetitions, [&](int ii) {c[ii] = u[ii].JrInv()*v[ii].data_;}, c);
+    Run(algebra, type, "apply",  "JrInv(v)", repetitions, [&](int ii) {c[ii] = u[ii].JrInv(v[ii]).data_;}, c);
+}
+
+/**
+ * Benchmarks the kernels of a Lie algebra for both branches.
+ */
+template<typename tAlgebra>
+void BenchAlgebra(const char* algebra, const char* type, int repetitions) {
+    BenchAlgebraBranch<tAlgebra>(algebra, type, "near_identity", kNearIdentityScale, repetitions);
+    BenchAlgebraBranch<tAlgebra>(algebra, type, "rodriguez", kRodriguezScale, repetitions);
+}
+
+/**
+ * Runs a batch kernel repetitions times and prints the ns/op and ops/s per element.
+ * @param group The name of the Lie group.
+ * @param type The name of the scalar type.
+ * @param layout The name of the memory layout.
+ * @param op The name of the kernel.
+ * @param repetitions The number of times to run the kernel.
+ * @param kernel Functor that processes all of the samples.
+ */
+template<typename tKernel>
+void RunBatch(const char* group, const char* type, const char* layout, const char* op, int repetitions, tKernel kernel) {
+
+    // Warm up
+    kernel();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int rr = 0; rr < repetitions; ++rr) {
+        kernel();
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(stop-start).count()/(static_cast<double>(repetitions)*kNumSamples);
+    std::printf("%-5s %-7s %-14s %-12s %12.2f %16.0f\n", group, type, layout, op, ns, 1e9/ns);
+}
+
+/**
+ * Compares the batch operations of a group array against the same operations on an
+ * array of group elements.
+ */
+template<typename tGroup>
+void BenchGroupArray(const char* group, const char* type, int repetitions) {
+
+    typedef GroupArray<tGroup> GArray;
+    typedef typename GArray::Mat_G Mat_G;
+    typedef typename GArray::Mat_C Mat_C;
+
+    std::vector<tGroup, Eigen::aligned_allocator<tGroup>> g_aos(kNumSamples), g2_aos(kNumSamples), out_aos(kNumSamples);
+    std::vector<Mat_C, Eigen::aligned_allocator<Mat_C>> u_aos(kNumSamples), c_aos(kNumSamples);
+    GArray g_soa(kNumSamples), g2_soa(kNumSamples), out_soa(kNumSamples);
+    typename GArray::Data_C u_soa(kNumSamples,Mat_C::SizeAtCompileTime), c_soa;
+
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        g_aos[ii].data_ = tGroup::Random();
+        g2_aos[ii].data_ = tGroup::Random();
+        u_aos[ii] = Mat_C::Random();
+        g_soa[ii] = g_aos[ii];
+        g2_soa[ii] = g2_aos[ii];
+        u_soa.row(ii) = u_aos[ii].transpose();
+    }
+
+    RunBatch(group, type, "aos", "Mult", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { out_aos[ii].data_ = tGroup::Mult(g_aos[ii].data_,g2_aos[ii].data_); } });
+    RunBatch(group, type, "soa", "Mult", repetitions, [&]() {GArray::Mult(g_soa,g2_soa,out_soa);});
+    RunBatch(group, type, "aos", "Inverse", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { out_aos[ii].data_ = tGroup::Inverse(g_aos[ii].data_); } });
+    RunBatch(group, type, "soa", "Inverse", repetitions, [&]() {GArray::Inverse(g_soa,out_soa);});
+    RunBatch(group, type, "aos", "OPlus", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { out_aos[ii].data_ = tGroup::OPlus(g_aos[ii].data_,u_aos[ii]); } });
+    RunBatch(group, type, "soa", "OPlus", repetitions, [&]() {GArray::OPlus(g_soa,u_soa,out_soa);});
+    RunBatch(group, type, "aos", "Exp", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { out_aos[ii].data_ = tGroup::Algebra::Exp(u_aos[ii]); } });
+    RunBatch(group, type, "soa", "Exp", repetitions, [&]() {GArray::Exp(u_soa,out_soa);});
+    RunBatch(group, type, "aos", "Log", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { c_aos[ii] = tGroup::Algebra::Log(g_aos[ii].data_); } });
+    RunBatch(group, type, "soa", "Log", repetitions, [&]() {GArray::Log(g_soa,c_soa);});
+
+    std::vector<Mat_G, Eigen::aligned_allocator<Mat_G>> results(kNumSamples);
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        results[ii] = out_aos[ii].data_ + out_soa[ii].data();
+        u_aos[ii] = c_aos[ii] + c_soa.row(ii).transpose();
+    }
+    Sink(results);
+    Sink(u_aos);
+}
+
+/**
+ * Compares applying the adjoint map to vectors and covariances through the adjoint matrix against the
+ * matrix-free functions and their batch kernels.
+ */
+template<typename tGroup>
+void BenchAdjoint(const char* group, const char* type, int repetitions) {
+
+    typedef GroupArray<tGroup> GArray;
+    typedef typename GArray::Mat_C Mat_C;
+    typedef decltype(tGroup().Adjoint()) Mat_Adj;
+
+    std::vector<tGroup, Eigen::aligned_allocator<tGroup>> g_aos(kNumSamples);
+    std::vector<Mat_C, Eigen::aligned_allocator<Mat_C>> v_aos(kNumSamples), c_aos(kNumSamples);
+    std::vector<Mat_Adj, Eigen::aligned_allocator<Mat_Adj>> p_aos(kNumSamples), out_aos(kNumSamples);
+    GArray g_soa(kNumSamples);
+    typename GArray::Data_C v_soa(kNumSamples,Mat_C::SizeAtCompileTime), c_soa;
+    typename GArray::Data_Cov p_soa(kNumSamples,Mat_Adj::SizeAtCompileTime), out_soa;
+
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        g_aos[ii].data_ = tGroup::Random();
+        v_aos[ii] = Mat_C::Random();
+        Mat_Adj l = Mat_Adj::Random();
+        p_aos[ii] = l*l.transpose();
+        g_soa[ii] = g_aos[ii];
+        v_soa.row(ii) = v_aos[ii].transpose();
+        p_soa.row(ii) = Eigen::Map<const Eigen::Matrix<typename Mat_C::Scalar,1,Mat_Adj::SizeAtCompileTime>>(p_aos[ii].data());
+    }
+
+    RunBatch(group, type, "matrix", "Ad*v", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { c_aos[ii] = g_aos[ii].Adjoint()*v_aos[ii]; } });
+    RunBatch(group, type, "aos", "AdjointAct", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { c_aos[ii] = g_aos[ii].AdjointAct(v_aos[ii]); } });
+    RunBatch(group, type, "soa", "AdjointAct", repetitions, [&]() {GArray::AdjointAct(g_soa,v_soa,c_soa);});
+    RunBatch(group, type, "matrix", "Ad*P*Ad^T", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { Mat_Adj adj = g_aos[ii].Adjoint(); out_aos[ii] = adj*p_aos[ii]*adj.transpose(); } });
+    RunBatch(group, type, "aos", "AdjointCov", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { out_aos[ii] = g_aos[ii].AdjointTransformCovariance(p_aos[ii]); } });
+    RunBatch(group, type, "soa", "AdjointCov", repetitions, [&]() {GArray::AdjointTransformCovariance(g_soa,p_soa,out_soa);});
+
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        c_aos[ii] += c_soa.row(ii).transpose();
+        out_aos[ii] += Eigen::Map<const Mat_Adj>(out_soa.row(ii).eval().data());
+    }
+    Sink(c_aos);
+    Sink(out_aos);
+}
+
+/**
+ * Times the group operation and the O-minus of consecutive elements of an array, which is what
+ * the representation of the elements matters for.
+ */
+template<typename tGroup>
+void BenchCompose(const char* group, const char* type, int repetitions) {
+
+    typedef typename tGroup::Base::Mat_G Mat_G;
+    typedef typename tGroup::Base::Mat_C Mat_C;
+
+    std::vector<Mat_G, Eigen::aligned_allocator<Mat_G>> g(kNumSamples), out(kNumSamples);
+    std::vector<Mat_C, Eigen::aligned_allocator<Mat_C>> u(kNumSamples);
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        g[ii] = tGroup::Random();
+    }
+
+    RunBatch(group, type, "consecutive", "Mult", repetitions, [&]() {
+        for (int ii = first_pair_; ii < kNumSamples; ++ii) { out[ii] = tGroup::Mult(g[ii-1],g[ii]); } });
+    RunBatch(group, type, "consecutive", "OMinus", repetitions, [&]() {
+        for (int ii = first_pair_; ii < kNumSamples; ++ii) { u[ii] = tGroup::OMinus(g[ii],g[ii-1]); } });
+
+    Sink(out);
+    Sink(u);
+}
+
+/**
+ * Compares the group operation and the O-minus of consecutive elements through the static functions of the group
+ * against the ones through AnyGroup, whose type is chosen at run time.
+ */
+template<typename tGroup>
+void BenchAnyGroup(const char* group, const char* type, int repetitions) {
+
+    typedef typename tGroup::Base::Mat_G Mat_G;
+    typedef typename tGroup::Base::Mat_C Mat_C;
+    typedef typename tGroup::Base::DataType DataType;
+
+    std::vector<Mat_G, Eigen::aligned_allocator<Mat_G>> g(kNumSamples), out(kNumSamples);
+    std::vector<Mat_C, Eigen::aligned_allocator<Mat_C>> u(kNumSamples);
+    std::vector<AnyGroup<DataType>> any_g(kNumSamples), any_out(kNumSamples);
+    std::vector<AnyAlgebra<DataType>> any_u(kNumSamples);
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        g[ii] = tGroup::Random();
+        any_g[ii] = AnyGroup<DataType>(tGroup(g[ii]));
+    }
+
+    RunBatch(group, type, "static", "Mult", repetitions, [&]() {
+        for (int ii = first_pair_; ii < kNumSamples; ++ii) { out[ii] = tGroup::Mult(g[ii-1],g[ii]); } });
+    RunBatch(group, type, "any", "Mult", repetitions, [&]() {
+        for (int ii = first_pair_; ii < kNumSamples; ++ii) { any_out[ii] = any_g[ii-1]*any_g[ii]; } });
+    RunBatch(group, type, "static", "OMinus", repetitions, [&]() {
+        for (int ii = first_pair_; ii < kNumSamples; ++ii) { u[ii] = tGroup::OMinus(g[ii],g[ii-1]); } });
+    RunBatch(group, type, "any", "OMinus", repetitions, [&]() {
+        for (int ii = first_pair_; ii < kNumSamples; ++ii) { any_u[ii] = any_g[ii].OMinus(any_g[ii-1]); } });
+
+    Sink(out);
+    Sink(u);
+    double acc = 0;
+    for (int ii = 1; ii < kNumSamples; ++ii) {
+        acc += static_cast<double>(any_out[ii].Data().sum() + any_u[ii].Data().sum());
+    }
+    sink_ = acc;
+}
+
+/**
+ * Compares propagating a covariance with the dense Jacobian of a state, J*P*J^T, against StateJacobian, which only
+ * stores the block of the group.
+ */
+template<typename tState>
+void BenchStateJacobian(const char* group, const char* type, int repetitions) {
+
+    typedef typename tState::Vec_SC Vec_SC;
+    typedef typename tState::Mat_SC Mat_SC;
+
+    std::vector<Vec_SC, Eigen::aligned_allocator<Vec_SC>> u(kNumSamples);
+    std::vector<Mat_SC, Eigen::aligned_allocator<Mat_SC>> cov(kNumSamples), out(kNumSamples);
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        u[ii] = Vec_SC::Random();
+        const Mat_SC m = Mat_SC::Random();
+        cov[ii] = m*m.transpose();
+    }
+
+    RunBatch(group, type, "dense", "JrPJr^T", repetitions, [&]() {
+        for (int ii = first_pair_; ii < kNumSamples; ++ii) {
+            const Mat_SC jr = tState::Jr(u[ii]).ToDense();
+            out[ii].noalias() = jr*cov[ii]*jr.transpose(); } });
+    RunBatch(group, type, "block", "JrPJr^T", repetitions, [&]() {
+        for (int ii = first_pair_; ii < kNumSamples; ++ii) { out[ii] = tState::Jr(u[ii]).Propagate(cov[ii]); } });
+
+    Sink(out);
+}
+
+/**
+ * Compares the Jacobians of OMinus with respect to both elements computed by forward differences,
+ * which costs 2*dim extra evaluations of OMinus, against the closed form Jacobians.
+ */
+template<typename tGroup>
+void BenchOMinusJacobians(const char* group, const char* type, int repetitions) {
+
+    typedef typename tGroup::Base::Mat_G Mat_G;
+    typedef typename tGroup::Base::Mat_C Mat_C;
+    typedef typename tGroup::Base::Mat_Jac Mat_Jac;
+    typedef typename tGroup::Base::DataType DataType;
+
+    std::vector<Mat_G, Eigen::aligned_allocator<Mat_G>> g1(kNumSamples), g2(kNumSamples);
+    std::vector<Mat_Jac, Eigen::aligned_allocator<Mat_Jac>> j1(kNumSamples), j2(kNumSamples);
+    for (int ii = 0; ii < kNumSamples; ++ii) {
+        g1[ii] = tGroup::Random();
+        g2[ii] = tGroup::Random();
+    }
+
+    const DataType dt = std::sqrt(Eigen::NumTraits<DataType>::epsilon());
+    RunBatch(group, type, "numeric", "OMinusJr", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) {
+            const Mat_C u = tGroup::OMinus(g1[ii],g2[ii]);
+            for (int cc = 0; cc < Mat_Jac::ColsAtCompileTime; ++cc) {
+                Mat_C du = Mat_C::Zero();
+                du(cc) = dt;
+                j1[ii].col(cc) = (tGroup::OMinus(tGroup::OPlus(g1[ii],du),g2[ii]) - u)/dt;
+                j2[ii].col(cc) = (tGroup::OMinus(g1[ii],tGroup::OPlus(g2[ii],du)) - u)/dt;
+            }
+        } });
+    RunBatch(group, type, "analytic", "OMinusJr", repetitions, [&]() {
+        for (int ii = 0; ii < kNumSamples; ++ii) { tGroup::OMinusWithJr(g1[ii],g2[ii],j1[ii],j2[ii]); } });
+
+    Sink(j1);
+    Sink(j2);
+}
+
+/**
+ * Compares transforming a point cloud by homogenizing the points and multiplying them by the data of the
+ * element against the batch action of the group and its parallel version.
+ */
+template<typename tGroup>
+void BenchTransformPoints(const char* group, const char* type, int repetitions, ThreadPool& pool) {
+
+    typedef typename tGroup::Point Point;
+    constexpr int d = Point::RowsAtCompileTime;
+
+    PointVector<tGroup> points(kNumCloudPoints), out(kNumCloudPoints);
+    ActJacobianVector<tGroup> j_pose(kNumCloudPoints);
+    for (int ii = 0; ii < kNumCloudPoints; ++ii) {
+        points[ii] = Point::Random();
+    }
+    const tGroup g(tGroup::Random());
+
+    auto run = [&](const char* layout, const char* op, const std::function<void()>& kernel) {
+        kernel();
+        auto t0 = std::chrono::steady_clock::now();
+        for (int rr = 0; rr < repetitions; ++rr) {
+            kernel();
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1-t0).count()/(static_cast<double>(repetitions)*kNumCloudPoints);
+        std::printf("%-5s %-7s %-14s %-12s %12.2f %16.0f\n", group, type, layout, op, ns, 1e9/ns);
+    };
+
+    run("homogeneous", "Act", [&]() {
+        for (int ii = 0; ii < kNumCloudPoints; ++ii) { out[ii] = (g.data_*points[ii].homogeneous()).template head<d>(); } });
+    run("batch", "Act", [&]() {tGroup::BatchAct(g.data_,points.data(),out.data(),kNumCloudPoints);});
+    run("pool", "Act", [&]() {TransformPoints(g,points,out,pool);});
+    run("pool", "ActWithJac", [&]() {TransformPoints(g,points,out,j_pose,pool);});
+
+    Sink(out);
+}
+
+/**
+ * Compares the serial composition of a trajectory and the recovery of its increments against
+ * the compose scans run on a thread pool.
+ */
+template<typename tGroup>
+void BenchComposeScan(const char* group, const char* type, int repetitions, ThreadPool& pool) {
+
+    GroupVector<tGroup> increments(kNumTrajectoryPoses), poses(kNumTrajectoryPoses);
+    CartesianVector<tGroup> u(kNumTrajectoryPoses);
+    for (int ii = 0; ii < kNumTrajectoryPoses; ++ii) {
+        increments[ii].data_ = tGroup::Random(static_cast<typename tGroup::Base::DataType>(0.1));
+    }
+    const tGroup start;
+
+    auto run = [&](const char* layout, const char* op, const std::function<void()>& kernel) {
+        kernel();
+        auto t0 = std::chrono::steady_clock::now();
+        for (int rr = 0; rr < repetitions; ++rr) {
+            kernel();
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1-t0).count()/(static_cast<double>(repetitions)*kNumTrajectoryPoses);
+        std::printf("%-5s %-7s %-14s %-12s %12.2f %16.0f\n", group, type, layout, op, ns, 1e9/ns);
+    };
+
+    run("serial", "Compose", [&]() {
+        poses[0].data_ = tGroup::Mult(start.data_,increments[0].data_);
+        for (int ii = 1; ii < kNumTrajectoryPoses; ++ii) { poses[ii].data_ = tGroup::Mult(poses[ii-1].data_,increments[ii].data_); } });
+    run("scan", "Compose", [&]() {ComposeScan(start,increments,poses,pool);});
+    run("serial", "OMinus", [&]() {
+        for (int ii = 0; ii < kNumTrajectoryPoses; ++ii) { u[ii] = tGroup::OMinus(poses[ii].data_, ii == 0 ? start.data_ : poses[ii-1].data_); } });
+    run("scan", "OMinus", [&]() {InverseComposeScan(start,poses,u,pool);});
+
+    Sink(u);
+}
+
+} // namespace bench
+} // namespace lie_groups
+
+
+int main(int argc, char** argv) {
+
+    using namespace lie_groups;
+
+    int repetitions = 1000;
+    if (argc > 1) {
+        repetitions = std::atoi(argv[1]);
+        if (repetitions <= 0) {
+            std::fprintf(stderr, "usage: %s [repetitions]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::printf("%-5s %-7s %-14s %-12s %12s %16s\n", "alg", "type", "branch", "op", "ns/op", "ops/s");
+
+    bench::BenchAlgebra<rn<double,3,1>>("rn",  "double", repetitions);
+    bench::BenchAlgebra<rn<float,3,1>> ("rn",  "float",  repetitions);
+    bench::BenchAlgebra<so2<double>>   ("so2", "double", repetitions);
+    bench::BenchAlgebra<so2<float>>    ("so2", "float",  repetitions);
+    bench::BenchAlgebra<so3<double>>   ("so3", "double", repetitions);
+    bench::BenchAlgebra<so3<float>>    ("so3", "float",  repetitions);
+    bench::BenchAlgebra<se2<double>>   ("se2", "double", repetitions);
+    bench::BenchAlgebra<se2<float>>    ("se2", "float",  repetitions);
+    bench::BenchAlgebra<se3<double>>   ("se3", "double", repetitions);
+    bench::BenchAlgebra<se3<float>>    ("se3", "float",  repetitions);
+
+    bench::BenchApplyJacobian<so3<double>>("so3", "double", repetitions);
+    bench::BenchApplyJacobian<so3<float>> ("so3", "float",  repetitions);
+    bench::BenchApplyJacobian<se2<double>>("se2", "double", repetitions);
+    bench::BenchApplyJacobian<se2<float>> ("se2", "float",  repetitions);
+    bench::BenchApplyJacobian<se3<double>>("se3", "double", repetitions);
+    bench::BenchApplyJacobian<se3<float>> ("se3", "float",  repetitions);
+
+    std::printf("\n%-5s %-7s %-14s %-12s %12s %16s\n", "group", "type", "layout", "op", "ns/op", "ops/s");
+
+    bench::BenchGroupArray<SO3<double>>("SO3", "double", repetitions);
+    bench::BenchGroupArray<SO3<float>> ("SO3", "float",  repetitions);
+    bench::BenchGroupArray<SO2<double>>("SO2", "double", repetitions);
+    bench::BenchGroupArray<SO2<float>> ("SO2", "float",  repetitions);
+    bench::BenchGroupArray<SE2<double>>("SE2", "double", repetitions);
+    bench::BenchGroupArray<SE2<float>> ("SE2", "float",  repetitions);
+    bench::BenchGroupArray<SE3<double>>("SE3", "double", repetitions);
+    bench::BenchGroupArray<SE3<float>> ("SE3", "float",  repetitions);
+
+    bench::BenchAdjoint<SE2<double>>("SE2", "double", repetitions);
+    bench::BenchAdjoint<SE2<float>> ("SE2", "float",  repetitions);
+    bench::BenchAdjoint<SE3<double>>("SE3", "double", repetitions);
+    bench::BenchAdjoint<SE3<float>> ("SE3", "float",  repetitions);
+
+    bench::BenchCompose<SO3<double>>      ("SO3",  "double", repetitions);
+    bench::BenchCompose<SO3Quat<double>>  ("SO3Q", "double", repetitions);
+    bench::BenchCompose<SO3<float>>       ("SO3",  "float",  repetitions);
+    bench::BenchCompose<SO3Quat<float>>   ("SO3Q", "float",  repetitions);
+    bench::BenchCompose<SE2<double>>       ("SE2",  "double", repetitions);
+    bench::BenchCompose<SE2Complex<double>>("SE2C", "double", repetitions);
+    bench::BenchCompose<SE2<float>>        ("SE2",  "float",  repetitions);
+    bench::BenchCompose<SE2Complex<float>> ("SE2C", "float",  repetitions);
+    bench::BenchCompose<SE3<double>>      ("SE3",  "double", repetitions);
+    bench::BenchCompose<SE3Affine<double>>("SE3A", "double", repetitions);
+    bench::BenchCompose<SE3<float>>       ("SE3",  "float",  repetitions);
+    bench::BenchCompose<SE3Affine<float>> ("SE3A", "float",  repetitions);
+
+    bench::BenchAnyGroup<SO3<double>>("SO3", "double", repetitions);
+    bench::BenchAnyGroup<SE2<double>>("SE2", "double", repetitions);
+    bench::BenchAnyGroup<SE3<double>>("SE3", "double", repetitions);
+
+    bench::BenchStateJacobian<SO3_so3>("SO3", "double", repetitions);
+    bench::BenchStateJacobian<SE3_se3>("SE3", "double", repetitions);
+
+    bench::BenchOMinusJacobians<SO3<double>>("SO3", "double", repetitions);
+    bench::BenchOMinusJacobians<SE2<double>>("SE2", "double", repetitions);
+    bench::BenchOMinusJacobians<SE3<double>>("SE3", "double", repetitions);
+
+    // Whole trajectories are much larger than the sample sets so they are timed fewer times.
+    ThreadPool pool;
+    const int trajectory_repetitions = std::max(1, repetitions/200);
+    std::printf("\n%u threads, %d poses\n", pool.NumThreads(), bench::kNumTrajectoryPoses);
+    std::printf("%-5s %-7s %-14s %-12s %12s %16s\n", "group", "type", "layout", "op", "ns/op", "ops/s");
+
+    bench::BenchComposeScan<SE2<double>>("SE2", "double", trajectory_repetitions, pool);
+    bench::BenchComposeScan<SE3<double>>("SE3", "double", trajectory_repetitions, pool);
+
+    std::printf("\n%u threads, %d points\n", pool.NumThreads(), bench::kNumCloudPoints);
+    std::printf("%-5s %-7s %-14s %-12s %12s %16s\n", "group", "type", "layout", "op", "ns/op", "ops/s");
+
+    bench::BenchTransformPoints<SE2<double>>("SE2", "double", trajectory_repetitions, pool);
+    bench::BenchTransformPoints<SE3<double>>("SE3", "double", trajectory_repetitions, pool);
+    bench::BenchTransformPoints<SE3<float>> ("SE3", "float",  trajectory_repetitions, pool);
+
+    return 0;
+}
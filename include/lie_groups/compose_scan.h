@@ -0,0 +1,144 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_COMPOSESCAN_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_COMPOSESCAN_
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <vector>
+
+#include "lie_groups/thread_pool.h"
+
+/**
+ * Parallel prefix composition of a chain of increments into absolute elements and its inverse.
+ * Given a start element \f$ g_0 \f$ and increments \f$ d_k \f$ the scan computes \f$ p_k = g_0 d_0 d_1 \cdots d_k \f$.
+ *
+ * The scan is work-efficient. The chain is split in one chunk per thread:
+ *  1. Every chunk is scanned locally in parallel.
+ *  2. The products of the chunks are scanned serially which gives the element that precedes every chunk.
+ *  3. Every chunk is multiplied on the left by the element that precedes it in parallel.
+ * This is about 2n group operations compared to n for the serial loop, spread across the threads of the pool.
+ */
+
+namespace lie_groups {
+
+constexpr Eigen::Index kComposeScanMinChunkSize = 4096; /** < Chains with fewer increments per thread are scanned with fewer threads.*/
+
+template<typename tGroup>
+using GroupVector = std::vector<tGroup, Eigen::aligned_allocator<tGroup>>;
+
+template<typename tGroup>
+using CartesianVector = std::vector<typename tGroup::Base::Mat_C, Eigen::aligned_allocator<typename tGroup::Base::Mat_C>>;
+
+namespace internal {
+
+/**
+ * Computes the prefix products of a chain. Element k of the chain is given by increment(k).
+ */
+template<typename tGroup, typename tIncrement>
+void ComposeScan(const tGroup& start, Eigen::Index n, tIncrement increment, GroupVector<tGroup>& poses, ThreadPool& pool) {
+
+    poses.resize(n);
+    if (n == 0) {
+        return;
+    }
+
+    const Eigen::Index num_chunks = std::max<Eigen::Index>(1, std::min<Eigen::Index>(pool.NumThreads(), n/kComposeScanMinChunkSize));
+    const Eigen::Index chunk_size = (n + num_chunks - 1)/num_chunks;
+
+    // Local scans. The first chunk starts from the start element so it is already absolute.
+    pool.ParallelFor(num_chunks, [&](Eigen::Index c) {
+        const Eigen::Index begin = c*chunk_size;
+        const Eigen::Index end = std::min(n, begin+chunk_size);
+        if (c == 0) {
+            poses[begin].data_ = tGroup::Mult(start.data_,increment(begin));
+        } else {
+            poses[begin].data_ = increment(begin);
+        }
+        for (Eigen::Index ii = begin+1; ii < end; ++ii) {
+            poses[ii].data_ = tGroup::Mult(poses[ii-1].data_,increment(ii));
+        }
+    });
+
+    if (num_chunks == 1) {
+        return;
+    }
+
+    // The element that precedes every chunk
+    GroupVector<tGroup> prefix(num_chunks);
+    prefix[1] = poses[chunk_size-1];
+    for (Eigen::Index c = 2; c < num_chunks; ++c) {
+        prefix[c].data_ = tGroup::Mult(prefix[c-1].data_,poses[c*chunk_size-1].data_);
+    }
+
+    pool.ParallelFor(num_chunks-1, [&](Eigen::Index task) {
+        const Eigen::Index c = task+1;
+        const Eigen::Index begin = c*chunk_size;
+        const Eigen::Index end = std::min(n, begin+chunk_size);
+        for (Eigen::Index ii = begin; ii < end; ++ii) {
+            poses[ii].data_ = tGroup::Mult(prefix[c].data_,poses[ii].data_);
+        }
+    });
+}
+
+} // namespace internal
+
+/**
+ * Composes a chain of increments into absolute elements, \f$ p_k = g_0 d_0 d_1 \cdots d_k \f$.
+ * @param start The element \f$ g_0 \f$ that precedes the chain.
+ * @param increments The increments \f$ d_k \f$.
+ * @param poses The resulting elements \f$ p_k \f$. It must not be the same vector as increments.
+ * @param pool The threads the scan is run on.
+ */
+template<typename tGroup>
+void ComposeScan(const tGroup& start, const GroupVector<tGroup>& increments, GroupVector<tGroup>& poses, ThreadPool& pool) {
+    internal::ComposeScan(start, static_cast<Eigen::Index>(increments.size()),
+        [&](Eigen::Index ii) -> const typename tGroup::Base::Mat_G& {return increments[ii].data_;}, poses, pool);
+}
+
+/**
+ * Composes a chain of increments given in the Cartesian space into absolute elements,
+ * \f$ p_k = p_{k-1} \exp(u_k) \f$ with \f$ p_{-1} = g_0 \f$. This is the inverse of InverseComposeScan.
+ * @param start The element \f$ g_0 \f$ that precedes the chain.
+ * @param increments The increments \f$ u_k \f$.
+ * @param poses The resulting elements \f$ p_k \f$.
+ * @param pool The threads the scan is run on.
+ */
+template<typename tGroup>
+void ComposeScan(const tGroup& start, const CartesianVector<tGroup>& increments, GroupVector<tGroup>& poses, ThreadPool& pool) {
+    internal::ComposeScan(start, static_cast<Eigen::Index>(increments.size()),
+        [&](Eigen::Index ii) {return tGroup::Algebra::Exp(increments[ii]);}, poses, pool);
+}
+
+/**
+ * Recovers the increments of a chain from the absolute elements, \f$ u_k = \log(p_{k-1}^{-1} p_k) \f$ with
+ * \f$ p_{-1} = g_0 \f$, i.e. the O-minus of consecutive elements. The increments are independent so they are
+ * computed in parallel.
+ * @param start The element \f$ g_0 \f$ that precedes the chain.
+ * @param poses The elements \f$ p_k \f$.
+ * @param increments The resulting increments \f$ u_k \f$.
+ * @param pool The threads the operation is run on.
+ */
+template<typename tGroup>
+void InverseComposeScan(const tGroup& start, const GroupVector<tGroup>& poses, CartesianVector<tGroup>& increments, ThreadPool& pool) {
+
+    const Eigen::Index n = static_cast<Eigen::Index>(poses.size());
+    increments.resize(n);
+    if (n == 0) {
+        return;
+    }
+
+    const Eigen::Index num_chunks = std::max<Eigen::Index>(1, std::min<Eigen::Index>(pool.NumThreads(), n/kComposeScanMinChunkSize));
+    const Eigen::Index chunk_size = (n + num_chunks - 1)/num_chunks;
+
+    pool.ParallelFor(num_chunks, [&](Eigen::Index c) {
+        const Eigen::Index begin = c*chunk_size;
+        const Eigen::Index end = std::min(n, begin+chunk_size);
+        increments[begin] = tGroup::OMinus(poses[begin].data_, begin == 0 ? start.data_ : poses[begin-1].data_);
+        for (Eigen::Index ii = begin+1; ii < end; ++ii) {
+            increments[ii] = tGroup::OMinus(poses[ii].data_,poses[ii-1].data_);
+        }
+    });
+}
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_COMPOSESCAN_
@@ -0,0 +1,129 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_COMPOSITIONINDEX_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_COMPOSITIONINDEX_
+
+#include <Eigen/Dense>
+#include <vector>
+
+#include "lie_groups/compose_scan.h"
+
+namespace lie_groups {
+
+/**
+ * A segment tree over a chain of increments \f$ d_0, d_1, \ldots, d_{n-1} \f$ of a group. Every node stores the
+ * ordered product of the increments below it so that the product of any range of increments is composed from
+ * \f$ O(\log n) \f$ nodes and an increment is updated by recomputing the \f$ O(\log n) \f$ nodes above it.
+ *
+ * With the absolute elements \f$ p_k = g_0 d_0 \cdots d_k \f$, the relative element between the elements i and j is
+ * \f$ p_i^{-1} p_j = d_{i+1} \cdots d_j \f$, which is what Between() returns without composing the whole chain.
+ */
+template<typename tGroup>
+class CompositionIndex {
+
+public:
+
+typedef tGroup Group;
+typedef typename Group::Base::Mat_G Mat_G;
+
+/**
+ * Default constructor. Initializes an empty chain.
+ */
+CompositionIndex() = default;
+
+/**
+ * Builds the index of a chain in \f$ O(n) \f$ group operations.
+ * @param increments The increments \f$ d_k \f$.
+ */
+explicit CompositionIndex(const GroupVector<Group>& increments) {Build(increments);}
+
+/**
+ * Builds the index of a chain in \f$ O(n) \f$ group operations.
+ * @param increments The increments \f$ d_k \f$.
+ */
+void Build(const GroupVector<Group>& increments) {
+    size_ = static_cast<Eigen::Index>(increments.size());
+    leaves_ = 1;
+    while (leaves_ < size_) {
+        leaves_ *= 2;
+    }
+
+    // The leaves past the end of the chain are the identity so that every node is the product of a contiguous range.
+    nodes_.assign(2*leaves_, Group().data_);
+    for (Eigen::Index ii = 0; ii < size_; ++ii) {
+        nodes_[leaves_+ii] = increments[ii].data_;
+    }
+    for (Eigen::Index node = leaves_-1; node > 0; --node) {
+        nodes_[node] = Group::Mult(nodes_[2*node],nodes_[2*node+1]);
+    }
+}
+
+/**
+ * Returns the number of increments.
+ */
+Eigen::Index Size() const {return size_;}
+
+/**
+ * Returns increment k.
+ */
+Group Increment(Eigen::Index k) const {return Group(nodes_[leaves_+k]);}
+
+/**
+ * Replaces increment k and updates the products that depend on it in \f$ O(\log n) \f$ group operations.
+ * @param k The index of the increment.
+ * @param increment The new increment.
+ */
+void Update(Eigen::Index k, const Group& increment) {
+    Eigen::Index node = leaves_+k;
+    nodes_[node] = increment.data_;
+    for (node /= 2; node > 0; node /= 2) {
+        nodes_[node] = Group::Mult(nodes_[2*node],nodes_[2*node+1]);
+    }
+}
+
+/**
+ * Computes the ordered product \f$ d_{begin} \cdots d_{end-1} \f$ of a range of increments in \f$ O(\log n) \f$
+ * group operations. The product of an empty range is the identity.
+ * @param begin The index of the first increment of the range.
+ * @param end One past the index of the last increment of the range.
+ */
+Group Product(Eigen::Index begin, Eigen::Index end) const {
+
+    // The products of the nodes on the left and right boundaries are kept separately since the group
+    // operation is not commutative in general.
+    Mat_G left = Group().data_;
+    Mat_G right = Group().data_;
+    for (Eigen::Index lo = begin+leaves_, hi = end+leaves_; lo < hi; lo /= 2, hi /= 2) {
+        if (lo & 1) {
+            left = Group::Mult(left,nodes_[lo++]);
+        }
+        if (hi & 1) {
+            right = Group::Mult(nodes_[--hi],right);
+        }
+    }
+    return Group(Group::Mult(left,right));
+}
+
+/**
+ * Computes the relative element \f$ p_i^{-1} p_j \f$ between the absolute elements i and j of the chain
+ * in \f$ O(\log n) \f$ group operations. It is the identity when i and j are equal.
+ * @param i The index of the first element.
+ * @param j The index of the second element.
+ */
+Group Between(Eigen::Index i, Eigen::Index j) const {
+    if (i <= j) {
+        return Product(i+1,j+1);
+    } else {
+        return Group(Group::Inverse(Product(j+1,i+1).data_));
+    }
+}
+
+private:
+
+Eigen::Index size_ = 0;    /** < The number of increments. */
+Eigen::Index leaves_ = 0;  /** < The number of leaves. It is the smallest power of two not less than size_. */
+std::vector<Mat_G, Eigen::aligned_allocator<Mat_G>> nodes_;  /** < Node 1 is the root and the children of node k are 2k and 2k+1. */
+
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_COMPOSITIONINDEX_
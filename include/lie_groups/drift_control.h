@@ -0,0 +1,113 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_DRIFTCONTROL_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_DRIFTCONTROL_
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "lie_groups/lie_groups/normalization.h"
+#include "lie_groups/lie_groups/retraction.h"
+
+/**
+ * Keeps the element of a long chain of compositions on the group. Every product adds a rounding error to the rotation
+ * so after millions of compositions \f$ R^\top R \f$ is measurably different from the identity.
+ *
+ * The element is checked every period compositions:
+ *  1. Its drift, see the Drift functions of the groups, is computed.
+ *  2. If the drift is above the threshold, the element is normalized with the policy tNormalization.
+ *  3. If the drift is above the fallback threshold, where a cheap policy is no longer exact, the element is normalized
+ *     with SVDNormalization instead.
+ * A threshold of zero normalizes every period compositions and a period of one checks the drift after every composition.
+ */
+
+namespace lie_groups {
+
+constexpr unsigned int kDriftControlPeriod = 64; /** < The default number of compositions between two checks of the drift.*/
+
+template <typename tGroup, typename tNormalization = PolarNormalization>
+class DriftControl {
+
+public:
+
+typedef typename tGroup::Base::DataType DataType;
+typedef typename tGroup::Base::Mat_C Mat_C;
+
+/**
+ * @param period The number of compositions between two checks of the drift. It is at least one.
+ * @param threshold The drift above which the element is normalized.
+ * @param fallback_threshold The drift above which the element is normalized with SVDNormalization. It defaults to the
+ * square root of the precision, below which one step of PolarNormalization is exact to the rounding.
+ */
+DriftControl(const unsigned int period = kDriftControlPeriod, const DataType threshold = static_cast<DataType>(0.0),
+             const DataType fallback_threshold = std::sqrt(std::numeric_limits<DataType>::epsilon())) :
+    period_(std::max(1u,period)), threshold_(threshold), fallback_threshold_(fallback_threshold) {}
+
+/**
+ * Counts a composition that updated g and normalizes g if it is time to.
+ * @param g The element of the chain.
+ * @return True if g was normalized.
+ */
+bool Update(tGroup& g) {
+    if (++count_ < period_) {
+        return false;
+    }
+    count_ = 0;
+
+    const DataType drift = tGroup::Drift(g.data_);
+    if (drift <= threshold_) {
+        return false;
+    }
+    if (drift > fallback_threshold_) {
+        g.template NormalizeEq<SVDNormalization>();
+    } else {
+        g.template NormalizeEq<tNormalization>();
+    }
+    ++num_normalizations_;
+    return true;
+}
+
+/**
+ * Composes g with h, \f$ g \leftarrow g h \f$, and counts the composition.
+ */
+void MultEq(tGroup& g, const tGroup& h) {
+    g.data_ = tGroup::Mult(g.data_,h.data_);
+    Update(g);
+}
+
+/**
+ * Performs the OPlus operation on g, \f$ g \leftarrow g R(u) \f$, and counts the composition.
+ */
+template <typename tRetraction = ExpRetraction>
+void OPlusEq(tGroup& g, const Mat_C& u_data) {
+    g.template OPlusEq<tRetraction>(u_data);
+    Update(g);
+}
+
+/**
+ * Restarts the count of compositions, e.g. when a new chain starts.
+ */
+void Reset() {count_ = 0;}
+
+unsigned int Period() const {return period_;}
+DataType Threshold() const {return threshold_;}
+DataType FallbackThreshold() const {return fallback_threshold_;}
+
+/**
+ * Returns the number of normalizations since the construction.
+ */
+unsigned long NumNormalizations() const {return num_normalizations_;}
+
+private:
+
+unsigned int period_;
+DataType threshold_;
+DataType fallback_threshold_;
+unsigned int count_ = 0;
+unsigned long num_normalizations_ = 0;
+
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_DRIFTCONTROL_
@@ -0,0 +1,414 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_GROUPARRAY_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_GROUPARRAY_
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include "lie_groups/lie_groups/group_base.h"
+
+namespace lie_groups {
+
+constexpr int kGroupArrayBlockSize = 256; /** < The number of elements the batch operations process at once so that the working set stays in cache. */
+
+/**
+ * A container of group elements stored as a structure of arrays. Entry k of the data of every element
+ * (in the column-major order of the group data) is stored contiguously in column k of data_.
+ * This allows the batch operations to stream through memory and to be vectorized by the compiler.
+ *
+ * Elements are accessed through lightweight proxies returned by operator[] which gather and scatter the
+ * data of a single element.
+ */
+template<typename tGroup>
+class GroupArray {
+
+public:
+
+typedef tGroup Group;
+typedef typename Group::Algebra Algebra;
+typedef typename Group::Base::Mat_G Mat_G;
+typedef typename Group::Base::Mat_C Mat_C;
+typedef typename Group::Base::DataType DataType;
+
+static constexpr int size_g_ = Mat_G::SizeAtCompileTime;  /** < The number of entries in the data of a group element. */
+static constexpr int size_c_ = Mat_C::SizeAtCompileTime;  /** < The number of entries in the data of a Cartesian element. */
+typedef Eigen::Matrix<DataType,Eigen::Dynamic,size_g_> Data_G;  /** < Row i holds the data of element i. */
+typedef Eigen::Matrix<DataType,Eigen::Dynamic,size_c_> Data_C;  /** < Row i holds the Cartesian data of element i. */
+typedef Eigen::Matrix<DataType,Eigen::Dynamic,size_c_*size_c_> Data_Cov;  /** < Row i holds a covariance of the Cartesian data of element i in column-major order. */
+
+Data_G data_;
+
+/**
+ * Proxy to an element of a group array. Reading the proxy gathers the data of the element and
+ * assigning to it scatters the data to the array.
+ */
+class Reference {
+public:
+Reference(Data_G& data, Eigen::Index index) : data_(data), index_(index) {}
+
+/**
+ * Copies the referenced element into the other referenced element.
+ */
+Reference& operator = (const Reference& r) {Scatter(data_,index_,r.data()); return *this;}
+
+/**
+ * Sets the referenced element to the one given.
+ */
+Reference& operator = (const Group& g) {Scatter(data_,index_,g.data_); return *this;}
+
+/**
+ * Sets the data of the referenced element to the one given.
+ */
+Reference& operator = (const Mat_G& g_data) {Scatter(data_,index_,g_data); return *this;}
+
+/**
+ * Returns a copy of the referenced element.
+ */
+operator Group() const {return Group(data());}
+
+/**
+ * Returns a copy of the data of the referenced element.
+ */
+Mat_G data() const {return Gather(data_,index_);}
+
+private:
+Data_G& data_;
+Eigen::Index index_;
+};
+
+/**
+ * Read only proxy to an element of a group array.
+ */
+class ConstReference {
+public:
+ConstReference(const Data_G& data, Eigen::Index index) : data_(data), index_(index) {}
+
+/**
+ * Returns a copy of the referenced element.
+ */
+operator Group() const {return Group(data());}
+
+/**
+ * Returns a copy of the data of the referenced element.
+ */
+Mat_G data() const {return Gather(data_,index_);}
+
+private:
+const Data_G& data_;
+Eigen::Index index_;
+};
+
+/**
+ * Default constructor. Initializes an empty array.
+ */
+GroupArray() = default;
+
+/**
+ * Initializes the array with size elements set to identity.
+ */
+explicit GroupArray(Eigen::Index size) : data_(size,Data_G::ColsAtCompileTime) {SetIdentity();}
+
+/**
+ * Returns the number of elements.
+ */
+Eigen::Index Size() const {return data_.rows();}
+
+/**
+ * Changes the number of elements. The data of the elements is not initialized.
+ */
+void Resize(Eigen::Index size) {data_.resize(size,size_g_);}
+
+/**
+ * Sets every element to identity.
+ */
+void SetIdentity() {data_.rowwise() = RowView(Group().data_);}
+
+/**
+ * Returns a proxy to element i.
+ */
+Reference operator [] (Eigen::Index i) {return Reference(data_,i);}
+
+/**
+ * Returns a read only proxy to element i.
+ */
+ConstReference operator [] (Eigen::Index i) const {return ConstReference(data_,i);}
+
+/**
+ * Returns the data of element i.
+ */
+static Mat_G Gather(const Data_G& data, Eigen::Index i) {
+    Mat_G m;
+    RowView(m) = data.row(i);
+    return m;}
+
+/**
+ * Sets the data of element i.
+ */
+static void Scatter(Data_G& data, Eigen::Index i, const Mat_G& g_data) {data.row(i) = RowView(g_data);}
+
+/**
+ * Performs the group operation g1*g2 on every pair of elements.
+ * @param g1 The left elements.
+ * @param g2 The right elements.
+ * @param out The result. It can be the same array as g1 or g2.
+ */
+static void Mult(const GroupArray& g1, const GroupArray& g2, GroupArray& out) {
+    assert(g1.Size() == g2.Size() && "GroupArray::Mult the arrays must have the same size");
+    out.Resize(g1.Size());
+    typedef typename std::conditional<Group::size2_ == 1,
+        typename std::conditional<std::is_same<typename Group::GroupType, Abelian>::value, std::true_type, ElementTag>::type,
+        std::false_type>::type DefaultTag;
+    typedef typename std::conditional<HasBatchMult<Group>::value, BatchTag, DefaultTag>::type Tag;
+    Mult(g1.data_,g2.data_,out.data_,Tag());
+}
+
+/**
+ * Computes the inverse of every element.
+ * @param g The elements.
+ * @param out The result. It can be the same array as g.
+ */
+static void Inverse(const GroupArray& g, GroupArray& out) {
+    out.Resize(g.Size());
+    for (Eigen::Index ii = 0; ii < g.Size(); ++ii) {
+        Scatter(out.data_,ii,Group::Inverse(Gather(g.data_,ii)));
+    }
+}
+
+/**
+ * Computes the exponential of every Cartesian element.
+ * @param u The data of the Cartesian elements.
+ * @param out The result.
+ */
+static void Exp(const Data_C& u, GroupArray& out) {
+    out.Resize(u.rows());
+    Exp(u,out.data_,HasBatchKernels<Algebra>());
+}
+
+/**
+ * Computes the logarithm of every element.
+ * @param g The elements.
+ * @param out The data of the resulting Cartesian elements.
+ */
+static void Log(const GroupArray& g, Data_C& out) {
+    out.resize(g.Size(),size_c_);
+    Log(g.data_,out,HasBatchKernels<Algebra>());
+}
+
+/**
+ * Performs the OPlus operation \f$ g \exp(u) \f$ on every element.
+ * @param g The elements.
+ * @param u The data of the Cartesian elements.
+ * @param out The result. It can be the same array as g.
+ */
+static void OPlus(const GroupArray& g, const Data_C& u, GroupArray& out) {
+    GroupArray tmp;
+    Exp(u,tmp);
+    Mult(g,tmp,out);
+}
+
+/**
+ * Performs the O-minus operation \f$ \log(g_2^{-1} g_1) \f$ on every pair of elements.
+ * @param g1 The elements \f$ g_1 \f$.
+ * @param g2 The elements \f$ g_2 \f$.
+ * @param out The data of the resulting Cartesian elements.
+ */
+static void OMinus(const GroupArray& g1, const GroupArray& g2, Data_C& out) {
+    GroupArray tmp;
+    Inverse(g2,tmp);
+    Mult(tmp,g1,tmp);
+    Log(tmp,out);
+}
+
+/**
+ * Applies the adjoint map of every element to the corresponding Cartesian element.
+ * The group must provide the batch kernel BatchAdjointAct.
+ * @param g The elements.
+ * @param v The data of the Cartesian elements.
+ * @param out The result. It can be the same as v.
+ */
+static void AdjointAct(const GroupArray& g, const Data_C& v, Data_C& out) {
+    out.resize(g.Size(),size_c_);
+    Columns<const DataType*> g_cols(g.data_), v_cols(v);
+    Columns<DataType*> out_cols(out);
+    Group::BatchAdjointAct(g_cols.ptr,v_cols.ptr,out_cols.ptr,g.Size());
+}
+
+/**
+ * Applies the adjoint map of the inverse of every element to the corresponding Cartesian element.
+ * The group must provide the batch kernel BatchAdjointInvAct.
+ * @param g The elements.
+ * @param v The data of the Cartesian elements.
+ * @param out The result. It can be the same as v.
+ */
+static void AdjointInvAct(const GroupArray& g, const Data_C& v, Data_C& out) {
+    out.resize(g.Size(),size_c_);
+    Columns<const DataType*> g_cols(g.data_), v_cols(v);
+    Columns<DataType*> out_cols(out);
+    Group::BatchAdjointInvAct(g_cols.ptr,v_cols.ptr,out_cols.ptr,g.Size());
+}
+
+/**
+ * Transforms the covariance of every element with its adjoint map, \f$ Ad P Ad^\top \f$.
+ * The group must provide the batch kernel BatchAdjointTransformCovariance.
+ * @param g The elements.
+ * @param cov The symmetric covariances.
+ * @param out The result. It can be the same as cov.
+ */
+static void AdjointTransformCovariance(const GroupArray& g, const Data_Cov& cov, Data_Cov& out) {
+    out.resize(g.Size(),size_c_*size_c_);
+    Columns<const DataType*> g_cols(g.data_), cov_cols(cov);
+    Columns<DataType*> out_cols(out);
+    Group::BatchAdjointTransformCovariance(g_cols.ptr,cov_cols.ptr,out_cols.ptr,g.Size());
+}
+
+private:
+
+typedef Eigen::Matrix<DataType,1,size_g_> Row_G;
+
+/**
+ * The pointers to the columns of an array which is how the batch kernels take their arguments.
+ */
+template<typename tPointer>
+struct Columns {
+    template<typename tData>
+    explicit Columns(tData& data) {
+        for (Eigen::Index k = 0; k < data.cols(); ++k) {ptr[k] = data.col(k).data();}
+    }
+    tPointer ptr[size_g_ > size_c_*size_c_ ? size_g_ : size_c_*size_c_];
+};
+
+/**
+ * Detects if the Lie algebra provides the SIMD kernels BatchExp and BatchLog that operate on a structure of arrays.
+ */
+template<typename tAlgebra, typename = void>
+struct HasBatchKernels : std::false_type {};
+
+template<typename tAlgebra>
+struct HasBatchKernels<tAlgebra, decltype(void(&tAlgebra::BatchExp), void(&tAlgebra::BatchLog))> : std::true_type {};
+
+/**
+ * Detects if the group provides the SIMD kernel BatchMult that operates on a structure of arrays.
+ */
+template<typename tG, typename = void>
+struct HasBatchMult : std::false_type {};
+
+template<typename tG>
+struct HasBatchMult<tG, decltype(void(&tG::BatchMult))> : std::true_type {};
+
+struct BatchTag {};
+struct ElementTag {};
+
+/**
+ * Computes the exponential of every element with the batch kernel of the Lie algebra.
+ */
+static void Exp(const Data_C& u, Data_G& out, std::true_type) {
+    const DataType* u_cols[size_c_];
+    DataType* out_cols[size_g_];
+    for (int k = 0; k < size_c_; ++k) {u_cols[k] = u.col(k).data();}
+    for (int k = 0; k < size_g_; ++k) {out_cols[k] = out.col(k).data();}
+    Algebra::BatchExp(u_cols,out_cols,u.rows());
+}
+
+/**
+ * Computes the exponential of every element one at a time.
+ */
+static void Exp(const Data_C& u, Data_G& out, std::false_type) {
+    Mat_C u_data;
+    for (Eigen::Index ii = 0; ii < u.rows(); ++ii) {
+        u_data = u.row(ii).transpose();
+        Scatter(out,ii,Algebra::Exp(u_data));
+    }
+}
+
+/**
+ * Computes the logarithm of every element with the batch kernel of the Lie algebra.
+ */
+static void Log(const Data_G& g, Data_C& out, std::true_type) {
+    const DataType* g_cols[size_g_];
+    DataType* out_cols[size_c_];
+    for (int k = 0; k < size_g_; ++k) {g_cols[k] = g.col(k).data();}
+    for (int k = 0; k < size_c_; ++k) {out_cols[k] = out.col(k).data();}
+    Algebra::BatchLog(g_cols,out_cols,g.rows());
+}
+
+/**
+ * Computes the logarithm of every element one at a time.
+ */
+static void Log(const Data_G& g, Data_C& out, std::false_type) {
+    for (Eigen::Index ii = 0; ii < g.rows(); ++ii) {
+        out.row(ii) = Algebra::Log(Gather(g,ii)).transpose();
+    }
+}
+
+/**
+ * Views the data of a group element as a row of the array.
+ */
+static Eigen::Map<Row_G> RowView(Mat_G& g_data) {return Eigen::Map<Row_G>(g_data.data());}
+static Eigen::Map<const Row_G> RowView(const Mat_G& g_data) {return Eigen::Map<const Row_G>(g_data.data());}
+
+/**
+ * Performs the group operation with the batch kernel of the group.
+ */
+static void Mult(const Data_G& g1, const Data_G& g2, Data_G& out, BatchTag) {
+    const DataType* g1_cols[size_g_];
+    const DataType* g2_cols[size_g_];
+    DataType* out_cols[size_g_];
+    for (int k = 0; k < size_g_; ++k) {
+        g1_cols[k] = g1.col(k).data();
+        g2_cols[k] = g2.col(k).data();
+        out_cols[k] = out.col(k).data();
+    }
+    Group::BatchMult(g1_cols,g2_cols,out_cols,g1.rows());
+}
+
+/**
+ * The group operation of the non-abelian groups whose data is a vector, e.g. a quaternion, is computed one element
+ * at a time.
+ */
+static void Mult(const Data_G& g1, const Data_G& g2, Data_G& out, ElementTag) {
+    for (Eigen::Index ii = 0; ii < g1.rows(); ++ii) {
+        Scatter(out,ii,Group::Mult(Gather(g1,ii),Gather(g2,ii)));
+    }
+}
+
+/**
+ * The group operation of the abelian groups whose data is a vector is addition.
+ */
+static void Mult(const Data_G& g1, const Data_G& g2, Data_G& out, std::true_type) {
+    out = g1 + g2;
+}
+
+/**
+ * The group operation of matrix groups is matrix multiplication. Every entry of the product is computed
+ * for a block of elements at once as a sum of coefficient-wise products of the columns.
+ */
+static void Mult(const Data_G& g1, const Data_G& g2, Data_G& out, std::false_type) {
+
+    constexpr int n = Group::size1_;
+    Eigen::Matrix<DataType,kGroupArrayBlockSize,size_g_> tmp;
+
+    for (Eigen::Index start = 0; start < g1.rows(); start += kGroupArrayBlockSize) {
+        const Eigen::Index len = std::min<Eigen::Index>(kGroupArrayBlockSize, g1.rows()-start);
+        auto a = g1.middleRows(start,len);
+        auto b = g2.middleRows(start,len);
+        auto c = tmp.topRows(len);
+
+        for (int col = 0; col < n; ++col) {
+            for (int row = 0; row < n; ++row) {
+                c.col(row+col*n) = a.col(row).cwiseProduct(b.col(col*n));
+                for (int k = 1; k < n; ++k) {
+                    c.col(row+col*n) += a.col(row+k*n).cwiseProduct(b.col(k+col*n));
+                }
+            }
+        }
+
+        // The block is written after it is computed so that out can alias g1 or g2.
+        out.middleRows(start,len) = c;
+    }
+}
+
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_GROUPARRAY_
@@ -0,0 +1,248 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEALGEBRAS_ANYALGEBRA_
+#define _LIEGROUPS_INCLUDE_LIEALGEBRAS_ANYALGEBRA_
+
+#include <Eigen/Dense>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+
+namespace lie_groups {
+
+constexpr int kAnyMaxDim = 6; /** < The largest dimension of the Cartesian space of AnyAlgebra and AnyGroup. */
+
+template <typename tDataType> class AnyGroup;
+
+namespace internal {
+
+/**
+ * The operations of one Lie algebra on the Cartesian data of AnyAlgebra. The data is given as a pointer to
+ * its scalars and the matrices are returned in fixed capacity Eigen types, so no operation allocates.
+ */
+template <typename tDataType>
+struct AnyAlgebraTable {
+    typedef Eigen::Matrix<tDataType,Eigen::Dynamic,Eigen::Dynamic,0,kAnyMaxDim,kAnyMaxDim> Mat;
+
+    int dim_;   /** < The dimension of the Cartesian space. */
+    void (*bracket_)(const tDataType* u, const tDataType* v, tDataType* out);
+    void (*adjoint_)(const tDataType* u, Mat& m);
+    void (*wedge_)(const tDataType* u, Mat& m);
+    void (*jr_)(const tDataType* u, Mat& m);
+    void (*jl_)(const tDataType* u, Mat& m);
+    void (*jr_inv_)(const tDataType* u, Mat& m);
+    void (*jl_inv_)(const tDataType* u, Mat& m);
+};
+
+/**
+ * Implements the table of AnyAlgebra with the functions of tAlgebra. The Jacobians are restricted to the block of the
+ * group, as in retraction.h.
+ */
+template <typename tAlgebra, typename tDataType>
+struct AnyAlgebraModel {
+
+    typedef Eigen::Matrix<tDataType,tAlgebra::total_num_dim_,1> Mat_C;
+    typedef typename AnyAlgebraTable<tDataType>::Mat Mat;
+    typedef typename std::decay<decltype(tAlgebra::Wedge(std::declval<Mat_C>()))>::type Mat_A;
+    static constexpr int dim_ = tAlgebra::dim_;
+
+    static_assert(std::is_same<typename std::decay<decltype(std::declval<tAlgebra>().data_)>::type::Scalar, tDataType>::value,
+                  "lie_groups::AnyAlgebra the data type of the algebra must be the one of AnyAlgebra.");
+    static_assert(Mat_C::SizeAtCompileTime <= kAnyMaxDim && Mat_A::RowsAtCompileTime <= kAnyMaxDim && Mat_A::ColsAtCompileTime <= kAnyMaxDim,
+                  "lie_groups::AnyAlgebra the algebra is too large.");
+
+    static Eigen::Map<Mat_C> CartesianMap(tDataType* u) {return Eigen::Map<Mat_C>(u);}
+
+    static tAlgebra Load(const tDataType* u) {
+        const Mat_C data = Eigen::Map<const Mat_C>(u);
+        return tAlgebra(data);
+    }
+
+    static void Bracket(const tDataType* u, const tDataType* v, tDataType* out) {
+        CartesianMap(out) = Load(u).Bracket(Load(v)).data_;
+    }
+    static void Adjoint(const tDataType* u, Mat& m) {m = Load(u).Adjoint().template topLeftCorner<dim_,dim_>();}
+    static void Wedge(const tDataType* u, Mat& m) {m = tAlgebra::Wedge(Eigen::Map<const Mat_C>(u));}
+    static void Jr(const tDataType* u, Mat& m) {m = Load(u).Jr().template topLeftCorner<dim_,dim_>();}
+    static void Jl(const tDataType* u, Mat& m) {m = Load(u).Jl().template topLeftCorner<dim_,dim_>();}
+    static void JrInv(const tDataType* u, Mat& m) {m = Load(u).JrInv().template topLeftCorner<dim_,dim_>();}
+    static void JlInv(const tDataType* u, Mat& m) {m = Load(u).JlInv().template topLeftCorner<dim_,dim_>();}
+
+    static const AnyAlgebraTable<tDataType> table_;
+};
+
+template <typename tAlgebra, typename tDataType>
+const AnyAlgebraTable<tDataType> AnyAlgebraModel<tAlgebra,tDataType>::table_ = {
+    static_cast<int>(Mat_C::SizeAtCompileTime), &Bracket, &Adjoint, &Wedge, &Jr, &Jl, &JrInv, &JlInv};
+
+} // namespace internal
+
+/**
+ * An element of any of the Lie algebras whose type is chosen at run time. The Cartesian data is stored in a buffer
+ * of kAnyMaxDim scalars next to a pointer to the table of the operations of the algebra, so an element never
+ * allocates and every operation is one indirect call to the static functions of the algebra. The linear operations
+ * are performed on the buffer directly. The algebras with several tangent spaces are too large to be stored.
+ *
+ * The operations between two elements require elements of the same algebra, otherwise they print an error and
+ * return an empty element. An empty element has no algebra; it is only valid to check Empty on it and to assign to it.
+ */
+template <typename tDataType = double>
+class AnyAlgebra {
+
+public:
+
+typedef Eigen::Matrix<tDataType,Eigen::Dynamic,1,0,kAnyMaxDim,1> Mat_C;                          /**< The Cartesian space data type. */
+typedef Eigen::Matrix<tDataType,Eigen::Dynamic,Eigen::Dynamic,0,kAnyMaxDim,kAnyMaxDim> Mat_A;   /**< The Lie algebra data type. */
+typedef Mat_A Mat_Jac;                                                                            /**< The Jacobian data type. */
+
+/**
+ * Default constructor. The element is empty.
+ */
+AnyAlgebra() : table_(nullptr), data_() {}
+
+/**
+ * Stores an element of the algebra tAlgebra.
+ */
+template <typename tAlgebra>
+explicit AnyAlgebra(const tAlgebra& u) : table_(&internal::AnyAlgebraModel<tAlgebra,tDataType>::table_), data_() {
+    internal::AnyAlgebraModel<tAlgebra,tDataType>::CartesianMap(data_) = u.data_;
+}
+
+/**
+ * Returns true if the element has no algebra.
+ */
+bool Empty() const {return table_ == nullptr;}
+
+/**
+ * Returns true if the element belongs to the algebra tAlgebra.
+ */
+template <typename tAlgebra>
+bool Is() const {return table_ == &internal::AnyAlgebraModel<tAlgebra,tDataType>::table_;}
+
+/**
+ * Returns the element as an element of tAlgebra. It must belong to it, see Is.
+ */
+template <typename tAlgebra>
+tAlgebra Get() const {return internal::AnyAlgebraModel<tAlgebra,tDataType>::Load(data_);}
+
+/**
+ * Returns the dimension of the Cartesian space.
+ */
+int Dim() const {return table_->dim_;}
+
+/**
+ * Returns the Cartesian data of the element.
+ */
+Mat_C Data() const {return Map();}
+
+/**
+ * Performs the Lie bracket \f$ [v,u] \f$ with this being v.
+ * @param u An element of the same Lie algebra.
+ */
+AnyAlgebra Bracket(const AnyAlgebra& u) const {
+    if (!Compatible(u,"Bracket")) {
+        return AnyAlgebra();
+    }
+    AnyAlgebra out(table_);
+    table_->bracket_(data_,u.data_,out.data_);
+    return out;
+}
+
+/**
+ * Computes the matrix adjoint representation of the element.
+ */
+Mat_Jac Adjoint() const {Mat_Jac m; table_->adjoint_(data_,m); return m;}
+
+/**
+ * Computes the Wedge operation which maps the Cartesian data to the Lie algebra.
+ */
+Mat_A Wedge() const {Mat_A m; table_->wedge_(data_,m); return m;}
+
+/**
+ * Computes the Euclidean norm of the Cartesian data.
+ */
+tDataType Norm() const {return Map().norm();}
+
+/**
+ * Computes the right Jacobian.
+ */
+Mat_Jac Jr() const {Mat_Jac m; table_->jr_(data_,m); return m;}
+
+/**
+ * Computes the left Jacobian.
+ */
+Mat_Jac Jl() const {Mat_Jac m; table_->jl_(data_,m); return m;}
+
+/**
+ * Computes the inverse of the right Jacobian.
+ */
+Mat_Jac JrInv() const {Mat_Jac m; table_->jr_inv_(data_,m); return m;}
+
+/**
+ * Computes the inverse of the left Jacobian.
+ */
+Mat_Jac JlInv() const {Mat_Jac m; table_->jl_inv_(data_,m); return m;}
+
+/**
+ * Adds two elements of the same algebra.
+ */
+AnyAlgebra operator + (const AnyAlgebra& u) const {
+    if (!Compatible(u,"operator +")) {
+        return AnyAlgebra();
+    }
+    AnyAlgebra out(table_);
+    out.Map() = Map() + u.Map();
+    return out;
+}
+
+/**
+ * Subtracts two elements of the same algebra.
+ */
+AnyAlgebra operator - (const AnyAlgebra& u) const {
+    if (!Compatible(u,"operator -")) {
+        return AnyAlgebra();
+    }
+    AnyAlgebra out(table_);
+    out.Map() = Map() - u.Map();
+    return out;
+}
+
+/**
+ * Performs scalar multiplication.
+ */
+AnyAlgebra operator * (const tDataType scalar) const {
+    AnyAlgebra out(table_);
+    out.Map() = scalar*Map();
+    return out;
+}
+
+/**
+ * Prints the data of the element.
+ */
+void Print() const {std::cout << Data() << std::endl;}
+
+private:
+
+template <typename> friend class AnyGroup;
+
+explicit AnyAlgebra(const internal::AnyAlgebraTable<tDataType>* table) : table_(table) {}
+
+// The Cartesian data of the element
+Eigen::Map<Mat_C> Map() {return Eigen::Map<Mat_C>(data_,table_->dim_);}
+Eigen::Map<const Mat_C> Map() const {return Eigen::Map<const Mat_C>(data_,table_->dim_);}
+
+// Verifies that u belongs to the same algebra and prints an error otherwise.
+bool Compatible(const AnyAlgebra& u, const char* operation) const {
+    if (table_ != u.table_ || table_ == nullptr) {
+        std::cerr << "AnyAlgebra::" << operation << " the elements do not belong to the same algebra" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const internal::AnyAlgebraTable<tDataType>* table_;
+tDataType data_[kAnyMaxDim];
+
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEALGEBRAS_ANYALGEBRA_
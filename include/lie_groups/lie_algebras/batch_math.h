@@ -0,0 +1,198 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEALGEBRAS_BATCHMATH_
+#define _LIEGROUPS_INCLUDE_LIEALGEBRAS_BATCHMATH_
+
+#include <Eigen/Core>
+#include <limits>
+
+/**
+ * Branchless elementary functions used by the batch kernels of the Lie algebras. They are written
+ * on Eigen's packet primitives so that a single call processes a full SIMD register, i.e. 2 doubles with SSE2,
+ * 4 with AVX2 and 8 with AVX-512, depending on the instruction set the code is compiled for. The same
+ * functions instantiated with a plain scalar type are the scalar fallback used for the remainder of a batch
+ * and when vectorization is disabled.
+ *
+ * The polynomial approximations are the ones of fdlibm (double) and cephes (float). On their reduced
+ * ranges they are accurate to about 1 ulp.
+ */
+
+namespace lie_groups { namespace batch_math {
+
+namespace ei = Eigen::internal;
+
+template<typename tPacket>
+struct PacketTraits {
+typedef typename ei::unpacket_traits<tPacket>::type Scalar;
+};
+
+/**
+ * Returns a packet with every lane set to the value given.
+ */
+template<typename tPacket>
+EIGEN_STRONG_INLINE tPacket Set(const typename PacketTraits<tPacket>::Scalar value) {return ei::pset1<tPacket>(value);}
+
+/**
+ * Computes a*b+c.
+ */
+template<typename tPacket>
+EIGEN_STRONG_INLINE tPacket Madd(const tPacket& a, const tPacket& b, const tPacket& c) {return ei::pmadd(a,b,c);}
+
+//---------------------------------------------------------------------
+// The coefficients of the approximations for each scalar type.
+
+/**
+ * Computes the sine and cosine of r in \f$ [-\pi/4, \pi/4] \f$.
+ */
+template<typename tPacket>
+EIGEN_STRONG_INLINE void SinCosReduced(const tPacket& r, tPacket& s, tPacket& c, double) {
+    const tPacket z = ei::pmul(r,r);
+    tPacket ps = Madd(z, Set<tPacket>(1.58969099521155010221e-10), Set<tPacket>(-2.50507602534068634195e-08));
+    ps = Madd(z, ps, Set<tPacket>(2.75573137070700676789e-06));
+    ps = Madd(z, ps, Set<tPacket>(-1.98412698298579493134e-04));
+    ps = Madd(z, ps, Set<tPacket>(8.33333333332248946124e-03));
+    ps = Madd(z, ps, Set<tPacket>(-1.66666666666666324348e-01));
+    s = Madd(ei::pmul(r,z), ps, r);
+
+    tPacket pc = Madd(z, Set<tPacket>(-1.13596475577881948265e-11), Set<tPacket>(2.08757232129817482790e-09));
+    pc = Madd(z, pc, Set<tPacket>(-2.75573143513906633035e-07));
+    pc = Madd(z, pc, Set<tPacket>(2.48015872894767294178e-05));
+    pc = Madd(z, pc, Set<tPacket>(-1.38888888888741095749e-03));
+    pc = Madd(z, pc, Set<tPacket>(4.16666666666666019037e-02));
+    c = Madd(ei::pmul(z,z), pc, Madd(z, Set<tPacket>(-0.5), Set<tPacket>(1.0)));
+}
+
+template<typename tPacket>
+EIGEN_STRONG_INLINE void SinCosReduced(const tPacket& r, tPacket& s, tPacket& c, float) {
+    const tPacket z = ei::pmul(r,r);
+    tPacket ps = Madd(z, Set<tPacket>(-1.9515295891e-4f), Set<tPacket>(8.3321608736e-3f));
+    ps = Madd(z, ps, Set<tPacket>(-1.6666654611e-1f));
+    s = Madd(ei::pmul(r,z), ps, r);
+
+    tPacket pc = Madd(z, Set<tPacket>(2.443315711809948e-5f), Set<tPacket>(-1.388731625493765e-3f));
+    pc = Madd(z, pc, Set<tPacket>(4.166664568298827e-2f));
+    c = Madd(ei::pmul(z,z), pc, Madd(z, Set<tPacket>(-0.5f), Set<tPacket>(1.0f)));
+}
+
+/**
+ * Subtracts k times \f$ \pi/2 \f$ from x. \f$ \pi/2 \f$ is split in three parts so that the
+ * products with k are exact for the supported range of x.
+ */
+template<typename tPacket>
+EIGEN_STRONG_INLINE tPacket ReducePio2(const tPacket& x, const tPacket& k, double) {
+    tPacket r = ei::psub(x, ei::pmul(k, Set<tPacket>(1.57079632673412561417e+00)));
+    r = ei::psub(r, ei::pmul(k, Set<tPacket>(6.07710050630396597660e-11)));
+    return ei::psub(r, ei::pmul(k, Set<tPacket>(2.02226624879595063154e-21)));
+}
+
+template<typename tPacket>
+EIGEN_STRONG_INLINE tPacket ReducePio2(const tPacket& x, const tPacket& k, float) {
+    tPacket r = ei::psub(x, ei::pmul(k, Set<tPacket>(1.5703125f)));
+    r = ei::psub(r, ei::pmul(k, Set<tPacket>(4.837512969970703125e-4f)));
+    return ei::psub(r, ei::pmul(k, Set<tPacket>(7.54978995489188216e-8f)));
+}
+
+/**
+ * Computes the arc tangent of t in \f$ [0, 1] \f$.
+ */
+template<typename tPacket>
+EIGEN_STRONG_INLINE tPacket AtanUnit(const tPacket& t, double) {
+    // Above 0.66 use atan(t) = pi/4 + atan((t-1)/(t+1))
+    const tPacket one = Set<tPacket>(1.0);
+    const tPacket reduce = ei::pcmp_lt(Set<tPacket>(0.66), t);
+    const tPacket x = ei::pselect(reduce, ei::pdiv(ei::psub(t,one), ei::padd(t,one)), t);
+    const tPacket z = ei::pmul(x,x);
+
+    tPacket p = Madd(z, Set<tPacket>(-8.750608600031904122785e-1), Set<tPacket>(-1.615753718733365076637e1));
+    p = Madd(z, p, Set<tPacket>(-7.500855792314704667340e1));
+    p = Madd(z, p, Set<tPacket>(-1.228866684490136173410e2));
+    p = Madd(z, p, Set<tPacket>(-6.485021904942025371773e1));
+    tPacket q = ei::padd(z, Set<tPacket>(2.485846490142306297962e1));
+    q = Madd(z, q, Set<tPacket>(1.650270098316988542046e2));
+    q = Madd(z, q, Set<tPacket>(4.328810604912902668951e2));
+    q = Madd(z, q, Set<tPacket>(4.853903996359136964868e2));
+    q = Madd(z, q, Set<tPacket>(1.945506571482613964425e2));
+
+    const tPacket a = Madd(ei::pmul(x,z), ei::pdiv(p,q), x);
+    // pi/4 is split in two parts so that the low part is added before the rounding of the sum
+    const tPacket a_reduced = ei::padd(Set<tPacket>(7.85398163397448278999e-01), ei::padd(a, Set<tPacket>(3.061616997868382943065e-17)));
+    return ei::pselect(reduce, a_reduced, a);
+}
+
+template<typename tPacket>
+EIGEN_STRONG_INLINE tPacket AtanUnit(const tPacket& t, float) {
+    // Above tan(pi/8) use atan(t) = pi/4 + atan((t-1)/(t+1))
+    const tPacket one = Set<tPacket>(1.0f);
+    const tPacket reduce = ei::pcmp_lt(Set<tPacket>(0.414213562373095f), t);
+    const tPacket x = ei::pselect(reduce, ei::pdiv(ei::psub(t,one), ei::padd(t,one)), t);
+    const tPacket z = ei::pmul(x,x);
+
+    tPacket p = Madd(z, Set<tPacket>(8.05374449538e-2f), Set<tPacket>(-1.38776856032e-1f));
+    p = Madd(z, p, Set<tPacket>(1.99777106478e-1f));
+    p = Madd(z, p, Set<tPacket>(-3.33329491539e-1f));
+
+    const tPacket a = Madd(ei::pmul(x,z), p, x);
+    return ei::pselect(reduce, ei::padd(Set<tPacket>(7.85398163397448e-1f), a), a);
+}
+
+//---------------------------------------------------------------------
+
+/**
+ * Computes the sine and cosine of every lane of x. The argument is reduced by multiples of \f$ \pi/2 \f$,
+ * so the result is accurate to about 1 ulp for \f$ |x| < 10^6 \f$ in double precision and \f$ |x| < 10^3 \f$
+ * in single precision.
+ * @param x The angles.
+ * @param s The sines of the angles.
+ * @param c The cosines of the angles.
+ */
+template<typename tPacket>
+EIGEN_STRONG_INLINE void SinCos(const tPacket& x, tPacket& s, tPacket& c) {
+    typedef typename PacketTraits<tPacket>::Scalar Scalar;
+
+    // x = k*pi/2 + r with r in [-pi/4, pi/4]
+    const tPacket k = ei::pfloor(Madd(x, Set<tPacket>(static_cast<Scalar>(0.636619772367581343076)), Set<tPacket>(static_cast<Scalar>(0.5))));
+    const tPacket r = ReducePio2(x, k, Scalar());
+    tPacket sr, cr;
+    SinCosReduced(r, sr, cr, Scalar());
+
+    // The quadrant q = k mod 4 decides which of sin(r) and cos(r) is used and its sign.
+    const tPacket q = ei::psub(k, ei::pmul(Set<tPacket>(4), ei::pfloor(ei::pmul(k, Set<tPacket>(static_cast<Scalar>(0.25))))));
+    const tPacket q1 = ei::pcmp_eq(q, Set<tPacket>(1));
+    const tPacket q2 = ei::pcmp_eq(q, Set<tPacket>(2));
+    const tPacket q3 = ei::pcmp_eq(q, Set<tPacket>(3));
+    const tPacket swap = ei::por(q1, q3);
+    const tPacket s0 = ei::pselect(swap, cr, sr);
+    const tPacket c0 = ei::pselect(swap, sr, cr);
+    s = ei::pselect(ei::por(q2, q3), ei::pnegate(s0), s0);
+    c = ei::pselect(ei::por(q1, q2), ei::pnegate(c0), c0);
+}
+
+/**
+ * Computes the four quadrant arc tangent of y/x. The result is in \f$ [-\pi, \pi] \f$ and has the
+ * sign of y. It is 0 when both y and x are 0.
+ * @param y The numerators.
+ * @param x The denominators.
+ */
+template<typename tPacket>
+EIGEN_STRONG_INLINE tPacket Atan2(const tPacket& y, const tPacket& x) {
+    typedef typename PacketTraits<tPacket>::Scalar Scalar;
+
+    const tPacket ay = ei::pabs(y);
+    const tPacket ax = ei::pabs(x);
+    const tPacket mn = ei::pmin(ay, ax);
+    const tPacket mx = ei::pmax(ei::pmax(ay, ax), Set<tPacket>(std::numeric_limits<Scalar>::min()));
+    tPacket a = AtanUnit(ei::pdiv(mn, mx), Scalar());
+
+    // Map the result from [0, pi/4] back to the octant of (x,|y|). The constants are split in a high 
+    // and a low part so that the low part is subtracted before the rounding of the difference.
+    const tPacket pio2_hi = Set<tPacket>(static_cast<Scalar>(1.57079632679489655800e+00));
+    const tPacket pio2_lo = Set<tPacket>(static_cast<Scalar>(6.12323399573676603587e-17));
+    a = ei::pselect(ei::pcmp_lt(ax, ay), ei::padd(pio2_hi, ei::psub(pio2_lo, a)), a);
+    const tPacket pi_hi = Set<tPacket>(static_cast<Scalar>(3.14159265358979311600e+00));
+    const tPacket pi_lo = Set<tPacket>(static_cast<Scalar>(1.22464679914735317720e-16));
+    a = ei::pselect(ei::pcmp_lt(x, Set<tPacket>(0)), ei::padd(pi_hi, ei::psub(pi_lo, a)), a);
+    return ei::pselect(ei::pcmp_lt(y, Set<tPacket>(0)), ei::pnegate(a), a);
+}
+
+} // namespace batch_math
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEALGEBRAS_BATCHMATH_
@@ -39,22 +39,22 @@ rn() : data_(VecAlgebra::Zero()) {}
 /**
  * Copy constructor.
  */ 
-rn(const rn & u) : data_(u.data_) {}
+rn(const rn & u) = default;
 
 /**
  * Copy assignment.
  */
-void operator = (const rn& u){data_ = u.data_;}
+rn& operator = (const rn& u) = default;
 
 /**
  * Move constructor.
  */ 
-rn(const rn && u) : data_(u.data_) {}
+rn(rn && u) = default;
 
 /**
  * Move assignment.
  */
-void operator = (const rn&& u){data_ = u.data_;}
+rn& operator = (rn&& u) = default;
 
 /**
 * Initializes algebra element to the one given. 
@@ -75,10 +75,9 @@ rn(const VecAlgebra & data, bool verify) : data_(data){}
  * Performs the Lie bracket which is always the identity element. 
  * The input is the right parameter 
  * of the Lie bracket function. \f$ \[v,u\] \f$
- * @param u An element of the Lie algebra.
  * @return The result of the Lie bracket operation.
  */ 
-rn Bracket(const rn& u) {return rn();}
+rn Bracket(const rn&) {return rn();}
 
 /**
  * Computes and returns the matrix adjoint representation of the Lie algebra.
@@ -142,6 +141,86 @@ static VecAlgebra Log(const VecGroup& data) {
     a.block(0,0,dim_,1) = data;
     return a;}
 
+/**
+ * Computes the exponential and the left Jacobian of the element of the Lie algebra.
+ * The left Jacobian is always the identity map for \f$ \mathbb{R}^n\f$.
+ * @param data The data of an element of the Lie algebra
+ * @param jl The left Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static VecGroup ExpWithJl(const VecAlgebra& data, MatAlgebra& jl) {jl.setIdentity(); return Exp(data);}
+
+/**
+ * Computes the exponential and the right Jacobian of the element of the Lie algebra.
+ * The right Jacobian is always the identity map for \f$ \mathbb{R}^n\f$.
+ * @param data The data of an element of the Lie algebra
+ * @param jr The right Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static VecGroup ExpWithJr(const VecAlgebra& data, MatAlgebra& jr) {jr.setIdentity(); return Exp(data);}
+
+/**
+ * Computes the logarithm and the left Jacobian inverse evaluated at the logarithm. 
+ * The left Jacobian inverse is always the identity map for \f$ \mathbb{R}^n\f$.
+ * @param data The data associated with an element of \f$ \mathbb{R}^n\f$
+ * @param jl_inv The left Jacobian inverse evaluated at the result
+ * @return The data of an element of the Lie algebra
+ */
+static VecAlgebra LogWithJlInv(const VecGroup& data, MatAlgebra& jl_inv) {jl_inv.setIdentity(); return Log(data);}
+
+/**
+ * Computes the logarithm and the right Jacobian inverse evaluated at the logarithm. 
+ * The right Jacobian inverse is always the identity map for \f$ \mathbb{R}^n\f$.
+ * @param data The data associated with an element of \f$ \mathbb{R}^n\f$
+ * @param jr_inv The right Jacobian inverse evaluated at the result
+ * @return The data of an element of the Lie algebra
+ */
+static VecAlgebra LogWithJrInv(const VecGroup& data, MatAlgebra& jr_inv) {jr_inv.setIdentity(); return Log(data);}
+
+/**
+ * The retractions of a vector space are the exponential. See CayleyRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static VecGroup Cayley(const VecAlgebra& data) {return Exp(data);}
+
+/**
+ * The inverse of Cayley is the logarithm.
+ * @param data The data of an element of the group
+ */
+static VecAlgebra CayleyInv(const VecGroup& data) {return Log(data);}
+
+/**
+ * The Jacobian of Cayley is the identity.
+ */
+static MatAlgebra CayleyJr(const VecAlgebra&) {return MatAlgebra::Identity();}
+
+/**
+ * The inverse of the Jacobian of Cayley is the identity.
+ */
+static MatAlgebra CayleyJrInv(const VecAlgebra&) {return MatAlgebra::Identity();}
+
+/**
+ * The retractions of a vector space are the exponential. See FirstOrderRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static VecGroup FirstOrder(const VecAlgebra& data) {return Exp(data);}
+
+/**
+ * The inverse of FirstOrder is the logarithm.
+ * @param data The data of an element of the group
+ */
+static VecAlgebra FirstOrderInv(const VecGroup& data) {return Log(data);}
+
+/**
+ * The Jacobian of FirstOrder is the identity.
+ */
+static MatAlgebra FirstOrderJr(const VecAlgebra&) {return MatAlgebra::Identity();}
+
+/**
+ * The inverse of the Jacobian of FirstOrder is the identity.
+ */
+static MatAlgebra FirstOrderJrInv(const VecAlgebra&) {return MatAlgebra::Identity();}
+
 /**
  * Computes and returns the Euclidean norm of the element of the Lie algebra
  */ 
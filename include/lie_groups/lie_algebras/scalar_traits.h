@@ -0,0 +1,34 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEALGEBRAS_SCALARTRAITS_
+#define _LIEGROUPS_INCLUDE_LIEALGEBRAS_SCALARTRAITS_
+
+namespace lie_groups {
+
+/**
+ * The thresholds that depend on the precision of the scalar type. The closed forms of the exponential, the logarithm
+ * and the Jacobians lose about \f$ \epsilon/\theta \f$ of accuracy to cancellation close to the identity while their Taylor
+ * series lose the first neglected term, so the angle at which one is swapped for the other grows with the machine epsilon.
+ * The primary template holds the values for double. They are the ones the library has always used.
+ */
+template <typename tDataType>
+struct ScalarTraits {
+static constexpr tDataType small_angle_threshold_ = static_cast<tDataType>(1e-7);  /** < Below this angle the closed forms are replaced by their Taylor series up to the second order.*/
+static constexpr tDataType series_threshold_ = static_cast<tDataType>(1e-1);       /** < Below this angle the coefficients of the Jacobians that suffer from cancellation use their Taylor series.*/
+static constexpr tDataType algebra_threshold_ = static_cast<tDataType>(1e-7);      /** < Tolerance of the checks that data is an element of a Lie algebra.*/
+static constexpr tDataType group_threshold_ = static_cast<tDataType>(1e-6);        /** < Tolerance of the checks that data is an element of a Lie group.*/
+};
+
+/**
+ * The thresholds for float. With \f$ \epsilon \approx 1.2 \cdot 10^{-7} \f$ the second order Taylor series are exact to
+ * rounding below \f$ 10^{-2} \f$ and the fourth order ones below \f$ 0.3 \f$.
+ */
+template <>
+struct ScalarTraits<float> {
+static constexpr float small_angle_threshold_ = 1e-2f;
+static constexpr float series_threshold_ = 3e-1f;
+static constexpr float algebra_threshold_ = 1e-5f;
+static constexpr float group_threshold_ = 1e-5f;
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEALGEBRAS_SCALARTRAITS_
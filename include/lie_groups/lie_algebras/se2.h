@@ -2,28 +2,45 @@
 #define _LIEGROUPS_INCLUDE_LIEALGEBRAS_SE2_
 
 #include <Eigen/Dense>
+#include <cmath>
 #include <iostream>
+#include "lie_groups/lie_algebras/batch_math.h"
+#include "lie_groups/lie_algebras/scalar_traits.h"
 
 namespace lie_groups {
 
 constexpr double kse2_threshold_=1e-7; /** < If two values are within this threshold, they are considered equal.*/
+constexpr double kse2_batch_threshold_=1e-3; /** < Below this angle the batch kernels use Taylor series. The truncation error is below the rounding error in float and double.*/
 
 template <typename tDataType=double, int tNumDimensions=3, int tNumTangentSpaces=1>
 class se2  {
 
-static_assert(tNumTangentSpaces == 1, "lie_groups::se2 the number of tangent spaces must be 1.");
+// The Lie operations act on the first tangent space only, see State::Propagate.
+static_assert(tNumTangentSpaces > 0, "lie_groups::se2 the number of tangent spaces must be greater than 0.");
 static_assert(tNumDimensions == 3, "lie_groups::se2 the number of dimensions must be 3.");
 
 
 public:
 
 Eigen::Matrix<tDataType,3,1> data_; /** < The vector is translational velocity followed by angular velocity*/
-Eigen::Map<Eigen::Matrix<tDataType,2,1>> p_;  /** < The translational velocity */
-Eigen::Map<Eigen::Matrix<tDataType,1,1>> th_; /** < The angular velocity */
 
 typedef Eigen::Matrix<tDataType,3,1> Vec3d;
 typedef Eigen::Matrix<tDataType,3,3> Mat3d;
 typedef Eigen::Matrix<tDataType,2,2> Mat2d;
+typedef Eigen::Matrix<tDataType,2,1> Vec2d;
+
+/**
+ * Returns a view of the translational velocity. The view is computed on demand so that 
+ * the element doesn't store pointers into its own data.
+ */
+Eigen::Block<Vec3d,2,1> p() {return data_.template block<2,1>(0,0);}
+Eigen::Block<const Vec3d,2,1> p() const {return data_.template block<2,1>(0,0);}
+
+/**
+ * Returns a view of the angular velocity.
+ */
+Eigen::Block<Vec3d,1,1> th() {return data_.template block<1,1>(2,0);}
+Eigen::Block<const Vec3d,1,1> th() const {return data_.template block<1,1>(2,0);}
 
 static constexpr unsigned int dim_ = tNumDimensions;
 static constexpr unsigned int dim_t_vel_=2; /** < The dimension of the translational velocity */
@@ -37,28 +54,28 @@ static constexpr unsigned int total_num_dim_ = tNumTangentSpaces*tNumDimensions;
 /**
  * Default constructor. Initializes algebra element to identity.
  */
-se2(): p_(data_.data()), th_(data_.data()+2), data_(Vec3d::Zero()){}
+se2(): data_(Vec3d::Zero()){}
 
 
 /**
  * Copy constructor.
  */ 
-se2(const se2 & u) : p_(data_.data()), th_(data_.data()+2), data_(u.data_){}
+se2(const se2 & u) = default;
 
 /**
  * Copy assignment
  */
-void operator = (const se2& u){data_ = u.data_;}
+se2& operator = (const se2& u) = default;
 
 /**
  * Move constructor.
  */ 
-se2(const se2 && u) : p_(data_.data()), th_(data_.data()+2), data_(u.data_){}
+se2(se2 && u) = default;
 
 /**
  * Move assignment.
  */
-void operator = (const se2&& u){data_ = u.data_;}
+se2& operator = (se2&& u) = default;
 
 
 
@@ -66,7 +83,7 @@ void operator = (const se2&& u){data_ = u.data_;}
 * Initializes algebra element to the one given. 
 * @param[in] data The data of an element of Cartesian space of \f$se(2)\f$
 */
-se2(const Vec3d data) : p_(data_.data()), th_(data_.data()+2), data_(data){}
+se2(const Vec3d data) : data_(data){}
 
 /**
 * Initializes algebra element to the one given. If verify is set to true,
@@ -85,7 +102,17 @@ se2(const Mat3d & data, bool verify);
  * @param u An element of the Lie algebra.
  * @return The result of the Lie bracket operation.
  */ 
-se2 Bracket(const se2& u){return se2(this->Adjoint()*u.data_);}
+se2 Bracket(const se2& u){return se2(AdjointAct(data_,u.data_));}
+
+/**
+ * Applies the adjoint representation of data to v without forming the matrix,
+ * \f$ [\theta\, S v_p - v_\theta S p;\ 0] \f$ with \f$ S \f$ being SSM(1).
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the adjoint is applied to.
+ */
+static Vec3d AdjointAct(const Vec3d& data, const Vec3d& v) {
+    return Vec3d(data(1)*v(2) - data(2)*v(1), data(2)*v(0) - data(0)*v(2), static_cast<tDataType>(0.0));
+}
 
 /**
  * Computes and returns the matrix adjoint representation of the Lie algebra.
@@ -93,8 +120,8 @@ se2 Bracket(const se2& u){return se2(this->Adjoint()*u.data_);}
  */ 
 Mat3d Adjoint(){
     Mat3d m = Mat3d::Zero();
-    m.block(0,0,2,2) = se2::SSM(th_(0));
-    m.block(0,2,2,1) = -se2::SSM(1)*p_;
+    m.block(0,0,2,2) = se2::SSM(th()(0));
+    m.block(0,2,2,1) = -se2::SSM(1)*p();
     return m;
 }
 
@@ -150,6 +177,118 @@ static Mat3d Exp(const Vec3d& data);
  */
 static Vec3d Log(const Mat3d& data);
 
+/**
+ * Computes the exponential of n elements of the Cartesian space at once. The data is given as a structure of arrays:
+ * u[k][i] is component k of element i and g[k][i] is entry k, in column-major order, of the matrix of element i.
+ * The elements are processed a SIMD register at a time and the remainder with the scalar version of the same 
+ * branchless code. The sine and cosine of the half angle are computed once and give both the rotation and \f$ W_l \f$.
+ * For \f$ |\theta| \leq 2\pi \f$ the entries of the result are within 4 ulp of the norm of the exact result.
+ * @param u The pointers to the three components of the elements.
+ * @param g The pointers to the nine entries of the resulting matrices.
+ * @param n The number of elements.
+ */
+static void BatchExp(const tDataType* const u[3], tDataType* const g[9], Eigen::Index n);
+
+/**
+ * Computes the logarithm of n elements of \f$ SE(2) \f$ at once. The data is given as a structure of arrays:
+ * g[k][i] is entry k, in column-major order, of the matrix of element i and u[k][i] is component k of result i.
+ * The inverse of \f$ W_l \f$ is computed in closed form from the rotation. The components of the result are within 
+ * 4 ulp of the norm of the exact result.
+ * @param g The pointers to the nine entries of the matrices.
+ * @param u The pointers to the three components of the results.
+ * @param n The number of elements.
+ */
+static void BatchLog(const tDataType* const g[9], tDataType* const u[3], Eigen::Index n);
+
+/**
+ * Computes the exponential and the left Jacobian of the element of the Lie algebra.
+ * The trigonometric terms are computed once and shared by both.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jl The left Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static Mat3d ExpWithJl(const Vec3d& data, Mat3d& jl);
+
+/**
+ * Computes the exponential and the right Jacobian of the element of the Lie algebra.
+ * The trigonometric terms are computed once and shared by both.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jr The right Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static Mat3d ExpWithJr(const Vec3d& data, Mat3d& jr);
+
+/**
+ * Computes the logarithm and the left Jacobian inverse evaluated at the logarithm. 
+ * The sine and cosine of the angle are taken from the rotation so no trigonometric functions
+ * other than the atan2 of the logarithm are evaluated.
+ * @param data The data associated with an element of \f$ SE(2) \f$
+ * @param jl_inv The left Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d LogWithJlInv(const Mat3d& data, Mat3d& jl_inv);
+
+/**
+ * Computes the logarithm and the right Jacobian inverse evaluated at the logarithm. 
+ * The sine and cosine of the angle are taken from the rotation so no trigonometric functions
+ * other than the atan2 of the logarithm are evaluated.
+ * @param data The data associated with an element of \f$ SE(2) \f$
+ * @param jr_inv The right Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d LogWithJrInv(const Mat3d& data, Mat3d& jr_inv);
+
+/**
+ * Computes the Cayley map \f$ (I - W/2)^{-1}(I + W/2) \f$ where W is the wedge of the element. The rotation is by
+ * \f$ 2\arctan(\theta/2) \f$ and the translation is \f$ (I - \theta S/2)^{-1} p \f$ with S being SSM(1). See CayleyRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d Cayley(const Vec3d& data);
+
+/**
+ * Computes the inverse of the Cayley map. It is defined for rotations of less than \f$ \pi \f$.
+ * @param data The data of an element of \f$ SE(2) \f$
+ */
+static Vec3d CayleyInv(const Mat3d& data);
+
+/**
+ * Computes the right Jacobian of the Cayley map, \f$ [M,\ M S t/2;\ 0,\ 4/(4+\theta^2)] \f$ with
+ * \f$ M = (I + \theta S/2)^{-1} \f$ and t the translation of the result.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d CayleyJr(const Vec3d& data);
+
+/**
+ * Computes the inverse of the right Jacobian of the Cayley map, \f$ [I + \theta S/2,\ -(1+\theta^2/4) S t/2;\ 0,\ 1+\theta^2/4] \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d CayleyJrInv(const Vec3d& data);
+
+/**
+ * Computes the element whose rotation is by \f$ \arctan\theta \f$, the rotation closest to \f$ I + \theta S \f$,
+ * and whose translation is p. See FirstOrderRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d FirstOrder(const Vec3d& data);
+
+/**
+ * Computes the inverse of FirstOrder. It is defined for rotations of less than \f$ \pi/2 \f$.
+ * @param data The data of an element of \f$ SE(2) \f$
+ */
+static Vec3d FirstOrderInv(const Mat3d& data);
+
+/**
+ * Computes the right Jacobian of FirstOrder, \f$ [R^\top,\ 0;\ 0,\ 1/(1+\theta^2)] \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d FirstOrderJr(const Vec3d& data);
+
+/**
+ * Computes the inverse of the right Jacobian of FirstOrder, \f$ [R,\ 0;\ 0,\ 1+\theta^2] \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d FirstOrderJrInv(const Vec3d& data);
+
 /**
  * Computes and returns the Euclidean norm of the element of the Lie algebra
  */ 
@@ -162,13 +301,10 @@ Mat3d Jl();
 
 /**
  * Computes the left Jacobian using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$.
- * Since the left Jacobian is the identity map for \f$se(2)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_l(v)u \f$. The matrix is not formed. See ApplyJl.
  * @param u An element of the Lie algebra.
- * @return It will return the parameter u.
  */ 
-se2 Jl(const se2& u){return se2(this->Jl()*u.data_);}
+se2 Jl(const se2& u){return se2(ApplyJl(data_,u.data_));}
 
 /**
  * Computes and returns the matrix of the Left Jacobian inverse.
@@ -177,12 +313,10 @@ Mat3d JlInv();
 
 /**
  * Computes the left Jacobian inverse using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$
- * Since the left Jacobian inverse is the identity map for \f$se(2)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_l^{-1}(v)u \f$. The matrix is not formed. See ApplyJlInv.
  * @param u An element of the Lie algebra.
  */ 
-se2 JlInv(const se2& u){return se2(this->JlInv()*u.data_);}
+se2 JlInv(const se2& u){return se2(ApplyJlInv(data_,u.data_));}
 
 /**
  * Computes and returns the matrix of the Right Jacobian
@@ -191,12 +325,10 @@ Mat3d Jr();
 
 /**
  * Computes the right Jacobian using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$
- * Since the right Jacobian is the identity map for \f$se(2)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_r(v)u \f$. The matrix is not formed. See ApplyJr.
  * @param u An element of the Lie algebra.
  */ 
-se2 Jr(const se2& u){return se2(this->Jr()*u.data_);}
+se2 Jr(const se2& u){return se2(ApplyJr(data_,u.data_));}
 
 /**
  * Computes and returns the matrix of the right Jacobian inverse.
@@ -205,12 +337,41 @@ Mat3d JrInv();
 
 /**
  * Computes the right Jacobian inverse using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$
- * Since the right Jacobian inverse is the identity map for \f$se(2)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_r^{-1}(v)u \f$. The matrix is not formed. See ApplyJrInv.
  * @param u An element of the Lie algebra.
  */ 
-se2 JrInv(const se2& u){return se2(this->JrInv()*u.data_);}
+se2 JrInv(const se2& u){return se2(ApplyJrInv(data_,u.data_));}
+
+/**
+ * Applies the left Jacobian evaluated at data to v without forming the matrix. The Jacobian is
+ * \f$ \begin{bmatrix} W_l & D_l p \\ 0 & 1 \end{bmatrix} \f$ and \f$ W_l \f$ is a scaled rotation, so it is applied
+ * with four coefficients.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian is applied to.
+ */
+static Vec3d ApplyJl(const Vec3d& data, const Vec3d& v){return ApplyJacobian(data,v,static_cast<tDataType>(1.0),false);}
+
+/**
+ * Applies the right Jacobian evaluated at data to v without forming the matrix.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian is applied to.
+ */
+static Vec3d ApplyJr(const Vec3d& data, const Vec3d& v){return ApplyJacobian(data,v,static_cast<tDataType>(-1.0),false);}
+
+/**
+ * Applies the left Jacobian inverse evaluated at data to v without forming the matrix.
+ * \f$ W_l^{-1} \f$ is also a scaled rotation so nothing is inverted numerically.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian inverse is applied to.
+ */
+static Vec3d ApplyJlInv(const Vec3d& data, const Vec3d& v){return ApplyJacobian(data,v,static_cast<tDataType>(1.0),true);}
+
+/**
+ * Applies the right Jacobian inverse evaluated at data to v without forming the matrix.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian inverse is applied to.
+ */
+static Vec3d ApplyJrInv(const Vec3d& data, const Vec3d& v){return ApplyJacobian(data,v,static_cast<tDataType>(-1.0),true);}
 
 /**
  * Adds two elements of the Algebra together
@@ -258,17 +419,44 @@ static Mat2d SSM(tDataType x) {
 static bool isElement(const Mat3d& data);
 
 
+protected:
+
+// Computes the coefficients of Wl = a*SSM(1) + b*I and Dl = d1*SSM(1) + d2*I from th and its sine and cosine. se2c
+// uses them for its exponential.
+static void WDCoefficients(const tDataType th, const tDataType sin_th, const tDataType cos_th, tDataType& a, tDataType& b, tDataType& d1, tDataType& d2);
+
 private:
 
+// Computes the inverse of Wl and Dl using the sine and cosine of th. Wr and Dr are their transposes.
+static void WlInvDl(const tDataType th, const tDataType sin_th, const tDataType cos_th, Mat2d& wl_inv, Mat2d& dl);
+
+// Applies the left (sign = 1) or right (sign = -1) Jacobian or its inverse of data to v
+static Vec3d ApplyJacobian(const Vec3d& data, const Vec3d& v, const tDataType sign, const bool inverse);
+
+// The translation of the Cayley map, (I - th*S/2)^{-1} p = (p + th*S*p/2)/(1 + th^2/4).
+static Vec2d CayleyTranslation(const Vec3d& data);
+
 // The following are used to compute the Jacobians
 static Mat2d Wl(const tDataType th);
 static Mat2d Wr(const tDataType th);
 static Mat2d Dl(const tDataType th);
 static Mat2d Dr(const tDataType th);
-Mat2d Wl(){return Wl(th_(0));}
-Mat2d Wr(){return Wr(th_(0));}
-Mat2d Dl(){return Dl(th_(0));}
-Mat2d Dr(){return Dr(th_(0));}
+Mat2d Wl(){return Wl(th()(0));}
+Mat2d Wr(){return Wr(th()(0));}
+Mat2d Dl(){return Dl(th()(0));}
+Mat2d Dr(){return Dr(th()(0));}
+
+/**
+ * Computes the exponential of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchExpKernel(const tDataType* const u[3], tDataType* const g[9], Eigen::Index i);
+
+/**
+ * Computes the logarithm of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchLogKernel(const tDataType* const g[9], tDataType* const u[3], Eigen::Index i);
 
 
 };
@@ -278,7 +466,7 @@ Mat2d Dr(){return Dr(th_(0));}
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
-se2<tDataType,tNumDimensions,tNumTangentSpaces>::se2(const Eigen::Matrix<tDataType,3,3>& data, bool verify) : p_(data_.data()), th_(data_.data()+2) {
+se2<tDataType,tNumDimensions,tNumTangentSpaces>::se2(const Eigen::Matrix<tDataType,3,3>& data, bool verify) {
 
     if(verify)
     {
@@ -306,13 +494,169 @@ template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Exp(const Eigen::Matrix<tDataType,3,1>& data) {
     
     Eigen::Matrix<tDataType,3,3> m;
-    m.block(0,0,2,2) << cos(data(2)), - sin(data(2)), sin(data(2)), cos(data(2));
+    m.block(0,0,2,2) << std::cos(data(2)), - std::sin(data(2)), std::sin(data(2)), std::cos(data(2));
     m.block(0,2,2,1) = Wl(data(2))*data.block(0,0,2,1);
     m.block(2,0,1,2).setZero();
     m(2,2) = static_cast<tDataType>(1.0);
     return m;
 }
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void se2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchExp(const tDataType* const u[3], tDataType* const g[9], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchExpKernel<Packet>(u,g,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchExpKernel<tDataType>(u,g,ii);
+    }
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void se2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchExpKernel(const tDataType* const u[3], tDataType* const g[9], Eigen::Index i) {
+    namespace ei = Eigen::internal;
+    using batch_math::Set;
+    using batch_math::Madd;
+
+    const tPacket px = ei::ploadu<tPacket>(u[0]+i);
+    const tPacket py = ei::ploadu<tPacket>(u[1]+i);
+    const tPacket th = ei::ploadu<tPacket>(u[2]+i);
+    const tPacket th2 = ei::pmul(th,th);
+    const tPacket small = ei::pcmp_lt(ei::pabs(th), Set<tPacket>(static_cast<tDataType>(kse2_batch_threshold_)));
+    const tPacket one = Set<tPacket>(static_cast<tDataType>(1.0));
+
+    // The rotation and Wl = a*SSM(1) + b*I with a = (1-cos(th))/th and b = sin(th)/th from the half angle
+    tPacket s2, c2;
+    batch_math::SinCos(ei::pmul(th, Set<tPacket>(static_cast<tDataType>(0.5))), s2, c2);
+    const tPacket two_s2 = ei::padd(s2,s2);
+    const tPacket s = ei::pmul(two_s2,c2);
+    const tPacket one_minus_c = ei::pmul(two_s2,s2);
+    const tPacket th_inv = ei::pdiv(one, ei::pselect(small, one, th));
+
+    // Taylor series close to the identity
+    const tPacket a_tay = ei::pmul(th, Madd(th2, Madd(th2, Set<tPacket>(static_cast<tDataType>(1.0/720.0)), Set<tPacket>(static_cast<tDataType>(-1.0/24.0))), Set<tPacket>(static_cast<tDataType>(0.5))));
+    const tPacket b_tay = Madd(th2, Madd(th2, Set<tPacket>(static_cast<tDataType>(1.0/120.0)), Set<tPacket>(static_cast<tDataType>(-1.0/6.0))), one);
+
+    const tPacket a = ei::pselect(small, a_tay, ei::pmul(one_minus_c,th_inv));
+    const tPacket b = ei::pselect(small, b_tay, ei::pmul(s,th_inv));
+
+    const tPacket c = ei::psub(one, one_minus_c);
+    const tPacket zero = Set<tPacket>(static_cast<tDataType>(0.0));
+    ei::pstoreu(g[0]+i, c);
+    ei::pstoreu(g[1]+i, s);
+    ei::pstoreu(g[2]+i, zero);
+    ei::pstoreu(g[3]+i, ei::pnegate(s));
+    ei::pstoreu(g[4]+i, c);
+    ei::pstoreu(g[5]+i, zero);
+    ei::pstoreu(g[6]+i, ei::psub(ei::pmul(b,px), ei::pmul(a,py)));
+    ei::pstoreu(g[7]+i, Madd(a,px,ei::pmul(b,py)));
+    ei::pstoreu(g[8]+i, one);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void se2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchLog(const tDataType* const g[9], tDataType* const u[3], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchLogKernel<Packet>(g,u,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchLogKernel<tDataType>(g,u,ii);
+    }
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void se2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchLogKernel(const tDataType* const g[9], tDataType* const u[3], Eigen::Index i) {
+    namespace ei = Eigen::internal;
+    using batch_math::Set;
+    using batch_math::Madd;
+
+    const tPacket c = ei::ploadu<tPacket>(g[0]+i);
+    const tPacket s = ei::ploadu<tPacket>(g[1]+i);
+    const tPacket tx = ei::ploadu<tPacket>(g[6]+i);
+    const tPacket ty = ei::ploadu<tPacket>(g[7]+i);
+    const tPacket th = batch_math::Atan2(s,c);
+    const tPacket half_th = ei::pmul(th, Set<tPacket>(static_cast<tDataType>(0.5)));
+    const tPacket one = Set<tPacket>(static_cast<tDataType>(1.0));
+
+    // The inverse of Wl is alpha*I - th/2*SSM(1) with alpha = th/2*cot(th/2). The cotangent of the half angle
+    // is (1+cos(th))/sin(th) = sin(th)/(1-cos(th)). The form whose denominator is away from zero is used.
+    const tPacket small = ei::pcmp_lt(ei::pabs(th), Set<tPacket>(static_cast<tDataType>(kse2_batch_threshold_)));
+    const tPacket negative = ei::pcmp_lt(c, Set<tPacket>(static_cast<tDataType>(0.0)));
+    const tPacket num = ei::pselect(negative, s, ei::padd(one,c));
+    const tPacket den = ei::pselect(small, one, ei::pselect(negative, ei::psub(one,c), s));
+    const tPacket alpha_rod = ei::pmul(half_th, ei::pdiv(num,den));
+
+    // Taylor series close to the identity
+    const tPacket th2 = ei::pmul(th,th);
+    const tPacket alpha_tay = Madd(th2, Madd(th2, Set<tPacket>(static_cast<tDataType>(-1.0/720.0)), Set<tPacket>(static_cast<tDataType>(-1.0/12.0))), one);
+    const tPacket alpha = ei::pselect(small, alpha_tay, alpha_rod);
+
+    ei::pstoreu(u[0]+i, Madd(alpha,tx,ei::pmul(half_th,ty)));
+    ei::pstoreu(u[1]+i, ei::psub(ei::pmul(alpha,ty),ei::pmul(half_th,tx)));
+    ei::pstoreu(u[2]+i, th);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::ExpWithJl(const Eigen::Matrix<tDataType,3,1>& data, Eigen::Matrix<tDataType,3,3>& jl) {
+    
+    const tDataType th = data(2);
+    const tDataType s = std::sin(th);
+    const tDataType c = std::cos(th);
+    tDataType a, b, d1, d2;
+    WDCoefficients(th,s,c,a,b,d1,d2);
+    const Eigen::Matrix<tDataType,2,2> wl = a*SSM(static_cast<tDataType>(1.0)) + b*Eigen::Matrix<tDataType,2,2>::Identity();
+    const Eigen::Matrix<tDataType,2,2> dl = d1*SSM(static_cast<tDataType>(1.0)) + d2*Eigen::Matrix<tDataType,2,2>::Identity();
+
+    Eigen::Matrix<tDataType,3,3> m;
+    m.block(0,0,2,2) << c, -s, s, c;
+    m.block(0,2,2,1) = wl*data.block(0,0,2,1);
+    m.block(2,0,1,2).setZero();
+    m(2,2) = static_cast<tDataType>(1.0);
+
+    jl.setIdentity();
+    jl.block(0,0,2,2) = wl;
+    jl.block(0,2,2,1) = dl*data.block(0,0,2,1);
+    return m;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::ExpWithJr(const Eigen::Matrix<tDataType,3,1>& data, Eigen::Matrix<tDataType,3,3>& jr) {
+    
+    const tDataType th = data(2);
+    const tDataType s = std::sin(th);
+    const tDataType c = std::cos(th);
+    tDataType a, b, d1, d2;
+    WDCoefficients(th,s,c,a,b,d1,d2);
+    const Eigen::Matrix<tDataType,2,2> wl = a*SSM(static_cast<tDataType>(1.0)) + b*Eigen::Matrix<tDataType,2,2>::Identity();
+    const Eigen::Matrix<tDataType,2,2> dl = d1*SSM(static_cast<tDataType>(1.0)) + d2*Eigen::Matrix<tDataType,2,2>::Identity();
+
+    Eigen::Matrix<tDataType,3,3> m;
+    m.block(0,0,2,2) << c, -s, s, c;
+    m.block(0,2,2,1) = wl*data.block(0,0,2,1);
+    m.block(2,0,1,2).setZero();
+    m(2,2) = static_cast<tDataType>(1.0);
+
+    // Since SSM(1) is skew symmetric, Wr = Wl^T and Dr = Dl^T
+    jr.setIdentity();
+    jr.block(0,0,2,2) = wl.transpose();
+    jr.block(0,2,2,1) = dl.transpose()*data.block(0,0,2,1);
+    return m;
+}
+
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,3,1> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Log(const Eigen::Matrix<tDataType,3,3>& data) {
@@ -323,6 +667,37 @@ Eigen::Matrix<tDataType,3,1> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Lo
     return u;    
 }
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> se2<tDataType,tNumDimensions,tNumTangentSpaces>::LogWithJlInv(const Eigen::Matrix<tDataType,3,3>& data, Eigen::Matrix<tDataType,3,3>& jl_inv) {
+    Eigen::Matrix<tDataType,3,1> u;
+    Eigen::Matrix<tDataType,2,2> wl_inv, dl;
+    u(2) = atan2(data(1,0),data(0,0)); // Compute the angle
+    WlInvDl(u(2),data(1,0),data(0,0),wl_inv,dl);
+    u.block(0,0,2,1) = wl_inv*data.block(0,2,2,1);
+
+    jl_inv.setIdentity();
+    jl_inv.block(0,0,2,2) = wl_inv;
+    jl_inv.block(0,2,2,1) = -wl_inv*dl*u.block(0,0,2,1);
+    return u;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> se2<tDataType,tNumDimensions,tNumTangentSpaces>::LogWithJrInv(const Eigen::Matrix<tDataType,3,3>& data, Eigen::Matrix<tDataType,3,3>& jr_inv) {
+    Eigen::Matrix<tDataType,3,1> u;
+    Eigen::Matrix<tDataType,2,2> wl_inv, dl;
+    u(2) = atan2(data(1,0),data(0,0)); // Compute the angle
+    WlInvDl(u(2),data(1,0),data(0,0),wl_inv,dl);
+    u.block(0,0,2,1) = wl_inv*data.block(0,2,2,1);
+
+    // Since SSM(1) is skew symmetric, Wr = Wl^T and Dr = Dl^T
+    jr_inv.setIdentity();
+    jr_inv.block(0,0,2,2) = wl_inv.transpose();
+    jr_inv.block(0,2,2,1) = -wl_inv.transpose()*dl.transpose()*u.block(0,0,2,1);
+    return u;
+}
+
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Jl() {
@@ -330,7 +705,7 @@ Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Jl
     Eigen::Matrix<tDataType,3,3> m;
     m.setIdentity();
     m.block(0,0,2,2) = this->Wl();
-    m.block(0,2,2,1) = this->Dl()*p_;
+    m.block(0,2,2,1) = this->Dl()*p();
 
     return m;
 }
@@ -343,7 +718,7 @@ Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Jl
     Eigen::Matrix<tDataType,3,3> m;
     m.setIdentity();
     m.block(0,0,2,2) = w_inv;
-    m.block(0,2,2,1) = -w_inv*this->Dl()*p_;
+    m.block(0,2,2,1) = -w_inv*this->Dl()*p();
 
     return m;
 }
@@ -355,7 +730,7 @@ Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Jr
     Eigen::Matrix<tDataType,3,3> m;
     m.setIdentity();
     m.block(0,0,2,2) = this->Wr();
-    m.block(0,2,2,1) = this->Dr()*p_;
+    m.block(0,2,2,1) = this->Dr()*p();
 
     return m;
 }
@@ -368,18 +743,111 @@ Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Jr
     Eigen::Matrix<tDataType,3,3> m;
     m.setIdentity();
     m.block(0,0,2,2) = w_inv;
-    m.block(0,2,2,1) = -w_inv*this->Dr()*p_;
+    m.block(0,2,2,1) = -w_inv*this->Dr()*p();
+
+    return m;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,2,1> se2<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyTranslation(const Vec3d& data) {
+    const tDataType half_th = data(2)/static_cast<tDataType>(2.0);
+    return Vec2d(data(0) - half_th*data(1), data(1) + half_th*data(0))/(static_cast<tDataType>(1.0) + half_th*half_th);
+}
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Cayley(const Vec3d& data) {
+    const tDataType half_th = data(2)/static_cast<tDataType>(2.0);
+    const tDataType k = static_cast<tDataType>(1.0)/(static_cast<tDataType>(1.0) + half_th*half_th);
+    const tDataType c = (static_cast<tDataType>(1.0) - half_th*half_th)*k;
+    const tDataType s = data(2)*k;
+    const Vec2d t = CayleyTranslation(data);
+    Mat3d m;
+    m << c, -s, t(0),
+         s,  c, t(1),
+         static_cast<tDataType>(0.0), static_cast<tDataType>(0.0), static_cast<tDataType>(1.0);
     return m;
 }
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> se2<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyInv(const Mat3d& data) {
+    const tDataType th = static_cast<tDataType>(2.0)*(data(1,0) - data(0,1))/(static_cast<tDataType>(2.0) + data(0,0) + data(1,1));
+    const tDataType half_th = th/static_cast<tDataType>(2.0);
+    return Vec3d(data(0,2) + half_th*data(1,2), data(1,2) - half_th*data(0,2), th);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyJr(const Vec3d& data) {
+    const tDataType half_th = data(2)/static_cast<tDataType>(2.0);
+    const tDataType k = static_cast<tDataType>(1.0)/(static_cast<tDataType>(1.0) + half_th*half_th);
+    const Mat2d M = k*(Mat2d::Identity() - SSM(half_th));
+    Mat3d j = Mat3d::Zero();
+    j.template block<2,2>(0,0) = M;
+    j.template block<2,1>(0,2) = M*SSM(static_cast<tDataType>(0.5))*CayleyTranslation(data);
+    j(2,2) = k;
+    return j;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyJrInv(const Vec3d& data) {
+    const tDataType half_th = data(2)/static_cast<tDataType>(2.0);
+    const tDataType k_inv = static_cast<tDataType>(1.0) + half_th*half_th;
+    Mat3d j = Mat3d::Zero();
+    j.template block<2,2>(0,0) = Mat2d::Identity() + SSM(half_th);
+    j.template block<2,1>(0,2) = -k_inv*SSM(static_cast<tDataType>(0.5))*CayleyTranslation(data);
+    j(2,2) = k_inv;
+    return j;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrder(const Vec3d& data) {
+    const tDataType c = static_cast<tDataType>(1.0)/std::sqrt(static_cast<tDataType>(1.0) + data(2)*data(2));
+    const tDataType s = data(2)*c;
+    Mat3d m;
+    m << c, -s, data(0),
+         s,  c, data(1),
+         static_cast<tDataType>(0.0), static_cast<tDataType>(0.0), static_cast<tDataType>(1.0);
+    return m;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> se2<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrderInv(const Mat3d& data) {
+    return Vec3d(data(0,2), data(1,2), (data(1,0) - data(0,1))/(data(0,0) + data(1,1)));
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrderJr(const Vec3d& data) {
+    const Mat3d m = FirstOrder(data);
+    Mat3d j = Mat3d::Zero();
+    j.template block<2,2>(0,0) = m.template block<2,2>(0,0).transpose();
+    j(2,2) = static_cast<tDataType>(1.0)/(static_cast<tDataType>(1.0) + data(2)*data(2));
+    return j;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se2<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrderJrInv(const Vec3d& data) {
+    const Mat3d m = FirstOrder(data);
+    Mat3d j = Mat3d::Zero();
+    j.template block<2,2>(0,0) = m.template block<2,2>(0,0);
+    j(2,2) = static_cast<tDataType>(1.0) + data(2)*data(2);
+    return j;
+}
+
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 bool se2<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Eigen::Matrix<tDataType,3,3>& data) {
 
     bool is_element = true;
      
-    if ( (data.block(0,0,2,2).transpose() + data.block(0,0,2,2)).norm() >= kse2_threshold_) {
+    if ( (data.block(0,0,2,2).transpose() + data.block(0,0,2,2)).norm() >= ScalarTraits<tDataType>::algebra_threshold_) {
         is_element = false;
     }
     else if (data.block(2,0,1,3) != Eigen::Matrix<tDataType,1,3>::Zero()) {
@@ -396,80 +864,106 @@ bool se2<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Eigen::Mat
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,2,2> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Wl(const tDataType th) {
 
-    Eigen::Matrix<tDataType,2,2> m;
+    tDataType a, b, d1, d2;
+    WDCoefficients(th,std::sin(th),std::cos(th),a,b,d1,d2);
+    return a*SSM(static_cast<tDataType>(1.0)) + b*Eigen::Matrix<tDataType,2,2>::Identity();
+}
 
-    if (th > kse2_threshold_ || th < -kse2_threshold_) {
-        tDataType a = (1.0-cos(th))/th;
-        tDataType b = sin(th)/th;
-        m = a*se2<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(static_cast<tDataType>(1.0)) + b*Eigen::Matrix<tDataType,2,2>::Identity();
-    }
-    else
-    {
-        m = Eigen::Matrix<tDataType,2,2>::Identity() + se2<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(static_cast<tDataType>(1.0))*th/2.0;
-    }
-    
-return m;
+//---------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void se2<tDataType,tNumDimensions,tNumTangentSpaces>::WlInvDl(const tDataType th, const tDataType sin_th, const tDataType cos_th, Eigen::Matrix<tDataType,2,2>& wl_inv, Eigen::Matrix<tDataType,2,2>& dl) {
+
+    // Wl = a*SSM(1) + b*I. Since SSM(1)*SSM(1) = -I, its inverse is (b*I - a*SSM(1))/(a^2+b^2)
+    tDataType a, b, d1, d2;
+    WDCoefficients(th,sin_th,cos_th,a,b,d1,d2);
+    wl_inv = (b*Eigen::Matrix<tDataType,2,2>::Identity() - a*SSM(static_cast<tDataType>(1.0)))/(a*a+b*b);
+    dl = d1*SSM(static_cast<tDataType>(1.0)) + d2*Eigen::Matrix<tDataType,2,2>::Identity();
 }
 
 //---------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,2,2> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Wr(const tDataType th) {
 
-    Eigen::Matrix<tDataType,2,2> m;
-
-    if (th > kse2_threshold_ || th < -kse2_threshold_) {
-        tDataType a = (cos(th)-1.0)/th;
-        tDataType b = sin(th)/th;
-        m = a*se2<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(static_cast<tDataType>(1.0)) + b*Eigen::Matrix<tDataType,2,2>::Identity();
-    }
-    else
-    {
-        m = Eigen::Matrix<tDataType,2,2>::Identity() - se2<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(static_cast<tDataType>(1.0))*th/2.0;
-    }
-    
-return m;
+    tDataType a, b, d1, d2;
+    WDCoefficients(th,std::sin(th),std::cos(th),a,b,d1,d2);
+    return -a*SSM(static_cast<tDataType>(1.0)) + b*Eigen::Matrix<tDataType,2,2>::Identity();
 }
 
 //---------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,2,2> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Dl(const tDataType th) {
 
-    Eigen::Matrix<tDataType,2,2> m;
-
-    if (fabs(th) > kse2_threshold_) {
-        tDataType a = (cos(th)-1.0)/(th*th);
-        tDataType b = (th-sin(th))/(th*th);
-        m = a*se2<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(1) + b*Eigen::Matrix<tDataType,2,2>::Identity();
-    }
-    else
-    {
-        m = Eigen::Matrix<tDataType,2,2>::Identity()*th/6.0 - se2<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(static_cast<tDataType>(1.0))*th/2.0;
-    }
-
-    return m;
+    tDataType a, b, d1, d2;
+    WDCoefficients(th,std::sin(th),std::cos(th),a,b,d1,d2);
+    return d1*SSM(static_cast<tDataType>(1.0)) + d2*Eigen::Matrix<tDataType,2,2>::Identity();
 }
 
 //---------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,2,2> se2<tDataType,tNumDimensions,tNumTangentSpaces>::Dr(const tDataType th) {
 
-    Eigen::Matrix<tDataType,2,2> m;
+    tDataType a, b, d1, d2;
+    WDCoefficients(th,std::sin(th),std::cos(th),a,b,d1,d2);
+    return -d1*SSM(static_cast<tDataType>(1.0)) + d2*Eigen::Matrix<tDataType,2,2>::Identity();
+}
 
-    if (th > kse2_threshold_ || th < -kse2_threshold_) {
-        tDataType a = (1.0-cos(th))/(th*th);
-        tDataType b = (th-sin(th))/(th*th);
-        m = a*se2<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(static_cast<tDataType>(1.0)) + b*Eigen::Matrix<tDataType,2,2>::Identity();
-    }
-    else
-    {
-        m = Eigen::Matrix<tDataType,2,2>::Identity()*th/6.0 + se2<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(static_cast<tDataType>(1.0))*th/2.0;
+//---------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void se2<tDataType,tNumDimensions,tNumTangentSpaces>::WDCoefficients(const tDataType th, const tDataType sin_th, const tDataType cos_th, tDataType& a, tDataType& b, tDataType& d1, tDataType& d2) {
+
+    // 1-cos(th) = sin(th)^2/(1+cos(th)) avoids the cancellation when the cosine is positive so a, b and d1 only need
+    // a series to avoid dividing by zero. The closed form of d2 loses about eps/th to cancellation so it is replaced
+    // by its Taylor series over a range that grows with the machine epsilon.
+    const tDataType th2 = th*th;
+
+    if (std::abs(th) < ScalarTraits<tDataType>::small_angle_threshold_) {
+        a = th*(static_cast<tDataType>(1.0/2.0) - th2*static_cast<tDataType>(1.0/24.0));
+        b = static_cast<tDataType>(1.0) - th2*static_cast<tDataType>(1.0/6.0);
+        d1 = -static_cast<tDataType>(1.0/2.0) + th2*static_cast<tDataType>(1.0/24.0);
+    } else {
+        const tDataType one_minus_cos = cos_th > static_cast<tDataType>(0.0) ? sin_th*sin_th/(static_cast<tDataType>(1.0)+cos_th) : static_cast<tDataType>(1.0)-cos_th;
+        a = one_minus_cos/th;
+        b = sin_th/th;
+        d1 = -one_minus_cos/th2;
     }
 
-    return m;
+    if (std::abs(th) < ScalarTraits<tDataType>::series_threshold_) {
+        d2 = th*(static_cast<tDataType>(1.0/6.0) - th2*(static_cast<tDataType>(1.0/120.0) - th2*(static_cast<tDataType>(1.0/5040.0) - th2*static_cast<tDataType>(1.0/362880.0))));
+    } else {
+        d2 = (th - sin_th)/th2;
+    }
 }
 
+//---------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> se2<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyJacobian(const Eigen::Matrix<tDataType,3,1>& data, const Eigen::Matrix<tDataType,3,1>& v, const tDataType sign, const bool inverse) {
+
+    // Wl = a*SSM(1) + b*I and Dl = d1*SSM(1) + d2*I. The right Jacobian uses their transposes which flips the sign of SSM(1).
+    const tDataType th = data(2);
+    tDataType a, b, d1, d2;
+    WDCoefficients(th,std::sin(th),std::cos(th),a,b,d1,d2);
+    a *= sign;
+    d1 *= sign;
+
+    // SSM(1)*x = [-x(1), x(0)]
+    const Eigen::Matrix<tDataType,2,1> p = data.template block<2,1>(0,0);
+    const Eigen::Matrix<tDataType,2,1> dp(d2*p(0) - d1*p(1), d1*p(0) + d2*p(1));
+    Eigen::Matrix<tDataType,3,1> out;
+    out(2) = v(2);
+
+    if (inverse) {
+        const Eigen::Matrix<tDataType,2,1> x = v.template block<2,1>(0,0) - v(2)*dp;
+        const tDataType norm = a*a + b*b;
+        out(0) = (b*x(0) + a*x(1))/norm;
+        out(1) = (b*x(1) - a*x(0))/norm;
+    } else {
+        out(0) = b*v(0) - a*v(1) + v(2)*dp(0);
+        out(1) = a*v(0) + b*v(1) + v(2)*dp(1);
+    }
 
+    return out;
+}
 
 } // namespace
 
-#endif //_LIEGROUPS_INCLUDE_LIEALGEBRAS_SE2_
\ No newline at end of file
+#endif //_LIEGROUPS_INCLUDE_LIEALGEBRAS_SE2_
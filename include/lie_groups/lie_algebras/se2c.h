@@ -0,0 +1,218 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEALGEBRAS_SE2C_
+#define _LIEGROUPS_INCLUDE_LIEALGEBRAS_SE2C_
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <iostream>
+#include "lie_groups/lie_algebras/se2.h"
+
+namespace lie_groups {
+
+/**
+ * The Lie algebra \f$se(2)\f$ whose exponential and logarithm map to and from the vector \f$ (\cos\theta,\sin\theta,t_x,t_y) \f$,
+ * the unit complex number of the rotation followed by the translation. It is the Lie algebra of SE2Complex. The Cartesian
+ * space, the wedge and vee maps and the Jacobians are the ones of se2.
+ */
+template <typename tDataType=double, int tNumDimensions=3, int tNumTangentSpaces=1>
+class se2c : public se2<tDataType,tNumDimensions,tNumTangentSpaces> {
+
+public:
+
+typedef se2<tDataType,tNumDimensions,tNumTangentSpaces> Base;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
+typedef Eigen::Matrix<tDataType,3,3> Mat3d;
+
+using Base::data_;
+
+/**
+ * Default constructor. Initializes algebra element to identity.
+ */
+se2c() = default;
+
+/**
+* Initializes algebra element to the one given.
+* @param[in] data The data of an element of Cartesian space of \f$se(2)\f$
+*/
+se2c(const Vec3d data) : Base(data) {}
+
+/**
+* Initializes algebra element to the one given. If verify is set to true,
+* it will verify that the element provided is an element of the Lie algebra.
+* @param[in] data The data of an element of \f$se(2)\f$
+* @param verify If true, the constructor will verify that the element given is an element of the Lie algebra.
+*/
+se2c(const Mat3d & data, bool verify) : Base(data,verify) {}
+
+/**
+* Initializes algebra element to the element of se2 given.
+* @param[in] u An element of se2.
+*/
+se2c(const Base& u) : Base(u) {}
+
+/**
+ * Computes the exponential of the element of the Lie algebra.
+ * @return The complex number and translation of the group element.
+ */
+Vec4d Exp(){ return Exp(data_);}
+
+/**
+ * Computes the exponential of the element of the Lie algebra, \f$ (\cos\theta,\sin\theta,W_l(\theta) p) \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @return The complex number and translation of the group element.
+ */
+static Vec4d Exp(const Vec3d& data);
+
+/**
+ * Computes the logarithm of the complex number and translation of an element of \f$ SE(2) \f$. The angle is
+ * the arc tangent of the complex number and the inverse of \f$ W_l \f$ is applied in closed form.
+ * @param data The complex number and translation of an element of \f$ SE(2) \f$
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d Log(const Vec4d& data);
+
+/**
+ * Computes the exponential and the left Jacobian of the element of the Lie algebra. See se2::ExpWithJl.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jl The left Jacobian evaluated at data
+ * @return The complex number and translation of the group element.
+ */
+static Vec4d ExpWithJl(const Vec3d& data, Mat3d& jl) {return FromHomogeneous(Base::ExpWithJl(data,jl));}
+
+/**
+ * Computes the exponential and the right Jacobian of the element of the Lie algebra. See se2::ExpWithJr.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jr The right Jacobian evaluated at data
+ * @return The complex number and translation of the group element.
+ */
+static Vec4d ExpWithJr(const Vec3d& data, Mat3d& jr) {return FromHomogeneous(Base::ExpWithJr(data,jr));}
+
+/**
+ * Computes the logarithm and the left Jacobian inverse evaluated at the logarithm. See se2::LogWithJlInv.
+ * @param data The complex number and translation of an element of \f$ SE(2) \f$
+ * @param jl_inv The left Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d LogWithJlInv(const Vec4d& data, Mat3d& jl_inv) {return Base::LogWithJlInv(Homogeneous(data),jl_inv);}
+
+/**
+ * Computes the logarithm and the right Jacobian inverse evaluated at the logarithm. See se2::LogWithJrInv.
+ * @param data The complex number and translation of an element of \f$ SE(2) \f$
+ * @param jr_inv The right Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d LogWithJrInv(const Vec4d& data, Mat3d& jr_inv) {return Base::LogWithJrInv(Homogeneous(data),jr_inv);}
+
+/**
+ * Computes the complex number and translation of the Cayley map. See se2::Cayley. Its Jacobians are the ones of se2.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Vec4d Cayley(const Vec3d& data) {return FromHomogeneous(Base::Cayley(data));}
+
+/**
+ * Computes the inverse of the Cayley map. See se2::CayleyInv.
+ * @param data The complex number and translation of an element of \f$ SE(2) \f$
+ */
+static Vec3d CayleyInv(const Vec4d& data) {return Base::CayleyInv(Homogeneous(data));}
+
+/**
+ * Computes the complex number and translation of FirstOrder. See se2::FirstOrder.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Vec4d FirstOrder(const Vec3d& data) {return FromHomogeneous(Base::FirstOrder(data));}
+
+/**
+ * Computes the inverse of FirstOrder. See se2::FirstOrderInv.
+ * @param data The complex number and translation of an element of \f$ SE(2) \f$
+ */
+static Vec3d FirstOrderInv(const Vec4d& data) {return Base::FirstOrderInv(Homogeneous(data));}
+
+/**
+ * Returns the homogeneous 3x3 matrix of the complex number and translation of an element of \f$ SE(2) \f$.
+ * @param data The complex number and translation of an element of \f$ SE(2) \f$
+ */
+static Mat3d Homogeneous(const Vec4d& data) {
+    Mat3d m;
+    m << data(0), -data(1), data(2),
+         data(1),  data(0), data(3),
+         static_cast<tDataType>(0.0), static_cast<tDataType>(0.0), static_cast<tDataType>(1.0);
+    return m;
+}
+
+/**
+ * Returns the complex number and translation of a homogeneous 3x3 matrix of \f$ SE(2) \f$.
+ * @param data The homogeneous matrix of an element of \f$ SE(2) \f$
+ */
+static Vec4d FromHomogeneous(const Mat3d& data) {return Vec4d(data(0,0),data(1,0),data(0,2),data(1,2));}
+
+/**
+ * Adds two elements of the Algebra together
+ * @param u An element of the Lie algebra.
+ */
+se2c operator + (const se2c& u){return se2c(Vec3d(data_ + u.data_));}
+
+/**
+ * Subtracts two elements of the Algebra together
+ * @param u An element of the Lie algebra.
+ */
+se2c operator - (const se2c& u){return se2c(Vec3d(data_ - u.data_));}
+
+/**
+ * Performs Scalar multiplication and returns the result.
+ * @param scalar The scalar that will scale the element of the Lie algebra
+ */
+se2c operator * (const tDataType scalar) const {return se2c(Vec3d(scalar*data_));}
+
+/**
+ * Returns the Identity element.
+ */
+static se2c Identity(){return se2c();}
+
+private:
+
+// The batch kernels of se2 write homogeneous matrices, not complex numbers, so they are hidden and GroupArray
+// computes Exp and Log one element at a time.
+using Base::BatchExp;
+using Base::BatchLog;
+
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                    Definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,4,1> se2c<tDataType,tNumDimensions,tNumTangentSpaces>::Exp(const Eigen::Matrix<tDataType,3,1>& data) {
+    const tDataType th = data(2);
+    const tDataType c = std::cos(th);
+    const tDataType s = std::sin(th);
+
+    // The translation is Wl*p with Wl = a*SSM(1) + b*I. See se2::WDCoefficients.
+    tDataType a, b, d1, d2;
+    Base::WDCoefficients(th,s,c,a,b,d1,d2);
+    return Vec4d(c, s, b*data(0) - a*data(1), a*data(0) + b*data(1));
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> se2c<tDataType,tNumDimensions,tNumTangentSpaces>::Log(const Eigen::Matrix<tDataType,4,1>& data) {
+    const tDataType c = data(0);
+    const tDataType s = data(1);
+    const tDataType th = std::atan2(s,c);
+    const tDataType half_th = th/static_cast<tDataType>(2.0);
+
+    // The inverse of Wl is alpha*I - th/2*SSM(1) with alpha = th/2*cot(th/2). The cotangent of the half angle
+    // is (1+cos(th))/sin(th) = sin(th)/(1-cos(th)). The form whose denominator is away from zero is used.
+    tDataType alpha;
+    if (th > ScalarTraits<tDataType>::small_angle_threshold_ || th < -ScalarTraits<tDataType>::small_angle_threshold_) {
+        alpha = c < static_cast<tDataType>(0.0) ? half_th*s/(static_cast<tDataType>(1.0)-c) : half_th*(static_cast<tDataType>(1.0)+c)/s;
+    } else {
+        alpha = static_cast<tDataType>(1.0) - th*th/static_cast<tDataType>(12.0);
+    }
+    return Vec3d(alpha*data(2) + half_th*data(3), alpha*data(3) - half_th*data(2), th);
+}
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEALGEBRAS_SE2C_
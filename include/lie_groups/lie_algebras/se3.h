@@ -2,6 +2,7 @@
 #define _LIEGROUPS_INCLUDE_LIEALGEBRAS_SE3_
 
 #include <Eigen/Dense>
+#include <cmath>
 #include <iostream>
 #include "lie_groups/lie_algebras/so3.h"
 
@@ -13,14 +14,13 @@ constexpr double kse3_threshold_=1e-7; /** < If two values are within this thres
 template <typename tDataType=double, int tNumDimensions=6, int tNumTangentSpaces=1>
 class se3  {
 
-static_assert(tNumTangentSpaces == 1, "lie_groups::se3 the number of tangent spaces must be 1.");
+// The Lie operations act on the first tangent space only, see State::Propagate.
+static_assert(tNumTangentSpaces > 0, "lie_groups::se3 the number of tangent spaces must be greater than 0.");
 static_assert(tNumDimensions == 6, "lie_groups::se3 the number of dimensions must be 6.");
 
 public:
 
 Eigen::Matrix<tDataType,6,1> data_; /** < The vector is translational velocity followed by angular velocity*/
-Eigen::Map<Eigen::Matrix<tDataType,3,1>> p_;  /** < The translational velocity */
-Eigen::Map<Eigen::Matrix<tDataType,3,1>> th_; /** < The angular velocity */
 static constexpr unsigned int dim_ = tNumDimensions;
 static constexpr unsigned int dim_t_vel_=3; /** < The dimension of the translational velocity */
 static constexpr unsigned int dim_a_vel_=3; /** < The dimension of the angular velocity */
@@ -33,38 +33,51 @@ typedef Eigen::Matrix<tDataType,3,3> Mat3d;
 typedef Eigen::Matrix<tDataType,4,4> Mat4d;
 typedef Eigen::Matrix<tDataType,6,6> Mat6d;
 
+/**
+ * Returns a view of the translational velocity. The view is computed on demand so that 
+ * the element doesn't store pointers into its own data.
+ */
+Eigen::Block<Vec6d,3,1> p() {return data_.template block<3,1>(0,0);}
+Eigen::Block<const Vec6d,3,1> p() const {return data_.template block<3,1>(0,0);}
+
+/**
+ * Returns a view of the angular velocity.
+ */
+Eigen::Block<Vec6d,3,1> th() {return data_.template block<3,1>(3,0);}
+Eigen::Block<const Vec6d,3,1> th() const {return data_.template block<3,1>(3,0);}
+
 /**
  * Default constructor. Initializes algebra element to identity.
  */
-se3() : p_(data_.data()), th_(data_.data()+3), data_(Vec6d::Zero()){}
+se3() : data_(Vec6d::Zero()){}
 
 
 /**
  * Copy constructor.
  */ 
-se3(const se3 & u) : p_(data_.data()), th_(data_.data()+3), data_(u.data_) {}
+se3(const se3 & u) = default;
 
 /**
  *Copy assignment
  */
-void operator = (const se3& u){data_ = u.data_;}
+se3& operator = (const se3& u) = default;
 
 /**
  * Move constructor.
  */ 
-se3(const se3 && u) : p_(data_.data()), th_(data_.data()+3), data_(u.data_) {}
+se3(se3 && u) = default;
 
 /**
  *Move assignment
  */
-void operator = (const se3&& u){data_ = u.data_;}
+se3& operator = (se3&& u) = default;
 
 
 /**
 * Initializes algebra element to the one given. 
 * @param[in] data The data of an element of Cartesian space of \f$se(3)\f$
 */
-se3(const Vec6d data) : p_(data_.data()), th_(data_.data()+3), data_(data){}
+se3(const Vec6d data) : data_(data){}
 
 /**
 * Initializes algebra element to the one given. If verify is set to true,
@@ -83,7 +96,21 @@ se3(const Mat4d & data, bool verify);
  * @param u An element of the Lie algebra.
  * @return The result of the Lie bracket operation.
  */ 
-se3 Bracket(const se3& u){return se3(this->Adjoint()*u.data_);}
+se3 Bracket(const se3& u){return se3(AdjointAct(data_,u.data_));}
+
+/**
+ * Applies the adjoint representation of data to v without forming the matrix,
+ * \f$ [w \times v_p + p \times v_w;\ w \times v_w] \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the adjoint is applied to.
+ */
+static Vec6d AdjointAct(const Vec6d& data, const Vec6d& v) {
+    Vec6d out;
+    const Vec3d w = data.template block<3,1>(3,0);
+    out.template block<3,1>(0,0) = w.cross(v.template block<3,1>(0,0)) + data.template block<3,1>(0,0).cross(v.template block<3,1>(3,0));
+    out.template block<3,1>(3,0) = w.cross(v.template block<3,1>(3,0));
+    return out;
+}
 
 /**
  * Computes and returns the matrix adjoint representation of the Lie algebra.
@@ -91,9 +118,9 @@ se3 Bracket(const se3& u){return se3(this->Adjoint()*u.data_);}
  */ 
 Mat6d Adjoint() {    
     Mat6d m = Mat6d::Zero();
-    m.block(0,0,3,3) = se3<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(th_);
-    m.block(3,3,3,3) = se3<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(th_);
-    m.block(0,3,3,3) = se3<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(p_);
+    m.block(0,0,3,3) = se3<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(th());
+    m.block(3,3,3,3) = se3<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(th());
+    m.block(0,3,3,3) = se3<tDataType,tNumDimensions,tNumTangentSpaces>::SSM(p());
 
     return m;}
 
@@ -150,6 +177,93 @@ static Mat4d Exp(const Vec6d& data);
  */
 static Vec6d Log(const Mat4d& data);
 
+/**
+ * Computes the exponential and the left Jacobian of the element of the Lie algebra.
+ * The trigonometric terms are computed once and shared by both.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jl The left Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static Mat4d ExpWithJl(const Vec6d& data, Mat6d& jl);
+
+/**
+ * Computes the exponential and the right Jacobian of the element of the Lie algebra.
+ * The trigonometric terms are computed once and shared by both.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jr The right Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static Mat4d ExpWithJr(const Vec6d& data, Mat6d& jr);
+
+/**
+ * Computes the logarithm and the left Jacobian inverse evaluated at the logarithm. 
+ * The angle recovered by the logarithm is used to compute the Jacobian. 
+ * @param data The data associated with an element of \f$ SE(3) \f$
+ * @param jl_inv The left Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec6d LogWithJlInv(const Mat4d& data, Mat6d& jl_inv);
+
+/**
+ * Computes the logarithm and the right Jacobian inverse evaluated at the logarithm. 
+ * The angle recovered by the logarithm is used to compute the Jacobian. 
+ * @param data The data associated with an element of \f$ SE(3) \f$
+ * @param jr_inv The right Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec6d LogWithJrInv(const Mat4d& data, Mat6d& jr_inv);
+
+/**
+ * Computes the Cayley map \f$ (I - W/2)^{-1}(I + W/2) \f$ where W is the wedge of the element. The rotation is
+ * so3::Cayley of the angular part and the translation is \f$ (I - [\omega]_\times/2)^{-1}\rho \f$. See CayleyRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat4d Cayley(const Vec6d& data);
+
+/**
+ * Computes the inverse of the Cayley map. It is defined for rotations of less than \f$ \pi \f$.
+ * @param data The data of an element of \f$ SE(3) \f$
+ */
+static Vec6d CayleyInv(const Mat4d& data);
+
+/**
+ * Computes the right Jacobian of the Cayley map, \f$ [M,\ -M[t/2]_\times;\ 0,\ J_r] \f$ with \f$ M = (I + [\omega]_\times/2)^{-1} \f$,
+ * t the translation of the result and \f$ J_r \f$ so3::CayleyJr.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat6d CayleyJr(const Vec6d& data);
+
+/**
+ * Computes the inverse of the right Jacobian of the Cayley map, \f$ [I + [\omega]_\times/2,\ [t/2]_\times J_r^{-1};\ 0,\ J_r^{-1}] \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat6d CayleyJrInv(const Vec6d& data);
+
+/**
+ * Computes the element whose rotation is so3::FirstOrder of the angular part and whose translation is \f$ \rho \f$,
+ * the projection of \f$ I + W \f$ onto the group. See FirstOrderRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat4d FirstOrder(const Vec6d& data);
+
+/**
+ * Computes the inverse of FirstOrder. It is defined for rotations of less than \f$ \pi/2 \f$.
+ * @param data The data of an element of \f$ SE(3) \f$
+ */
+static Vec6d FirstOrderInv(const Mat4d& data);
+
+/**
+ * Computes the right Jacobian of FirstOrder, \f$ [R^\top,\ 0;\ 0,\ J_r] \f$ with \f$ J_r \f$ so3::FirstOrderJr.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat6d FirstOrderJr(const Vec6d& data);
+
+/**
+ * Computes the inverse of the right Jacobian of FirstOrder, \f$ [R,\ 0;\ 0,\ J_r^{-1}] \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat6d FirstOrderJrInv(const Vec6d& data);
+
 /**
  * Computes and returns the Euclidean norm of the element of the Lie algebra
  */ 
@@ -162,13 +276,10 @@ Mat6d Jl();
 
 /**
  * Computes the left Jacobian using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$.
- * Since the left Jacobian is the identity map for \f$se(3)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_l(v)u \f$. The matrix is not formed. See ApplyJl.
  * @param u An element of the Lie algebra.
- * @return It will return the parameter u.
  */ 
-se3 Jl(const se3& u){return se3(this->Jl()*u.data_);}
+se3 Jl(const se3& u){return se3(ApplyJl(data_,u.data_));}
 
 /**
  * Computes and returns the matrix of the Left Jacobian inverse.
@@ -177,12 +288,10 @@ Mat6d JlInv();
 
 /**
  * Computes the left Jacobian inverse using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$
- * Since the left Jacobian inverse is the identity map for \f$se(3)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_l^{-1}(v)u \f$. The matrix is not formed. See ApplyJlInv.
  * @param u An element of the Lie algebra.
  */ 
-se3 JlInv(const se3& u){return se3(this->JlInv()*u.data_);}
+se3 JlInv(const se3& u){return se3(ApplyJlInv(data_,u.data_));}
 
 /**
  * Computes and returns the matrix of the Right Jacobian
@@ -191,12 +300,10 @@ Mat6d Jr();
 
 /**
  * Computes the right Jacobian using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$
- * Since the right Jacobian is the identity map for \f$se(3)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_r(v)u \f$. The matrix is not formed. See ApplyJr.
  * @param u An element of the Lie algebra.
  */ 
-se3 Jr(const se3& u){return se3(this->Jr()*u.data_);}
+se3 Jr(const se3& u){return se3(ApplyJr(data_,u.data_));}
 
 /**
  * Computes and returns the matrix of the right Jacobian inverse.
@@ -205,12 +312,42 @@ Mat6d JrInv();
 
 /**
  * Computes the right Jacobian inverse using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$
- * Since the right Jacobian inverse is the identity map for \f$se(3)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_r^{-1}(v)u \f$. The matrix is not formed. See ApplyJrInv.
  * @param u An element of the Lie algebra.
  */ 
-se3 JrInv(const se3& u){ return se3(this->JrInv()*u.data_);}
+se3 JrInv(const se3& u){ return se3(ApplyJrInv(data_,u.data_));}
+
+/**
+ * Applies the left Jacobian evaluated at data to v without forming the matrix. The Jacobian is 
+ * \f$ \begin{bmatrix} J_l(w) & B_l \\ 0 & J_l(w) \end{bmatrix} \f$ where \f$ J_l(w) \f$ is the left Jacobian of 
+ * \f$ so(3) \f$. Both it and the coupling block \f$ B_l \f$ are applied with cross products.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian is applied to.
+ */
+static Vec6d ApplyJl(const Vec6d& data, const Vec6d& v);
+
+/**
+ * Applies the right Jacobian evaluated at data to v without forming the matrix.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian is applied to.
+ */
+static Vec6d ApplyJr(const Vec6d& data, const Vec6d& v);
+
+/**
+ * Applies the left Jacobian inverse evaluated at data to v without forming the matrix. The inverse is 
+ * \f$ \begin{bmatrix} J_l^{-1} & -J_l^{-1} B_l J_l^{-1} \\ 0 & J_l^{-1} \end{bmatrix} \f$ so the rotational 
+ * part is solved first and the coupling is applied to it.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian inverse is applied to.
+ */
+static Vec6d ApplyJlInv(const Vec6d& data, const Vec6d& v);
+
+/**
+ * Applies the right Jacobian inverse evaluated at data to v without forming the matrix.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian inverse is applied to.
+ */
+static Vec6d ApplyJrInv(const Vec6d& data, const Vec6d& v);
 
 /**
  * Adds two elements of the Algebra together
@@ -264,6 +401,19 @@ private:
 static Mat3d Bl(const Vec6d& u);
 static Mat3d Br(const Vec6d& u);
 
+// The same as above, but they use the norm of the angular velocity and its sine and cosine provided
+static Mat3d Bl(const Vec6d& u, const tDataType th, const tDataType sin_th, const tDataType cos_th);
+static Mat3d Br(const Vec6d& u, const tDataType th, const tDataType sin_th, const tDataType cos_th);
+
+// Applies Bl (sign = -1) or Br (sign = 1) of u to x without forming the matrix
+static Vec3d ApplyB(const Vec6d& u, const tDataType th, const Vec3d& x, const tDataType sign);
+
+// Computes the coefficients of Bl and Br from the norm of the angular velocity and its sine and cosine
+static void BCoefficients(const tDataType th, const tDataType sin_th, const tDataType cos_th, tDataType& a, tDataType& b, tDataType& c, tDataType& d);
+
+// The translation of the Cayley map, (I - [w]x/2)^{-1} p = (p + w x p/2 + w w.p/4)/(1 + |w|^2/4).
+static Vec3d CayleyTranslation(const Vec6d& data);
+
 
 };
 
@@ -274,7 +424,7 @@ static Mat3d Br(const Vec6d& u);
 
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
-se3<tDataType,tNumDimensions,tNumTangentSpaces>::se3(const Mat4d& data, bool verify) : p_(data_.data()), th_(data_.data()+3) {
+se3<tDataType,tNumDimensions,tNumTangentSpaces>::se3(const Mat4d& data, bool verify) {
 
     if(verify)
     {
@@ -299,22 +449,98 @@ se3<tDataType,tNumDimensions,tNumTangentSpaces>::se3(const Mat4d& data, bool ver
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,4,4> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Exp(const Vec6d& data) {
     Mat4d m;
-    so3<tDataType> omega(data.block(3,0,3,1));
-    m.block(0,0,3,3) = omega.Exp();
-    m.block(0,3,3,1) = omega.Jl()*data.block(0,0,3,1);
+    Mat3d jl;
+    m.block(0,0,3,3) = so3<tDataType>::ExpWithJl(data.block(3,0,3,1),jl);
+    m.block(0,3,3,1) = jl*data.block(0,0,3,1);
     m.block(3,0,1,4) << static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(1.0);
     return m;  
 }
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,4,4> se3<tDataType,tNumDimensions,tNumTangentSpaces>::ExpWithJl(const Vec6d& data, Mat6d& jl) {
+    Mat4d m;
+    Mat3d jl_w;
+    tDataType th = data.block(3,0,3,1).norm();
+    tDataType sin_th = std::sin(th);
+    tDataType cos_th = std::cos(th);
+    m.block(0,0,3,3) = so3<tDataType>::ExpWithJl(data.block(3,0,3,1),th,sin_th,cos_th,jl_w);
+    m.block(0,3,3,1) = jl_w*data.block(0,0,3,1);
+    m.block(3,0,1,4) << static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(1.0);
+
+    jl.block(0,0,3,3) = jl_w;
+    jl.block(0,3,3,3) = Bl(data,th,sin_th,cos_th);
+    jl.block(3,0,3,3).setZero();
+    jl.block(3,3,3,3) = jl_w;
+    return m;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,4,4> se3<tDataType,tNumDimensions,tNumTangentSpaces>::ExpWithJr(const Vec6d& data, Mat6d& jr) {
+    Mat4d m;
+    Mat3d jl_w;
+    tDataType th = data.block(3,0,3,1).norm();
+    tDataType sin_th = std::sin(th);
+    tDataType cos_th = std::cos(th);
+    m.block(0,0,3,3) = so3<tDataType>::ExpWithJl(data.block(3,0,3,1),th,sin_th,cos_th,jl_w);
+    m.block(0,3,3,1) = jl_w*data.block(0,0,3,1);
+    m.block(3,0,1,4) << static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(1.0);
+
+    // The right Jacobian of so3 is the transpose of the left Jacobian
+    jr.block(0,0,3,3) = jl_w.transpose();
+    jr.block(0,3,3,3) = Br(data,th,sin_th,cos_th);
+    jr.block(3,0,3,3).setZero();
+    jr.block(3,3,3,3) = jr.block(0,0,3,3);
+    return m;
+}
+
 
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Log(const Mat4d& data) {
     
     Vec6d u;
-    so3<tDataType>  omega(so3<tDataType>::Log(data.block(0,0,3,3)));
-    u.block(3,0,3,1) = omega.Vee();
-    u.block(0,0,3,1) = omega.JlInv()*data.block(0,3,3,1);
+    tDataType th, sin_th, cos_th;
+    u.block(3,0,3,1) = so3<tDataType>::Log(data.block(0,0,3,3),th,sin_th,cos_th);
+    u.block(0,0,3,1) = so3<tDataType>::JlInv(u.block(3,0,3,1),th,sin_th,cos_th)*data.block(0,3,3,1);
+    
+    return u;    
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::LogWithJlInv(const Mat4d& data, Mat6d& jl_inv) {
+    
+    Vec6d u;
+    tDataType th, sin_th, cos_th;
+    u.block(3,0,3,1) = so3<tDataType>::Log(data.block(0,0,3,3),th,sin_th,cos_th);
+    Mat3d jl_inv_w = so3<tDataType>::JlInv(u.block(3,0,3,1),th,sin_th,cos_th);
+    u.block(0,0,3,1) = jl_inv_w*data.block(0,3,3,1);
+
+    jl_inv.block(0,0,3,3) = jl_inv_w;
+    jl_inv.block(0,3,3,3) = -jl_inv_w*Bl(u,th,sin_th,cos_th)*jl_inv_w;
+    jl_inv.block(3,0,3,3).setZero();
+    jl_inv.block(3,3,3,3) = jl_inv_w;
+    
+    return u;    
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::LogWithJrInv(const Mat4d& data, Mat6d& jr_inv) {
+    
+    Vec6d u;
+    tDataType th, sin_th, cos_th;
+    u.block(3,0,3,1) = so3<tDataType>::Log(data.block(0,0,3,3),th,sin_th,cos_th);
+    Mat3d jl_inv_w = so3<tDataType>::JlInv(u.block(3,0,3,1),th,sin_th,cos_th);
+    u.block(0,0,3,1) = jl_inv_w*data.block(0,3,3,1);
+
+    // The right Jacobian inverse of so3 is the transpose of the left Jacobian inverse
+    jr_inv.block(0,0,3,3) = jl_inv_w.transpose();
+    jr_inv.block(0,3,3,3) = -jr_inv.block(0,0,3,3)*Br(u,th,sin_th,cos_th)*jr_inv.block(0,0,3,3);
+    jr_inv.block(3,0,3,3).setZero();
+    jr_inv.block(3,3,3,3) = jr_inv.block(0,0,3,3);
     
     return u;    
 }
@@ -323,7 +549,7 @@ Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Lo
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Jl() {
 
-    so3<tDataType> omega(th_);
+    so3<tDataType> omega(th());
 
     Eigen::Matrix<tDataType,6,6> m;
     m.block(0,0,3,3) = omega.Jl();
@@ -338,7 +564,7 @@ Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Jl
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::JlInv() {
 
-    so3<tDataType> omega(th_);
+    so3<tDataType> omega(th());
 
     Eigen::Matrix<tDataType,6,6> m;
     m.block(0,0,3,3) = omega.JlInv();
@@ -353,7 +579,7 @@ Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Jl
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Jr() {
 
-    so3<tDataType> omega(th_);
+    so3<tDataType> omega(th());
 
     Eigen::Matrix<tDataType,6,6> m;
     m.block(0,0,3,3) = omega.Jr();
@@ -369,7 +595,7 @@ Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Jr
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::JrInv() {
     
-    so3<tDataType> omega(th_);
+    so3<tDataType> omega(th());
 
     Eigen::Matrix<tDataType,6,6> m;
     m.block(0,0,3,3) = omega.JrInv();
@@ -382,6 +608,98 @@ Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Jr
     return m;
 }
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyTranslation(const Vec6d& data) {
+    const Vec3d w = data.template block<3,1>(3,0);
+    const Vec3d p = data.template block<3,1>(0,0);
+    return (p + w.cross(p)/static_cast<tDataType>(2.0) + w.dot(p)/static_cast<tDataType>(4.0)*w)/(static_cast<tDataType>(1.0) + w.squaredNorm()/static_cast<tDataType>(4.0));
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,4,4> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Cayley(const Vec6d& data) {
+    Mat4d m = Mat4d::Identity();
+    m.template block<3,3>(0,0) = so3<tDataType>::Cayley(data.template block<3,1>(3,0));
+    m.template block<3,1>(0,3) = CayleyTranslation(data);
+    return m;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyInv(const Mat4d& data) {
+    Vec6d u;
+    const Vec3d w = so3<tDataType>::CayleyInv(data.template block<3,3>(0,0));
+    const Vec3d t = data.template block<3,1>(0,3);
+    u.template block<3,1>(0,0) = t - w.cross(t)/static_cast<tDataType>(2.0);
+    u.template block<3,1>(3,0) = w;
+    return u;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyJr(const Vec6d& data) {
+    Mat6d j;
+    const Vec3d w = data.template block<3,1>(3,0);
+    const Mat3d M = (Mat3d::Identity() - SSM(w)/static_cast<tDataType>(2.0) + w*w.transpose()/static_cast<tDataType>(4.0))/(static_cast<tDataType>(1.0) + w.squaredNorm()/static_cast<tDataType>(4.0));
+    j.template block<3,3>(0,0) = M;
+    j.template block<3,3>(0,3) = -M*SSM(CayleyTranslation(data)/static_cast<tDataType>(2.0));
+    j.template block<3,3>(3,0).setZero();
+    j.template block<3,3>(3,3) = so3<tDataType>::CayleyJr(w);
+    return j;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyJrInv(const Vec6d& data) {
+    Mat6d j;
+    const Vec3d w = data.template block<3,1>(3,0);
+    const Mat3d jr_inv = so3<tDataType>::CayleyJrInv(w);
+    j.template block<3,3>(0,0) = Mat3d::Identity() + SSM(w)/static_cast<tDataType>(2.0);
+    j.template block<3,3>(0,3) = SSM(CayleyTranslation(data)/static_cast<tDataType>(2.0))*jr_inv;
+    j.template block<3,3>(3,0).setZero();
+    j.template block<3,3>(3,3) = jr_inv;
+    return j;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,4,4> se3<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrder(const Vec6d& data) {
+    Mat4d m = Mat4d::Identity();
+    m.template block<3,3>(0,0) = so3<tDataType>::FirstOrder(data.template block<3,1>(3,0));
+    m.template block<3,1>(0,3) = data.template block<3,1>(0,0);
+    return m;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrderInv(const Mat4d& data) {
+    Vec6d u;
+    u.template block<3,1>(0,0) = data.template block<3,1>(0,3);
+    u.template block<3,1>(3,0) = so3<tDataType>::FirstOrderInv(data.template block<3,3>(0,0));
+    return u;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrderJr(const Vec6d& data) {
+    Mat6d j = Mat6d::Zero();
+    const Vec3d w = data.template block<3,1>(3,0);
+    j.template block<3,3>(0,0) = so3<tDataType>::FirstOrder(w).transpose();
+    j.template block<3,3>(3,3) = so3<tDataType>::FirstOrderJr(w);
+    return j;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,6> se3<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrderJrInv(const Vec6d& data) {
+    Mat6d j = Mat6d::Zero();
+    const Vec3d w = data.template block<3,1>(3,0);
+    j.template block<3,3>(0,0) = so3<tDataType>::FirstOrder(w);
+    j.template block<3,3>(3,3) = so3<tDataType>::FirstOrderJrInv(w);
+    return j;
+}
+
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 bool se3<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Mat4d& data) {
@@ -399,71 +717,175 @@ bool se3<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Mat4d& dat
 }
 
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyJl(const Vec6d& data, const Vec6d& v) {
+    // Both diagonal blocks are the Jacobian of so(3) so its coefficients are computed once
+    const Vec3d w = data.template block<3,1>(3,0);
+    const tDataType th = w.norm();
+    tDataType a, b;
+    so3<tDataType>::JlCoefficients(th,a,b);
+    const Vec3d v_p = v.template block<3,1>(0,0);
+    const Vec3d v_w = v.template block<3,1>(3,0);
+    const Vec3d wv_p = w.cross(v_p);
+    const Vec3d wv_w = w.cross(v_w);
+    Vec6d out;
+    out.template block<3,1>(3,0) = v_w + a*wv_w + b*w.cross(wv_w);
+    out.template block<3,1>(0,0) = v_p + a*wv_p + b*w.cross(wv_p) + ApplyB(data,th,v_w,static_cast<tDataType>(-1.0));
+    return out;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyJr(const Vec6d& data, const Vec6d& v) {
+    // Both diagonal blocks are the Jacobian of so(3) so its coefficients are computed once
+    const Vec3d w = data.template block<3,1>(3,0);
+    const tDataType th = w.norm();
+    tDataType a, b;
+    so3<tDataType>::JlCoefficients(th,a,b);
+    const Vec3d v_p = v.template block<3,1>(0,0);
+    const Vec3d v_w = v.template block<3,1>(3,0);
+    const Vec3d wv_p = w.cross(v_p);
+    const Vec3d wv_w = w.cross(v_w);
+    Vec6d out;
+    out.template block<3,1>(3,0) = v_w - a*wv_w + b*w.cross(wv_w);
+    out.template block<3,1>(0,0) = v_p - a*wv_p + b*w.cross(wv_p) + ApplyB(data,th,v_w,static_cast<tDataType>(1.0));
+    return out;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyJlInv(const Vec6d& data, const Vec6d& v) {
+    // The rotational part is solved first and the coupling is applied to it
+    const Vec3d w = data.template block<3,1>(3,0);
+    const tDataType th = w.norm();
+    const tDataType c = so3<tDataType>::JlInvCoefficient(th);
+    const Vec3d v_w = v.template block<3,1>(3,0);
+    const Vec3d wv_w = w.cross(v_w);
+    Vec6d out;
+    out.template block<3,1>(3,0) = v_w - wv_w/static_cast<tDataType>(2.0) + c*w.cross(wv_w);
+    const Vec3d x = v.template block<3,1>(0,0) - ApplyB(data,th,out.template block<3,1>(3,0),static_cast<tDataType>(-1.0));
+    const Vec3d wx = w.cross(x);
+    out.template block<3,1>(0,0) = x - wx/static_cast<tDataType>(2.0) + c*w.cross(wx);
+    return out;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyJrInv(const Vec6d& data, const Vec6d& v) {
+    // The rotational part is solved first and the coupling is applied to it
+    const Vec3d w = data.template block<3,1>(3,0);
+    const tDataType th = w.norm();
+    const tDataType c = so3<tDataType>::JlInvCoefficient(th);
+    const Vec3d v_w = v.template block<3,1>(3,0);
+    const Vec3d wv_w = w.cross(v_w);
+    Vec6d out;
+    out.template block<3,1>(3,0) = v_w + wv_w/static_cast<tDataType>(2.0) + c*w.cross(wv_w);
+    const Vec3d x = v.template block<3,1>(0,0) - ApplyB(data,th,out.template block<3,1>(3,0),static_cast<tDataType>(1.0));
+    const Vec3d wx = w.cross(x);
+    out.template block<3,1>(0,0) = x + wx/static_cast<tDataType>(2.0) + c*w.cross(wx);
+    return out;
+}
+
 /////////////////////////////////////////////////
 //                  Private Functions
 /////////////////////////////////////////////////
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,3,3> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Bl(const Eigen::Matrix<tDataType, 6,1>& u) {
 
-Eigen::Matrix<tDataType,3,3> m;
-Eigen::Map<const Eigen::Matrix<tDataType,3,1>> p(u.data());
-Eigen::Map<const Eigen::Matrix<tDataType,3,1>> w(u.data()+3);
+tDataType th = u.block(3,0,3,1).norm();
+return Bl(u,th,std::sin(th),std::cos(th));
 
-tDataType th = w.norm();
+}
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Br(const Eigen::Matrix<tDataType, 6,1>& u) {
 
-if (th <= kse3_threshold_) { // Close to the identity element;
-    m = SSM(p)/static_cast<tDataType>(2.0) + (SSM(w)*SSM(p)-SSM(p)*SSM(w))/static_cast<tDataType>(6.0);
-} else {
-    tDataType th2 = pow(th,2);
-    tDataType th3 = pow(th,3);
-    tDataType th4 = pow(th,4);
-    tDataType a = (cos(th)-1.0)/th2;
-    tDataType b = (th - sin(th))/th3;
-    tDataType c = -sin(th)/th3 + 2.0*(1.0-cos(th))/th4;
-    tDataType d = -2.0/th4 + 3.0*sin(th)/pow(th,5) - cos(th)/th4;
-    Eigen::Matrix<tDataType,3,3> q;
-    q = w.dot(p)*(-c*SSM(w) + d*SSM(w)*SSM(w));
+tDataType th = u.block(3,0,3,1).norm();
+return Br(u,th,std::sin(th),std::cos(th));
 
-    m = -a*SSM(p) + b*(SSM(w)*SSM(p) + SSM(p)*SSM(w)) + q;
 }
 
-return m;
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Bl(const Eigen::Matrix<tDataType, 6,1>& u, const tDataType th, const tDataType sin_th, const tDataType cos_th) {
+
+Eigen::Map<const Eigen::Matrix<tDataType,3,1>> p(u.data());
+Eigen::Map<const Eigen::Matrix<tDataType,3,1>> w(u.data()+3);
+
+tDataType a, b, c, d;
+BCoefficients(th,sin_th,cos_th,a,b,c,d);
+Eigen::Matrix<tDataType,3,3> q;
+q = w.dot(p)*(-c*SSM(w) + d*SSM(w)*SSM(w));
+
+return -a*SSM(p) + b*(SSM(w)*SSM(p) + SSM(p)*SSM(w)) + q;
 
 }
 
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
-Eigen::Matrix<tDataType,3,3> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Br(const Eigen::Matrix<tDataType, 6,1>& u) {
+Eigen::Matrix<tDataType,3,3> se3<tDataType,tNumDimensions,tNumTangentSpaces>::Br(const Eigen::Matrix<tDataType, 6,1>& u, const tDataType th, const tDataType sin_th, const tDataType cos_th) {
 
-Eigen::Matrix<tDataType,3,3> m;
 Eigen::Map<const Eigen::Matrix<tDataType,3,1>> p(u.data());
 Eigen::Map<const Eigen::Matrix<tDataType,3,1>> w(u.data()+3);
 
-tDataType th = w.norm();
+tDataType a, b, c, d;
+BCoefficients(th,sin_th,cos_th,a,b,c,d);
+Eigen::Matrix<tDataType,3,3> q;
+q = w.dot(p)*(c*SSM(w) + d*SSM(w)*SSM(w));
 
+return a*SSM(p) + b*(SSM(w)*SSM(p) + SSM(p)*SSM(w)) + q;
 
-if (th <= kse3_threshold_) { // Close to the identity element;
-    m = - SSM(p)/static_cast<tDataType>(2.0) + (SSM(w)*SSM(p)-SSM(p)*SSM(w))/static_cast<tDataType>(6.0);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void se3<tDataType,tNumDimensions,tNumTangentSpaces>::BCoefficients(const tDataType th, const tDataType sin_th, const tDataType cos_th, tDataType& a, tDataType& b, tDataType& c, tDataType& d) {
+
+const tDataType th2 = th*th;
+
+// 1-cos(th) is computed without cancellation so a only needs a series to avoid dividing by zero. The closed forms
+// of b, c and d lose about eps/th^2 to cancellation so they are replaced by their Taylor series over a range that
+// grows with the machine epsilon.
+if (th < ScalarTraits<tDataType>::small_angle_threshold_) {
+    a = -(static_cast<tDataType>(1.0/2.0) - th2*static_cast<tDataType>(1.0/24.0));
+} else {
+    a = -so3<tDataType>::OneMinusCos(sin_th,cos_th)/th2;
+}
+
+if (th < ScalarTraits<tDataType>::series_threshold_) {
+    b = static_cast<tDataType>(1.0/6.0) - th2*(static_cast<tDataType>(1.0/120.0) - th2*(static_cast<tDataType>(1.0/5040.0) - th2*static_cast<tDataType>(1.0/362880.0)));
+    c = static_cast<tDataType>(1.0/12.0) - th2*(static_cast<tDataType>(1.0/180.0) - th2*(static_cast<tDataType>(1.0/6720.0) - th2*static_cast<tDataType>(1.0/453600.0)));
+    d = -static_cast<tDataType>(1.0/60.0) + th2*(static_cast<tDataType>(1.0/1260.0) - th2*static_cast<tDataType>(1.0/60480.0));
 } else {
-    tDataType th2 = pow(th,2);
-    tDataType th3 = pow(th,3);
-    tDataType th4 = pow(th,4);
-    tDataType a = (cos(th)-1.0)/th2;
-    tDataType b = (th - sin(th))/th3;
-    tDataType c = -sin(th)/th3 + 2.0*(1.0-cos(th))/th4;
-    tDataType d = -2.0/th4 + 3.0*sin(th)/pow(th,5) - cos(th)/th4;
-    Eigen::Matrix<tDataType,3,3> q;
-    q = w.dot(p)*(c*SSM(w) + d*SSM(w)*SSM(w));
-    m = a*SSM(p) + b*(SSM(w)*SSM(p) + SSM(p)*SSM(w)) + q;
+    const tDataType th3 = th2*th;
+    const tDataType th4 = th3*th;
+    b = (th - sin_th)/th3;
+    c = -sin_th/th3 - static_cast<tDataType>(2.0)*a/th2;
+    d = -static_cast<tDataType>(2.0)/th4 + static_cast<tDataType>(3.0)*sin_th/(th4*th) - cos_th/th4;
 }
 
-return m;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> se3<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyB(const Eigen::Matrix<tDataType,6,1>& u, const tDataType th, const Eigen::Matrix<tDataType,3,1>& x, const tDataType sign) {
+
+// B = sign*(a*SSM(p) + c*(w.p)*SSM(w)) + b*(SSM(w)*SSM(p) + SSM(p)*SSM(w)) + d*(w.p)*SSM(w)*SSM(w) with the coefficients of Bl and Br
+const Vec3d p = u.template block<3,1>(0,0);
+const Vec3d w = u.template block<3,1>(3,0);
+tDataType a, b, c, d;
+BCoefficients(th,std::sin(th),std::cos(th),a,b,c,d);
 
+const Vec3d px = p.cross(x);
+const Vec3d wx = w.cross(x);
+const tDataType wp = w.dot(p);
+return sign*(a*px + c*wp*wx) + b*(w.cross(px) + p.cross(wx)) + d*wp*w.cross(wx);
 
 }
 
 
 }
 
-#endif //_LIEGROUPS_INCLUDE_LIEALGEBRAS_SE3_
\ No newline at end of file
+#endif //_LIEGROUPS_INCLUDE_LIEALGEBRAS_SE3_
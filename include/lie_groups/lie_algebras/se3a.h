@@ -0,0 +1,181 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEALGEBRAS_SE3A_
+#define _LIEGROUPS_INCLUDE_LIEALGEBRAS_SE3A_
+
+#include <Eigen/Dense>
+#include <iostream>
+#include "lie_groups/lie_algebras/se3.h"
+
+namespace lie_groups {
+
+/**
+ * The Lie algebra \f$se(3)\f$ whose exponential and logarithm map to and from the top 3x4 block \f$ [R\ t] \f$ of
+ * the homogeneous matrices of \f$SE(3)\f$. It is the Lie algebra of SE3Affine. The Cartesian space, the wedge and vee maps
+ * and the Jacobians are the ones of se3.
+ */
+template <typename tDataType=double, int tNumDimensions=6, int tNumTangentSpaces=1>
+class se3a : public se3<tDataType,tNumDimensions,tNumTangentSpaces> {
+
+public:
+
+typedef se3<tDataType,tNumDimensions,tNumTangentSpaces> Base;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,6,1> Vec6d;
+typedef Eigen::Matrix<tDataType,3,3> Mat3d;
+typedef Eigen::Matrix<tDataType,3,4> Mat34d;
+typedef Eigen::Matrix<tDataType,4,4> Mat4d;
+typedef Eigen::Matrix<tDataType,6,6> Mat6d;
+
+using Base::data_;
+
+/**
+ * Default constructor. Initializes algebra element to identity.
+ */
+se3a() = default;
+
+/**
+* Initializes algebra element to the one given.
+* @param[in] data The data of an element of Cartesian space of \f$se(3)\f$
+*/
+se3a(const Vec6d data) : Base(data) {}
+
+/**
+* Initializes algebra element to the one given. If verify is set to true,
+* it will verify that the element provided is an element of the Lie algebra.
+* @param[in] data The data of an element of \f$se(3)\f$
+* @param verify If true, the constructor will verify that the element given is an element of the Lie algebra.
+*/
+se3a(const Mat4d & data, bool verify) : Base(data,verify) {}
+
+/**
+* Initializes algebra element to the element of se3 given.
+* @param[in] u An element of se3.
+*/
+se3a(const Base& u) : Base(u) {}
+
+/**
+ * Computes the exponential of the element of the Lie algebra.
+ * @return The top 3x4 block of the group element.
+ */
+Mat34d Exp(){ return Exp(data_);}
+
+/**
+ * Computes the exponential of the element of the Lie algebra, \f$ [\exp(w)\ J_l(w) p] \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @return The top 3x4 block of the group element.
+ */
+static Mat34d Exp(const Vec6d& data) {
+    Mat34d m;
+    Mat3d jl;
+    m.template block<3,3>(0,0) = so3<tDataType>::ExpWithJl(data.template block<3,1>(3,0),jl);
+    m.template block<3,1>(0,3) = jl*data.template block<3,1>(0,0);
+    return m;
+}
+
+/**
+ * Computes the logarithm of the top 3x4 block of an element of \f$ SE(3) \f$.
+ * @param data The top 3x4 block of an element of \f$ SE(3) \f$
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec6d Log(const Mat34d& data) {
+    Vec6d u;
+    tDataType th, sin_th, cos_th;
+    u.template block<3,1>(3,0) = so3<tDataType>::Log(data.template block<3,3>(0,0),th,sin_th,cos_th);
+    u.template block<3,1>(0,0) = so3<tDataType>::JlInv(u.template block<3,1>(3,0),th,sin_th,cos_th)*data.template block<3,1>(0,3);
+    return u;
+}
+
+/**
+ * Computes the exponential and the left Jacobian of the element of the Lie algebra. See se3::ExpWithJl.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jl The left Jacobian evaluated at data
+ * @return The top 3x4 block of the group element.
+ */
+static Mat34d ExpWithJl(const Vec6d& data, Mat6d& jl) {return Base::ExpWithJl(data,jl).template topRows<3>();}
+
+/**
+ * Computes the exponential and the right Jacobian of the element of the Lie algebra. See se3::ExpWithJr.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jr The right Jacobian evaluated at data
+ * @return The top 3x4 block of the group element.
+ */
+static Mat34d ExpWithJr(const Vec6d& data, Mat6d& jr) {return Base::ExpWithJr(data,jr).template topRows<3>();}
+
+/**
+ * Computes the logarithm and the left Jacobian inverse evaluated at the logarithm. See se3::LogWithJlInv.
+ * @param data The top 3x4 block of an element of \f$ SE(3) \f$
+ * @param jl_inv The left Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec6d LogWithJlInv(const Mat34d& data, Mat6d& jl_inv) {return Base::LogWithJlInv(Homogeneous(data),jl_inv);}
+
+/**
+ * Computes the logarithm and the right Jacobian inverse evaluated at the logarithm. See se3::LogWithJrInv.
+ * @param data The top 3x4 block of an element of \f$ SE(3) \f$
+ * @param jr_inv The right Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec6d LogWithJrInv(const Mat34d& data, Mat6d& jr_inv) {return Base::LogWithJrInv(Homogeneous(data),jr_inv);}
+
+/**
+ * Computes the top 3x4 block of the Cayley map. See se3::Cayley. Its Jacobians are the ones of se3.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat34d Cayley(const Vec6d& data) {return Base::Cayley(data).template topRows<3>();}
+
+/**
+ * Computes the inverse of the Cayley map. See se3::CayleyInv.
+ * @param data The top 3x4 block of an element of \f$ SE(3) \f$
+ */
+static Vec6d CayleyInv(const Mat34d& data) {return Base::CayleyInv(Homogeneous(data));}
+
+/**
+ * Computes the top 3x4 block of FirstOrder. See se3::FirstOrder.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat34d FirstOrder(const Vec6d& data) {return Base::FirstOrder(data).template topRows<3>();}
+
+/**
+ * Computes the inverse of FirstOrder. See se3::FirstOrderInv.
+ * @param data The top 3x4 block of an element of \f$ SE(3) \f$
+ */
+static Vec6d FirstOrderInv(const Mat34d& data) {return Base::FirstOrderInv(Homogeneous(data));}
+
+/**
+ * Returns the homogeneous 4x4 matrix of the top 3x4 block of an element of \f$ SE(3) \f$.
+ * @param data The top 3x4 block of an element of \f$ SE(3) \f$
+ */
+static Mat4d Homogeneous(const Mat34d& data) {
+    Mat4d m;
+    m.template topRows<3>() = data;
+    m.template bottomRows<1>() << static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(1.0);
+    return m;
+}
+
+/**
+ * Adds two elements of the Algebra together
+ * @param u An element of the Lie algebra.
+ */
+se3a operator + (const se3a& u){return se3a(Vec6d(data_ + u.data_));}
+
+/**
+ * Subtracts two elements of the Algebra together
+ * @param u An element of the Lie algebra.
+ */
+se3a operator - (const se3a& u){return se3a(Vec6d(data_ - u.data_));}
+
+/**
+ * Performs Scalar multiplication and returns the result.
+ * @param scalar The scalar that will scale the element of the Lie algebra
+ */
+se3a operator * (const tDataType scalar) const {return se3a(Vec6d(scalar*data_));}
+
+/**
+ * Returns the Identity element.
+ */
+static se3a Identity(){return se3a();}
+
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEALGEBRAS_SE3A_
@@ -2,7 +2,10 @@
 #define _LIEGROUPS_INCLUDE_LIEALGEBRAS_SO2_
 
 #include <Eigen/Dense>
+#include <cmath>
 #include <iostream>
+#include "lie_groups/lie_algebras/batch_math.h"
+#include "lie_groups/lie_algebras/scalar_traits.h"
 
 namespace lie_groups {
 
@@ -37,22 +40,22 @@ so2() : data_(Mat1d::Zero()){}
 /**
  * Copy constructor.
  */ 
-so2(const so2 & u) : data_(u.data_){}
+so2(const so2 & u) = default;
 
 /**
  * Copy assignment.
  */
-void operator = (const so2& u){data_ = u.data_;}
+so2& operator = (const so2& u) = default;
 
 /**
  * Move constructor.
  */ 
-so2(const so2 && u) : data_(u.data_){}
+so2(so2 && u) = default;
 
 /**
  * Move assignment.
  */
-void operator = (const so2&& u){data_ = u.data_;}
+so2& operator = (so2&& u) = default;
 
 /**
 * Initializes algebra element to the one given. 
@@ -76,10 +79,9 @@ so2(const Mat2d & data, bool verify);
  * Performs the Lie bracket with is always the identity element. 
  * The input is the right parameter 
  * of the Lie bracket function. \f$ \[v,u\] \f$
- * @param u An element of the Lie algebra.
  * @return The result of the Lie bracket operation.
  */ 
-so2 Bracket(const so2& u) {return so2();}
+so2 Bracket(const so2&) {return so2();}
 
 /**
  * Computes and returns the matrix adjoint representation of the Lie algebra.
@@ -143,10 +145,117 @@ Mat2d Exp(){ return so2<tDataType,tNumDimensions,tNumTangentSpaces>::Exp(this->d
  */
 static Mat1d Log(const Mat2d& data);
 
+/**
+ * Computes the exponential of n elements of the Cartesian space at once. u[0][i] is the angle of element i
+ * and r[k][i] is entry k, in column-major order, of the rotation matrix of element i. The elements are processed 
+ * a SIMD register at a time and the remainder with the scalar version of the same code. The entries of the
+ * result are within 1 ulp of 1 of the exact result for \f$ |u| < 10^6 \f$ (\f$ |u| < 10^3 \f$ for float).
+ * @param u The pointer to the angles.
+ * @param r The pointers to the four entries of the resulting rotation matrices.
+ * @param n The number of elements.
+ */
+static void BatchExp(const tDataType* const u[1], tDataType* const r[4], Eigen::Index n);
+
+/**
+ * Computes the logarithm of n rotation matrices at once. r[k][i] is entry k, in column-major order, of the 
+ * rotation matrix of element i and u[0][i] is the resulting angle. The result is within 2 ulp of the exact result.
+ * @param r The pointers to the four entries of the rotation matrices.
+ * @param u The pointer to the resulting angles.
+ * @param n The number of elements.
+ */
+static void BatchLog(const tDataType* const r[4], tDataType* const u[1], Eigen::Index n);
+
+/**
+ * Computes the Cayley map, the rotation by \f$ 2\arctan(\theta/2) \f$ whose cosine is \f$ (4-\theta^2)/(4+\theta^2) \f$
+ * and sine \f$ 4\theta/(4+\theta^2) \f$. See CayleyRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat2d Cayley(const Mat1d& data);
+
+/**
+ * Computes the inverse of the Cayley map, \f$ 2\sin\theta/(1+\cos\theta) \f$.
+ * @param data The data associated with an element of \f$ SO(2) \f$
+ */
+static Mat1d CayleyInv(const Mat2d& data) {
+    return Mat1d(static_cast<tDataType>(2.0)*(data(1,0) - data(0,1))/(static_cast<tDataType>(2.0) + data(0,0) + data(1,1)));
+}
+
+/**
+ * Computes the Jacobian of the Cayley map, \f$ 4/(4+\theta^2) \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat1d CayleyJr(const Mat1d& data) {return Mat1d(static_cast<tDataType>(4.0)/(static_cast<tDataType>(4.0) + data(0)*data(0)));}
+
+/**
+ * Computes the inverse of the Jacobian of the Cayley map, \f$ 1+\theta^2/4 \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat1d CayleyJrInv(const Mat1d& data) {return Mat1d(static_cast<tDataType>(1.0) + data(0)*data(0)/static_cast<tDataType>(4.0));}
+
+/**
+ * Computes the rotation closest to \f$ I + W \f$, the rotation by \f$ \arctan\theta \f$. See FirstOrderRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat2d FirstOrder(const Mat1d& data);
+
+/**
+ * Computes the inverse of FirstOrder, \f$ \tan\theta \f$.
+ * @param data The data associated with an element of \f$ SO(2) \f$
+ */
+static Mat1d FirstOrderInv(const Mat2d& data) {return Mat1d((data(1,0) - data(0,1))/(data(0,0) + data(1,1)));}
+
+/**
+ * Computes the Jacobian of FirstOrder, \f$ 1/(1+\theta^2) \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat1d FirstOrderJr(const Mat1d& data) {return Mat1d(static_cast<tDataType>(1.0)/(static_cast<tDataType>(1.0) + data(0)*data(0)));}
+
+/**
+ * Computes the inverse of the Jacobian of FirstOrder, \f$ 1+\theta^2 \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat1d FirstOrderJrInv(const Mat1d& data) {return Mat1d(static_cast<tDataType>(1.0) + data(0)*data(0));}
+
+/**
+ * Computes the exponential and the left Jacobian of the element of the Lie algebra.
+ * The left Jacobian is always the identity map for \f$so(2)\f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jl The left Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static Mat2d ExpWithJl(const Mat1d& data, Mat2d& jl) {jl.setIdentity(); return Exp(data);}
+
+/**
+ * Computes the exponential and the right Jacobian of the element of the Lie algebra.
+ * The right Jacobian is always the identity map for \f$so(2)\f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jr The right Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static Mat2d ExpWithJr(const Mat1d& data, Mat2d& jr) {jr.setIdentity(); return Exp(data);}
+
+/**
+ * Computes the logarithm and the left Jacobian inverse evaluated at the logarithm. 
+ * The left Jacobian inverse is always the identity map for \f$so(2)\f$.
+ * @param data The data associated with an element of \f$ SO(2) \f$
+ * @param jl_inv The left Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Mat1d LogWithJlInv(const Mat2d& data, Mat2d& jl_inv) {jl_inv.setIdentity(); return Log(data);}
+
+/**
+ * Computes the logarithm and the right Jacobian inverse evaluated at the logarithm. 
+ * The right Jacobian inverse is always the identity map for \f$so(2)\f$.
+ * @param data The data associated with an element of \f$ SO(2) \f$
+ * @param jr_inv The right Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Mat1d LogWithJrInv(const Mat2d& data, Mat2d& jr_inv) {jr_inv.setIdentity(); return Log(data);}
+
 /**
  * Computes and returns the Euclidean norm of the element of the Lie algebra
  */ 
-double Norm() {return data_.norm();}
+tDataType Norm() {return data_.norm();}
 
 /**
  * Computes and returns the matrix of the Left Jacobian.
@@ -225,7 +334,7 @@ so2 operator - (const so2& u){return so2(data_ - u.data_);}
  * Performs Scalar multiplication and returns the result.
  * @param scalar The scalar that will scale the element of the Lie algebra
  */ 
-so2 operator * (const double scalar) const {return so2(scalar*data_);}
+so2 operator * (const tDataType scalar) const {return so2(scalar*data_);}
 
 /**
  * Prints the data of the element.
@@ -243,7 +352,19 @@ static so2 Identity(){return so2();}
  */ 
 static bool isElement(const Mat2d& data);
 
+private:
 
+/**
+ * Computes the exponential of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchExpKernel(const tDataType* const u[1], tDataType* const r[4], Eigen::Index i);
+
+/**
+ * Computes the logarithm of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchLogKernel(const tDataType* const r[4], tDataType* const u[1], Eigen::Index i);
 
 };
 
@@ -276,7 +397,9 @@ so2<tDataType,tNumDimensions,tNumTangentSpaces>::so2(const Eigen::Matrix<tDataTy
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,2,2> so2<tDataType,tNumDimensions,tNumTangentSpaces>::Exp(const Mat1d &data) {
     Mat2d m;
-    m << cos(data(0)), -sin(data(0)), sin(data(0)), cos(data(0));
+    tDataType s = std::sin(data(0));
+    tDataType c = std::cos(data(0));
+    m << c, -s, s, c;
     return m;
 }
 
@@ -284,15 +407,88 @@ Eigen::Matrix<tDataType,2,2> so2<tDataType,tNumDimensions,tNumTangentSpaces>::Ex
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 Eigen::Matrix<tDataType,1,1> so2<tDataType,tNumDimensions,tNumTangentSpaces>::Log(const Mat2d& data) {
     Mat1d m;
-    m(0) = atan2(data(1,0),data(0,0));
+    m(0) = std::atan2(data(1,0),data(0,0));
+    return m;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,2,2> so2<tDataType,tNumDimensions,tNumTangentSpaces>::Cayley(const Mat1d& data) {
+    Mat2d m;
+    const tDataType th2 = data(0)*data(0);
+    const tDataType k = static_cast<tDataType>(1.0)/(static_cast<tDataType>(4.0) + th2);
+    const tDataType c = (static_cast<tDataType>(4.0) - th2)*k;
+    const tDataType s = static_cast<tDataType>(4.0)*data(0)*k;
+    m << c, -s, s, c;
+    return m;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,2,2> so2<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrder(const Mat1d& data) {
+    Mat2d m;
+    const tDataType c = static_cast<tDataType>(1.0)/std::sqrt(static_cast<tDataType>(1.0) + data(0)*data(0));
+    const tDataType s = data(0)*c;
+    m << c, -s, s, c;
     return m;
 }
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void so2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchExp(const tDataType* const u[1], tDataType* const r[4], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchExpKernel<Packet>(u,r,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchExpKernel<tDataType>(u,r,ii);
+    }
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void so2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchExpKernel(const tDataType* const u[1], tDataType* const r[4], Eigen::Index i) {
+    namespace ei = Eigen::internal;
+    tPacket s, c;
+    batch_math::SinCos(ei::ploadu<tPacket>(u[0]+i), s, c);
+    ei::pstoreu(r[0]+i, c);
+    ei::pstoreu(r[1]+i, s);
+    ei::pstoreu(r[2]+i, ei::pnegate(s));
+    ei::pstoreu(r[3]+i, c);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void so2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchLog(const tDataType* const r[4], tDataType* const u[1], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchLogKernel<Packet>(r,u,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchLogKernel<tDataType>(r,u,ii);
+    }
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void so2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchLogKernel(const tDataType* const r[4], tDataType* const u[1], Eigen::Index i) {
+    namespace ei = Eigen::internal;
+    ei::pstoreu(u[0]+i, batch_math::Atan2(ei::ploadu<tPacket>(r[1]+i), ei::ploadu<tPacket>(r[0]+i)));
+}
+
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 bool so2<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Mat2d& data) {
 
-    if ( (data.transpose() + data).norm() >= kso2_threshold_) {
+    if ( (data.transpose() + data).norm() >= ScalarTraits<tDataType>::algebra_threshold_) {
         return false;
     } else {
         return true;
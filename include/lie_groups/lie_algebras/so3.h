@@ -2,17 +2,21 @@
 #define _LIEGROUPS_INCLUDE_LIEALGEBRAS_SO3_
 
 #include <Eigen/Dense>
+#include <cmath>
 #include <iostream>
+#include "lie_groups/lie_algebras/batch_math.h"
+#include "lie_groups/lie_algebras/scalar_traits.h"
 
 namespace lie_groups {
 
-constexpr double kso3_threshold_=1e-7; /** < If two values are within this threshold, they are considered equal.*/
+constexpr double kso3_batch_threshold_=1e-3; /** < Below this angle the batch kernels use Taylor series. The truncation error is below the rounding error in float and double.*/
 
 
 template <typename tDataType=double, int tNumDimensions=3, int tNumTangentSpaces=1>
 class so3  {
 
-static_assert(tNumTangentSpaces == 1, "lie_groups::so3 the number of tangent spaces must be 1.");
+// The Lie operations act on the first tangent space only, see State::Propagate.
+static_assert(tNumTangentSpaces > 0, "lie_groups::so3 the number of tangent spaces must be greater than 0.");
 static_assert(tNumDimensions == 3, "lie_groups::so3 the number of dimensions must be 3.");
 
 public:
@@ -20,6 +24,7 @@ public:
 typedef Eigen::Matrix<tDataType,3,1> Vec3d;
 typedef Eigen::Matrix<tDataType,2,2> Mat2d;
 typedef Eigen::Matrix<tDataType,3,3> Mat3d;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
 
 static constexpr unsigned int dim_ = 3;
 static constexpr unsigned int size1_ = 3;
@@ -37,22 +42,22 @@ so3() : data_(Vec3d::Zero()){}
 /**
  * Copy constructor.
  */ 
-so3(const so3 & u) : data_(u.data_) {}
+so3(const so3 & u) = default;
 
 /**
  * Copy assignment.
  */
-void operator = (const so3& u){data_ = u.data_;}
+so3& operator = (const so3& u) = default;
 
 /**
  * Move constructor.
  */ 
-so3(const so3 && u) : data_(u.data_) {}
+so3(so3 && u) = default;
 
 /**
  * Move assignment.
  */
-void operator = (const so3&& u){data_ = u.data_;}
+so3& operator = (so3&& u) = default;
 
 /**
 * Initializes algebra element to the one given. 
@@ -129,16 +134,170 @@ Mat3d Exp(){ return so3<tDataType>::Exp(this->data_);}
 static Mat3d Exp(const Vec3d& data);
 
 /**
- * Computes the logaritm of the element of the Lie algebra.
+ * Computes the logaritm of the element of the Lie algebra. The rotation is converted to a quaternion with
+ * Shepperd's method close to \f$ \pi \f$, where the skew symmetric part vanishes, so that the result is accurate
+ * up to an angle of \f$ \pi \f$.
  * @param data The data associated with an element of \f$ SO(3) \f$
  * @return The data of an element of the Cartesian space associated with the Lie algebra
  */
 static Vec3d Log(const Mat3d& data);
 
+/**
+ * Computes the exponential and the left Jacobian of the element of the Lie algebra.
+ * The trigonometric terms are computed once and shared by both.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jl The left Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static Mat3d ExpWithJl(const Vec3d& data, Mat3d& jl);
+
+/**
+ * Computes the exponential and the right Jacobian of the element of the Lie algebra.
+ * The trigonometric terms are computed once and shared by both.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jr The right Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static Mat3d ExpWithJr(const Vec3d& data, Mat3d& jr);
+
+/**
+ * Computes the exponential and the left Jacobian of the element of the Lie algebra
+ * using the norm of the element and its sine and cosine provided. This is used by the Lie algebras
+ * that contain \f$so(3)\f$ and need the trigonometric terms for their own Jacobians.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param th The norm of data
+ * @param sin_th The sine of th
+ * @param cos_th The cosine of th
+ * @param jl The left Jacobian evaluated at data
+ * @return The data associated to the group element.
+ */
+static Mat3d ExpWithJl(const Vec3d& data, const tDataType th, const tDataType sin_th, const tDataType cos_th, Mat3d& jl);
+
+/**
+ * Computes the logarithm and the left Jacobian inverse evaluated at the logarithm. 
+ * The angle recovered by the logarithm is used to compute the Jacobian. 
+ * @param data The data associated with an element of \f$ SO(3) \f$
+ * @param jl_inv The left Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d LogWithJlInv(const Mat3d& data, Mat3d& jl_inv);
+
+/**
+ * Computes the logarithm and the right Jacobian inverse evaluated at the logarithm. 
+ * The angle recovered by the logarithm is used to compute the Jacobian. 
+ * @param data The data associated with an element of \f$ SO(3) \f$
+ * @param jr_inv The right Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d LogWithJrInv(const Mat3d& data, Mat3d& jr_inv);
+
+/**
+ * Computes the logarithm of the element of the Lie algebra and returns 
+ * the norm of the result with its sine and cosine. This is used by the Lie algebras
+ * that contain \f$so(3)\f$ and need the trigonometric terms for their own Jacobians.
+ * @param data The data associated with an element of \f$ SO(3) \f$
+ * @param th The norm of the result
+ * @param sin_th The sine of th
+ * @param cos_th The cosine of th
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d Log(const Mat3d& data, tDataType& th, tDataType& sin_th, tDataType& cos_th);
+
+/**
+ * Computes the unit quaternion \f$ (x,y,z,w) \f$ of a rotation matrix with Shepperd's method. The scalar part
+ * is non-negative. The coefficients are in the order of Eigen::Quaternion.
+ * @param data The data associated with an element of \f$ SO(3) \f$
+ */
+static Vec4d Quaternion(const Mat3d& data);
+
+/**
+ * Computes the left Jacobian inverse using the norm of the element and its sine and cosine provided.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param th The norm of data
+ * @param sin_th The sine of th
+ * @param cos_th The cosine of th
+ */
+static Mat3d JlInv(const Vec3d& data, const tDataType th, const tDataType sin_th, const tDataType cos_th);
+
+/**
+ * Computes the exponential of n elements of the Cartesian space at once. The data is given as a structure of arrays:
+ * u[k][i] is component k of element i and r[k][i] is entry k, in column-major order, of the rotation matrix of element i.
+ * The elements are processed a SIMD register at a time (2, 4 or 8 doubles with SSE2, AVX2 or AVX-512) and
+ * the remainder with the scalar version of the same branchless code. For \f$ |u| \leq 2\pi \f$ the entries of the result 
+ * are within 8 ulp of 1 of the exact result.
+ * @param u The pointers to the three components of the elements.
+ * @param r The pointers to the nine entries of the resulting rotation matrices.
+ * @param n The number of elements.
+ */
+static void BatchExp(const tDataType* const u[3], tDataType* const r[9], Eigen::Index n);
+
+/**
+ * Computes the logarithm of n rotation matrices at once. The data is given as a structure of arrays:
+ * r[k][i] is entry k, in column-major order, of the rotation matrix of element i and u[k][i] is component k of result i.
+ * The angle is recovered with a four quadrant arc tangent. The components of the result are within 4 ulp of the norm of the exact result
+ * except close to an angle of \f$ \pi \f$ where the axis can't be recovered from the skew symmetric part. Log() doesn't have this limitation.
+ * @param r The pointers to the nine entries of the rotation matrices.
+ * @param u The pointers to the three components of the results.
+ * @param n The number of elements.
+ */
+static void BatchLog(const tDataType* const r[9], tDataType* const u[3], Eigen::Index n);
+
+/**
+ * Computes the Cayley map \f$ (I - W/2)^{-1}(I + W/2) = I + \frac{4}{4+\theta^2}(W + W^2/2) \f$ where W is the wedge of
+ * the element and \f$ \theta \f$ its norm. It is a retraction that agrees with the exponential to the second order
+ * and needs no trigonometric function. The angle of the rotation is \f$ 2\arctan(\theta/2) \f$. See CayleyRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d Cayley(const Vec3d& data);
+
+/**
+ * Computes the inverse of the Cayley map, \f$ 2\,\text{vee}(R - R^\top)/(1 + \text{tr}(R)) \f$. It is defined for angles less than \f$ \pi \f$.
+ * @param data The data associated with an element of \f$ SO(3) \f$
+ */
+static Vec3d CayleyInv(const Mat3d& data);
+
+/**
+ * Computes the right Jacobian of the Cayley map, \f$ \frac{4}{4+\theta^2}(I - W/2) \f$. The left Jacobian is the right Jacobian of -data.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d CayleyJr(const Vec3d& data);
+
+/**
+ * Computes the inverse of the right Jacobian of the Cayley map, \f$ I + W/2 + u u^\top/4 \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d CayleyJrInv(const Vec3d& data);
+
+/**
+ * Computes the rotation closest to \f$ I + W \f$, its orthogonal polar factor, which is
+ * \f$ I + W/r + W^2/(r(r+1)) \f$ with \f$ r = \sqrt{1+\theta^2} \f$. It is a retraction that costs a square root.
+ * The angle of the rotation is \f$ \arctan\theta \f$. See FirstOrderRetraction.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d FirstOrder(const Vec3d& data);
+
+/**
+ * Computes the inverse of FirstOrder, \f$ \text{vee}(R - R^\top)/(\text{tr}(R) - 1) \f$. It is defined for angles less than \f$ \pi/2 \f$.
+ * @param data The data associated with an element of \f$ SO(3) \f$
+ */
+static Vec3d FirstOrderInv(const Mat3d& data);
+
+/**
+ * Computes the right Jacobian of FirstOrder, \f$ I/r^2 - W/(r(r+1)) - W^2/(r^2(r+1)) \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d FirstOrderJr(const Vec3d& data);
+
+/**
+ * Computes the inverse of the right Jacobian of FirstOrder, \f$ r^2 I + W/2 + \frac{2r+1}{2(r+1)} W^2 \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Mat3d FirstOrderJrInv(const Vec3d& data);
+
 /**
  * Computes and returns the Euclidean norm of the element of the Lie algebra
  */ 
-double Norm(){return data_.norm();}
+tDataType Norm(){return data_.norm();}
 
 /**
  * Computes and returns the matrix of the Left Jacobian.
@@ -147,13 +306,10 @@ Mat3d Jl();
 
 /**
  * Computes the left Jacobian using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$.
- * Since the left Jacobian is the identity map for \f$so(3)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_l(v)u \f$. The matrix is not formed. See ApplyJl.
  * @param u An element of the Lie algebra.
- * @return It will return the parameter u.
  */ 
-so3 Jl(const so3& u){return so3(this->Jl()*u.data_);}
+so3 Jl(const so3& u){return so3(ApplyJl(data_,u.data_));}
 
 /**
  * Computes and returns the matrix of the Left Jacobian inverse.
@@ -162,12 +318,10 @@ Mat3d JlInv();
 
 /**
  * Computes the left Jacobian inverse using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$
- * Since the left Jacobian inverse is the identity map for \f$so(3)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_l^{-1}(v)u \f$. The matrix is not formed. See ApplyJlInv.
  * @param u An element of the Lie algebra.
  */ 
-so3 JlInv(const so3& u){return so3(this->JlInv()*u.data_);}
+so3 JlInv(const so3& u){return so3(ApplyJlInv(data_,u.data_));}
 
 /**
  * Computes and returns the matrix of the Right Jacobian
@@ -176,12 +330,10 @@ Mat3d Jr();
 
 /**
  * Computes the right Jacobian using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$
- * Since the right Jacobian is the identity map for \f$so(3)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_r(v)u \f$. The matrix is not formed. See ApplyJr.
  * @param u An element of the Lie algebra.
  */ 
-so3 Jr(const so3& u){return so3(this->Jr()*u.data_);}
+so3 Jr(const so3& u){return so3(ApplyJr(data_,u.data_));}
 
 /**
  * Computes and returns the matrix of the right Jacobian inverse.
@@ -190,12 +342,78 @@ Mat3d JrInv();
 
 /**
  * Computes the right Jacobian inverse using the element of *this and applies it to the
- * parameter provided. \f$ J_l(v)u \f$
- * Since the right Jacobian inverse is the identity map for \f$so(3)\f$, it will simply return
- * the parameter u.
+ * parameter provided. \f$ J_r^{-1}(v)u \f$. The matrix is not formed. See ApplyJrInv.
  * @param u An element of the Lie algebra.
  */ 
-so3 JrInv(const so3& u){return so3(this->JrInv()*u.data_);}
+so3 JrInv(const so3& u){return so3(ApplyJrInv(data_,u.data_));}
+
+/**
+ * Applies the left Jacobian evaluated at data to v without forming the matrix.
+ * \f$ J_l v = v + a\, w \times v + b\, w \times (w \times v) \f$ with \f$ w \f$ being data.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian is applied to.
+ */
+static Vec3d ApplyJl(const Vec3d& data, const Vec3d& v);
+
+/**
+ * Applies the right Jacobian evaluated at data to v without forming the matrix.
+ * Since \f$ J_r(w) = J_l(-w) \f$, the sign of the first order term is flipped.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian is applied to.
+ */
+static Vec3d ApplyJr(const Vec3d& data, const Vec3d& v);
+
+/**
+ * Applies the left Jacobian inverse evaluated at data to v without forming the matrix.
+ * \f$ J_l^{-1} v = v - \frac{1}{2} w \times v + c\, w \times (w \times v) \f$ with \f$ w \f$ being data.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian inverse is applied to.
+ */
+static Vec3d ApplyJlInv(const Vec3d& data, const Vec3d& v);
+
+/**
+ * Applies the right Jacobian inverse evaluated at data to v without forming the matrix.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param v The vector the Jacobian inverse is applied to.
+ */
+static Vec3d ApplyJrInv(const Vec3d& data, const Vec3d& v);
+
+/**
+ * Computes the coefficients of the left Jacobian \f$ J_l = I + a W + b W^2 \f$ where W is the wedge of 
+ * an element whose norm is th. The coefficients are accurate for any angle.
+ * @param th The norm of the element.
+ * @param a The coefficient \f$ (1-\cos\theta)/\theta^2 \f$.
+ * @param b The coefficient \f$ (\theta-\sin\theta)/\theta^3 \f$.
+ */
+static void JlCoefficients(const tDataType th, tDataType& a, tDataType& b);
+
+/**
+ * Computes the coefficient c of the left Jacobian inverse \f$ J_l^{-1} = I - W/2 + c W^2 \f$ where W is the wedge of 
+ * an element whose norm is th. It is accurate for any angle less than \f$ 2\pi \f$.
+ * @param th The norm of the element.
+ * @return The coefficient \f$ (1-\frac{\theta}{2}\cot\frac{\theta}{2})/\theta^2 \f$.
+ */
+static tDataType JlInvCoefficient(const tDataType th);
+
+/**
+ * Computes \f$ 1-\cos\theta \f$ as \f$ 2\sin^2(\theta/2) \f$ which, unlike the difference, keeps its relative accuracy
+ * close to the identity.
+ * @param th The angle.
+ */
+static tDataType OneMinusCos(const tDataType th) {
+    const tDataType s = std::sin(th/static_cast<tDataType>(2.0));
+    return static_cast<tDataType>(2.0)*s*s;
+}
+
+/**
+ * Computes \f$ 1-\cos\theta \f$ from the sine and cosine of the angle. When the cosine is positive it is
+ * computed as \f$ \sin^2\theta/(1+\cos\theta) \f$ to avoid the cancellation.
+ * @param sin_th The sine of the angle.
+ * @param cos_th The cosine of the angle.
+ */
+static tDataType OneMinusCos(const tDataType sin_th, const tDataType cos_th) {
+    return cos_th > static_cast<tDataType>(0.0) ? sin_th*sin_th/(static_cast<tDataType>(1.0)+cos_th) : static_cast<tDataType>(1.0)-cos_th;
+}
 
 /**
  * Adds two elements of the Algebra together
@@ -213,7 +431,7 @@ so3 operator - (const so3& u){return so3(data_ - u.data_);}
  * Performs Scalar multiplication and returns the result.
  * @param scalar The scalar that will scale the element of the Lie algebra
  */ 
-so3 operator * (const double scalar) const {return so3(scalar*data_);}
+so3 operator * (const tDataType scalar) const {return so3(scalar*data_);}
 
 /**
  * Prints the data of the element.
@@ -238,6 +456,19 @@ static Mat2d SSM(tDataType x);
  */ 
 static bool isElement(const Mat3d& data);
 
+private:
+
+/**
+ * Computes the exponential of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchExpKernel(const tDataType* const u[3], tDataType* const r[9], Eigen::Index i);
+
+/**
+ * Computes the logarithm of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchLogKernel(const tDataType* const r[9], tDataType* const u[3], Eigen::Index i);
 
 };
 
@@ -278,15 +509,12 @@ Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Ex
     Mat3d m;
     tDataType th = data.norm();
 
-    if (th < static_cast<tDataType>(kso3_threshold_)) { // See if the element is close to the identity element.
-        // m.setIdentity();
+    if (th < ScalarTraits<tDataType>::small_angle_threshold_) { // See if the element is close to the identity element.
         m = Mat3d::Identity()+ Wedge(data) + Wedge(data)*Wedge(data)/static_cast<tDataType>(2.0);
     } else {  // Use Rodriguez formula 
-        tDataType a = sin(th)/th;
-        tDataType b = (static_cast<tDataType>(1.0)-cos(th))/pow(th,2);
+        tDataType a = std::sin(th)/th;
+        tDataType b = OneMinusCos(th)/(th*th);
         m = Mat3d::Identity() + a*Wedge(data) + b*Wedge(data)*Wedge(data);
-        // std::cout << "here 2" << std::endl;
-
     }
     return m;
 
@@ -294,87 +522,374 @@ Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Ex
 
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
-Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Log(const Eigen::Matrix<tDataType,3,3>& data) {
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::ExpWithJl(const Eigen::Matrix<tDataType,3,1>& data, Eigen::Matrix<tDataType,3,3>& jl) {
+    tDataType th = data.norm();
+    return ExpWithJl(data,th,std::sin(th),std::cos(th),jl);
+}
 
-    Vec3d u;
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::ExpWithJl(const Eigen::Matrix<tDataType,3,1>& data, const tDataType th, const tDataType sin_th, const tDataType cos_th, Eigen::Matrix<tDataType,3,3>& jl) {
+    Mat3d m;
+    Mat3d W = Wedge(data);
+    Mat3d W2 = data*data.transpose() - th*th*Mat3d::Identity(); // Equivalent to W*W since W is skew symmetric
 
-    tDataType t = data.trace();
-    if ( (t-3.0) <= kso3_threshold_ && (t-3.0) >= - kso3_threshold_) { // Rotation matrix is close to identity
-    
-        Mat3d D = data - Mat3d::Identity();
-        u = so3<tDataType>::Vee( D - D*D/static_cast<tDataType>(2.0) + D*D*D/static_cast<tDataType>(3.0));
+    if (th < ScalarTraits<tDataType>::small_angle_threshold_) { // See if the element is close to the identity element.
+        m = Mat3d::Identity() + W + W2/static_cast<tDataType>(2.0);
+        jl = Mat3d::Identity() + W/static_cast<tDataType>(2.0) + W2/static_cast<tDataType>(6.0);
+    } else {  // Use Rodriguez formula 
+        tDataType th2 = th*th;
+        tDataType b = OneMinusCos(sin_th,cos_th)/th2;
+        m = Mat3d::Identity() + (sin_th/th)*W + b*W2;
+        jl = Mat3d::Identity() + b*W + ((th-sin_th)/(th2*th))*W2;
+    }
+    return m;
+}
 
-        // u.setZero();
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::ExpWithJr(const Eigen::Matrix<tDataType,3,1>& data, Eigen::Matrix<tDataType,3,3>& jr) {
+    // Since the wedge matrix is skew symmetric, Jr(v) = Jl(-v) = Jl(v)^T
+    Mat3d m = ExpWithJl(data,jr);
+    jr.transposeInPlace();
+    return m;
+}
 
-    } else { // Use Rodriguez formula 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Log(const Eigen::Matrix<tDataType,3,3>& data) {
+    tDataType th, sin_th, cos_th;
+    return Log(data,th,sin_th,cos_th);
+}
 
-        tDataType th = acos( (t-1.0)/2.0);
-        u = so3<tDataType>::Vee(th*(data-data.transpose())/(2.0*sin(th)));
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Log(const Eigen::Matrix<tDataType,3,3>& data, tDataType& th, tDataType& sin_th, tDataType& cos_th) {
+
+    const tDataType one = static_cast<tDataType>(1.0);
+    const tDataType two = static_cast<tDataType>(2.0);
+    const tDataType t = data.trace();
+
+    if (t > static_cast<tDataType>(-0.5)) {
+        // The vee of the skew symmetric part is 2*sin(th) times the axis and t-1 is 2*cos(th). The angle is the arc sine
+        // of the former for small angles and the arc cosine of the latter otherwise, so that neither is evaluated where
+        // it is ill conditioned. The axis is accurate as long as the sine is away from zero, here above 0.66.
+        const Vec3d d(data(2,1) - data(1,2), data(0,2) - data(2,0), data(1,0) - data(0,1));
+        const tDataType n2 = d.squaredNorm();
+        const tDataType n = std::sqrt(n2);
+        sin_th = n/two;
+        cos_th = (t - one)/two;
+        th = cos_th > static_cast<tDataType>(0.7) ? std::asin(sin_th) : std::acos(cos_th);
+
+        // th/n = th/(2*sin(th)), its series only avoids dividing by zero
+        if (n < ScalarTraits<tDataType>::small_angle_threshold_) {
+            return ((one + n2/static_cast<tDataType>(24.0))/two)*d;
+        }
+        return (th/n)*d;
     }
 
-    return u;    
+    // Close to pi the skew symmetric part vanishes and the axis is recovered from the diagonal with Shepperd's
+    // method. The vector part of the quaternion has a norm of at least 0.93.
+    const Vec4d q = Quaternion(data);
+    const Vec3d v = q.template head<3>();
+    const tDataType w = q(3);
+    const tDataType n2 = v.squaredNorm();
+    const tDataType n = std::sqrt(n2);
+    th = two*std::atan2(n, w);
+    const tDataType r2 = n2 + w*w;
+    sin_th = two*n*w/r2;
+    cos_th = (w*w - n2)/r2;
+    return (th/n)*v;
 }
 
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
-Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Jl() {
+Eigen::Matrix<tDataType,4,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Quaternion(const Eigen::Matrix<tDataType,3,3>& data) {
+
+    // Shepperd's method: a component of the quaternion of magnitude at least 1/2 is recovered from the diagonal and
+    // the others from the off-diagonal terms divided by it. The scalar part is used whenever it is large enough, which
+    // is the case up to an angle of 2pi/3, so that the common case takes a single branch.
+    const tDataType t = data.trace();
+    const tDataType one = static_cast<tDataType>(1.0);
+    Vec4d q;
+
+    if (t >= static_cast<tDataType>(0.0)) {
+        const tDataType r = std::sqrt(one + t);
+        const tDataType f = static_cast<tDataType>(0.5)/r;
+        q << (data(2,1) - data(1,2))*f, (data(0,2) - data(2,0))*f, (data(1,0) - data(0,1))*f, static_cast<tDataType>(0.5)*r;
+    } else if (data(0,0) >= data(1,1) && data(0,0) >= data(2,2)) {
+        const tDataType r = std::sqrt(one + data(0,0) - data(1,1) - data(2,2));
+        const tDataType f = static_cast<tDataType>(0.5)/r;
+        q << static_cast<tDataType>(0.5)*r, (data(0,1) + data(1,0))*f, (data(0,2) + data(2,0))*f, (data(2,1) - data(1,2))*f;
+    } else if (data(1,1) >= data(2,2)) {
+        const tDataType r = std::sqrt(one - data(0,0) + data(1,1) - data(2,2));
+        const tDataType f = static_cast<tDataType>(0.5)/r;
+        q << (data(0,1) + data(1,0))*f, static_cast<tDataType>(0.5)*r, (data(1,2) + data(2,1))*f, (data(0,2) - data(2,0))*f;
+    } else {
+        const tDataType r = std::sqrt(one - data(0,0) - data(1,1) + data(2,2));
+        const tDataType f = static_cast<tDataType>(0.5)/r;
+        q << (data(0,2) + data(2,0))*f, (data(1,2) + data(2,1))*f, static_cast<tDataType>(0.5)*r, (data(1,0) - data(0,1))*f;
+    }
 
-    Mat3d m;
-    
-    tDataType th = data_.norm();
+    // The quaternion with a non-negative scalar part gives an angle in [0,pi]
+    if (q(3) < static_cast<tDataType>(0.0)) {
+        q = -q;
+    }
+    return q;
+}
 
-    if (th < static_cast<tDataType>(kso3_threshold_)) { // See if the element is close to the identity element.
-        m = Mat3d::Identity() + this->Wedge()/static_cast<tDataType>(2.0) +this->Wedge()*this->Wedge()/static_cast<tDataType>(6.0);
-    } else {   
-        tDataType a = (static_cast<tDataType>(1.0)-cos(th))/pow(th,2);
-        tDataType b = (th-sin(th))/pow(th,3);
-        m = Mat3d::Identity() + a*this->Wedge() + b*this->Wedge()*this->Wedge();
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::JlInv(const Eigen::Matrix<tDataType,3,1>& data, const tDataType th, const tDataType sin_th, const tDataType cos_th) {
+
+    Mat3d m;
+    Mat3d W = Wedge(data);
+    Mat3d W2 = data*data.transpose() - th*th*Mat3d::Identity(); // Equivalent to W*W since W is skew symmetric
+
+    if (th < ScalarTraits<tDataType>::small_angle_threshold_) { // See if the element is close to the identity element.
+        m = Mat3d::Identity() - W/static_cast<tDataType>(2.0) + W2/static_cast<tDataType>(12.0);
+    } else {
+        // cot(th/2) = (1+cos(th))/sin(th) = sin(th)/(1-cos(th)). Use the form that doesn't suffer from cancellation.
+        tDataType cot = cos_th >= 0 ? (static_cast<tDataType>(1.0)+cos_th)/sin_th : sin_th/(static_cast<tDataType>(1.0)-cos_th);
+        tDataType b = -(th*cot-static_cast<tDataType>(2.0))/(static_cast<tDataType>(2.0)*th*th);
+        m = Mat3d::Identity() - W/static_cast<tDataType>(2.0) + b*W2;
     }
 
     return m;
 }
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::LogWithJlInv(const Eigen::Matrix<tDataType,3,3>& data, Eigen::Matrix<tDataType,3,3>& jl_inv) {
+    tDataType th, sin_th, cos_th;
+    Vec3d u = Log(data,th,sin_th,cos_th);
+    jl_inv = JlInv(u,th,sin_th,cos_th);
+    return u;
+}
 
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
-Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::JlInv() {
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::LogWithJrInv(const Eigen::Matrix<tDataType,3,3>& data, Eigen::Matrix<tDataType,3,3>& jr_inv) {
+    // Since the wedge matrix is skew symmetric, JrInv(v) = JlInv(-v) = JlInv(v)^T
+    Vec3d u = LogWithJlInv(data,jr_inv);
+    jr_inv.transposeInPlace();
+    return u;
+}
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void so3<tDataType,tNumDimensions,tNumTangentSpaces>::BatchExp(const tDataType* const u[3], tDataType* const r[9], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
 
-    Mat3d m;
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchExpKernel<Packet>(u,r,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchExpKernel<tDataType>(u,r,ii);
+    }
+}
 
-    tDataType th = data_.norm();
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void so3<tDataType,tNumDimensions,tNumTangentSpaces>::BatchExpKernel(const tDataType* const u[3], tDataType* const r[9], Eigen::Index i) {
+    namespace ei = Eigen::internal;
+    using batch_math::Set;
+    using batch_math::Madd;
+
+    const tPacket x = ei::ploadu<tPacket>(u[0]+i);
+    const tPacket y = ei::ploadu<tPacket>(u[1]+i);
+    const tPacket z = ei::ploadu<tPacket>(u[2]+i);
+    const tPacket th2 = Madd(x,x,Madd(y,y,ei::pmul(z,z)));
+    const tPacket th = ei::psqrt(th2);
+    const tPacket small = ei::pcmp_lt(th, Set<tPacket>(static_cast<tDataType>(kso3_batch_threshold_)));
+
+    // Rodriguez formula with a = sin(th)/th and b = (1-cos(th))/th^2 computed from the half angle to avoid cancellation.
+    tPacket s2, c2;
+    batch_math::SinCos(ei::pmul(th, Set<tPacket>(static_cast<tDataType>(0.5))), s2, c2);
+    const tPacket th_inv = ei::pdiv(Set<tPacket>(static_cast<tDataType>(1.0)), ei::pselect(small, Set<tPacket>(static_cast<tDataType>(1.0)), th));
+    const tPacket two_s2 = ei::padd(s2,s2);
+    const tPacket a_rod = ei::pmul(ei::pmul(two_s2,c2),th_inv);
+    const tPacket b_rod = ei::pmul(ei::pmul(two_s2,s2),ei::pmul(th_inv,th_inv));
+
+    // Taylor series close to the identity
+    const tPacket a_tay = Madd(th2, Madd(th2, Set<tPacket>(static_cast<tDataType>(1.0/120.0)), Set<tPacket>(static_cast<tDataType>(-1.0/6.0))), Set<tPacket>(static_cast<tDataType>(1.0)));
+    const tPacket b_tay = Madd(th2, Madd(th2, Set<tPacket>(static_cast<tDataType>(1.0/720.0)), Set<tPacket>(static_cast<tDataType>(-1.0/24.0))), Set<tPacket>(static_cast<tDataType>(0.5)));
+
+    const tPacket a = ei::pselect(small, a_tay, a_rod);
+    const tPacket b = ei::pselect(small, b_tay, b_rod);
+
+    // R = I + a*W + b*W^2 with W^2 = u*u^T - th^2*I
+    const tPacket one = Set<tPacket>(static_cast<tDataType>(1.0));
+    const tPacket ax = ei::pmul(a,x), ay = ei::pmul(a,y), az = ei::pmul(a,z);
+    const tPacket bxy = ei::pmul(b,ei::pmul(x,y)), bxz = ei::pmul(b,ei::pmul(x,z)), byz = ei::pmul(b,ei::pmul(y,z));
+    ei::pstoreu(r[0]+i, Madd(b, ei::psub(ei::pmul(x,x),th2), one));
+    ei::pstoreu(r[1]+i, ei::padd(bxy,az));
+    ei::pstoreu(r[2]+i, ei::psub(bxz,ay));
+    ei::pstoreu(r[3]+i, ei::psub(bxy,az));
+    ei::pstoreu(r[4]+i, Madd(b, ei::psub(ei::pmul(y,y),th2), one));
+    ei::pstoreu(r[5]+i, ei::padd(byz,ax));
+    ei::pstoreu(r[6]+i, ei::padd(bxz,ay));
+    ei::pstoreu(r[7]+i, ei::psub(byz,ax));
+    ei::pstoreu(r[8]+i, Madd(b, ei::psub(ei::pmul(z,z),th2), one));
+}
 
-    if (th < kso3_threshold_ || sin(th/2.0) < kso3_threshold_) { // See if the element is close to the identity element.
-        m = Mat3d::Identity() + this->Wedge()/static_cast<tDataType>(2.0);
-    } else {   
-        tDataType a = static_cast<tDataType>(-0.5);
-        tDataType cot = cos(th/2.0)/sin(th/2.0);
-        tDataType b = -(th*cot-2.0)/(2.0*pow(th,2));
-        m = Mat3d::Identity() + a*this->Wedge() + b*this->Wedge()*this->Wedge();
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void so3<tDataType,tNumDimensions,tNumTangentSpaces>::BatchLog(const tDataType* const r[9], tDataType* const u[3], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchLogKernel<Packet>(r,u,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchLogKernel<tDataType>(r,u,ii);
     }
+}
 
-    return m;
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void so3<tDataType,tNumDimensions,tNumTangentSpaces>::BatchLogKernel(const tDataType* const r[9], tDataType* const u[3], Eigen::Index i) {
+    namespace ei = Eigen::internal;
+    using batch_math::Set;
+    using batch_math::Madd;
+
+    const tPacket half = Set<tPacket>(static_cast<tDataType>(0.5));
+
+    // sin(th) times the axis is the vee of the skew symmetric part and cos(th) follows from the trace
+    const tPacket wx = ei::pmul(half, ei::psub(ei::ploadu<tPacket>(r[5]+i), ei::ploadu<tPacket>(r[7]+i)));
+    const tPacket wy = ei::pmul(half, ei::psub(ei::ploadu<tPacket>(r[6]+i), ei::ploadu<tPacket>(r[2]+i)));
+    const tPacket wz = ei::pmul(half, ei::psub(ei::ploadu<tPacket>(r[1]+i), ei::ploadu<tPacket>(r[3]+i)));
+    const tPacket trace = ei::padd(ei::ploadu<tPacket>(r[0]+i), ei::padd(ei::ploadu<tPacket>(r[4]+i), ei::ploadu<tPacket>(r[8]+i)));
+    const tPacket c = ei::pmul(half, ei::psub(trace, Set<tPacket>(static_cast<tDataType>(1.0))));
+    const tPacket s2 = Madd(wx,wx,Madd(wy,wy,ei::pmul(wz,wz)));
+    const tPacket s = ei::psqrt(s2);
+    const tPacket th = batch_math::Atan2(s,c);
+
+    // The result is th/sin(th) times the vee of the skew symmetric part. Close to the identity
+    // th/sin(th) = asin(s)/s is replaced by its Taylor series.
+    const tPacket small = ei::pand(ei::pcmp_lt(s, Set<tPacket>(static_cast<tDataType>(kso3_batch_threshold_))), ei::pcmp_lt(Set<tPacket>(static_cast<tDataType>(0.0)), c));
+    const tPacket f_tay = Madd(s2, Madd(s2, Set<tPacket>(static_cast<tDataType>(3.0/40.0)), Set<tPacket>(static_cast<tDataType>(1.0/6.0))), Set<tPacket>(static_cast<tDataType>(1.0)));
+    const tPacket f_rod = ei::pdiv(th, ei::pmax(s, Set<tPacket>(std::numeric_limits<tDataType>::min())));
+    const tPacket f = ei::pselect(small, f_tay, f_rod);
+
+    ei::pstoreu(u[0]+i, ei::pmul(f,wx));
+    ei::pstoreu(u[1]+i, ei::pmul(f,wy));
+    ei::pstoreu(u[2]+i, ei::pmul(f,wz));
 }
 
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
-Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Jr() {
+void so3<tDataType,tNumDimensions,tNumTangentSpaces>::JlCoefficients(const tDataType th, tDataType& a, tDataType& b) {
+
+    // 1-cos(th) = 2*sin(th/2)^2 avoids the cancellation so a only needs a series to avoid dividing by zero. The
+    // closed form of b loses about eps/th^2 to cancellation so it is replaced by its Taylor series over a range
+    // that grows with the machine epsilon.
+    const tDataType th2 = th*th;
+    if (th < ScalarTraits<tDataType>::small_angle_threshold_) {
+        a = static_cast<tDataType>(1.0/2.0) - th2*static_cast<tDataType>(1.0/24.0);
+    } else {
+        a = OneMinusCos(th)/th2;
+    }
+    if (th < ScalarTraits<tDataType>::series_threshold_) {
+        b = static_cast<tDataType>(1.0/6.0) - th2*(static_cast<tDataType>(1.0/120.0) - th2*static_cast<tDataType>(1.0/5040.0));
+    } else {
+        b = (th - std::sin(th))/(th2*th);
+    }
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+tDataType so3<tDataType,tNumDimensions,tNumTangentSpaces>::JlInvCoefficient(const tDataType th) {
+
+    const tDataType th2 = th*th;
+    if (th < ScalarTraits<tDataType>::series_threshold_) {
+        return static_cast<tDataType>(1.0/12.0) + th2*(static_cast<tDataType>(1.0/720.0) + th2*static_cast<tDataType>(1.0/30240.0));
+    } else {
+        const tDataType half_th = th/static_cast<tDataType>(2.0);
+        return (static_cast<tDataType>(1.0) - half_th*std::cos(half_th)/std::sin(half_th))/th2;
+    }
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyJl(const Vec3d& data, const Vec3d& v) {
+    tDataType a, b;
+    JlCoefficients(data.norm(),a,b);
+    const Vec3d wv = data.cross(v);
+    return v + a*wv + b*data.cross(wv);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyJr(const Vec3d& data, const Vec3d& v) {
+    tDataType a, b;
+    JlCoefficients(data.norm(),a,b);
+    const Vec3d wv = data.cross(v);
+    return v - a*wv + b*data.cross(wv);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyJlInv(const Vec3d& data, const Vec3d& v) {
+    const tDataType c = JlInvCoefficient(data.norm());
+    const Vec3d wv = data.cross(v);
+    return v - wv/static_cast<tDataType>(2.0) + c*data.cross(wv);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::ApplyJrInv(const Vec3d& data, const Vec3d& v) {
+    const tDataType c = JlInvCoefficient(data.norm());
+    const Vec3d wv = data.cross(v);
+    return v + wv/static_cast<tDataType>(2.0) + c*data.cross(wv);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Jl() {
+
+    tDataType a, b;
+    JlCoefficients(data_.norm(),a,b);
+    const Mat3d W = this->Wedge();
+    return Mat3d::Identity() + a*W + b*W*W;
+}
+
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::JlInv() {
+
 
     Mat3d m;
-    
+
     tDataType th = data_.norm();
 
-    if (th < kso3_threshold_) { // See if the element is close to the identity element.
+    if (th > ScalarTraits<tDataType>::series_threshold_ && std::sin(th/static_cast<tDataType>(2.0)) < ScalarTraits<tDataType>::small_angle_threshold_) { // Close to 2 pi where the Jacobian isn't invertible.
         m = Mat3d::Identity() - this->Wedge()/static_cast<tDataType>(2.0);
     } else {   
-        tDataType a = (cos(th)-1.0)/pow(th,2);
-        tDataType b = (th-sin(th))/pow(th,3);
-        m = Mat3d::Identity() + a*this->Wedge() + b*this->Wedge()*this->Wedge();
+        const Mat3d W = this->Wedge();
+        m = Mat3d::Identity() - W/static_cast<tDataType>(2.0) + JlInvCoefficient(th)*W*W;
     }
 
     return m;
 }
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Jr() {
+
+    tDataType a, b;
+    JlCoefficients(data_.norm(),a,b);
+    const Mat3d W = this->Wedge();
+    return Mat3d::Identity() - a*W + b*W*W;
+}
+
 
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
@@ -384,25 +899,87 @@ Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Jr
 
     tDataType th = data_.norm();
 
-    if (th < kso3_threshold_ || sin(th/2) < kso3_threshold_) { // See if the element is close to the identity element.
+    if (th > ScalarTraits<tDataType>::series_threshold_ && std::sin(th/static_cast<tDataType>(2.0)) < ScalarTraits<tDataType>::small_angle_threshold_) { // Close to 2 pi where the Jacobian isn't invertible.
         m = Mat3d::Identity() + this->Wedge()/static_cast<tDataType>(2.0);
     } else {   
-        tDataType a = 0.5;
-        tDataType cot = cos(th/2.0)/sin(th/2.0);
-        tDataType b = -(th*cot-2.0)/(2.0*pow(th,2));
-        m = Mat3d::Identity() + a*this->Wedge() + b*this->Wedge()*this->Wedge();
+        const Mat3d W = this->Wedge();
+        m = Mat3d::Identity() + W/static_cast<tDataType>(2.0) + JlInvCoefficient(th)*W*W;
     }
 
     return m;
 }
 
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::Cayley(const Eigen::Matrix<tDataType,3,1>& data) {
+    const Mat3d W = Wedge(data);
+    const tDataType c = static_cast<tDataType>(4.0)/(static_cast<tDataType>(4.0) + data.squaredNorm());
+    return Mat3d::Identity() + c*(W + W*W/static_cast<tDataType>(2.0));
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyInv(const Eigen::Matrix<tDataType,3,3>& data) {
+    const Vec3d d(data(2,1) - data(1,2), data(0,2) - data(2,0), data(1,0) - data(0,1));
+    return static_cast<tDataType>(2.0)/(static_cast<tDataType>(1.0) + data.trace())*d;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyJr(const Eigen::Matrix<tDataType,3,1>& data) {
+    const tDataType c = static_cast<tDataType>(4.0)/(static_cast<tDataType>(4.0) + data.squaredNorm());
+    return c*(Mat3d::Identity() - Wedge(data)/static_cast<tDataType>(2.0));
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::CayleyJrInv(const Eigen::Matrix<tDataType,3,1>& data) {
+    return Mat3d::Identity() + Wedge(data)/static_cast<tDataType>(2.0) + data*data.transpose()/static_cast<tDataType>(4.0);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrder(const Eigen::Matrix<tDataType,3,1>& data) {
+    // The polar factor of I + W rotates by arctan(th), whose cosine is 1/r and sine th/r. The coefficient of W^2,
+    // (1-1/r)/th^2, is written without the cancellation.
+    const Mat3d W = Wedge(data);
+    const tDataType r = std::sqrt(static_cast<tDataType>(1.0) + data.squaredNorm());
+    return Mat3d::Identity() + W/r + W*W/(r*(r + static_cast<tDataType>(1.0)));
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrderInv(const Eigen::Matrix<tDataType,3,3>& data) {
+    const Vec3d d(data(2,1) - data(1,2), data(0,2) - data(2,0), data(1,0) - data(0,1));
+    return d/(data.trace() - static_cast<tDataType>(1.0));
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrderJr(const Eigen::Matrix<tDataType,3,1>& data) {
+    const Mat3d W = Wedge(data);
+    const tDataType r2 = static_cast<tDataType>(1.0) + data.squaredNorm();
+    const tDataType r = std::sqrt(r2);
+    const tDataType r_1 = r + static_cast<tDataType>(1.0);
+    return Mat3d::Identity()/r2 - W/(r*r_1) - W*W/(r2*r_1);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,3> so3<tDataType,tNumDimensions,tNumTangentSpaces>::FirstOrderJrInv(const Eigen::Matrix<tDataType,3,1>& data) {
+    const Mat3d W = Wedge(data);
+    const tDataType r2 = static_cast<tDataType>(1.0) + data.squaredNorm();
+    const tDataType r = std::sqrt(r2);
+    return r2*Mat3d::Identity() + W/static_cast<tDataType>(2.0) + (static_cast<tDataType>(2.0)*r + static_cast<tDataType>(1.0))/(static_cast<tDataType>(2.0)*(r + static_cast<tDataType>(1.0)))*W*W;
+}
+
 //---------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 bool so3<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Eigen::Matrix<tDataType,3,3>& data) {
 
     bool is_element = true;
      
-    if ( (data.transpose()+data).norm()/static_cast<tDataType>(2.0) >= kso3_threshold_) {
+    if ( (data.transpose()+data).norm()/static_cast<tDataType>(2.0) >= ScalarTraits<tDataType>::algebra_threshold_) {
         is_element = false;
     }
 
@@ -0,0 +1,255 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEALGEBRAS_SO3Q_
+#define _LIEGROUPS_INCLUDE_LIEALGEBRAS_SO3Q_
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <iostream>
+#include "lie_groups/lie_algebras/so3.h"
+
+namespace lie_groups {
+
+constexpr double kso3q_threshold_=1e-7; /** < Below this angle the exponential and logarithm use Taylor series to avoid dividing by zero.*/
+
+/**
+ * The Lie algebra \f$so(3)\f$ whose exponential and logarithm map to and from unit quaternions instead of
+ * rotation matrices. It is the Lie algebra of SO3Quat. The Cartesian space, the wedge and vee maps and the Jacobians
+ * are the ones of so3. The quaternions are stored as the vector \f$ (x,y,z,w) \f$, the order of the coefficients
+ * of Eigen::Quaternion.
+ */
+template <typename tDataType=double, int tNumDimensions=3, int tNumTangentSpaces=1>
+class so3q : public so3<tDataType,tNumDimensions,tNumTangentSpaces> {
+
+public:
+
+typedef so3<tDataType,tNumDimensions,tNumTangentSpaces> Base;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
+typedef Eigen::Matrix<tDataType,3,3> Mat3d;
+
+using Base::data_;
+
+/**
+ * Default constructor. Initializes algebra element to identity.
+ */
+so3q() = default;
+
+/**
+* Initializes algebra element to the one given.
+* @param[in] data The data of an element of Cartesian space of \f$so(3)\f$
+*/
+so3q(const Vec3d data) : Base(data) {}
+
+/**
+* Initializes algebra element to the one given. If verify is set to true,
+* it will verify that the element provided is an element of the Lie algebra.
+* @param[in] data The data of an element of \f$so(3)\f$
+* @param verify If true, the constructor will verify that the element given is an element of the Lie algebra.
+*/
+so3q(const Mat3d & data, bool verify) : Base(data,verify) {}
+
+/**
+* Initializes algebra element to the element of so3 given.
+* @param[in] u An element of so3.
+*/
+so3q(const Base& u) : Base(u) {}
+
+/**
+ * Computes the exponential of the element of the Lie algebra.
+ * @return The unit quaternion of the group element.
+ */
+Vec4d Exp(){ return Exp(data_);}
+
+/**
+ * Computes the exponential of the element of the Lie algebra, \f$ (\sin(\theta/2) w/\theta, \cos(\theta/2)) \f$.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @return The unit quaternion of the group element.
+ */
+static Vec4d Exp(const Vec3d& data);
+
+/**
+ * Computes the logarithm of a unit quaternion. The angle is recovered with a four quadrant arc tangent of
+ * the norms of the vector and scalar parts, which is accurate for every angle. The quaternions q and -q
+ * are the same rotation and the result is the one with an angle in \f$ [0,\pi] \f$.
+ * @param data The unit quaternion of an element of \f$ SO(3) \f$
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d Log(const Vec4d& data);
+
+/**
+ * Computes the exponential and the left Jacobian of the element of the Lie algebra.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jl The left Jacobian evaluated at data
+ * @return The unit quaternion of the group element.
+ */
+static Vec4d ExpWithJl(const Vec3d& data, Mat3d& jl);
+
+/**
+ * Computes the exponential and the right Jacobian of the element of the Lie algebra.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ * @param jr The right Jacobian evaluated at data
+ * @return The unit quaternion of the group element.
+ */
+static Vec4d ExpWithJr(const Vec3d& data, Mat3d& jr);
+
+/**
+ * Computes the logarithm and the left Jacobian inverse evaluated at the logarithm.
+ * @param data The unit quaternion of an element of \f$ SO(3) \f$
+ * @param jl_inv The left Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d LogWithJlInv(const Vec4d& data, Mat3d& jl_inv);
+
+/**
+ * Computes the logarithm and the right Jacobian inverse evaluated at the logarithm.
+ * @param data The unit quaternion of an element of \f$ SO(3) \f$
+ * @param jr_inv The right Jacobian inverse evaluated at the result
+ * @return The data of an element of the Cartesian space associated with the Lie algebra
+ */
+static Vec3d LogWithJrInv(const Vec4d& data, Mat3d& jr_inv);
+
+/**
+ * Computes the quaternion of the Cayley map, \f$ (u/2, 1) \f$ normalized. See so3::Cayley. Its Jacobians are the ones of so3.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Vec4d Cayley(const Vec3d& data) {
+    Vec4d q;
+    q << data/static_cast<tDataType>(2.0), static_cast<tDataType>(1.0);
+    return q/std::sqrt(static_cast<tDataType>(1.0) + data.squaredNorm()/static_cast<tDataType>(4.0));
+}
+
+/**
+ * Computes the inverse of the Cayley map, \f$ 2v/w \f$ for the quaternion \f$ (v,w) \f$.
+ * @param data The unit quaternion of an element of \f$ SO(3) \f$
+ */
+static Vec3d CayleyInv(const Vec4d& data) {return static_cast<tDataType>(2.0)/data(3)*data.template head<3>();}
+
+/**
+ * Computes the quaternion of so3::FirstOrder, \f$ (u, 1+\sqrt{1+\theta^2}) \f$ normalized.
+ * @param data The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+static Vec4d FirstOrder(const Vec3d& data) {
+    Vec4d q;
+    q << data, static_cast<tDataType>(1.0) + std::sqrt(static_cast<tDataType>(1.0) + data.squaredNorm());
+    return q.normalized();
+}
+
+/**
+ * Computes the inverse of FirstOrder, \f$ 2wv/(w^2 - |v|^2) \f$ for the quaternion \f$ (v,w) \f$.
+ * @param data The unit quaternion of an element of \f$ SO(3) \f$
+ */
+static Vec3d FirstOrderInv(const Vec4d& data) {
+    const Vec3d v = data.template head<3>();
+    return static_cast<tDataType>(2.0)*data(3)/(data(3)*data(3) - v.squaredNorm())*v;
+}
+
+/**
+ * Adds two elements of the Algebra together
+ * @param u An element of the Lie algebra.
+ */
+so3q operator + (const so3q& u){return so3q(Vec3d(data_ + u.data_));}
+
+/**
+ * Subtracts two elements of the Algebra together
+ * @param u An element of the Lie algebra.
+ */
+so3q operator - (const so3q& u){return so3q(Vec3d(data_ - u.data_));}
+
+/**
+ * Performs Scalar multiplication and returns the result.
+ * @param scalar The scalar that will scale the element of the Lie algebra
+ */
+so3q operator * (const tDataType scalar) const {return so3q(Vec3d(scalar*data_));}
+
+/**
+ * Returns the Identity element.
+ */
+static so3q Identity(){return so3q();}
+
+private:
+
+// The batch kernels of so3 write rotation matrices, not quaternions, so they are hidden and GroupArray computes
+// Exp and Log one element at a time.
+using Base::BatchExp;
+using Base::BatchLog;
+
+};
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                    Definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,4,1> so3q<tDataType,tNumDimensions,tNumTangentSpaces>::Exp(const Eigen::Matrix<tDataType,3,1>& data) {
+    Vec4d q;
+    const tDataType th = data.norm();
+    // sin(th/2)/th
+    tDataType s;
+    if (th < static_cast<tDataType>(kso3q_threshold_)) {
+        s = static_cast<tDataType>(0.5) - th*th/static_cast<tDataType>(48.0);
+    } else {
+        s = std::sin(th/static_cast<tDataType>(2.0))/th;
+    }
+    q.template head<3>() = s*data;
+    q(3) = std::cos(th/static_cast<tDataType>(2.0));
+    return q;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3q<tDataType,tNumDimensions,tNumTangentSpaces>::Log(const Eigen::Matrix<tDataType,4,1>& data) {
+    // Use the quaternion with a non-negative scalar part so that the angle is in [0,pi]
+    const tDataType w = data(3) < static_cast<tDataType>(0) ? -data(3) : data(3);
+    const Vec3d v = data(3) < static_cast<tDataType>(0) ? Vec3d(-data.template head<3>()) : Vec3d(data.template head<3>());
+    const tDataType n = v.norm();
+    // th/n with th = 2 atan2(n,w)
+    tDataType s;
+    if (n < static_cast<tDataType>(kso3q_threshold_)) {
+        s = static_cast<tDataType>(2.0)/w*(static_cast<tDataType>(1.0) - n*n/(static_cast<tDataType>(3.0)*w*w));
+    } else {
+        s = static_cast<tDataType>(2.0)*std::atan2(n,w)/n;
+    }
+    return s*v;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,4,1> so3q<tDataType,tNumDimensions,tNumTangentSpaces>::ExpWithJl(const Eigen::Matrix<tDataType,3,1>& data, Eigen::Matrix<tDataType,3,3>& jl) {
+    tDataType a, b;
+    Base::JlCoefficients(data.norm(),a,b);
+    const Mat3d W = Base::Wedge(data);
+    jl = Mat3d::Identity() + a*W + b*W*W;
+    return Exp(data);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,4,1> so3q<tDataType,tNumDimensions,tNumTangentSpaces>::ExpWithJr(const Eigen::Matrix<tDataType,3,1>& data, Eigen::Matrix<tDataType,3,3>& jr) {
+    tDataType a, b;
+    Base::JlCoefficients(data.norm(),a,b);
+    const Mat3d W = Base::Wedge(data);
+    jr = Mat3d::Identity() - a*W + b*W*W;
+    return Exp(data);
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3q<tDataType,tNumDimensions,tNumTangentSpaces>::LogWithJlInv(const Eigen::Matrix<tDataType,4,1>& data, Eigen::Matrix<tDataType,3,3>& jl_inv) {
+    const Vec3d u = Log(data);
+    const Mat3d W = Base::Wedge(u);
+    jl_inv = Mat3d::Identity() - W/static_cast<tDataType>(2.0) + Base::JlInvCoefficient(u.norm())*W*W;
+    return u;
+}
+
+//---------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,3,1> so3q<tDataType,tNumDimensions,tNumTangentSpaces>::LogWithJrInv(const Eigen::Matrix<tDataType,4,1>& data, Eigen::Matrix<tDataType,3,3>& jr_inv) {
+    const Vec3d u = Log(data);
+    const Mat3d W = Base::Wedge(u);
+    jr_inv = Mat3d::Identity() + W/static_cast<tDataType>(2.0) + Base::JlInvCoefficient(u.norm())*W*W;
+    return u;
+}
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEALGEBRAS_SO3Q_
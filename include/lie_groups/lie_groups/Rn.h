@@ -47,22 +47,22 @@ Rn() : data_(MatNd::Zero()) {}
 /**
  * Copy constructor.
  */ 
-Rn(const Rn & g) : data_(g.data_) {}
+Rn(const Rn & g) = default;
 
 /**
  * Copy assignment
  */ 
-void operator = (const Rn& g){ this->data_ = g.data_; }
+Rn& operator = (const Rn& g) = default;
 
 /**
  * Move constructor.
  */ 
-Rn(const Rn && g) : data_(g.data_) {}
+Rn(Rn && g) = default;
 
 /**
  * Move assignment
  */ 
-void operator = (const Rn&& g){ this->data_ = g.data_; }
+Rn& operator = (Rn&& g) = default;
 
 /**
 * Initializes group element to the one given. If verify is true
@@ -144,6 +144,19 @@ Rn BoxPlus(const Algebra& u) const
  */ 
 Algebra BoxMinus(const Rn& g) const { return Algebra( Algebra::Vee(BoxMinus(g.data_)));}
 
+/**
+ * Projects the data of an element that drifted away from the group after many compositions back onto it. It returns the data.
+ * @param data The data of the element.
+ * @tparam tNormalization The policy that projects the rotation, see normalization.h.
+ */
+template <typename tNormalization = PolarNormalization>
+static MatNd Normalize(const MatNd& data) {return data;}
+
+/**
+ * Computes how far the data of an element drifted away from the group, which is always zero.
+ */
+static tDataType Drift(const MatNd&) {return static_cast<tDataType>(0.0);}
+
 /**
  * Verifies that the data of an element properly corresponds to the set. 
  */ 
@@ -17,7 +17,7 @@ constexpr double kSE2_threshold_ = 1e-6;
 template <typename tDataType=double, int tNumDimensions=3, int tNumTangentSpaces=1>
 class SE2 : public GroupBase<SE2<tDataType,tNumDimensions,tNumTangentSpaces>,se2<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,3,3>, Eigen::Matrix<tDataType,3,3>, Eigen::Matrix<tDataType,3,1>, tDataType>{
 
-static_assert(tNumTangentSpaces == 1, "lie_groups::SE2 the number of tangent spaces must be 1.");
+static_assert(tNumTangentSpaces > 0, "lie_groups::SE2 the number of tangent spaces must be greater than 0.");
 
 
 public:
@@ -42,36 +42,50 @@ typedef SO2<tDataType> RotGroup;
 using Base::BoxPlus;
 using Base::BoxMinus;
 
+typedef Eigen::Matrix<tDataType,2,1> Point;  /** < A point the group acts on. */
+typedef Eigen::Matrix<tDataType,2,3> ActJacobian;  /** < The Jacobian of the group action with respect to the element. */
+
 
 Mat3d data_;
-Eigen::Map<Vec2d> t_;  /** < The position */
-Eigen::Ref<Mat2d> R_; /** < The rotation */
+
+/**
+ * Returns a view of the position. The view is computed on demand so that 
+ * the element doesn't store pointers into its own data.
+ */ 
+Eigen::Block<Mat3d,2,1> t() { return data_.template block<2,1>(0,2); }
+Eigen::Block<const Mat3d,2,1> t() const { return data_.template block<2,1>(0,2); }
+
+/**
+ * Returns a view of the rotation. 
+ */ 
+Eigen::Block<Mat3d,2,2> R() { return data_.template block<2,2>(0,0); }
+Eigen::Block<const Mat3d,2,2> R() const { return data_.template block<2,2>(0,0); }
 
 /**
  * Default constructor. Initializes group element to identity.
  */
-SE2() : t_(data_.data()+6), R_(data_.block(0,0,2,2)), data_(Mat3d::Identity() ) {}
+SE2() : data_(Mat3d::Identity() ) {}
 
 
 /**
  * Copy constructor.
  */ 
-SE2(const SE2 & g) : t_(data_.data()+6), R_(data_.block(0,0,2,2)), data_(g.data_) {}
+SE2(const SE2 & g) = default;
 
 /**
  * Copy assignment
  */ 
-void operator = (const SE2& g){ this->data_ = g.data_; }
+SE2& operator = (const SE2& g) = default;
 
 /**
  * Move constructor.
  */ 
-SE2(const SE2 && g) : t_(data_.data()+6), R_(data_.block(0,0,2,2)), data_(g.data_) {}
+SE2(SE2 && g) = default;
 
 /**
  * Move assignment
  */ 
-void operator = (const SE2&& g){ this->data_ = g.data_; }
+SE2& operator = (SE2&& g) = default;
 
 /**
 * Initializes group element to the one given. If verify is true
@@ -86,7 +100,7 @@ SE2(const Mat3d & data, bool verify);
 * Initializes group element to the data of the one given. 
 * @param[in] data  The data pertaining to an element of \f$SE(2)\f$
 */
-SE2(const Mat3d & data) :data_(data), t_(data_.data()+6), R_(data_.block(0,0,2,2)){}
+SE2(const Mat3d & data) :data_(data) {}
 
 /*
  * Returns the inverse of the element
@@ -95,10 +109,15 @@ SE2 Inverse() const { return SE2::Inverse(this->data_);}
 
 
 /*
- * Returns the inverse of the data of an element
+ * Returns the inverse of the data of an element. The structure of the element
+ * is used so that the inverse is \f$ [R^\top, -R^\top t; 0, 1] \f$
  */ 
 static Mat3d Inverse(const Mat3d& data){  
-    return data.inverse();}
+    Mat3d m;
+    m.template block<2,2>(0,0) = data.template block<2,2>(0,0).transpose();
+    m.template block<2,1>(0,2) = -m.template block<2,2>(0,0)*data.template block<2,1>(0,2);
+    m.template block<1,3>(2,0) << static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(1.0);
+    return m;}
 
 /**
  * Returns the identity element
@@ -111,16 +130,176 @@ static SE2 Identity(){return SE2();}
  */ 
 Mat3d Adjoint(){
     Mat3d m = data_;
-    m.block(0,2,2,1) << t_(1), -t_(0);
+    m.block(0,2,2,1) << t()(1), -t()(0);
     return m;
 }
 
 
+/**
+ * Applies the adjoint map of the element to v without forming the matrix.
+ * @param v The data of an element of the Cartesian space.
+ */
+Vec3d AdjointAct(const Vec3d& v) const {return AdjointAct(data_,v);}
+
+/**
+ * Applies the adjoint map of the inverse of the element to v without forming the matrix.
+ * @param v The data of an element of the Cartesian space.
+ */
+Vec3d AdjointInvAct(const Vec3d& v) const {return AdjointInvAct(data_,v);}
+
+/**
+ * Transforms a covariance with the adjoint map of the element, \f$ Ad P Ad^\top \f$, without forming the matrix.
+ * @param cov A symmetric covariance of an element of the Cartesian space.
+ */
+Mat3d AdjointTransformCovariance(const Mat3d& cov) const {return AdjointTransformCovariance(data_,cov);}
+
+/**
+ * Applies the adjoint map of the data of an element to v. Since \f$ Ad = \begin{bmatrix} R & a \\ 0 & 1 \end{bmatrix} \f$
+ * with \f$ a = [t_y, -t_x]^\top \f$, the result is \f$ [R v_p + v_\theta a;\ v_\theta] \f$.
+ * @param data The data of an element of the group.
+ * @param v The data of an element of the Cartesian space.
+ */
+static Vec3d AdjointAct(const Mat3d& data, const Vec3d& v) {
+    Vec3d out;
+    out.template block<2,1>(0,0) = data.template block<2,2>(0,0)*v.template block<2,1>(0,0) + v(2)*Vec2d(data(1,2),-data(0,2));
+    out(2) = v(2);
+    return out;
+}
+
+/**
+ * Applies the adjoint map of the inverse of the data of an element to v. The result is
+ * \f$ [R^\top (v_p - v_\theta a);\ v_\theta] \f$.
+ * @param data The data of an element of the group.
+ * @param v The data of an element of the Cartesian space.
+ */
+static Vec3d AdjointInvAct(const Mat3d& data, const Vec3d& v) {
+    Vec3d out;
+    out.template block<2,1>(0,0) = data.template block<2,2>(0,0).transpose()*(v.template block<2,1>(0,0) - v(2)*Vec2d(data(1,2),-data(0,2)));
+    out(2) = v(2);
+    return out;
+}
+
+/**
+ * Transforms a covariance with the adjoint map of the data of an element, \f$ Ad P Ad^\top \f$. With
+ * \f$ P = \begin{bmatrix} A & b \\ b^\top & c \end{bmatrix} \f$ the result is
+ * \f$ \begin{bmatrix} R A R^\top + R b a^\top + a b^\top R^\top + c a a^\top & R b + c a \\ (R b + c a)^\top & c \end{bmatrix} \f$.
+ * @param data The data of an element of the group.
+ * @param cov A symmetric covariance of an element of the Cartesian space.
+ */
+static Mat3d AdjointTransformCovariance(const Mat3d& data, const Mat3d& cov) {
+    const Mat2d R = data.template block<2,2>(0,0);
+    const Vec2d a(data(1,2),-data(0,2));
+    const Vec2d rb = R*cov.template block<2,1>(0,2);
+    const Vec2d off_diagonal = rb + cov(2,2)*a;
+    Mat3d m;
+    m.template block<2,2>(0,0) = R*cov.template block<2,2>(0,0)*R.transpose() + rb*a.transpose() + a*off_diagonal.transpose();
+    m.template block<2,1>(0,2) = off_diagonal;
+    m.template block<1,2>(2,0) = off_diagonal.transpose();
+    m(2,2) = cov(2,2);
+    return m;
+}
+
+/**
+ * Applies the adjoint map of n elements to n vectors at once. The data is given as a structure of arrays:
+ * g[k][i] is entry k, in column-major order, of the matrix of element i and v[k][i] is entry k of vector i.
+ * @param g The pointers to the nine entries of the elements.
+ * @param v The pointers to the three entries of the vectors.
+ * @param out The pointers to the three entries of the results. They can be the same as v.
+ * @param n The number of elements.
+ */
+static void BatchAdjointAct(const tDataType* const g[9], const tDataType* const v[3], tDataType* const out[3], Eigen::Index n);
+
+/**
+ * Applies the adjoint map of the inverse of n elements to n vectors at once. See BatchAdjointAct.
+ */
+static void BatchAdjointInvAct(const tDataType* const g[9], const tDataType* const v[3], tDataType* const out[3], Eigen::Index n);
+
+/**
+ * Transforms n covariances with the adjoint map of n elements at once. cov[k][i] is entry k, in column-major order,
+ * of covariance i. The covariances must be symmetric.
+ * @param g The pointers to the nine entries of the elements.
+ * @param cov The pointers to the nine entries of the covariances.
+ * @param out The pointers to the nine entries of the results. They can be the same as cov.
+ * @param n The number of elements.
+ */
+static void BatchAdjointTransformCovariance(const tDataType* const g[9], const tDataType* const cov[9], tDataType* const out[9], Eigen::Index n);
+
 /**
  * Performs the left group action 
  */
 SE2 operator * (const SE2& g){ return SE2(data_ *g.data_) ;}
 
+/**
+ * Applies the group action to a point, \f$ R p + t \f$.
+ * @param p The point.
+ */
+Point Act(const Point& p) const {return Act(data_,p);}
+
+/**
+ * Applies the group action of the data of an element to a point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ */
+static Point Act(const Mat3d& data, const Point& p) {return data.template block<2,2>(0,0)*p + data.template block<2,1>(0,2);}
+
+/**
+ * Applies the group action of the data of an element to a point and computes the Jacobians of the result with
+ * respect to the element, perturbed on the right as in OPlus, and to the point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ * @param j_pose The Jacobian with respect to the element, \f$ [R,\ R S p] \f$ with \f$ S \f$ being SSM(1).
+ * @param j_point The Jacobian with respect to the point, the rotation \f$ R \f$.
+ * @return The transformed point.
+ */
+static Point ActWithJacobians(const Mat3d& data, const Point& p, ActJacobian& j_pose, Eigen::Matrix<tDataType,2,2>& j_point) {
+    const Point out = Act(data,p);
+    // g exp(u) p is about g p + R (u_p + u_th S p) and R S p = S (g p - t)
+    j_pose.template block<2,2>(0,0) = data.template block<2,2>(0,0);
+    j_pose(0,2) = data(1,2) - out(1);
+    j_pose(1,2) = out(0) - data(0,2);
+    j_point = data.template block<2,2>(0,0);
+    return out;
+}
+
+/**
+ * Applies the group action of the data of an element to n points. The points are stored contiguously so that
+ * they are transformed as the columns of a single matrix, which Eigen vectorizes.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param n The number of points.
+ */
+static void BatchAct(const Mat3d& data, const Point* points, Point* out, Eigen::Index n) {
+    if (n <= 0) {
+        return;
+    }
+    // The points are transformed a block at a time through a buffer so that out can alias points.
+    Eigen::Map<const Eigen::Matrix<tDataType,2,Eigen::Dynamic>> points_map(points->data(),2,n);
+    Eigen::Map<Eigen::Matrix<tDataType,2,Eigen::Dynamic>> out_map(out->data(),2,n);
+    Eigen::Matrix<tDataType,2,kBatchActBlockSize> tmp;
+    for (Eigen::Index start = 0; start < n; start += kBatchActBlockSize) {
+        const Eigen::Index len = std::min<Eigen::Index>(kBatchActBlockSize, n-start);
+        tmp.leftCols(len).noalias() = data.template block<2,2>(0,0).lazyProduct(points_map.middleCols(start,len));
+        out_map.middleCols(start,len) = tmp.leftCols(len).colwise() + data.template block<2,1>(0,2);
+    }
+}
+
+/**
+ * Applies the group action of the data of an element to n points and computes the Jacobians of the results with respect
+ * to the element. The Jacobian with respect to every point is the rotation \f$ R \f$ so it is not repeated.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param j_pose The first of the n Jacobians with respect to the element.
+ * @param n The number of points.
+ */
+static void BatchActWithJacobians(const Mat3d& data, const Point* points, Point* out, ActJacobian* j_pose, Eigen::Index n) {
+    Eigen::Matrix<tDataType,2,2> j_point;
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        out[ii] = ActWithJacobians(data,points[ii],j_pose[ii],j_point);
+    }
+}
+
 /**
  * Performs the group operation between the data of two elements
  */ 
@@ -128,6 +307,17 @@ static Mat3d Mult(const Mat3d& data1, const Mat3d& data2 ){
     return data1*data2;
 }
 
+/**
+ * Performs the group operation on n pairs of elements at once. The data is given as a structure of arrays:
+ * g1[k][i] is entry k, in column-major order, of the matrix of element i. Only the rotation and translation
+ * blocks are multiplied and the elements are processed a SIMD register at a time.
+ * @param g1 The pointers to the nine entries of the left elements.
+ * @param g2 The pointers to the nine entries of the right elements.
+ * @param out The pointers to the nine entries of the results. They can be the same as g1 or g2.
+ * @param n The number of elements.
+ */
+static void BatchMult(const tDataType* const g1[9], const tDataType* const g2[9], tDataType* const out[9], Eigen::Index n);
+
 /**
  * Performs the BoxPlus operation 
  * @param g An element of the group
@@ -154,11 +344,49 @@ SE2 BoxPlus(const Algebra& u) const
 Algebra BoxMinus(const SE2& g) const { return Algebra( Algebra::Vee(BoxMinus(g.data_)));}
 
 
+/**
+ * Projects the data of an element that drifted away from the group after many compositions back onto it.
+ * @param data The data of the element.
+ * @tparam tNormalization The policy that projects the rotation, see normalization.h.
+ */
+template <typename tNormalization = PolarNormalization>
+static Mat3d Normalize(const Mat3d& data) {
+    Mat3d m = data;
+    m.template block<2,2>(0,0) = tNormalization::Rotation(Mat2d(data.template block<2,2>(0,0)));
+    m.template block<1,3>(2,0) << 0, 0, 1;
+    return m;
+}
+
+/**
+ * Computes how far the data of an element drifted away from the group, \f$ \|R^\top R - I\| \f$.
+ */
+static tDataType Drift(const Mat3d& data) {return RotationDrift(data.template block<2,2>(0,0));}
+
 /**
  * Verifies that the data of an element properly corresponds to the set. 
  */ 
 static bool isElement(const Mat3d& data);
 
+private:
+
+/**
+ * Performs the group operation on the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchMultKernel(const tDataType* const g1[9], const tDataType* const g2[9], tDataType* const out[9], Eigen::Index i);
+
+/**
+ * Applies the adjoint map, or the one of the inverse, of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchAdjointActKernel(const tDataType* const g[9], const tDataType* const v[3], tDataType* const out[3], Eigen::Index i, bool inverse);
+
+/**
+ * Transforms the covariances of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchAdjointTransformCovarianceKernel(const tDataType* const g[9], const tDataType* const cov[9], tDataType* const out[9], Eigen::Index i);
+
 };
 
 
@@ -167,7 +395,7 @@ static bool isElement(const Mat3d& data);
 //                    Definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
-SE2<tDataType,tNumDimensions,tNumTangentSpaces>::SE2(const Eigen::Matrix<tDataType,3,3> & data, bool verify) : t_(data_.data()+6), R_(data_.block(0,0,2,2)) {
+SE2<tDataType,tNumDimensions,tNumTangentSpaces>::SE2(const Eigen::Matrix<tDataType,3,3> & data, bool verify) {
 
     // First verify that it is a proper group element.
     if (verify ) {
@@ -182,13 +410,159 @@ SE2<tDataType,tNumDimensions,tNumTangentSpaces>::SE2(const Eigen::Matrix<tDataTy
     }
 }
 
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void SE2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchMult(const tDataType* const g1[9], const tDataType* const g2[9], tDataType* const out[9], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchMultKernel<Packet>(g1,g2,out,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchMultKernel<tDataType>(g1,g2,out,ii);
+    }
+}
+
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void SE2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchMultKernel(const tDataType* const g1[9], const tDataType* const g2[9], tDataType* const out[9], Eigen::Index i) {
+    namespace ei = Eigen::internal;
+    using batch_math::Madd;
+
+    // Every entry is loaded before any is stored so that out can alias g1 or g2.
+    const tPacket a0 = ei::ploadu<tPacket>(g1[0]+i), a1 = ei::ploadu<tPacket>(g1[1]+i);
+    const tPacket a3 = ei::ploadu<tPacket>(g1[3]+i), a4 = ei::ploadu<tPacket>(g1[4]+i);
+    const tPacket a6 = ei::ploadu<tPacket>(g1[6]+i), a7 = ei::ploadu<tPacket>(g1[7]+i);
+    const tPacket b0 = ei::ploadu<tPacket>(g2[0]+i), b1 = ei::ploadu<tPacket>(g2[1]+i);
+    const tPacket b3 = ei::ploadu<tPacket>(g2[3]+i), b4 = ei::ploadu<tPacket>(g2[4]+i);
+    const tPacket b6 = ei::ploadu<tPacket>(g2[6]+i), b7 = ei::ploadu<tPacket>(g2[7]+i);
+
+    const tPacket zero = batch_math::Set<tPacket>(static_cast<tDataType>(0.0));
+    ei::pstoreu(out[0]+i, Madd(a0,b0,ei::pmul(a3,b1)));
+    ei::pstoreu(out[1]+i, Madd(a1,b0,ei::pmul(a4,b1)));
+    ei::pstoreu(out[2]+i, zero);
+    ei::pstoreu(out[3]+i, Madd(a0,b3,ei::pmul(a3,b4)));
+    ei::pstoreu(out[4]+i, Madd(a1,b3,ei::pmul(a4,b4)));
+    ei::pstoreu(out[5]+i, zero);
+    ei::pstoreu(out[6]+i, Madd(a0,b6,Madd(a3,b7,a6)));
+    ei::pstoreu(out[7]+i, Madd(a1,b6,Madd(a4,b7,a7)));
+    ei::pstoreu(out[8]+i, batch_math::Set<tPacket>(static_cast<tDataType>(1.0)));
+}
+
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void SE2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointAct(const tDataType* const g[9], const tDataType* const v[3], tDataType* const out[3], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchAdjointActKernel<Packet>(g,v,out,ii,false);
+    }
+    for (; ii < n; ++ii) {
+        BatchAdjointActKernel<tDataType>(g,v,out,ii,false);
+    }
+}
+
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void SE2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointInvAct(const tDataType* const g[9], const tDataType* const v[3], tDataType* const out[3], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchAdjointActKernel<Packet>(g,v,out,ii,true);
+    }
+    for (; ii < n; ++ii) {
+        BatchAdjointActKernel<tDataType>(g,v,out,ii,true);
+    }
+}
+
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void SE2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointTransformCovariance(const tDataType* const g[9], const tDataType* const cov[9], tDataType* const out[9], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchAdjointTransformCovarianceKernel<Packet>(g,cov,out,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchAdjointTransformCovarianceKernel<tDataType>(g,cov,out,ii);
+    }
+}
+
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void SE2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointActKernel(const tDataType* const g[9], const tDataType* const v[3], tDataType* const out[3], Eigen::Index i, bool inverse) {
+    namespace ei = Eigen::internal;
+    using batch_math::Madd;
+
+    // The rotation is [c -s; s c] and a = [t_y, -t_x]
+    const tPacket c = ei::ploadu<tPacket>(g[0]+i), s = ei::ploadu<tPacket>(g[1]+i);
+    const tPacket tx = ei::ploadu<tPacket>(g[6]+i), ty = ei::ploadu<tPacket>(g[7]+i);
+    tPacket x = ei::ploadu<tPacket>(v[0]+i), y = ei::ploadu<tPacket>(v[1]+i);
+    const tPacket th = ei::ploadu<tPacket>(v[2]+i);
+
+    if (inverse) {
+        x = ei::psub(x, ei::pmul(th,ty));
+        y = Madd(th,tx,y);
+        ei::pstoreu(out[0]+i, Madd(c,x,ei::pmul(s,y)));
+        ei::pstoreu(out[1]+i, ei::psub(ei::pmul(c,y),ei::pmul(s,x)));
+    } else {
+        ei::pstoreu(out[0]+i, Madd(th,ty,ei::psub(ei::pmul(c,x),ei::pmul(s,y))));
+        ei::pstoreu(out[1]+i, ei::psub(Madd(s,x,ei::pmul(c,y)),ei::pmul(th,tx)));
+    }
+    ei::pstoreu(out[2]+i, th);
+}
+
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void SE2<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointTransformCovarianceKernel(const tDataType* const g[9], const tDataType* const cov[9], tDataType* const out[9], Eigen::Index i) {
+    namespace ei = Eigen::internal;
+    using batch_math::Madd;
+
+    const tPacket c = ei::ploadu<tPacket>(g[0]+i), s = ei::ploadu<tPacket>(g[1]+i);
+    const tPacket ax = ei::ploadu<tPacket>(g[7]+i), ay = ei::pnegate(ei::ploadu<tPacket>(g[6]+i));
+    const tPacket p00 = ei::ploadu<tPacket>(cov[0]+i), p10 = ei::ploadu<tPacket>(cov[1]+i), p20 = ei::ploadu<tPacket>(cov[2]+i);
+    const tPacket p11 = ei::ploadu<tPacket>(cov[4]+i), p21 = ei::ploadu<tPacket>(cov[5]+i), p22 = ei::ploadu<tPacket>(cov[8]+i);
+
+    // R A, the rotated b and the off diagonal block R b + c a
+    const tPacket ra00 = ei::psub(ei::pmul(c,p00),ei::pmul(s,p10)), ra01 = ei::psub(ei::pmul(c,p10),ei::pmul(s,p11));
+    const tPacket ra10 = Madd(s,p00,ei::pmul(c,p10)), ra11 = Madd(s,p10,ei::pmul(c,p11));
+    const tPacket rb0 = ei::psub(ei::pmul(c,p20),ei::pmul(s,p21)), rb1 = Madd(s,p20,ei::pmul(c,p21));
+    const tPacket o0 = Madd(p22,ax,rb0), o1 = Madd(p22,ay,rb1);
+
+    // R A R^T + rb a^T + a o^T
+    const tPacket m00 = Madd(ra00,c,ei::psub(Madd(rb0,ax,ei::pmul(ax,o0)),ei::pmul(ra01,s)));
+    const tPacket m10 = Madd(ra10,c,ei::psub(Madd(rb1,ax,ei::pmul(ay,o0)),ei::pmul(ra11,s)));
+    const tPacket m11 = Madd(ra10,s,Madd(ra11,c,Madd(rb1,ay,ei::pmul(ay,o1))));
+
+    ei::pstoreu(out[0]+i, m00);
+    ei::pstoreu(out[1]+i, m10);
+    ei::pstoreu(out[2]+i, o0);
+    ei::pstoreu(out[3]+i, m10);
+    ei::pstoreu(out[4]+i, m11);
+    ei::pstoreu(out[5]+i, o1);
+    ei::pstoreu(out[6]+i, o0);
+    ei::pstoreu(out[7]+i, o1);
+    ei::pstoreu(out[8]+i, p22);
+}
+
 //----------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 bool SE2<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Eigen::Matrix<tDataType,3,3>& data) {
     
     tDataType d = (data.block(0,0,2,2).transpose()*data.block(0,0,2,2)-Eigen::Matrix<tDataType,2,2>::Identity()).norm();
     
-    return d <= kSE2_threshold_ && data(2,0) == 0 && data(2,1)==0 && data(2,2)==1;
+    return d <= ScalarTraits<tDataType>::group_threshold_ && data(2,0) == 0 && data(2,1)==0 && data(2,2)==1;
 }
 
 } // namespace lie_groups
@@ -0,0 +1,354 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_SE2COMPLEX_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_SE2COMPLEX_
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <iostream>
+
+#include "lie_groups/lie_algebras/se2c.h"
+#include "lie_groups/lie_groups/SE2.h"
+#include "lie_groups/lie_groups/group_base.h"
+
+namespace lie_groups {
+
+/**
+ * The group \f$SE(2)\f$ with the elements stored as the vector \f$ (\cos\theta,\sin\theta,t_x,t_y) \f$, the unit complex
+ * number of the rotation followed by the translation. It has the interface of SE2 but an element takes 4 scalars instead
+ * of 9 and the group operation takes 8 multiplications instead of the 12 of the rotation and translation blocks.
+ * The homogeneous matrix is formed only on request, see Matrix(). The group operation does not normalize the
+ * complex number so its norm drifts by the rounding error of every product.
+ */
+template <typename tDataType=double, int tNumDimensions=3, int tNumTangentSpaces=1>
+class SE2Complex : public GroupBase<SE2Complex<tDataType,tNumDimensions,tNumTangentSpaces>,se2c<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,4,1>, Eigen::Matrix<tDataType,3,3>, Eigen::Matrix<tDataType,3,1>,tDataType> {
+
+static_assert(tNumTangentSpaces == 1, "lie_groups::SE2Complex the number of tangent spaces must be 1.");
+
+
+public:
+
+typedef Eigen::Matrix<tDataType,2,1> Vec2d;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
+typedef Eigen::Matrix<tDataType,2,2> Mat2d;
+typedef Eigen::Matrix<tDataType,3,3> Mat3d;
+
+static constexpr unsigned int dim_ = tNumDimensions;
+static constexpr unsigned int dim_pos_ = 2; /** < The dimension of the position */
+static constexpr unsigned int dim_rot_ = 1; /** < The dimension of the rotation */
+static constexpr unsigned int size1_ = 4;
+static constexpr unsigned int size2_ = 1;
+typedef se2c<tDataType,tNumDimensions,tNumTangentSpaces> Algebra;
+typedef NonAbelian GroupType;
+typedef so2<tDataType> RotAlgebra;
+typedef SO2<tDataType> RotGroup;
+typedef GroupBase<SE2Complex<tDataType,tNumDimensions,tNumTangentSpaces>,se2c<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,4,1>, Eigen::Matrix<tDataType,3,3>, Eigen::Matrix<tDataType,3,1>,tDataType> Base;
+using Base::BoxPlus;
+using Base::BoxMinus;
+
+typedef Eigen::Matrix<tDataType,2,1> Point;  /** < A point the group acts on. */
+typedef Eigen::Matrix<tDataType,2,3> ActJacobian;  /** < The Jacobian of the group action with respect to the element. */
+
+
+Vec4d data_;
+
+/**
+ * Returns a view of the position. The view is computed on demand so that
+ * the element doesn't store pointers into its own data.
+ */
+Eigen::Block<Vec4d,2,1> t() { return data_.template block<2,1>(2,0); }
+Eigen::Block<const Vec4d,2,1> t() const { return data_.template block<2,1>(2,0); }
+
+/**
+ * Returns the rotation matrix.
+ */
+Mat2d R() const { return Rotation(data_); }
+
+
+/**
+ * Default constructor. Initializes group element to identity.
+ */
+SE2Complex() : data_(1,0,0,0) {}
+
+
+/**
+ * Copy constructor.
+ */
+SE2Complex(const SE2Complex & g) = default;
+
+/**
+ * Copy assignment
+ */
+SE2Complex& operator = (const SE2Complex& g) = default;
+
+/**
+ * Move constructor.
+ */
+SE2Complex(SE2Complex && g) = default;
+
+/**
+ * Move assignment
+ */
+SE2Complex& operator = (SE2Complex&& g) = default;
+
+/**
+* Initializes group element to the one given. If verify is true
+* it will check that the complex number has unit norm.
+* @param[in] data The complex number and translation of an element of \f$SE(2)\f$
+* @param verify If true, the constructor will verify that the provided
+* element is a member of \f$SE(2)\f$
+*/
+SE2Complex(const Vec4d & data, bool verify);
+
+/**
+* Initializes group element to the data of the one given.
+* @param[in] data The complex number and translation of an element of \f$SE(2)\f$
+*/
+SE2Complex(const Vec4d & data) :data_(data) {}
+
+/**
+* Initializes group element to an element of SE2.
+* @param[in] g An element of SE2.
+*/
+explicit SE2Complex(const SE2<tDataType>& g) : data_(Algebra::FromHomogeneous(g.data_)) {}
+
+/**
+ * Returns the element of SE2 with the same data.
+ */
+SE2<tDataType> ToSE2() const {return SE2<tDataType>(Matrix());}
+
+/**
+ * Returns the homogeneous 3x3 matrix of the element.
+ */
+Mat3d Matrix() const {return Algebra::Homogeneous(data_);}
+
+/**
+ * Returns the rotation matrix of the data of an element.
+ * @param data The data of an element of the group.
+ */
+static Mat2d Rotation(const Vec4d& data) {
+    Mat2d m;
+    m << data(0), -data(1), data(1), data(0);
+    return m;
+}
+
+/*
+ * Returns the inverse of the element
+ */
+SE2Complex Inverse() const { return SE2Complex::Inverse(this->data_);}
+
+/*
+ * Returns the inverse of the data of an element, the conjugate of the complex number and \f$ -R^\top t \f$
+ */
+static Vec4d Inverse(const Vec4d& data){
+    return Vec4d(data(0), -data(1), -data(0)*data(2) - data(1)*data(3), data(1)*data(2) - data(0)*data(3));}
+
+/**
+ * Returns the identity element
+ */
+static SE2Complex Identity(){return SE2Complex();}
+
+/**
+ * Returns the matrix adjoint map, \f$ \begin{bmatrix} R & a \\ 0 & 1 \end{bmatrix} \f$ with \f$ a = [t_y, -t_x]^\top \f$.
+ */
+Mat3d Adjoint(){
+    Mat3d m;
+    m << data_(0), -data_(1), data_(3),
+         data_(1),  data_(0), -data_(2),
+         static_cast<tDataType>(0.0), static_cast<tDataType>(0.0), static_cast<tDataType>(1.0);
+    return m;
+}
+
+/**
+ * Applies the adjoint map of the element to v without forming the matrix.
+ * @param v The data of an element of the Cartesian space.
+ */
+Vec3d AdjointAct(const Vec3d& v) const {return AdjointAct(data_,v);}
+
+/**
+ * Applies the adjoint map of the inverse of the element to v without forming the matrix.
+ * @param v The data of an element of the Cartesian space.
+ */
+Vec3d AdjointInvAct(const Vec3d& v) const {return AdjointInvAct(data_,v);}
+
+/**
+ * Applies the adjoint map of the data of an element to v. See SE2::AdjointAct.
+ * @param data The data of an element of the group.
+ * @param v The data of an element of the Cartesian space.
+ */
+static Vec3d AdjointAct(const Vec4d& data, const Vec3d& v) {
+    return Vec3d(data(0)*v(0) - data(1)*v(1) + v(2)*data(3),
+                 data(1)*v(0) + data(0)*v(1) - v(2)*data(2),
+                 v(2));
+}
+
+/**
+ * Applies the adjoint map of the inverse of the data of an element to v. See SE2::AdjointInvAct.
+ * @param data The data of an element of the group.
+ * @param v The data of an element of the Cartesian space.
+ */
+static Vec3d AdjointInvAct(const Vec4d& data, const Vec3d& v) {
+    const tDataType x = v(0) - v(2)*data(3);
+    const tDataType y = v(1) + v(2)*data(2);
+    return Vec3d(data(0)*x + data(1)*y, data(0)*y - data(1)*x, v(2));
+}
+
+/**
+ * Performs the left group action on itself. i.e. this is on the left of
+ * the bilinear operation.
+ */
+SE2Complex operator * (const SE2Complex& g){ return SE2Complex(Mult(data_,g.data_)) ;}
+
+/**
+ * Applies the group action to a point, \f$ R p + t \f$.
+ * @param p The point.
+ */
+Point Act(const Point& p) const {return Act(data_,p);}
+
+/**
+ * Applies the group action of the data of an element to a point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ */
+static Point Act(const Vec4d& data, const Point& p) {
+    return Point(data(0)*p(0) - data(1)*p(1) + data(2), data(1)*p(0) + data(0)*p(1) + data(3));
+}
+
+/**
+ * Applies the group action of the data of an element to a point and computes the Jacobians of the result with
+ * respect to the element, perturbed on the right as in OPlus, and to the point. See SE2::ActWithJacobians.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ * @param j_pose The Jacobian with respect to the element, \f$ [R,\ R S p] \f$ with \f$ S \f$ being SSM(1).
+ * @param j_point The Jacobian with respect to the point, the rotation \f$ R \f$.
+ * @return The transformed point.
+ */
+static Point ActWithJacobians(const Vec4d& data, const Point& p, ActJacobian& j_pose, Eigen::Matrix<tDataType,2,2>& j_point) {
+    const Point out = Act(data,p);
+    j_point = Rotation(data);
+    j_pose.template block<2,2>(0,0) = j_point;
+    j_pose(0,2) = data(3) - out(1);
+    j_pose(1,2) = out(0) - data(2);
+    return out;
+}
+
+/**
+ * Applies the group action of the data of an element to n points. The points are transformed by SE2::BatchAct
+ * with the homogeneous matrix formed once.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param n The number of points.
+ */
+static void BatchAct(const Vec4d& data, const Point* points, Point* out, Eigen::Index n) {
+    SE2<tDataType>::BatchAct(Algebra::Homogeneous(data),points,out,n);
+}
+
+/**
+ * Applies the group action of the data of an element to n points and computes the Jacobians of the results with respect
+ * to the element. See SE2::BatchActWithJacobians.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param j_pose The first of the n Jacobians with respect to the element.
+ * @param n The number of points.
+ */
+static void BatchActWithJacobians(const Vec4d& data, const Point* points, Point* out, ActJacobian* j_pose, Eigen::Index n) {
+    Eigen::Matrix<tDataType,2,2> j_point;
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        out[ii] = ActWithJacobians(data,points[ii],j_pose[ii],j_point);
+    }
+}
+
+/**
+ * Performs the group operation between the data of two elements. The complex numbers are multiplied and
+ * the translation is \f$ R_1 t_2 + t_1 \f$.
+ */
+static Vec4d Mult(const Vec4d& data1, const Vec4d& data2 ){
+    const tDataType c1 = data1(0), s1 = data1(1);
+    return Vec4d(c1*data2(0) - s1*data2(1),
+                 s1*data2(0) + c1*data2(1),
+                 c1*data2(2) - s1*data2(3) + data1(2),
+                 s1*data2(2) + c1*data2(3) + data1(3));
+}
+
+/**
+ * Performs the BoxPlus operation
+ * @param g An element of the group
+ * @param u An element of the Lie algebra.
+ * @return The result of the BoxPlus operation.
+ */
+static SE2Complex BoxPlus(const SE2Complex& g, const Algebra& u)
+{return SE2Complex(Base::OPlus(g.data_,u.data_));}
+
+
+/**
+ * Performs the BoxPlus operation
+ * @param u An element of the Lie algebra.
+ * @return The result of the BoxPlus operation.
+ */
+SE2Complex BoxPlus(const Algebra& u) const
+{return BoxPlus(*this,u);}
+
+/**
+ * Performs the O-minus operation with this being \f$ g_1 \f$ in the equation \f$ \log(g_2^-1*g_1) \f$
+ * @param g An element of the group
+ * @return An element of the Lie algebra
+ */
+Algebra BoxMinus(const SE2Complex& g) const { return Algebra( Algebra::Vee(BoxMinus(g.data_)));}
+
+
+/**
+ * Projects the data of an element that drifted away from the group after many compositions back onto it. The complex number is
+ * normalized, which is exact, whatever the policy.
+ * @param data The data of the element.
+ * @tparam tNormalization The policy that projects the rotation, see normalization.h.
+ */
+template <typename tNormalization = PolarNormalization>
+static Vec4d Normalize(const Vec4d& data) {
+    Vec4d m = data;
+    m.template head<2>().normalize();
+    return m;
+}
+
+/**
+ * Computes how far the data of an element drifted away from the group, \f$ |c^2 + s^2 - 1| \f$.
+ */
+static tDataType Drift(const Vec4d& data) {return std::abs(data(0)*data(0) + data(1)*data(1) - static_cast<tDataType>(1.0));}
+
+/**
+ * Verifies that the complex number of the data of an element has unit norm.
+ */
+static bool isElement(const Vec4d& data);
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                    Definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+SE2Complex<tDataType,tNumDimensions,tNumTangentSpaces>::SE2Complex(const Eigen::Matrix<tDataType,4,1> & data, bool verify) {
+
+    // First verify that it is a proper group element.
+    if (verify ) {
+        if (SE2Complex::isElement(data)) {
+            data_ = data;
+        } else {
+            std::cerr << "SE2Complex::Constructor not valid input setting to identity" << std::endl;
+            data_ = Vec4d(1,0,0,0);
+        }
+    } else {
+        data_ = data;
+    }
+}
+
+
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+bool SE2Complex<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Eigen::Matrix<tDataType,4,1>& data) {
+    return std::abs(data(0)*data(0) + data(1)*data(1) - static_cast<tDataType>(1.0)) <= ScalarTraits<tDataType>::group_threshold_;
+}
+
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_SE2COMPLEX_
@@ -15,7 +15,7 @@ constexpr double kSE3_threshold_ = 1e-6;
 template <typename tDataType=double, int tNumDimensions=6, int tNumTangentSpaces=1>
 class SE3 : public GroupBase<SE3<tDataType,tNumDimensions,tNumTangentSpaces>,se3<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,4,4>, Eigen::Matrix<tDataType,4,4>, Eigen::Matrix<tDataType,6,1>,tDataType> {
 
-static_assert(tNumTangentSpaces == 1, "lie_groups::SE3 the number of tangent spaces must be 1.");
+static_assert(tNumTangentSpaces > 0, "lie_groups::SE3 the number of tangent spaces must be greater than 0.");
 
 
 public:
@@ -39,37 +39,51 @@ typedef GroupBase<SE3<tDataType,tNumDimensions,tNumTangentSpaces>,se3<tDataType,
 using Base::BoxPlus;
 using Base::BoxMinus;
 
+typedef Eigen::Matrix<tDataType,3,1> Point;  /** < A point the group acts on. */
+typedef Eigen::Matrix<tDataType,3,6> ActJacobian;  /** < The Jacobian of the group action with respect to the element. */
+
 
 Mat4d data_;
-Eigen::Map<Vec3d> t_;  /** < The position */
-Eigen::Ref<Mat3d> R_; /** < The rotation */
+
+/**
+ * Returns a view of the position. The view is computed on demand so that 
+ * the element doesn't store pointers into its own data.
+ */ 
+Eigen::Block<Mat4d,3,1> t() { return data_.template block<3,1>(0,3); }
+Eigen::Block<const Mat4d,3,1> t() const { return data_.template block<3,1>(0,3); }
+
+/**
+ * Returns a view of the rotation. 
+ */ 
+Eigen::Block<Mat4d,3,3> R() { return data_.template block<3,3>(0,0); }
+Eigen::Block<const Mat4d,3,3> R() const { return data_.template block<3,3>(0,0); }
 
 
 /**
  * Default constructor. Initializes group element to identity.
  */
-SE3() : t_(data_.data()+12), R_(data_.block(0,0,3,3)), data_(Mat4d::Identity() ) {}
+SE3() : data_(Mat4d::Identity() ) {}
 
 
 /**
  * Copy constructor.
  */ 
-SE3(const SE3 & g) : t_(data_.data()+12), R_(data_.block(0,0,3,3)), data_(g.data_) {}
+SE3(const SE3 & g) = default;
 
 /**
  * Copy assignment
  */ 
-void operator = (const SE3& g){ this->data_ = g.data_; }
+SE3& operator = (const SE3& g) = default;
 
 /**
  * Move constructor.
  */ 
-SE3(const SE3 && g) : t_(data_.data()+12), R_(data_.block(0,0,3,3)), data_(g.data_) {}
+SE3(SE3 && g) = default;
 
 /**
  * Move assignment
  */ 
-void operator = (const SE3&& g){ this->data_ = g.data_; }
+SE3& operator = (SE3&& g) = default;
 
 /**
 * Initializes group element to the one given. If verify is true
@@ -84,7 +98,7 @@ SE3(const Mat4d & data, bool verify);
 * Initializes group element to the data of the one given. 
 * @param[in] data  The data pertaining to an element of \f$SE(3)\f$
 */
-SE3(const Mat4d & data) :data_(data), t_(data_.data()+12), R_(data_.block(0,0,3,3)){}
+SE3(const Mat4d & data) :data_(data) {}
 
 /*
  * Returns the inverse of the element
@@ -93,11 +107,15 @@ SE3 Inverse() const { return SE3::Inverse(this->data_);}
 
 
 /*
- * Returns the inverse of the data of an element
+ * Returns the inverse of the data of an element. The structure of the element
+ * is used so that the inverse is \f$ [R^\top, -R^\top t; 0, 1] \f$
  */ 
-
 static Mat4d Inverse(const Mat4d& data){  
-    return data.inverse();}
+    Mat4d m;
+    m.template block<3,3>(0,0) = data.template block<3,3>(0,0).transpose();
+    m.template block<3,1>(0,3) = -m.template block<3,3>(0,0)*data.template block<3,1>(0,3);
+    m.template block<1,4>(3,0) << static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(0.0),static_cast<tDataType>(1.0);
+    return m;}
 
 /**
  * Returns the identity element
@@ -110,18 +128,170 @@ static SE3 Identity(){return SE3();}
  */ 
 Mat6d Adjoint(){
     Mat6d m;
-    m.block(0,0,3,3) = R_;
-    m.block(3,3,3,3) = R_;
-    m.block(0,3,3,3) = se3<tDataType>::SSM(t_)*R_;
+    m.block(0,0,3,3) = R();
+    m.block(3,3,3,3) = R();
+    m.block(0,3,3,3) = se3<tDataType>::SSM(t())*R();
     m.block(3,0,3,3).setZero(); 
     return m;
 }
 
+/**
+ * Applies the adjoint map of the element to v without forming the matrix.
+ * @param v The data of an element of the Cartesian space.
+ */
+Vec6d AdjointAct(const Vec6d& v) const {return AdjointAct(data_,v);}
+
+/**
+ * Applies the adjoint map of the inverse of the element to v without forming the matrix.
+ * @param v The data of an element of the Cartesian space.
+ */
+Vec6d AdjointInvAct(const Vec6d& v) const {return AdjointInvAct(data_,v);}
+
+/**
+ * Transforms a covariance with the adjoint map of the element, \f$ Ad P Ad^\top \f$, without forming the matrix.
+ * @param cov A symmetric covariance of an element of the Cartesian space.
+ */
+Mat6d AdjointTransformCovariance(const Mat6d& cov) const {return AdjointTransformCovariance(data_,cov);}
+
+/**
+ * Applies the adjoint map of the data of an element to v. Since \f$ Ad = \begin{bmatrix} R & [t]_\times R \\ 0 & R \end{bmatrix} \f$,
+ * the result is \f$ [R v_p + t \times R v_w;\ R v_w] \f$.
+ * @param data The data of an element of the group.
+ * @param v The data of an element of the Cartesian space.
+ */
+static Vec6d AdjointAct(const Mat4d& data, const Vec6d& v) {
+    Vec6d out;
+    out.template block<3,1>(3,0) = data.template block<3,3>(0,0)*v.template block<3,1>(3,0);
+    out.template block<3,1>(0,0) = data.template block<3,3>(0,0)*v.template block<3,1>(0,0) + data.template block<3,1>(0,3).cross(out.template block<3,1>(3,0));
+    return out;
+}
+
+/**
+ * Applies the adjoint map of the inverse of the data of an element to v. The result is
+ * \f$ [R^\top (v_p - t \times v_w);\ R^\top v_w] \f$.
+ * @param data The data of an element of the group.
+ * @param v The data of an element of the Cartesian space.
+ */
+static Vec6d AdjointInvAct(const Mat4d& data, const Vec6d& v) {
+    Vec6d out;
+    out.template block<3,1>(3,0) = data.template block<3,3>(0,0).transpose()*v.template block<3,1>(3,0);
+    out.template block<3,1>(0,0) = data.template block<3,3>(0,0).transpose()*(v.template block<3,1>(0,0) - data.template block<3,1>(0,3).cross(v.template block<3,1>(3,0)));
+    return out;
+}
+
+/**
+ * Transforms a covariance with the adjoint map of the data of an element, \f$ Ad P Ad^\top \f$. The adjoint is
+ * factored as \f$ \begin{bmatrix} I & [t]_\times \\ 0 & I \end{bmatrix} \begin{bmatrix} R & 0 \\ 0 & R \end{bmatrix} \f$
+ * so the blocks are rotated and then sheared with cross products.
+ * @param data The data of an element of the group.
+ * @param cov A symmetric covariance of an element of the Cartesian space.
+ */
+static Mat6d AdjointTransformCovariance(const Mat4d& data, const Mat6d& cov);
+
+/**
+ * Applies the adjoint map of n elements to n vectors at once. The data is given as a structure of arrays:
+ * g[k][i] is entry k, in column-major order, of the matrix of element i and v[k][i] is entry k of vector i.
+ * @param g The pointers to the sixteen entries of the elements.
+ * @param v The pointers to the six entries of the vectors.
+ * @param out The pointers to the six entries of the results. They can be the same as v.
+ * @param n The number of elements.
+ */
+static void BatchAdjointAct(const tDataType* const g[16], const tDataType* const v[6], tDataType* const out[6], Eigen::Index n);
+
+/**
+ * Applies the adjoint map of the inverse of n elements to n vectors at once. See BatchAdjointAct.
+ */
+static void BatchAdjointInvAct(const tDataType* const g[16], const tDataType* const v[6], tDataType* const out[6], Eigen::Index n);
+
+/**
+ * Transforms n covariances with the adjoint map of n elements at once. cov[k][i] is entry k, in column-major order,
+ * of covariance i. Since the covariances are symmetric, \f$ Ad P Ad^\top = Ad (Ad P)^\top \f$ is computed
+ * by applying the adjoint to the columns of P and then to the rows of the result.
+ * @param g The pointers to the sixteen entries of the elements.
+ * @param cov The pointers to the thirty six entries of the covariances.
+ * @param out The pointers to the thirty six entries of the results. They can be the same as cov.
+ * @param n The number of elements.
+ */
+static void BatchAdjointTransformCovariance(const tDataType* const g[16], const tDataType* const cov[36], tDataType* const out[36], Eigen::Index n);
+
 /**
  * Performs the left group action 
  */
 SE3 operator * (const SE3& g){ return SE3(data_ *g.data_) ;}
 
+/**
+ * Applies the group action to a point, \f$ R p + t \f$.
+ * @param p The point.
+ */
+Point Act(const Point& p) const {return Act(data_,p);}
+
+/**
+ * Applies the group action of the data of an element to a point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ */
+static Point Act(const Mat4d& data, const Point& p) {return data.template block<3,3>(0,0)*p + data.template block<3,1>(0,3);}
+
+/**
+ * Applies the group action of the data of an element to a point and computes the Jacobians of the result with
+ * respect to the element, perturbed on the right as in OPlus, and to the point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ * @param j_pose The Jacobian with respect to the element, \f$ [R,\ -R [p]_\times] \f$.
+ * @param j_point The Jacobian with respect to the point, the rotation \f$ R \f$.
+ * @return The transformed point.
+ */
+static Point ActWithJacobians(const Mat4d& data, const Point& p, ActJacobian& j_pose, Eigen::Matrix<tDataType,3,3>& j_point) {
+    const Point out = Act(data,p);
+    // g exp(u) p is about g p + R (u_p - [p]x u_w) and R [p]x = [R p]x R so column k is R_k x R p
+    const Point rp = out - data.template block<3,1>(0,3);
+    j_pose.template block<3,3>(0,0) = data.template block<3,3>(0,0);
+    for (int k = 0; k < 3; ++k) {
+        j_pose.col(3+k) = data.template block<3,1>(0,k).cross(rp);
+    }
+    j_point = data.template block<3,3>(0,0);
+    return out;
+}
+
+/**
+ * Applies the group action of the data of an element to n points. The points are stored contiguously so that
+ * they are transformed as the columns of a single matrix, which Eigen vectorizes.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param n The number of points.
+ */
+static void BatchAct(const Mat4d& data, const Point* points, Point* out, Eigen::Index n) {
+    if (n <= 0) {
+        return;
+    }
+    // The points are transformed a block at a time through a buffer so that out can alias points.
+    Eigen::Map<const Eigen::Matrix<tDataType,3,Eigen::Dynamic>> points_map(points->data(),3,n);
+    Eigen::Map<Eigen::Matrix<tDataType,3,Eigen::Dynamic>> out_map(out->data(),3,n);
+    Eigen::Matrix<tDataType,3,kBatchActBlockSize> tmp;
+    for (Eigen::Index start = 0; start < n; start += kBatchActBlockSize) {
+        const Eigen::Index len = std::min<Eigen::Index>(kBatchActBlockSize, n-start);
+        tmp.leftCols(len).noalias() = data.template block<3,3>(0,0).lazyProduct(points_map.middleCols(start,len));
+        out_map.middleCols(start,len) = tmp.leftCols(len).colwise() + data.template block<3,1>(0,3);
+    }
+}
+
+/**
+ * Applies the group action of the data of an element to n points and computes the Jacobians of the results with respect
+ * to the element. The Jacobian with respect to every point is the rotation \f$ R \f$ so it is not repeated.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param j_pose The first of the n Jacobians with respect to the element.
+ * @param n The number of points.
+ */
+static void BatchActWithJacobians(const Mat4d& data, const Point* points, Point* out, ActJacobian* j_pose, Eigen::Index n) {
+    Eigen::Matrix<tDataType,3,3> j_point;
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        out[ii] = ActWithJacobians(data,points[ii],j_pose[ii],j_point);
+    }
+}
+
 /**
  * Performs the group operation between the data of two elements
  */ 
@@ -163,18 +333,62 @@ void Print() {
     std::cout << data_ << std::endl; 
 }
 
+/**
+ * Projects the data of an element that drifted away from the group after many compositions back onto it.
+ * @param data The data of the element.
+ * @tparam tNormalization The policy that projects the rotation, see normalization.h.
+ */
+template <typename tNormalization = PolarNormalization>
+static Mat4d Normalize(const Mat4d& data) {
+    Mat4d m = data;
+    m.template block<3,3>(0,0) = tNormalization::Rotation(Mat3d(data.template block<3,3>(0,0)));
+    m.template block<1,4>(3,0) << 0, 0, 0, 1;
+    return m;
+}
+
+/**
+ * Computes how far the data of an element drifted away from the group, \f$ \|R^\top R - I\| \f$.
+ */
+static tDataType Drift(const Mat4d& data) {return RotationDrift(data.template block<3,3>(0,0));}
+
 /**
  * Verifies that the data of an element properly corresponds to the set. 
  */ 
 static bool isElement(const Mat4d& data);
 
+private:
+
+/**
+ * Applies the adjoint map, or the one of the inverse, of a rotation r in column-major order and a translation t to v.
+ */
+template<typename tPacket, bool tInverse>
+static void AdjointActPacket(const tPacket r[9], const tPacket t[3], const tPacket v[6], tPacket out[6]);
+
+/**
+ * Loads the rotation and translation of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void LoadPacket(const tDataType* const g[16], Eigen::Index i, tPacket r[9], tPacket t[3]);
+
+/**
+ * Applies the adjoint map, or the one of the inverse, of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket, bool tInverse>
+static void BatchAdjointActKernel(const tDataType* const g[16], const tDataType* const v[6], tDataType* const out[6], Eigen::Index i);
+
+/**
+ * Transforms the covariances of the elements i to i plus the size of tPacket.
+ */
+template<typename tPacket>
+static void BatchAdjointTransformCovarianceKernel(const tDataType* const g[16], const tDataType* const cov[36], tDataType* const out[36], Eigen::Index i);
+
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //                    Definitions
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
-SE3<tDataType,tNumDimensions,tNumTangentSpaces>::SE3(const Eigen::Matrix<tDataType,4,4> & data, bool verify) : t_(data_.data()+12), R_(data_.block(0,0,3,3)) {
+SE3<tDataType,tNumDimensions,tNumTangentSpaces>::SE3(const Eigen::Matrix<tDataType,4,4> & data, bool verify) {
 
     // First verify that it is a proper group element.
     if (verify ) {
@@ -189,13 +403,164 @@ SE3<tDataType,tNumDimensions,tNumTangentSpaces>::SE3(const Eigen::Matrix<tDataTy
     }
 }
 
+//-------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+Eigen::Matrix<tDataType,6,6> SE3<tDataType,tNumDimensions,tNumTangentSpaces>::AdjointTransformCovariance(const Mat4d& data, const Mat6d& cov) {
+
+    // With the rotated blocks A = R P_pp R^T, B = R P_pw R^T and C = R P_ww R^T and T = [t]x the result is
+    // [A + T B^T + B T^T + T C T^T, B + T C; (B + T C)^T, C]. Since C is symmetric, B T^T + T C T^T = (B + T C) T^T.
+    const Mat3d R = data.template block<3,3>(0,0);
+    const Vec3d t = data.template block<3,1>(0,3);
+    const Mat3d A = R*cov.template block<3,3>(0,0)*R.transpose();
+    const Mat3d B = R*cov.template block<3,3>(0,3)*R.transpose();
+    const Mat3d C = R*cov.template block<3,3>(3,3)*R.transpose();
+
+    const Mat3d T = se3<tDataType>::SSM(t);
+    const Mat3d off_diagonal = B + T*C;
+
+    Mat6d m;
+    m.template block<3,3>(0,0) = A + T*B.transpose() + off_diagonal*T.transpose();
+    m.template block<3,3>(0,3) = off_diagonal;
+    m.template block<3,3>(3,0) = off_diagonal.transpose();
+    m.template block<3,3>(3,3) = C;
+    return m;
+}
+
+//-------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void SE3<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointAct(const tDataType* const g[16], const tDataType* const v[6], tDataType* const out[6], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchAdjointActKernel<Packet,false>(g,v,out,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchAdjointActKernel<tDataType,false>(g,v,out,ii);
+    }
+}
+
+//-------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void SE3<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointInvAct(const tDataType* const g[16], const tDataType* const v[6], tDataType* const out[6], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchAdjointActKernel<Packet,true>(g,v,out,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchAdjointActKernel<tDataType,true>(g,v,out,ii);
+    }
+}
+
+//-------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+void SE3<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointTransformCovariance(const tDataType* const g[16], const tDataType* const cov[36], tDataType* const out[36], Eigen::Index n) {
+    typedef typename Eigen::internal::packet_traits<tDataType>::type Packet;
+    const Eigen::Index packet_size = Eigen::internal::packet_traits<tDataType>::size;
+
+    Eigen::Index ii = 0;
+    for (; ii + packet_size <= n; ii += packet_size) {
+        BatchAdjointTransformCovarianceKernel<Packet>(g,cov,out,ii);
+    }
+    for (; ii < n; ++ii) {
+        BatchAdjointTransformCovarianceKernel<tDataType>(g,cov,out,ii);
+    }
+}
+
+//-------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket, bool tInverse>
+EIGEN_STRONG_INLINE void SE3<tDataType,tNumDimensions,tNumTangentSpaces>::AdjointActPacket(const tPacket r[9], const tPacket t[3], const tPacket v[6], tPacket out[6]) {
+    namespace ei = Eigen::internal;
+    using batch_math::Madd;
+
+    if (tInverse) {
+        // R^T (v_p - t x v_w) and R^T v_w
+        const tPacket x0 = ei::psub(v[0],ei::psub(ei::pmul(t[1],v[5]),ei::pmul(t[2],v[4])));
+        const tPacket x1 = ei::psub(v[1],ei::psub(ei::pmul(t[2],v[3]),ei::pmul(t[0],v[5])));
+        const tPacket x2 = ei::psub(v[2],ei::psub(ei::pmul(t[0],v[4]),ei::pmul(t[1],v[3])));
+        for (int ii = 0; ii < 3; ++ii) {
+            out[ii] = Madd(r[3*ii],x0,Madd(r[3*ii+1],x1,ei::pmul(r[3*ii+2],x2)));
+            out[ii+3] = Madd(r[3*ii],v[3],Madd(r[3*ii+1],v[4],ei::pmul(r[3*ii+2],v[5])));
+        }
+    } else {
+        // R v_p + t x R v_w and R v_w
+        for (int ii = 0; ii < 3; ++ii) {
+            out[ii+3] = Madd(r[ii],v[3],Madd(r[ii+3],v[4],ei::pmul(r[ii+6],v[5])));
+            out[ii] = Madd(r[ii],v[0],Madd(r[ii+3],v[1],ei::pmul(r[ii+6],v[2])));
+        }
+        out[0] = ei::padd(out[0],ei::psub(ei::pmul(t[1],out[5]),ei::pmul(t[2],out[4])));
+        out[1] = ei::padd(out[1],ei::psub(ei::pmul(t[2],out[3]),ei::pmul(t[0],out[5])));
+        out[2] = ei::padd(out[2],ei::psub(ei::pmul(t[0],out[4]),ei::pmul(t[1],out[3])));
+    }
+}
+
+//-------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+EIGEN_STRONG_INLINE void SE3<tDataType,tNumDimensions,tNumTangentSpaces>::LoadPacket(const tDataType* const g[16], Eigen::Index i, tPacket r[9], tPacket t[3]) {
+    for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            r[row+3*col] = Eigen::internal::ploadu<tPacket>(g[row+4*col]+i);
+        }
+        t[col] = Eigen::internal::ploadu<tPacket>(g[12+col]+i);
+    }
+}
+
+//-------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket, bool tInverse>
+void SE3<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointActKernel(const tDataType* const g[16], const tDataType* const v[6], tDataType* const out[6], Eigen::Index i) {
+    tPacket r[9], t[3], x[6], y[6];
+    LoadPacket(g,i,r,t);
+    for (int k = 0; k < 6; ++k) {
+        x[k] = Eigen::internal::ploadu<tPacket>(v[k]+i);
+    }
+    AdjointActPacket<tPacket,tInverse>(r,t,x,y);
+    for (int k = 0; k < 6; ++k) {
+        Eigen::internal::pstoreu(out[k]+i, y[k]);
+    }
+}
+
+//-------------------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+template <typename tPacket>
+void SE3<tDataType,tNumDimensions,tNumTangentSpaces>::BatchAdjointTransformCovarianceKernel(const tDataType* const g[16], const tDataType* const cov[36], tDataType* const out[36], Eigen::Index i) {
+    tPacket r[9], t[3], x[6], m[36];
+    LoadPacket(g,i,r,t);
+
+    // Column k of m is Ad times column k of the covariance
+    for (int col = 0; col < 6; ++col) {
+        for (int row = 0; row < 6; ++row) {
+            x[row] = Eigen::internal::ploadu<tPacket>(cov[row+6*col]+i);
+        }
+        AdjointActPacket<tPacket,false>(r,t,x,m+6*col);
+    }
+
+    // Column k of the result is Ad times row k of m. Every entry was loaded so out can alias cov.
+    tPacket y[6];
+    for (int col = 0; col < 6; ++col) {
+        for (int k = 0; k < 6; ++k) {
+            x[k] = m[col+6*k];
+        }
+        AdjointActPacket<tPacket,false>(r,t,x,y);
+        for (int row = 0; row < 6; ++row) {
+            Eigen::internal::pstoreu(out[row+6*col]+i, y[row]);
+        }
+    }
+}
+
 //-------------------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 bool SE3<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Eigen::Matrix<tDataType,4,4>& data) {
     
-    double d = (data.block(0,0,3,3).transpose()*data.block(0,0,3,3)-Mat3d::Identity()).norm();
+    tDataType d = (data.block(0,0,3,3).transpose()*data.block(0,0,3,3)-Mat3d::Identity()).norm();
     
-    return d <= kSE3_threshold_ && data(3,0) == 0 && data(3,1)==0 && data(3,2)==0 && data(3,3)==1;
+    return d <= ScalarTraits<tDataType>::group_threshold_ && data(3,0) == 0 && data(3,1)==0 && data(3,2)==0 && data(3,3)==1;
 }
 
 
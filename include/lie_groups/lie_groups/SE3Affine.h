@@ -0,0 +1,371 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_SE3AFFINE_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_SE3AFFINE_
+
+#include <Eigen/Dense>
+#include <iostream>
+
+#include "lie_groups/lie_algebras/se3a.h"
+#include "lie_groups/lie_groups/SE3.h"
+#include "lie_groups/lie_groups/group_base.h"
+
+namespace lie_groups {
+
+/**
+ * The group \f$SE(3)\f$ with the elements stored as the top 3x4 block \f$ [R\ t] \f$ of their homogeneous matrices.
+ * It has the interface of SE3 but an element takes 12 scalars instead of 16 and the group operation, the inverse and
+ * the group action only touch the rotation and translation. The homogeneous matrix is formed only on request, see Matrix().
+ */
+template <typename tDataType=double, int tNumDimensions=6, int tNumTangentSpaces=1>
+class SE3Affine : public GroupBase<SE3Affine<tDataType,tNumDimensions,tNumTangentSpaces>,se3a<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,3,4>, Eigen::Matrix<tDataType,4,4>, Eigen::Matrix<tDataType,6,1>,tDataType> {
+
+static_assert(tNumTangentSpaces == 1, "lie_groups::SE3Affine the number of tangent spaces must be 1.");
+
+
+public:
+
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,6,1> Vec6d;
+typedef Eigen::Matrix<tDataType,3,3> Mat3d;
+typedef Eigen::Matrix<tDataType,3,4> Mat34d;
+typedef Eigen::Matrix<tDataType,4,4> Mat4d;
+typedef Eigen::Matrix<tDataType,6,6> Mat6d;
+
+static constexpr unsigned int dim_ = tNumDimensions;
+static constexpr unsigned int dim_pos_ = 3; /** < The dimension of the position */
+static constexpr unsigned int dim_rot_ = 3; /** < The dimension of the rotation */
+static constexpr unsigned int size1_ = 3;
+static constexpr unsigned int size2_ = 4;
+typedef se3a<tDataType,tNumDimensions,tNumTangentSpaces> Algebra;
+typedef NonAbelian GroupType;
+typedef so3<tDataType> RotAlgebra;
+typedef SO3<tDataType> RotGroup;
+typedef GroupBase<SE3Affine<tDataType,tNumDimensions,tNumTangentSpaces>,se3a<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,3,4>, Eigen::Matrix<tDataType,4,4>, Eigen::Matrix<tDataType,6,1>,tDataType> Base;
+using Base::BoxPlus;
+using Base::BoxMinus;
+
+typedef Eigen::Matrix<tDataType,3,1> Point;  /** < A point the group acts on. */
+typedef Eigen::Matrix<tDataType,3,6> ActJacobian;  /** < The Jacobian of the group action with respect to the element. */
+
+
+Mat34d data_;
+
+/**
+ * Returns a view of the position. The view is computed on demand so that
+ * the element doesn't store pointers into its own data.
+ */
+Eigen::Block<Mat34d,3,1> t() { return data_.template block<3,1>(0,3); }
+Eigen::Block<const Mat34d,3,1> t() const { return data_.template block<3,1>(0,3); }
+
+/**
+ * Returns a view of the rotation.
+ */
+Eigen::Block<Mat34d,3,3> R() { return data_.template block<3,3>(0,0); }
+Eigen::Block<const Mat34d,3,3> R() const { return data_.template block<3,3>(0,0); }
+
+
+/**
+ * Default constructor. Initializes group element to identity.
+ */
+SE3Affine() : data_(Mat34d::Identity() ) {}
+
+
+/**
+ * Copy constructor.
+ */
+SE3Affine(const SE3Affine & g) = default;
+
+/**
+ * Copy assignment
+ */
+SE3Affine& operator = (const SE3Affine& g) = default;
+
+/**
+ * Move constructor.
+ */
+SE3Affine(SE3Affine && g) = default;
+
+/**
+ * Move assignment
+ */
+SE3Affine& operator = (SE3Affine&& g) = default;
+
+/**
+* Initializes group element to the one given. If verify is true
+* it will check that the rotation is an element of \f$SO(3)\f$
+* @param[in] data The top 3x4 block of an element of \f$SE(3)\f$
+* @param verify If true, the constructor will verify that the provided
+* element is a member of \f$SE(3)\f$
+*/
+SE3Affine(const Mat34d & data, bool verify);
+
+/**
+* Initializes group element to the data of the one given.
+* @param[in] data The top 3x4 block of an element of \f$SE(3)\f$
+*/
+SE3Affine(const Mat34d & data) :data_(data) {}
+
+/**
+* Initializes group element to an element of SE3.
+* @param[in] g An element of SE3.
+*/
+explicit SE3Affine(const SE3<tDataType>& g) : data_(g.data_.template topRows<3>()) {}
+
+/**
+ * Returns the element of SE3 with the same data.
+ */
+SE3<tDataType> ToSE3() const {return SE3<tDataType>(Matrix());}
+
+/**
+ * Returns the homogeneous 4x4 matrix of the element.
+ */
+Mat4d Matrix() const {return Algebra::Homogeneous(data_);}
+
+/*
+ * Returns the inverse of the element
+ */
+SE3Affine Inverse() const { return SE3Affine::Inverse(this->data_);}
+
+/*
+ * Returns the inverse of the data of an element, \f$ [R^\top\ -R^\top t] \f$
+ */
+static Mat34d Inverse(const Mat34d& data){
+    Mat34d m;
+    m.template block<3,3>(0,0) = data.template block<3,3>(0,0).transpose();
+    m.template block<3,1>(0,3).noalias() = -m.template block<3,3>(0,0)*data.template block<3,1>(0,3);
+    return m;}
+
+/**
+ * Returns the identity element
+ */
+static SE3Affine Identity(){return SE3Affine();}
+
+/**
+ * Returns the matrix adjoint map.
+ */
+Mat6d Adjoint(){
+    Mat6d m;
+    m.block(0,0,3,3) = R();
+    m.block(3,3,3,3) = R();
+    m.block(0,3,3,3) = se3<tDataType>::SSM(t())*R();
+    m.block(3,0,3,3).setZero();
+    return m;
+}
+
+/**
+ * Applies the adjoint map of the element to v without forming the matrix.
+ * @param v The data of an element of the Cartesian space.
+ */
+Vec6d AdjointAct(const Vec6d& v) const {return AdjointAct(data_,v);}
+
+/**
+ * Applies the adjoint map of the inverse of the element to v without forming the matrix.
+ * @param v The data of an element of the Cartesian space.
+ */
+Vec6d AdjointInvAct(const Vec6d& v) const {return AdjointInvAct(data_,v);}
+
+/**
+ * Transforms a covariance with the adjoint map of the element, \f$ Ad P Ad^\top \f$, without forming the matrix.
+ * @param cov A symmetric covariance of an element of the Cartesian space.
+ */
+Mat6d AdjointTransformCovariance(const Mat6d& cov) const {return AdjointTransformCovariance(data_,cov);}
+
+/**
+ * Applies the adjoint map of the data of an element to v. See SE3::AdjointAct.
+ * @param data The data of an element of the group.
+ * @param v The data of an element of the Cartesian space.
+ */
+static Vec6d AdjointAct(const Mat34d& data, const Vec6d& v) {
+    Vec6d out;
+    out.template block<3,1>(3,0) = data.template block<3,3>(0,0)*v.template block<3,1>(3,0);
+    out.template block<3,1>(0,0) = data.template block<3,3>(0,0)*v.template block<3,1>(0,0) + data.template block<3,1>(0,3).cross(out.template block<3,1>(3,0));
+    return out;
+}
+
+/**
+ * Applies the adjoint map of the inverse of the data of an element to v. See SE3::AdjointInvAct.
+ * @param data The data of an element of the group.
+ * @param v The data of an element of the Cartesian space.
+ */
+static Vec6d AdjointInvAct(const Mat34d& data, const Vec6d& v) {
+    Vec6d out;
+    out.template block<3,1>(3,0) = data.template block<3,3>(0,0).transpose()*v.template block<3,1>(3,0);
+    out.template block<3,1>(0,0) = data.template block<3,3>(0,0).transpose()*(v.template block<3,1>(0,0) - data.template block<3,1>(0,3).cross(v.template block<3,1>(3,0)));
+    return out;
+}
+
+/**
+ * Transforms a covariance with the adjoint map of the data of an element. See SE3::AdjointTransformCovariance.
+ * @param data The data of an element of the group.
+ * @param cov A symmetric covariance of an element of the Cartesian space.
+ */
+static Mat6d AdjointTransformCovariance(const Mat34d& data, const Mat6d& cov) {
+    return SE3<tDataType>::AdjointTransformCovariance(Algebra::Homogeneous(data),cov);
+}
+
+/**
+ * Performs the left group action
+ */
+SE3Affine operator * (const SE3Affine& g){ return SE3Affine(Mult(data_,g.data_)) ;}
+
+/**
+ * Applies the group action to a point, \f$ R p + t \f$.
+ * @param p The point.
+ */
+Point Act(const Point& p) const {return Act(data_,p);}
+
+/**
+ * Applies the group action of the data of an element to a point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ */
+static Point Act(const Mat34d& data, const Point& p) {return data.template block<3,3>(0,0)*p + data.template block<3,1>(0,3);}
+
+/**
+ * Applies the group action of the data of an element to a point and computes the Jacobians of the result with
+ * respect to the element, perturbed on the right as in OPlus, and to the point. See SE3::ActWithJacobians.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ * @param j_pose The Jacobian with respect to the element, \f$ [R,\ -R [p]_\times] \f$.
+ * @param j_point The Jacobian with respect to the point, the rotation \f$ R \f$.
+ * @return The transformed point.
+ */
+static Point ActWithJacobians(const Mat34d& data, const Point& p, ActJacobian& j_pose, Eigen::Matrix<tDataType,3,3>& j_point) {
+    const Point out = Act(data,p);
+    const Point rp = out - data.template block<3,1>(0,3);
+    j_pose.template block<3,3>(0,0) = data.template block<3,3>(0,0);
+    for (int k = 0; k < 3; ++k) {
+        j_pose.col(3+k) = data.template block<3,1>(0,k).cross(rp);
+    }
+    j_point = data.template block<3,3>(0,0);
+    return out;
+}
+
+/**
+ * Applies the group action of the data of an element to n points. See SE3::BatchAct.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param n The number of points.
+ */
+static void BatchAct(const Mat34d& data, const Point* points, Point* out, Eigen::Index n) {
+    if (n <= 0) {
+        return;
+    }
+    // The points are transformed a block at a time through a buffer so that out can alias points.
+    Eigen::Map<const Eigen::Matrix<tDataType,3,Eigen::Dynamic>> points_map(points->data(),3,n);
+    Eigen::Map<Eigen::Matrix<tDataType,3,Eigen::Dynamic>> out_map(out->data(),3,n);
+    Eigen::Matrix<tDataType,3,kBatchActBlockSize> tmp;
+    for (Eigen::Index start = 0; start < n; start += kBatchActBlockSize) {
+        const Eigen::Index len = std::min<Eigen::Index>(kBatchActBlockSize, n-start);
+        tmp.leftCols(len).noalias() = data.template block<3,3>(0,0).lazyProduct(points_map.middleCols(start,len));
+        out_map.middleCols(start,len) = tmp.leftCols(len).colwise() + data.template block<3,1>(0,3);
+    }
+}
+
+/**
+ * Applies the group action of the data of an element to n points and computes the Jacobians of the results with respect
+ * to the element. See SE3::BatchActWithJacobians.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param j_pose The first of the n Jacobians with respect to the element.
+ * @param n The number of points.
+ */
+static void BatchActWithJacobians(const Mat34d& data, const Point* points, Point* out, ActJacobian* j_pose, Eigen::Index n) {
+    Eigen::Matrix<tDataType,3,3> j_point;
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        out[ii] = ActWithJacobians(data,points[ii],j_pose[ii],j_point);
+    }
+}
+
+/**
+ * Performs the group operation between the data of two elements, \f$ [R_1 R_2\ R_1 t_2 + t_1] \f$. It takes
+ * 36 multiplications instead of the 64 of the product of the homogeneous matrices.
+ */
+static Mat34d Mult(const Mat34d& data1, const Mat34d& data2 ){
+    Mat34d m;
+    m.template block<3,3>(0,0).noalias() = data1.template block<3,3>(0,0)*data2.template block<3,3>(0,0);
+    m.template block<3,1>(0,3) = data1.template block<3,3>(0,0)*data2.template block<3,1>(0,3) + data1.template block<3,1>(0,3);
+    return m;
+}
+
+/**
+ * Performs the BoxPlus operation
+ * @param g An element of the group
+ * @param u An element of the Lie algebra.
+ * @return The result of the BoxPlus operation.
+ */
+static SE3Affine BoxPlus(const SE3Affine& g, const Algebra& u)
+{return SE3Affine(Base::OPlus(g.data_,u.data_));}
+
+
+/**
+ * Performs the BoxPlus operation
+ * @param u An element of the Lie algebra.
+ * @return The result of the BoxPlus operation.
+ */
+SE3Affine BoxPlus(const Algebra& u) const
+{return BoxPlus(*this,u);}
+
+/**
+ * Performs the O-minus operation with this being \f$ g_1 \f$ in the equation \f$ \log(g_2^-1*g_1) \f$
+ * @param g An element of the group
+ * @return An element of the Lie algebra
+ */
+Algebra BoxMinus(const SE3Affine& g) const { return Algebra( Algebra::Vee(BoxMinus(g.data_)));}
+
+
+/**
+ * Projects the data of an element that drifted away from the group after many compositions back onto it.
+ * @param data The data of the element.
+ * @tparam tNormalization The policy that projects the rotation, see normalization.h.
+ */
+template <typename tNormalization = PolarNormalization>
+static Mat34d Normalize(const Mat34d& data) {
+    Mat34d m = data;
+    m.template block<3,3>(0,0) = tNormalization::Rotation(Mat3d(data.template block<3,3>(0,0)));
+    return m;
+}
+
+/**
+ * Computes how far the data of an element drifted away from the group, \f$ \|R^\top R - I\| \f$.
+ */
+static tDataType Drift(const Mat34d& data) {return RotationDrift(data.template block<3,3>(0,0));}
+
+/**
+ * Verifies that the rotation of the data of an element is an element of \f$SO(3)\f$.
+ */
+static bool isElement(const Mat34d& data);
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                    Definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+SE3Affine<tDataType,tNumDimensions,tNumTangentSpaces>::SE3Affine(const Eigen::Matrix<tDataType,3,4> & data, bool verify) {
+
+    // First verify that it is a proper group element.
+    if (verify ) {
+        if (SE3Affine::isElement(data)) {
+            data_ = data;
+        } else {
+            std::cerr << "SE3Affine::Constructor not valid input setting to identity" << std::endl;
+            data_.setIdentity();
+        }
+    } else {
+        data_ = data;
+    }
+}
+
+
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+bool SE3Affine<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Eigen::Matrix<tDataType,3,4>& data) {
+    return (data.template block<3,3>(0,0).transpose()*data.template block<3,3>(0,0) - Mat3d::Identity()).norm() <= ScalarTraits<tDataType>::group_threshold_;
+}
+
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_SE3AFFINE_
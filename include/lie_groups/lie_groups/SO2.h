@@ -14,7 +14,7 @@ namespace lie_groups {
 constexpr double kSO2_threshold_ = 1e-7;
 
 template <typename tDataType=double, int tNumDimensions=1, int tNumTangentSpaces=1>
-class SO2 : public GroupBase<SO2<tDataType,tNumDimensions,tNumTangentSpaces>,so2<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,2,2>, Eigen::Matrix<tDataType,2,2>, Eigen::Matrix<tDataType,1,1>>{
+class SO2 : public GroupBase<SO2<tDataType,tNumDimensions,tNumTangentSpaces>,so2<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,2,2>, Eigen::Matrix<tDataType,2,2>, Eigen::Matrix<tDataType,1,1>, tDataType>{
 
 static_assert(tNumTangentSpaces == 1, "lie_groups::SO2 the number of tangent spaces must be greater than 0.");
 
@@ -30,10 +30,13 @@ static constexpr unsigned int size1_ = 2;
 static constexpr unsigned int size2_ = 2;
 typedef so2<tDataType,tNumDimensions,tNumTangentSpaces> Algebra;
 typedef Abelian GroupType;
-typedef GroupBase<SO2<tDataType,tNumDimensions,tNumTangentSpaces>,so2<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,2,2>, Eigen::Matrix<tDataType,2,2>, Eigen::Matrix<tDataType,1,1>> Base;
+typedef GroupBase<SO2<tDataType,tNumDimensions,tNumTangentSpaces>,so2<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,2,2>, Eigen::Matrix<tDataType,2,2>, Eigen::Matrix<tDataType,1,1>, tDataType> Base;
 using Base::BoxPlus;
 using Base::BoxMinus;
 
+typedef Eigen::Matrix<tDataType,2,1> Point;  /** < A point the group acts on. */
+typedef Eigen::Matrix<tDataType,2,1> ActJacobian;  /** < The Jacobian of the group action with respect to the element. */
+
 Mat2d data_;
 
 /**
@@ -45,22 +48,22 @@ SO2() : data_(Mat2d::Identity()){}
 /**
  * Copy constructor.
  */ 
-SO2(const SO2 & g) : data_(g.data_) {}
+SO2(const SO2 & g) = default;
 
 /**
  * Copy assignment
  */ 
-void operator = (const SO2& g){ this->data_ = g.data_; }
+SO2& operator = (const SO2& g) = default;
 
 /**
  * Move constructor.
  */ 
-SO2(const SO2 && g) : data_(g.data_) {}
+SO2(SO2 && g) = default;
 
 /**
  * Move assignment
  */ 
-void operator = (const SO2&& g){ this->data_ = g.data_; }
+SO2& operator = (SO2&& g) = default;
 
 /**
 * Initializes group element to the one given. If verify is true
@@ -105,6 +108,75 @@ Mat1d Adjoint(){return Mat1d::Identity();}
  */ 
 SO2 operator * (const SO2& g){ return SO2(data_ *g.data_);}
 
+/**
+ * Applies the group action to a point, \f$ R p \f$.
+ * @param p The point.
+ */
+Point Act(const Point& p) const {return Act(data_,p);}
+
+/**
+ * Applies the group action of the data of an element to a point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ */
+static Point Act(const Mat2d& data, const Point& p) {return data*p;}
+
+/**
+ * Applies the group action of the data of an element to a point and computes the Jacobians of the result with
+ * respect to the element, perturbed on the right as in OPlus, and to the point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ * @param j_pose The Jacobian with respect to the element, \f$ S R p \f$ with \f$ S \f$ being SSM(1).
+ * @param j_point The Jacobian with respect to the point, the rotation \f$ R \f$.
+ * @return The transformed point.
+ */
+static Point ActWithJacobians(const Mat2d& data, const Point& p, ActJacobian& j_pose, Eigen::Matrix<tDataType,2,2>& j_point) {
+    const Point out = Act(data,p);
+    // R exp(th) p is about R p + th R S p and R S p = S R p in the plane
+    j_pose << -out(1), out(0);
+    j_point = data;
+    return out;
+}
+
+/**
+ * Applies the group action of the data of an element to n points. The points are stored contiguously so that
+ * they are transformed as the columns of a single matrix, which Eigen vectorizes.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param n The number of points.
+ */
+static void BatchAct(const Mat2d& data, const Point* points, Point* out, Eigen::Index n) {
+    if (n <= 0) {
+        return;
+    }
+    // The points are transformed a block at a time through a buffer so that out can alias points.
+    Eigen::Map<const Eigen::Matrix<tDataType,2,Eigen::Dynamic>> points_map(points->data(),2,n);
+    Eigen::Map<Eigen::Matrix<tDataType,2,Eigen::Dynamic>> out_map(out->data(),2,n);
+    Eigen::Matrix<tDataType,2,kBatchActBlockSize> tmp;
+    for (Eigen::Index start = 0; start < n; start += kBatchActBlockSize) {
+        const Eigen::Index len = std::min<Eigen::Index>(kBatchActBlockSize, n-start);
+        tmp.leftCols(len).noalias() = data.lazyProduct(points_map.middleCols(start,len));
+        out_map.middleCols(start,len) = tmp.leftCols(len);
+    }
+}
+
+/**
+ * Applies the group action of the data of an element to n points and computes the Jacobians of the results with respect
+ * to the element. The Jacobian with respect to every point is the rotation \f$ R \f$ so it is not repeated.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param j_pose The first of the n Jacobians with respect to the element.
+ * @param n The number of points.
+ */
+static void BatchActWithJacobians(const Mat2d& data, const Point* points, Point* out, ActJacobian* j_pose, Eigen::Index n) {
+    Eigen::Matrix<tDataType,2,2> j_point;
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        out[ii] = ActWithJacobians(data,points[ii],j_pose[ii],j_point);
+    }
+}
+
 /**
  * Performs the group operation between the data of two elements
  */ 
@@ -144,6 +216,19 @@ void Print() {
     std::cout << data_ << std::endl; 
 }
 
+/**
+ * Projects the data of an element that drifted away from the group after many compositions back onto it.
+ * @param data The data of the element.
+ * @tparam tNormalization The policy that projects the rotation, see normalization.h.
+ */
+template <typename tNormalization = PolarNormalization>
+static Mat2d Normalize(const Mat2d& data) {return tNormalization::Rotation(data);}
+
+/**
+ * Computes how far the data of an element drifted away from the group, \f$ \|R^\top R - I\| \f$.
+ */
+static tDataType Drift(const Mat2d& data) {return RotationDrift(data);}
+
 /**
  * Verifies that the data of an element properly corresponds to the set. 
  */ 
@@ -173,7 +258,7 @@ SO2<tDataType,tNumDimensions,tNumTangentSpaces>::SO2(const Eigen::Matrix<tDataTy
 //----------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 bool SO2<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Eigen::Matrix<tDataType,2,2>& data) {
-    return (data.transpose()*data - Mat2d::Identity()).norm() < kSO2_threshold_;
+    return (data.transpose()*data - Mat2d::Identity()).norm() < ScalarTraits<tDataType>::group_threshold_;
 }
 
 
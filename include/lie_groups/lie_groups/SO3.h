@@ -14,7 +14,7 @@ constexpr double kSO3_threshold_ = 1e-6;
 template <typename tDataType=double, int tNumDimensions=3, int tNumTangentSpaces=1>
 class SO3 : public GroupBase<SO3<tDataType,tNumDimensions,tNumTangentSpaces>,so3<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,3,3>, Eigen::Matrix<tDataType,3,3>, Eigen::Matrix<tDataType,3,1>,tDataType> {
 
-static_assert(tNumTangentSpaces == 1, "lie_groups::SO3 the number of tangent spaces must be 1.");
+static_assert(tNumTangentSpaces > 0, "lie_groups::SO3 the number of tangent spaces must be greater than 0.");
 
 
 public:
@@ -31,6 +31,9 @@ typedef NonAbelian GroupType;
 using Base::BoxPlus;
 using Base::BoxMinus;
 
+typedef Eigen::Matrix<tDataType,3,1> Point;  /** < A point the group acts on. */
+typedef Eigen::Matrix<tDataType,3,3> ActJacobian;  /** < The Jacobian of the group action with respect to the element. */
+
  Mat3d data_;
 
 /**
@@ -42,22 +45,22 @@ SO3() : data_( Mat3d::Identity()){}
 /**
  * Copy constructor.
  */ 
-SO3(const SO3 & g) : data_(g.data_) {}
+SO3(const SO3 & g) = default;
 
 /**
  * copy assignment
  */ 
-void operator = (const SO3& g){ this->data_ = g.data_; }
+SO3& operator = (const SO3& g) = default;
 
 /**
  * Move constructor.
  */ 
-SO3(const SO3 && g) : data_(g.data_) {}
+SO3(SO3 && g) = default;
 
 /**
  * Move assignment
  */ 
-void operator = (const SO3&& g){ this->data_ = g.data_; }
+SO3& operator = (SO3&& g) = default;
 
 /**
 * Initializes group element to the one given. If verify is true
@@ -101,6 +104,77 @@ static SO3 Identity(){return SO3();}
  */ 
 SO3 operator * (const SO3& g){ return SO3(data_ *g.data_);}
 
+/**
+ * Applies the group action to a point, \f$ R p \f$.
+ * @param p The point.
+ */
+Point Act(const Point& p) const {return Act(data_,p);}
+
+/**
+ * Applies the group action of the data of an element to a point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ */
+static Point Act(const Mat3d& data, const Point& p) {return data*p;}
+
+/**
+ * Applies the group action of the data of an element to a point and computes the Jacobians of the result with
+ * respect to the element, perturbed on the right as in OPlus, and to the point.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ * @param j_pose The Jacobian with respect to the element, \f$ -R [p]_\times \f$.
+ * @param j_point The Jacobian with respect to the point, the rotation \f$ R \f$.
+ * @return The transformed point.
+ */
+static Point ActWithJacobians(const Mat3d& data, const Point& p, ActJacobian& j_pose, Eigen::Matrix<tDataType,3,3>& j_point) {
+    const Point out = Act(data,p);
+    // R exp(w) p is about R p - R [p]x w and R [p]x = [R p]x R so column k is R_k x R p
+    for (int k = 0; k < 3; ++k) {
+        j_pose.col(k) = data.col(k).cross(out);
+    }
+    j_point = data;
+    return out;
+}
+
+/**
+ * Applies the group action of the data of an element to n points. The points are stored contiguously so that
+ * they are transformed as the columns of a single matrix, which Eigen vectorizes.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param n The number of points.
+ */
+static void BatchAct(const Mat3d& data, const Point* points, Point* out, Eigen::Index n) {
+    if (n <= 0) {
+        return;
+    }
+    // The points are transformed a block at a time through a buffer so that out can alias points.
+    Eigen::Map<const Eigen::Matrix<tDataType,3,Eigen::Dynamic>> points_map(points->data(),3,n);
+    Eigen::Map<Eigen::Matrix<tDataType,3,Eigen::Dynamic>> out_map(out->data(),3,n);
+    Eigen::Matrix<tDataType,3,kBatchActBlockSize> tmp;
+    for (Eigen::Index start = 0; start < n; start += kBatchActBlockSize) {
+        const Eigen::Index len = std::min<Eigen::Index>(kBatchActBlockSize, n-start);
+        tmp.leftCols(len).noalias() = data.lazyProduct(points_map.middleCols(start,len));
+        out_map.middleCols(start,len) = tmp.leftCols(len);
+    }
+}
+
+/**
+ * Applies the group action of the data of an element to n points and computes the Jacobians of the results with respect
+ * to the element. The Jacobian with respect to every point is the rotation \f$ R \f$ so it is not repeated.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param j_pose The first of the n Jacobians with respect to the element.
+ * @param n The number of points.
+ */
+static void BatchActWithJacobians(const Mat3d& data, const Point* points, Point* out, ActJacobian* j_pose, Eigen::Index n) {
+    Eigen::Matrix<tDataType,3,3> j_point;
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        out[ii] = ActWithJacobians(data,points[ii],j_pose[ii],j_point);
+    }
+}
+
 /**
  * Performs the group operation between the data of two elements
  */ 
@@ -134,6 +208,19 @@ SO3 BoxPlus(const Algebra& u) const
 Algebra BoxMinus(const SO3& g) const { return Algebra( Algebra::Vee(BoxMinus(g.data_)));}
 
 
+/**
+ * Projects the data of an element that drifted away from the group after many compositions back onto it.
+ * @param data The data of the element.
+ * @tparam tNormalization The policy that projects the rotation, see normalization.h.
+ */
+template <typename tNormalization = PolarNormalization>
+static Mat3d Normalize(const Mat3d& data) {return tNormalization::Rotation(data);}
+
+/**
+ * Computes how far the data of an element drifted away from the group, \f$ \|R^\top R - I\| \f$.
+ */
+static tDataType Drift(const Mat3d& data) {return RotationDrift(data);}
+
 /**
  * Verifies that the data of an element properly corresponds to the set. 
  */ 
@@ -164,7 +251,7 @@ SO3<tDataType,tNumDimensions,tNumTangentSpaces>::SO3(const  Eigen::Matrix<tDataT
 //----------------------------------------------------------
 template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
 bool SO3<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const  Eigen::Matrix<tDataType,3,3>& data) {
-    return (data.transpose()*data -  Mat3d::Identity()).norm() < kSO3_threshold_;
+    return (data.transpose()*data -  Mat3d::Identity()).norm() < ScalarTraits<tDataType>::group_threshold_;
 }
 
 
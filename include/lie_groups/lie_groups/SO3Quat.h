@@ -0,0 +1,280 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_SO3QUAT_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_SO3QUAT_
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <iostream>
+
+#include "lie_groups/lie_algebras/so3q.h"
+#include "lie_groups/lie_groups/SO3.h"
+#include "lie_groups/lie_groups/group_base.h"
+
+namespace lie_groups {
+
+/**
+ * The group \f$SO(3)\f$ with the elements stored as unit quaternions. It has the interface of SO3 but an element
+ * takes 4 scalars instead of 9 and the group operation takes 16 multiplications instead of 27. The quaternions are
+ * stored as the vector \f$ (x,y,z,w) \f$, the order of the coefficients of Eigen::Quaternion. The group operation does
+ * not normalize the result so the norm of long products drifts by the rounding error of every product.
+ */
+template <typename tDataType=double, int tNumDimensions=3, int tNumTangentSpaces=1>
+class SO3Quat : public GroupBase<SO3Quat<tDataType,tNumDimensions,tNumTangentSpaces>,so3q<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,4,1>, Eigen::Matrix<tDataType,3,3>, Eigen::Matrix<tDataType,3,1>,tDataType> {
+
+static_assert(tNumTangentSpaces == 1, "lie_groups::SO3Quat the number of tangent spaces must be 1.");
+
+
+public:
+
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
+typedef Eigen::Matrix<tDataType,3,3> Mat3d;
+typedef Eigen::Quaternion<tDataType> Quaternion;
+
+static constexpr unsigned int dim_ = tNumDimensions;
+static constexpr unsigned int size1_ = 4;
+static constexpr unsigned int size2_ = 1;
+typedef GroupBase<SO3Quat<tDataType,tNumDimensions,tNumTangentSpaces>,so3q<tDataType,tNumDimensions,tNumTangentSpaces>, Eigen::Matrix<tDataType,4,1>, Eigen::Matrix<tDataType,3,3>, Eigen::Matrix<tDataType,3,1>,tDataType> Base;
+typedef so3q<tDataType,tNumDimensions,tNumTangentSpaces> Algebra;
+typedef NonAbelian GroupType;
+using Base::BoxPlus;
+using Base::BoxMinus;
+
+typedef Eigen::Matrix<tDataType,3,1> Point;  /** < A point the group acts on. */
+typedef Eigen::Matrix<tDataType,3,3> ActJacobian;  /** < The Jacobian of the group action with respect to the element. */
+
+Vec4d data_;
+
+/**
+ * Default constructor. Initializes group element to identity.
+ */
+SO3Quat() : data_(0,0,0,1) {}
+
+/**
+ * Copy constructor.
+ */
+SO3Quat(const SO3Quat & g) = default;
+
+/**
+ * copy assignment
+ */
+SO3Quat& operator = (const SO3Quat& g) = default;
+
+/**
+ * Move constructor.
+ */
+SO3Quat(SO3Quat && g) = default;
+
+/**
+ * Move assignment
+ */
+SO3Quat& operator = (SO3Quat&& g) = default;
+
+/**
+* Initializes group element to the one given. If verify is true
+* it will check that the input is a unit quaternion.
+* @param[in] data The unit quaternion of an element of \f$SO(3)\f$
+* @param verify If true, the constructor will verify that the provided
+* element is a member of \f$SO(3)\f$
+*/
+SO3Quat(const Vec4d & data, bool verify);
+
+/**
+* Initializes group element to the data of the one given.
+* @param[in] data The unit quaternion of an element of \f$SO(3)\f$
+*/
+SO3Quat(const Vec4d & data) :data_(data){}
+
+/**
+* Initializes group element to the rotation of an element of SO3.
+* @param[in] g An element of SO3.
+*/
+explicit SO3Quat(const SO3<tDataType>& g) : data_(FromRotationMatrix(g.data_)) {}
+
+/**
+ * Returns the element of SO3 with the same rotation.
+ */
+SO3<tDataType> ToSO3() const {return SO3<tDataType>(ToRotationMatrix(data_));}
+
+/**
+ * Converts a rotation matrix to a unit quaternion.
+ * @param data The data of an element of SO3.
+ */
+static Vec4d FromRotationMatrix(const Mat3d& data) {return Quaternion(data).coeffs();}
+
+/**
+ * Converts a unit quaternion to a rotation matrix.
+ * @param data The unit quaternion of an element of the group.
+ */
+static Mat3d ToRotationMatrix(const Vec4d& data) {return Eigen::Map<const Quaternion>(data.data()).toRotationMatrix();}
+
+/*
+ * Returns the inverse of the element
+ */
+SO3Quat Inverse() const { return SO3Quat::Inverse(this->data_);}
+
+/*
+ * Returns the inverse of the data of an element, the conjugate of the quaternion.
+ */
+static Vec4d Inverse(const Vec4d& data){ return Vec4d(-data(0),-data(1),-data(2),data(3));}
+
+/**
+ * Returns the identity element
+ */
+static SO3Quat Identity(){return SO3Quat();}
+
+/**
+ * Returns the matrix adjoint map. It is the rotation matrix.
+ */
+Mat3d Adjoint(){return ToRotationMatrix(data_);}
+
+/**
+ * Performs the left group action on itself. i.e. this is on the left of
+ * the bilinear operation.
+ */
+SO3Quat operator * (const SO3Quat& g){ return SO3Quat(Mult(data_,g.data_));}
+
+/**
+ * Applies the group action to a point, \f$ q p q^{-1} \f$.
+ * @param p The point.
+ */
+Point Act(const Point& p) const {return Act(data_,p);}
+
+/**
+ * Applies the group action of the data of an element to a point, \f$ p + 2w(v \times p) + 2v \times (v \times p) \f$
+ * where v and w are the vector and scalar parts of the quaternion.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ */
+static Point Act(const Vec4d& data, const Point& p) {
+    const Vec3d v = data.template head<3>();
+    const Vec3d t = static_cast<tDataType>(2.0)*v.cross(p);
+    return p + data(3)*t + v.cross(t);
+}
+
+/**
+ * Applies the group action of the data of an element to a point and computes the Jacobians of the result with
+ * respect to the element, perturbed on the right as in OPlus, and to the point. See SO3::ActWithJacobians.
+ * @param data The data of an element of the group.
+ * @param p The point.
+ * @param j_pose The Jacobian with respect to the element, \f$ -R [p]_\times \f$.
+ * @param j_point The Jacobian with respect to the point, the rotation \f$ R \f$.
+ * @return The transformed point.
+ */
+static Point ActWithJacobians(const Vec4d& data, const Point& p, ActJacobian& j_pose, Eigen::Matrix<tDataType,3,3>& j_point) {
+    return SO3<tDataType>::ActWithJacobians(ToRotationMatrix(data),p,j_pose,j_point);
+}
+
+/**
+ * Applies the group action of the data of an element to n points. The rotation matrix is formed once and the points
+ * are transformed by SO3::BatchAct.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param n The number of points.
+ */
+static void BatchAct(const Vec4d& data, const Point* points, Point* out, Eigen::Index n) {
+    SO3<tDataType>::BatchAct(ToRotationMatrix(data),points,out,n);
+}
+
+/**
+ * Applies the group action of the data of an element to n points and computes the Jacobians of the results with respect
+ * to the element. See SO3::BatchActWithJacobians.
+ * @param data The data of an element of the group.
+ * @param points The first of the n points.
+ * @param out The first of the n transformed points. It can be the same as points.
+ * @param j_pose The first of the n Jacobians with respect to the element.
+ * @param n The number of points.
+ */
+static void BatchActWithJacobians(const Vec4d& data, const Point* points, Point* out, ActJacobian* j_pose, Eigen::Index n) {
+    SO3<tDataType>::BatchActWithJacobians(ToRotationMatrix(data),points,out,j_pose,n);
+}
+
+/**
+ * Performs the group operation between the data of two elements, the Hamilton product of the quaternions.
+ */
+static Vec4d Mult(const Vec4d& data1, const Vec4d& data2 ){
+    const tDataType x1 = data1(0), y1 = data1(1), z1 = data1(2), w1 = data1(3);
+    const tDataType x2 = data2(0), y2 = data2(1), z2 = data2(2), w2 = data2(3);
+    return Vec4d(w1*x2 + x1*w2 + y1*z2 - z1*y2,
+                 w1*y2 - x1*z2 + y1*w2 + z1*x2,
+                 w1*z2 + x1*y2 - y1*x2 + z1*w2,
+                 w1*w2 - x1*x2 - y1*y2 - z1*z2);
+}
+
+/**
+ * Performs the BoxPlus operation
+ * @param g An element of the group
+ * @param u An element of the Lie algebra.
+ * @return The result of the BoxPlus operation.
+ */
+static SO3Quat BoxPlus(const SO3Quat& g, const Algebra& u)
+{return SO3Quat(Base::OPlus(g.data_,u.data_));}
+
+
+/**
+ * Performs the BoxPlus operation
+ * @param u An element of the Lie algebra.
+ * @return The result of the BoxPlus operation.
+ */
+SO3Quat BoxPlus(const Algebra& u) const
+{return BoxPlus(*this,u);}
+
+/**
+ * Performs the O-minus operation with this being \f$ g_1 \f$ in the equation \f$ \log(g_2^-1*g_1) \f$
+ * @param g An element of the group
+ * @return An element of the Lie algebra
+ */
+Algebra BoxMinus(const SO3Quat& g) const { return Algebra( Algebra::Vee(BoxMinus(g.data_)));}
+
+
+/**
+ * Projects the data of an element that drifted away from the group after many compositions back onto it. The quaternion is
+ * normalized, which is exact, whatever the policy.
+ * @param data The data of the element.
+ * @tparam tNormalization The policy that projects the rotation, see normalization.h.
+ */
+template <typename tNormalization = PolarNormalization>
+static Vec4d Normalize(const Vec4d& data) {return data.normalized();}
+
+/**
+ * Computes how far the data of an element drifted away from the group, \f$ |q^\top q - 1| \f$.
+ */
+static tDataType Drift(const Vec4d& data) {return std::abs(data.squaredNorm() - static_cast<tDataType>(1.0));}
+
+/**
+ * Verifies that the data of an element is a unit quaternion.
+ */
+static bool isElement(const Vec4d& data);
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                    Definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+SO3Quat<tDataType,tNumDimensions,tNumTangentSpaces>::SO3Quat(const Eigen::Matrix<tDataType,4,1> & data, bool verify) {
+
+    // First verify that it is a proper group element.
+    if (verify ) {
+        if (SO3Quat::isElement(data)) {
+            data_ = data;
+        } else {
+            std::cerr << "SO3Quat::Constructor not valid input setting to identity" << std::endl;
+            data_ = Vec4d(0,0,0,1);
+        }
+    } else {
+        data_ = data;
+    }
+}
+
+
+//----------------------------------------------------------
+template <typename tDataType, int tNumDimensions, int tNumTangentSpaces>
+bool SO3Quat<tDataType,tNumDimensions,tNumTangentSpaces>::isElement(const Eigen::Matrix<tDataType,4,1>& data) {
+    return std::abs(data.squaredNorm() - static_cast<tDataType>(1.0)) < ScalarTraits<tDataType>::group_threshold_;
+}
+
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_SO3QUAT_
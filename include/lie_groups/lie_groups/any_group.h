@@ -0,0 +1,323 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_ANYGROUP_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_ANYGROUP_
+
+#include <Eigen/Dense>
+#include <iostream>
+#include <string>
+
+#include "lie_groups/lie_algebras/any_algebra.h"
+#include "lie_groups/lie_groups/Rn.h"
+#include "lie_groups/lie_groups/SO2.h"
+#include "lie_groups/lie_groups/SO3.h"
+#include "lie_groups/lie_groups/SE2.h"
+#include "lie_groups/lie_groups/SE3.h"
+#include "lie_groups/lie_groups/SO3Quat.h"
+#include "lie_groups/lie_groups/SE3Affine.h"
+#include "lie_groups/lie_groups/SE2Complex.h"
+
+namespace lie_groups {
+
+constexpr int kAnyMaxGroupSize = 16; /** < The largest number of scalars of the data of an element of AnyGroup. */
+
+namespace internal {
+
+/**
+ * The names of the groups that AnyGroup can create at run time, see AnyGroup::Identity.
+ */
+template <typename tGroup> struct AnyGroupName;
+template <typename tDataType, int tNumDimensions> struct AnyGroupName<Rn<tDataType,tNumDimensions,1>> {
+    static constexpr const char* value = tNumDimensions == 1 ? "R1" : tNumDimensions == 2 ? "R2" : tNumDimensions == 3 ? "R3" :
+                                         tNumDimensions == 4 ? "R4" : tNumDimensions == 5 ? "R5" : "R6";
+};
+template <typename tDataType> struct AnyGroupName<SO2<tDataType,1,1>> {static constexpr const char* value = "SO2";};
+template <typename tDataType> struct AnyGroupName<SO3<tDataType,3,1>> {static constexpr const char* value = "SO3";};
+template <typename tDataType> struct AnyGroupName<SE2<tDataType,3,1>> {static constexpr const char* value = "SE2";};
+template <typename tDataType> struct AnyGroupName<SE3<tDataType,6,1>> {static constexpr const char* value = "SE3";};
+template <typename tDataType> struct AnyGroupName<SO3Quat<tDataType,3,1>> {static constexpr const char* value = "SO3Quat";};
+template <typename tDataType> struct AnyGroupName<SE3Affine<tDataType,6,1>> {static constexpr const char* value = "SE3Affine";};
+template <typename tDataType> struct AnyGroupName<SE2Complex<tDataType,3,1>> {static constexpr const char* value = "SE2Complex";};
+
+/**
+ * The operations of one group on the data of AnyGroup. The data is given as a pointer to its scalars in column-major
+ * order and the Cartesian data as a pointer to kAnyMaxDim scalars.
+ */
+template <typename tDataType>
+struct AnyGroupTable {
+    typedef typename AnyAlgebraTable<tDataType>::Mat Mat;
+
+    const char* name_;                            /** < The name of the group. */
+    int rows_;                                    /** < The size of the data of an element. */
+    int cols_;
+    const AnyAlgebraTable<tDataType>* algebra_;   /** < The table of the Lie algebra. */
+    void (*identity_)(tDataType* g);
+    void (*mult_)(const tDataType* g1, const tDataType* g2, tDataType* out);
+    void (*inverse_)(const tDataType* g, tDataType* out);
+    void (*log_)(const tDataType* g, tDataType* u);
+    void (*oplus_)(const tDataType* g, const tDataType* u, tDataType* out);
+    void (*ominus_)(const tDataType* g1, const tDataType* g2, tDataType* u);
+    void (*adjoint_)(const tDataType* g, Mat& m);
+    void (*normalize_)(const tDataType* g, tDataType* out);
+    tDataType (*drift_)(const tDataType* g);
+};
+
+/**
+ * Implements the table of AnyGroup with the static functions of tGroup.
+ */
+template <typename tGroup, typename tDataType>
+struct AnyGroupModel {
+
+    typedef typename tGroup::Algebra Algebra;
+    typedef typename tGroup::Base::Mat_G Mat_G;
+    typedef typename tGroup::Base::Mat_C Mat_C;
+    typedef typename AnyGroupTable<tDataType>::Mat Mat;
+    static constexpr int dim_ = Algebra::dim_;
+
+    static_assert(std::is_same<typename tGroup::Base::DataType, tDataType>::value,
+                  "lie_groups::AnyGroup the data type of the group must be the one of AnyGroup.");
+    static_assert(Mat_G::SizeAtCompileTime <= kAnyMaxGroupSize && Mat_G::RowsAtCompileTime <= kAnyMaxDim,
+                  "lie_groups::AnyGroup the data of the group is too large.");
+
+    static Eigen::Map<Mat_G> GroupMap(tDataType* g) {return Eigen::Map<Mat_G>(g);}
+    static Eigen::Map<Mat_C> CartesianMap(tDataType* u) {return Eigen::Map<Mat_C>(u);}
+
+    static tGroup Load(const tDataType* g) {
+        tGroup out;
+        out.data_ = Eigen::Map<const Mat_G>(g);
+        return out;
+    }
+
+    static void Identity(tDataType* g) {GroupMap(g) = tGroup().data_;}
+    static void Mult(const tDataType* g1, const tDataType* g2, tDataType* out) {
+        GroupMap(out) = tGroup::Mult(Eigen::Map<const Mat_G>(g1),Eigen::Map<const Mat_G>(g2));
+    }
+    static void Inverse(const tDataType* g, tDataType* out) {GroupMap(out) = tGroup::Inverse(Eigen::Map<const Mat_G>(g));}
+    static void Log(const tDataType* g, tDataType* u) {CartesianMap(u) = Algebra::Log(Eigen::Map<const Mat_G>(g));}
+    static void OPlus(const tDataType* g, const tDataType* u, tDataType* out) {
+        GroupMap(out) = tGroup::OPlus(Eigen::Map<const Mat_G>(g),Eigen::Map<const Mat_C>(u));
+    }
+    static void OMinus(const tDataType* g1, const tDataType* g2, tDataType* u) {
+        CartesianMap(u) = tGroup::OMinus(Eigen::Map<const Mat_G>(g1),Eigen::Map<const Mat_G>(g2));
+    }
+    static void Adjoint(const tDataType* g, Mat& m) {m = Load(g).Adjoint().template topLeftCorner<dim_,dim_>();}
+    static void Normalize(const tDataType* g, tDataType* out) {GroupMap(out) = tGroup::Normalize(Eigen::Map<const Mat_G>(g));}
+    static tDataType Drift(const tDataType* g) {return tGroup::Drift(Eigen::Map<const Mat_G>(g));}
+
+    static const AnyGroupTable<tDataType> table_;
+};
+
+template <typename tGroup, typename tDataType>
+const AnyGroupTable<tDataType> AnyGroupModel<tGroup,tDataType>::table_ = {
+    AnyGroupName<tGroup>::value, static_cast<int>(Mat_G::RowsAtCompileTime), static_cast<int>(Mat_G::ColsAtCompileTime),
+    &AnyAlgebraModel<Algebra,tDataType>::table_,
+    &Identity, &Mult, &Inverse, &Log, &OPlus, &OMinus, &Adjoint, &Normalize, &Drift};
+
+} // namespace internal
+
+/**
+ * An element of any of the groups whose type is chosen at run time, e.g. from a configuration file with
+ * AnyGroup::Identity("SE3"). The data is stored in a buffer of kAnyMaxGroupSize scalars next to a pointer to the table
+ * of the operations of the group, so an element never allocates and every operation is one indirect call to the static
+ * functions of the group. The groups with several tangent spaces are not supported.
+ *
+ * The operations between two elements require elements of the same group, otherwise they print an error and
+ * return an empty element. An empty element has no group; it is only valid to check Empty on it and to assign to it.
+ */
+template <typename tDataType = double>
+class AnyGroup {
+
+public:
+
+typedef AnyAlgebra<tDataType> Algebra;
+typedef typename Algebra::Mat_C Mat_C;                                                              /**< The Cartesian space data type. */
+typedef typename Algebra::Mat_Jac Mat_Jac;                                                          /**< The Jacobian data type. */
+typedef Eigen::Matrix<tDataType,Eigen::Dynamic,Eigen::Dynamic,0,kAnyMaxDim,kAnyMaxDim> Mat_G;      /**< The group data type. */
+
+/**
+ * Default constructor. The element is empty.
+ */
+AnyGroup() : table_(nullptr), data_() {}
+
+/**
+ * Stores an element of the group tGroup.
+ */
+template <typename tGroup>
+explicit AnyGroup(const tGroup& g) : table_(&internal::AnyGroupModel<tGroup,tDataType>::table_), data_() {
+    internal::AnyGroupModel<tGroup,tDataType>::GroupMap(data_) = g.data_;
+}
+
+/**
+ * Returns the identity element of the group with the given name: R1 to R6, SO2, SO3, SE2, SE3, SO3Quat, SE3Affine or
+ * SE2Complex. If the name is unknown an error is printed and the element is empty.
+ */
+static AnyGroup Identity(const std::string& name);
+
+/**
+ * Returns true if the element has no group.
+ */
+bool Empty() const {return table_ == nullptr;}
+
+/**
+ * Returns true if the element belongs to the group tGroup.
+ */
+template <typename tGroup>
+bool Is() const {return table_ == &internal::AnyGroupModel<tGroup,tDataType>::table_;}
+
+/**
+ * Returns the element as an element of tGroup. It must belong to it, see Is.
+ */
+template <typename tGroup>
+tGroup Get() const {return internal::AnyGroupModel<tGroup,tDataType>::Load(data_);}
+
+/**
+ * Returns the name of the group.
+ */
+const char* Name() const {return table_->name_;}
+
+/**
+ * Returns the dimension of the group.
+ */
+int Dim() const {return table_->algebra_->dim_;}
+
+/**
+ * Returns the data of the element.
+ */
+Mat_G Data() const {return Eigen::Map<const Mat_G>(data_,table_->rows_,table_->cols_);}
+
+/**
+ * Composes two elements of the same group, \f$ g_1 g_2 \f$ with this being \f$ g_1 \f$.
+ */
+AnyGroup Mult(const AnyGroup& g) const {
+    if (!Compatible(g,"Mult")) {
+        return AnyGroup();
+    }
+    AnyGroup out(table_);
+    table_->mult_(data_,g.data_,out.data_);
+    return out;
+}
+
+/**
+ * Composes two elements of the same group.
+ */
+AnyGroup operator * (const AnyGroup& g) const {return Mult(g);}
+
+/**
+ * Returns the inverse of the element.
+ */
+AnyGroup Inverse() const {AnyGroup out(table_); table_->inverse_(data_,out.data_); return out;}
+
+/**
+ * Computes the log of the element.
+ */
+Algebra Log() const {Algebra u(table_->algebra_); table_->log_(data_,u.data_); return u;}
+
+/**
+ * Performs the OPlus operation \f$ g \exp(u) \f$.
+ * @param u_data The Cartesian data. Its size is the dimension of the group.
+ */
+AnyGroup OPlus(const Mat_C& u_data) const {
+    AnyGroup out(table_);
+    tDataType u[kAnyMaxDim];
+    Eigen::Map<Mat_C> u_map(u,table_->algebra_->dim_);
+    u_map = u_data;
+    table_->oplus_(data_,u,out.data_);
+    return out;
+}
+
+/**
+ * Performs the OPlus operation \f$ g \exp(u) \f$ with an element of the Lie algebra of the group.
+ */
+AnyGroup OPlus(const Algebra& u) const {
+    if (u.table_ != table_->algebra_) {
+        std::cerr << "AnyGroup::OPlus the element does not belong to the Lie algebra of the group" << std::endl;
+        return AnyGroup();
+    }
+    AnyGroup out(table_);
+    table_->oplus_(data_,u.data_,out.data_);
+    return out;
+}
+
+/**
+ * Performs the O-minus operation \f$ \log(g_2^{-1} g_1) \f$ with this being \f$ g_1 \f$.
+ */
+Algebra OMinus(const AnyGroup& g) const {
+    if (!Compatible(g,"OMinus")) {
+        return Algebra();
+    }
+    Algebra u(table_->algebra_);
+    table_->ominus_(data_,g.data_,u.data_);
+    return u;
+}
+
+/**
+ * Computes the adjoint of the element.
+ */
+Mat_Jac Adjoint() const {Mat_Jac m; table_->adjoint_(data_,m); return m;}
+
+/**
+ * Projects the element back onto the group with PolarNormalization, see normalization.h.
+ */
+void NormalizeEq() {table_->normalize_(data_,data_);}
+
+/**
+ * Computes how far the element drifted away from the group.
+ */
+tDataType Drift() const {return table_->drift_(data_);}
+
+/**
+ * Prints the data of the element.
+ */
+void Print() const {std::cout << Data() << std::endl;}
+
+private:
+
+explicit AnyGroup(const internal::AnyGroupTable<tDataType>* table) : table_(table) {}
+
+// Verifies that g belongs to the same group and prints an error otherwise.
+bool Compatible(const AnyGroup& g, const char* operation) const {
+    if (table_ != g.table_ || table_ == nullptr) {
+        std::cerr << "AnyGroup::" << operation << " the elements do not belong to the same group" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const internal::AnyGroupTable<tDataType>* table_;
+tDataType data_[kAnyMaxGroupSize];
+
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                    Definitions
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename tDataType>
+AnyGroup<tDataType> AnyGroup<tDataType>::Identity(const std::string& name) {
+
+    static const internal::AnyGroupTable<tDataType>* const tables[] = {
+        &internal::AnyGroupModel<Rn<tDataType,1,1>,tDataType>::table_,
+        &internal::AnyGroupModel<Rn<tDataType,2,1>,tDataType>::table_,
+        &internal::AnyGroupModel<Rn<tDataType,3,1>,tDataType>::table_,
+        &internal::AnyGroupModel<Rn<tDataType,4,1>,tDataType>::table_,
+        &internal::AnyGroupModel<Rn<tDataType,5,1>,tDataType>::table_,
+        &internal::AnyGroupModel<Rn<tDataType,6,1>,tDataType>::table_,
+        &internal::AnyGroupModel<SO2<tDataType>,tDataType>::table_,
+        &internal::AnyGroupModel<SO3<tDataType>,tDataType>::table_,
+        &internal::AnyGroupModel<SE2<tDataType>,tDataType>::table_,
+        &internal::AnyGroupModel<SE3<tDataType>,tDataType>::table_,
+        &internal::AnyGroupModel<SO3Quat<tDataType>,tDataType>::table_,
+        &internal::AnyGroupModel<SE3Affine<tDataType>,tDataType>::table_,
+        &internal::AnyGroupModel<SE2Complex<tDataType>,tDataType>::table_};
+
+    for (const internal::AnyGroupTable<tDataType>* table : tables) {
+        if (name == table->name_) {
+            AnyGroup g(table);
+            table->identity_(g.data_);
+            return g;
+        }
+    }
+    std::cerr << "AnyGroup::Identity unknown group " << name << std::endl;
+    return AnyGroup();
+}
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_ANYGROUP_
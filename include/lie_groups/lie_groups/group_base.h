@@ -3,8 +3,13 @@
 
 
 #include <Eigen/Dense>
+#include <algorithm>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 #include "lie_groups/lie_algebras/se2.h"
+#include "lie_groups/lie_groups/normalization.h"
+#include "lie_groups/lie_groups/retraction.h"
 
 
 
@@ -12,6 +17,8 @@
 
 namespace lie_groups {
 
+constexpr int kBatchActBlockSize = 256; /** < The number of points the batch group actions transform at once. */
+
 // These classes are used to give addition information about a state
 struct Abelian {};
 struct NonAbelian{};
@@ -34,6 +41,7 @@ typedef _Mat_G Mat_G;
 typedef _Mat_A Mat_A;
 typedef _Mat_C Mat_C;
 typedef _DataType DataType;
+typedef Eigen::Matrix<DataType,Algebra::dim_,Algebra::dim_> Mat_Jac; /**< The Jacobian data type of the group operations. */
 
 
 /**
@@ -53,13 +61,15 @@ Mat_C Log() const {return Algebra::Log(static_cast<const Group*>(this)->data_);}
 static Mat_G Random(const DataType scalar = static_cast<DataType>(1.0)) {return Algebra::Exp(Mat_C::Random()*scalar);}
 
 /**
- * Performs the OPlus operation 
+ * Performs the OPlus operation, \f$ g R(u) \f$ where \f$ R \f$ is the retraction given by the policy tRetraction.
+ * It defaults to the exponential. See retraction.h.
  * @param g_data The data belonging to the group element.
  * @param u_data The data belonging to the Cartesian space that is isomorphic to the Lie algebra.
  * @return The result of the BoxPlus operation.
  */ 
+template <typename tRetraction = ExpRetraction>
 static Mat_G OPlus(const Mat_G& g_data, const Mat_C& u_data)
-{return Group::Mult(g_data,Algebra::Exp(u_data));}
+{return Group::Mult(g_data,tRetraction::template Retract<Group>(u_data));}
 
 
 /**
@@ -67,16 +77,26 @@ static Mat_G OPlus(const Mat_G& g_data, const Mat_C& u_data)
  * @param u_data The data belonging to the Cartesian space that is isomorphic to the Lie algebra.
  * @return The result of the BoxPlus operation.
  */ 
+template <typename tRetraction = ExpRetraction>
 Mat_G OPlus(const Mat_C& u_data) const
-{return OPlus(static_cast<const Group*>(this)->data_ ,u_data);}
+{return OPlus<tRetraction>(static_cast<const Group*>(this)->data_ ,u_data);}
 
 /**
  * Performs the OPlus operation and assigns the result to the group element
  * @param u_data The data belonging to the Cartesian space that is isomorphic to the Lie algebra.
  * @return The result of the BoxPlus operation.
  */ 
+template <typename tRetraction = ExpRetraction>
 void OPlusEq(const Mat_C& u_data)
-{static_cast<Group*>(this)->data_ = this->OPlus(u_data);}
+{static_cast<Group*>(this)->data_ = this->template OPlus<tRetraction>(u_data);}
+
+/**
+ * Projects the element back onto the group with the policy tNormalization, see normalization.h.
+ * A chain of compositions drifts away from the group by the rounding errors. See DriftControl.
+ */
+template <typename tNormalization = PolarNormalization>
+void NormalizeEq()
+{static_cast<Group*>(this)->data_ = Group::template Normalize<tNormalization>(static_cast<const Group*>(this)->data_);}
 
 /**
  * Performs the BoxPlus operation 
@@ -113,13 +133,15 @@ void BoxPlusEq(const Algebra& u)
 
 
 /**
- * Performs the O-minus operation \f$ \log(g_2^-1*g_1) \f$
+ * Performs the O-minus operation \f$ \log(g_2^-1*g_1) \f$, or \f$ R^{-1}(g_2^{-1} g_1) \f$ with the inverse
+ * of the retraction given by the policy tRetraction.
  * @param g_data1 The data of  \f$ g_1 \f$
  * @param g_data2 The data of \f$ g_2 \f$
  * @return The data of an element of the Cartesian space isomorphic to the Lie algebra
  */ 
+template <typename tRetraction = ExpRetraction>
 static Mat_C OMinus(const Mat_G& g1_data,const Mat_G& g2_data) 
-{return Algebra::Log(Group::Mult(Group::Inverse(g2_data),g1_data));}
+{return tRetraction::template InverseRetract<Group>(Group::Mult(Group::Inverse(g2_data),g1_data));}
 
 
 /**
@@ -127,8 +149,9 @@ static Mat_C OMinus(const Mat_G& g1_data,const Mat_G& g2_data)
  * @param g_data The data of  \f$ g_1 \f$
  * @return The data of an element of the Cartesian space isomorphic to the Lie algebra
  */ 
+template <typename tRetraction = ExpRetraction>
 Mat_C OMinus(const Mat_G& g_data) const
-{return OMinus(static_cast<const Group*>(this)->data_,g_data);}
+{return OMinus<tRetraction>(static_cast<const Group*>(this)->data_,g_data);}
 
 /**
  * Performs the O-minus operation \f$ \log(g_2^-1*g_1) \f$
@@ -148,6 +171,134 @@ Mat_A BoxMinus(const Mat_G& g_data) const
 {return BoxMinus(static_cast<const Group*>(this)->data_,g_data);}
 
 
+/**
+ * Composes two elements, \f$ g_1 g_2 \f$, and computes the right Jacobians of the result with respect to each element.
+ * The right Jacobian of \f$ f \f$ is the derivative of \f$ \log(f(g)^{-1} f(g \exp(\tau))) \f$ at \f$ \tau = 0 \f$,
+ * which is the perturbation used by OPlus and OMinus.
+ * @param g1_data The data of \f$ g_1 \f$
+ * @param g2_data The data of \f$ g_2 \f$
+ * @param jr1 The right Jacobian with respect to \f$ g_1 \f$, \f$ \text{Ad}_{g_2^{-1}} \f$.
+ * @param jr2 The right Jacobian with respect to \f$ g_2 \f$, the identity.
+ * @return The data of \f$ g_1 g_2 \f$
+ */
+static Mat_G MultWithJr(const Mat_G& g1_data, const Mat_G& g2_data, Mat_Jac& jr1, Mat_Jac& jr2) {
+    jr1 = Group(Group::Inverse(g2_data)).Adjoint();
+    jr2.setIdentity();
+    return Group::Mult(g1_data,g2_data);
+}
+
+/**
+ * Composes two elements, \f$ g_1 g_2 \f$, and computes the left Jacobians of the result with respect to each element.
+ * The left Jacobian of \f$ f \f$ is the derivative of \f$ \log(f(\exp(\tau) g) f(g)^{-1}) \f$ at \f$ \tau = 0 \f$.
+ * @param g1_data The data of \f$ g_1 \f$
+ * @param g2_data The data of \f$ g_2 \f$
+ * @param jl1 The left Jacobian with respect to \f$ g_1 \f$, the identity.
+ * @param jl2 The left Jacobian with respect to \f$ g_2 \f$, \f$ \text{Ad}_{g_1} \f$.
+ * @return The data of \f$ g_1 g_2 \f$
+ */
+static Mat_G MultWithJl(const Mat_G& g1_data, const Mat_G& g2_data, Mat_Jac& jl1, Mat_Jac& jl2) {
+    jl1.setIdentity();
+    jl2 = Group(g1_data).Adjoint();
+    return Group::Mult(g1_data,g2_data);
+}
+
+/**
+ * Computes the inverse of an element and the right Jacobian of the inverse, \f$ -\text{Ad}_{g} \f$.
+ * @param g_data The data of the element.
+ * @param jr The right Jacobian of the inverse.
+ * @return The data of the inverse.
+ */
+static Mat_G InverseWithJr(const Mat_G& g_data, Mat_Jac& jr) {
+    jr = -Group(g_data).Adjoint();
+    return Group::Inverse(g_data);
+}
+
+/**
+ * Computes the inverse of an element and the left Jacobian of the inverse, \f$ -\text{Ad}_{g^{-1}} \f$.
+ * @param g_data The data of the element.
+ * @param jl The left Jacobian of the inverse.
+ * @return The data of the inverse.
+ */
+static Mat_G InverseWithJl(const Mat_G& g_data, Mat_Jac& jl) {
+    Mat_G inverse = Group::Inverse(g_data);
+    jl = -Group(inverse).Adjoint();
+    return inverse;
+}
+
+/**
+ * Performs the OPlus operation, \f$ g \exp(u) \f$, and computes the right Jacobians of the result with respect to
+ * the element and to the Cartesian vector. The exponential and the right Jacobian of the Lie algebra are
+ * computed together. With another retraction, \f$ \exp(u) \f$ and \f$ J_r(u) \f$ are the ones of the retraction.
+ * @param g_data The data belonging to the group element.
+ * @param u_data The data belonging to the Cartesian space that is isomorphic to the Lie algebra.
+ * @param jr_g The right Jacobian with respect to the element, \f$ \text{Ad}_{\exp(-u)} \f$.
+ * @param j_u The Jacobian with respect to the Cartesian vector, \f$ J_r(u) \f$.
+ * @return The result of the OPlus operation.
+ */
+template <typename tRetraction = ExpRetraction>
+static Mat_G OPlusWithJr(const Mat_G& g_data, const Mat_C& u_data, Mat_Jac& jr_g, Mat_Jac& j_u) {
+    const Mat_G exp_u = tRetraction::template RetractWithJr<Group>(u_data,j_u);
+    jr_g = Group(Group::Inverse(exp_u)).Adjoint();
+    return Group::Mult(g_data,exp_u);
+}
+
+/**
+ * Performs the OPlus operation, \f$ g \exp(u) \f$, and computes the left Jacobians of the result with respect to
+ * the element and to the Cartesian vector.
+ * @param g_data The data belonging to the group element.
+ * @param u_data The data belonging to the Cartesian space that is isomorphic to the Lie algebra.
+ * @param jl_g The left Jacobian with respect to the element, the identity.
+ * @param j_u The Jacobian with respect to the Cartesian vector, \f$ \text{Ad}_{g} J_l(u) \f$.
+ * @return The result of the OPlus operation.
+ */
+template <typename tRetraction = ExpRetraction>
+static Mat_G OPlusWithJl(const Mat_G& g_data, const Mat_C& u_data, Mat_Jac& jl_g, Mat_Jac& j_u) {
+    Mat_Jac jl;
+    const Mat_G exp_u = tRetraction::template RetractWithJl<Group>(u_data,jl);
+    j_u = Group(g_data).Adjoint()*jl;
+    jl_g.setIdentity();
+    return Group::Mult(g_data,exp_u);
+}
+
+/**
+ * Performs the O-minus operation, \f$ u = \log(g_2^{-1} g_1) \f$, and computes the right Jacobians of the result
+ * with respect to each element. The logarithm and \f$ J_r^{-1}(u) \f$ are computed together and 
+ * \f$ J_l^{-1}(u) = J_r^{-1}(u) \text{Ad}_{\exp(-u)} \f$ is recovered from the adjoint so only one Jacobian of the 
+ * Lie algebra is evaluated. With another retraction, the logarithm and \f$ J_r^{-1}(u) \f$ are the ones of its inverse.
+ * @param g1_data The data of \f$ g_1 \f$
+ * @param g2_data The data of \f$ g_2 \f$
+ * @param jr1 The right Jacobian with respect to \f$ g_1 \f$, \f$ J_r^{-1}(u) \f$.
+ * @param jr2 The right Jacobian with respect to \f$ g_2 \f$, \f$ -J_l^{-1}(u) \f$.
+ * @return The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+template <typename tRetraction = ExpRetraction>
+static Mat_C OMinusWithJr(const Mat_G& g1_data, const Mat_G& g2_data, Mat_Jac& jr1, Mat_Jac& jr2) {
+    const Mat_G difference = Group::Mult(Group::Inverse(g2_data),g1_data);
+    const Mat_C u = tRetraction::template InverseRetractWithJrInv<Group>(difference,jr1);
+    jr2 = -jr1*Group(Group::Inverse(difference)).Adjoint();
+    return u;
+}
+
+/**
+ * Performs the O-minus operation, \f$ u = \log(g_2^{-1} g_1) \f$, and computes the left Jacobians of the result
+ * with respect to each element. They are \f$ \pm J_r^{-1}(u) \text{Ad}_{g_1^{-1}} \f$.
+ * @param g1_data The data of \f$ g_1 \f$
+ * @param g2_data The data of \f$ g_2 \f$
+ * @param jl1 The left Jacobian with respect to \f$ g_1 \f$.
+ * @param jl2 The left Jacobian with respect to \f$ g_2 \f$.
+ * @return The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */
+template <typename tRetraction = ExpRetraction>
+static Mat_C OMinusWithJl(const Mat_G& g1_data, const Mat_G& g2_data, Mat_Jac& jl1, Mat_Jac& jl2) {
+    Mat_Jac jr_inv;
+    const Mat_G g1_inverse = Group::Inverse(g1_data);
+    const Mat_C u = tRetraction::template InverseRetractWithJrInv<Group>(Group::Mult(Group::Inverse(g2_data),g1_data),jr_inv);
+    jl1 = jr_inv*Group(g1_inverse).Adjoint();
+    jl2 = -jl1;
+    return u;
+}
+
+
 /**
  * Prints the content of the data
  */ 
@@ -155,7 +306,6 @@ void Print() {
     std::cout << static_cast<Group*>(this)->data_ << std::endl; 
 }
 
-
 };
 
 
@@ -0,0 +1,80 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_NORMALIZATION_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_NORMALIZATION_
+
+#include <Eigen/Dense>
+#include <cmath>
+
+namespace lie_groups {
+
+/**
+ * The policies that project a rotation matrix that drifted away from \f$ SO(n) \f$ after many compositions back onto it.
+ * A policy provides Rotation, which is used by the Normalize functions of the groups on their rotation block. The groups
+ * that store a unit quaternion or a unit complex number only renormalize it, whatever the policy.
+ */
+
+/**
+ * One Newton step of the polar decomposition, \f$ R (3I - R^\top R)/2 \f$. It squares the drift
+ * \f$ \|R^\top R - I\| \f$ with two matrix products, so it is exact to the rounding when it is applied before the drift
+ * grows above the square root of the precision. It is the default.
+ */
+struct PolarNormalization {
+
+template <typename tDataType, int tDim>
+static Eigen::Matrix<tDataType,tDim,tDim> Rotation(const Eigen::Matrix<tDataType,tDim,tDim>& r) {
+    typedef Eigen::Matrix<tDataType,tDim,tDim> Mat;
+    return r*(static_cast<tDataType>(1.5)*Mat::Identity() - static_cast<tDataType>(0.5)*r.transpose()*r);
+}
+
+};
+
+/**
+ * Converts the rotation to a unit quaternion, or a unit complex number in 2D, normalizes it and converts it back. The
+ * quaternion is computed from the trace or the largest diagonal element, so it handles any drift and any angle.
+ */
+struct QuaternionNormalization {
+
+template <typename tDataType>
+static Eigen::Matrix<tDataType,3,3> Rotation(const Eigen::Matrix<tDataType,3,3>& r) {
+    return Eigen::Quaternion<tDataType>(r).normalized().toRotationMatrix();
+}
+
+template <typename tDataType>
+static Eigen::Matrix<tDataType,2,2> Rotation(const Eigen::Matrix<tDataType,2,2>& r) {
+    const tDataType c = r(0,0) + r(1,1);
+    const tDataType s = r(1,0) - r(0,1);
+    const tDataType norm = std::sqrt(c*c + s*s);
+    Eigen::Matrix<tDataType,2,2> m;
+    m << c/norm, -s/norm, s/norm, c/norm;
+    return m;
+}
+
+};
+
+/**
+ * The closest rotation in the Frobenius norm, \f$ U \text{diag}(1,\dots,\det(UV^\top)) V^\top \f$, from the singular
+ * value decomposition. It is the exact fallback for large drifts.
+ */
+struct SVDNormalization {
+
+template <typename tDataType, int tDim>
+static Eigen::Matrix<tDataType,tDim,tDim> Rotation(const Eigen::Matrix<tDataType,tDim,tDim>& r) {
+    typedef Eigen::Matrix<tDataType,tDim,tDim> Mat;
+    const Eigen::JacobiSVD<Mat> svd(r, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    Eigen::Matrix<tDataType,tDim,1> d = Eigen::Matrix<tDataType,tDim,1>::Ones();
+    d(tDim-1) = (svd.matrixU()*svd.matrixV().transpose()).determinant() < 0 ? -1 : 1;
+    return svd.matrixU()*d.asDiagonal()*svd.matrixV().transpose();
+}
+
+};
+
+/**
+ * Computes the drift of a rotation matrix, \f$ \|R^\top R - I\| \f$. It is the quantity checked by isElement.
+ */
+template <typename tDerived>
+typename tDerived::Scalar RotationDrift(const Eigen::MatrixBase<tDerived>& r) {
+    return (r.transpose()*r - tDerived::PlainObject::Identity()).norm();
+}
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_NORMALIZATION_
@@ -0,0 +1,187 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_RETRACTION_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_RETRACTION_
+
+#include <Eigen/Dense>
+#include <type_traits>
+#include <utility>
+
+namespace lie_groups {
+
+/**
+ * The functions shared by the retraction policies. A retraction \f$ R \f$ maps the Cartesian space to the group with
+ * \f$ R(0) = I \f$ and a derivative at zero equal to the one of the exponential. OPlus computes \f$ g R(u) \f$ and
+ * OMinus \f$ R^{-1}(g_2^{-1} g_1) \f$. The Jacobians of a retraction are taken with the perturbations of the group,
+ * e.g. the right Jacobian is the derivative of \f$ \log(R(u)^{-1} R(u+\delta)) \f$ at \f$ \delta = 0 \f$, so the
+ * Jacobians of the operations of the group keep their meaning. A policy provides Retract, InverseRetract, Jr and JrInv;
+ * the others are derived here from the adjoint, \f$ J_l(u) = \text{Ad}_{R(u)} J_r(u) \f$.
+ * The functions are templated on the group whose Algebra provides the maps.
+ */
+template <typename tRetraction>
+struct RetractionBase {
+
+/**
+ * Computes the retraction and its right Jacobian.
+ * @param u_data The data belonging to the Cartesian space that is isomorphic to the Lie algebra.
+ * @param jr The right Jacobian evaluated at u_data.
+ */
+template <typename tGroup>
+static typename tGroup::Mat_G RetractWithJr(const typename tGroup::Mat_C& u_data, typename tGroup::Mat_Jac& jr) {
+    jr = tRetraction::template Jr<tGroup>(u_data);
+    return tRetraction::template Retract<tGroup>(u_data);
+}
+
+/**
+ * Computes the retraction and its left Jacobian.
+ * @param u_data The data belonging to the Cartesian space that is isomorphic to the Lie algebra.
+ * @param jl The left Jacobian evaluated at u_data.
+ */
+template <typename tGroup>
+static typename tGroup::Mat_G RetractWithJl(const typename tGroup::Mat_C& u_data, typename tGroup::Mat_Jac& jl) {
+    const typename tGroup::Mat_G g = tRetraction::template Retract<tGroup>(u_data);
+    jl = tGroup(g).Adjoint()*tRetraction::template Jr<tGroup>(u_data);
+    return g;
+}
+
+/**
+ * Computes the inverse of the retraction and the inverse of its right Jacobian evaluated at the result.
+ * @param g_data The data of an element of the group.
+ * @param jr_inv The right Jacobian inverse evaluated at the result.
+ */
+template <typename tGroup>
+static typename tGroup::Mat_C InverseRetractWithJrInv(const typename tGroup::Mat_G& g_data, typename tGroup::Mat_Jac& jr_inv) {
+    const typename tGroup::Mat_C u = tRetraction::template InverseRetract<tGroup>(g_data);
+    jr_inv = tRetraction::template JrInv<tGroup>(u);
+    return u;
+}
+
+/**
+ * Computes the left Jacobian of the retraction.
+ * @param u_data The data belonging to the Cartesian space that is isomorphic to the Lie algebra.
+ */
+template <typename tGroup>
+static typename tGroup::Mat_Jac Jl(const typename tGroup::Mat_C& u_data) {
+    typename tGroup::Mat_Jac jl;
+    RetractWithJl<tGroup>(u_data,jl);
+    return jl;
+}
+
+/**
+ * Computes the inverse of the left Jacobian of the retraction, \f$ J_r^{-1}(u) \text{Ad}_{R(u)^{-1}} \f$.
+ * @param u_data The data belonging to the Cartesian space that is isomorphic to the Lie algebra.
+ */
+template <typename tGroup>
+static typename tGroup::Mat_Jac JlInv(const typename tGroup::Mat_C& u_data) {
+    const typename tGroup::Mat_G g = tRetraction::template Retract<tGroup>(u_data);
+    return tRetraction::template JrInv<tGroup>(u_data)*tGroup(tGroup::Inverse(g)).Adjoint();
+}
+
+protected:
+
+// The Jacobians of the Lie algebra. They are larger than Mat_Jac for so(2), whose Jacobians are the 2x2 identity, and
+// for several tangent spaces.
+template <typename tGroup>
+using AlgebraJacobian = typename std::decay<decltype(std::declval<typename tGroup::Algebra&>().Jr())>::type;
+
+// The block of a Jacobian of the Lie algebra that belongs to the group
+template <typename tGroup, typename tMatrix>
+static typename tGroup::Mat_Jac GroupBlock(const tMatrix& m) {
+    return m.template topLeftCorner<tGroup::Mat_Jac::RowsAtCompileTime,tGroup::Mat_Jac::ColsAtCompileTime>();
+}
+
+};
+
+/**
+ * The exponential map and the logarithm. It is the default retraction of the groups and of State.
+ */
+struct ExpRetraction : public RetractionBase<ExpRetraction> {
+
+template <typename tGroup>
+static typename tGroup::Mat_G Retract(const typename tGroup::Mat_C& u_data) {return tGroup::Algebra::Exp(u_data);}
+
+template <typename tGroup>
+static typename tGroup::Mat_C InverseRetract(const typename tGroup::Mat_G& g_data) {return tGroup::Algebra::Log(g_data);}
+
+template <typename tGroup>
+static typename tGroup::Mat_Jac Jr(const typename tGroup::Mat_C& u_data) {return GroupBlock<tGroup>(typename tGroup::Algebra(u_data).Jr());}
+
+template <typename tGroup>
+static typename tGroup::Mat_Jac Jl(const typename tGroup::Mat_C& u_data) {return GroupBlock<tGroup>(typename tGroup::Algebra(u_data).Jl());}
+
+template <typename tGroup>
+static typename tGroup::Mat_Jac JrInv(const typename tGroup::Mat_C& u_data) {return GroupBlock<tGroup>(typename tGroup::Algebra(u_data).JrInv());}
+
+template <typename tGroup>
+static typename tGroup::Mat_Jac JlInv(const typename tGroup::Mat_C& u_data) {return GroupBlock<tGroup>(typename tGroup::Algebra(u_data).JlInv());}
+
+// The exponential and logarithm are computed together with their Jacobians
+template <typename tGroup>
+static typename tGroup::Mat_G RetractWithJr(const typename tGroup::Mat_C& u_data, typename tGroup::Mat_Jac& jr) {
+    AlgebraJacobian<tGroup> j;
+    const typename tGroup::Mat_G g = tGroup::Algebra::ExpWithJr(u_data,j);
+    jr = GroupBlock<tGroup>(j);
+    return g;
+}
+
+template <typename tGroup>
+static typename tGroup::Mat_G RetractWithJl(const typename tGroup::Mat_C& u_data, typename tGroup::Mat_Jac& jl) {
+    AlgebraJacobian<tGroup> j;
+    const typename tGroup::Mat_G g = tGroup::Algebra::ExpWithJl(u_data,j);
+    jl = GroupBlock<tGroup>(j);
+    return g;
+}
+
+template <typename tGroup>
+static typename tGroup::Mat_C InverseRetractWithJrInv(const typename tGroup::Mat_G& g_data, typename tGroup::Mat_Jac& jr_inv) {
+    AlgebraJacobian<tGroup> j;
+    const typename tGroup::Mat_C u = tGroup::Algebra::LogWithJrInv(g_data,j);
+    jr_inv = GroupBlock<tGroup>(j);
+    return u;
+}
+
+};
+
+/**
+ * The Cayley map \f$ (I - W/2)^{-1}(I + W/2) \f$ where W is the wedge of the Cartesian vector, and its inverse.
+ * It agrees with the exponential to the second order and uses no trigonometric function. Its inverse is
+ * defined for rotations of less than \f$ \pi \f$. See the Cayley functions of the Lie algebras.
+ */
+struct CayleyRetraction : public RetractionBase<CayleyRetraction> {
+
+template <typename tGroup>
+static typename tGroup::Mat_G Retract(const typename tGroup::Mat_C& u_data) {return tGroup::Algebra::Cayley(u_data);}
+
+template <typename tGroup>
+static typename tGroup::Mat_C InverseRetract(const typename tGroup::Mat_G& g_data) {return tGroup::Algebra::CayleyInv(g_data);}
+
+template <typename tGroup>
+static typename tGroup::Mat_Jac Jr(const typename tGroup::Mat_C& u_data) {return GroupBlock<tGroup>(tGroup::Algebra::CayleyJr(u_data));}
+
+template <typename tGroup>
+static typename tGroup::Mat_Jac JrInv(const typename tGroup::Mat_C& u_data) {return GroupBlock<tGroup>(tGroup::Algebra::CayleyJrInv(u_data));}
+
+};
+
+/**
+ * The first order map \f$ I + W \f$ projected back onto the group, and its inverse. The rotation is the closest one
+ * to \f$ I + W \f$ and the translation is kept, so it only costs a square root. Its inverse is defined for
+ * rotations of less than \f$ \pi/2 \f$. See the FirstOrder functions of the Lie algebras.
+ */
+struct FirstOrderRetraction : public RetractionBase<FirstOrderRetraction> {
+
+template <typename tGroup>
+static typename tGroup::Mat_G Retract(const typename tGroup::Mat_C& u_data) {return tGroup::Algebra::FirstOrder(u_data);}
+
+template <typename tGroup>
+static typename tGroup::Mat_C InverseRetract(const typename tGroup::Mat_G& g_data) {return tGroup::Algebra::FirstOrderInv(g_data);}
+
+template <typename tGroup>
+static typename tGroup::Mat_Jac Jr(const typename tGroup::Mat_C& u_data) {return GroupBlock<tGroup>(tGroup::Algebra::FirstOrderJr(u_data));}
+
+template <typename tGroup>
+static typename tGroup::Mat_Jac JrInv(const typename tGroup::Mat_C& u_data) {return GroupBlock<tGroup>(tGroup::Algebra::FirstOrderJrInv(u_data));}
+
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_RETRACTION_
@@ -0,0 +1,344 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_PRODUCTSTATE_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_PRODUCTSTATE_
+
+#include <Eigen/Dense>
+#include <iostream>
+#include <tuple>
+#include <type_traits>
+
+#include "lie_groups/state.h"
+
+/**
+ * The product of several states, e.g. a pose with its twist and the biases of a sensor, ProductState<SE3_se3,R3_r3>.
+ * The Cartesian vector of the product stacks the Cartesian vectors of the components in order. The offsets of the
+ * components in it are computed at compile time and every operation is unrolled over the components with fixed-size
+ * blocks, so a product costs the same as the components used by hand.
+ */
+
+namespace lie_groups {
+
+namespace internal {
+
+// The sum of the dimensions
+template <int... tDims> struct DimSum;
+template <> struct DimSum<> {static constexpr int value = 0;};
+template <int tFirst, int... tRest> struct DimSum<tFirst, tRest...> {static constexpr int value = tFirst + DimSum<tRest...>::value;};
+
+// The sum of the first I dimensions, i.e. the offset of the block I
+template <int I, int... tDims> struct DimOffset;
+template <int tFirst, int... tRest> struct DimOffset<0, tFirst, tRest...> {static constexpr int value = 0;};
+template <int I, int tFirst, int... tRest> struct DimOffset<I, tFirst, tRest...> {static constexpr int value = tFirst + DimOffset<I-1, tRest...>::value;};
+
+// The operations of BlockDiagonal on its blocks, which are fixed-size Eigen matrices or StateJacobian
+template <typename tDerived>
+const tDerived& DenseBlock(const Eigen::MatrixBase<tDerived>& block) {return block.derived();}
+
+template <typename tDataType, int tBlockDim, int tDim>
+typename StateJacobian<tDataType,tBlockDim,tDim>::Mat DenseBlock(const StateJacobian<tDataType,tBlockDim,tDim>& block) {return block.ToDense();}
+
+template <typename tDerived, typename tOther>
+auto BlockTransposeTimes(const Eigen::MatrixBase<tDerived>& block, const tOther& m) -> decltype(block.transpose()*m) {return block.transpose()*m;}
+
+template <typename tDataType, int tBlockDim, int tDim, typename tOther>
+auto BlockTransposeTimes(const StateJacobian<tDataType,tBlockDim,tDim>& block, const tOther& m) -> decltype(block.TransposeTimes(m)) {return block.TransposeTimes(m);}
+
+} // namespace internal
+
+/**
+ * A block diagonal matrix whose blocks are fixed-size square matrices of different sizes or StateJacobian, e.g. the
+ * Jacobians of a ProductState. Only the blocks are stored and the products are performed block by block.
+ */
+template <typename tDataType, typename... tBlocks>
+class BlockDiagonal {
+
+public:
+
+static constexpr int num_blocks_ = sizeof...(tBlocks);
+static constexpr int dim_ = internal::DimSum<tBlocks::RowsAtCompileTime...>::value;
+typedef Eigen::Matrix<tDataType,dim_,dim_> Mat;   /**< The dense matrix data type. */
+
+template <int I>
+using BlockType = typename std::tuple_element<I, std::tuple<tBlocks...>>::type;
+
+/**
+ * The offset of the block I in the rows and the columns.
+ */
+template <int I>
+struct Offset {static constexpr int value = internal::DimOffset<I, tBlocks::RowsAtCompileTime...>::value;};
+
+std::tuple<tBlocks...> blocks_;  /** < The blocks of the diagonal. */
+
+/**
+ * Returns the block I.
+ */
+template <int I>
+BlockType<I>& Block() {return std::get<I>(blocks_);}
+
+template <int I>
+const BlockType<I>& Block() const {return std::get<I>(blocks_);}
+
+/**
+ * Returns the dense matrix.
+ */
+Mat ToDense() const {
+    Mat m = Mat::Zero();
+    ToDense<0>(m);
+    return m;
+}
+
+/**
+ * Multiplies a matrix or a vector with dim_ rows on the left, \f$ J m \f$.
+ */
+template <typename tDerived>
+Eigen::Matrix<tDataType,dim_,tDerived::ColsAtCompileTime> operator * (const Eigen::MatrixBase<tDerived>& m) const {
+    Eigen::Matrix<tDataType,dim_,tDerived::ColsAtCompileTime> out(static_cast<Eigen::Index>(dim_),m.cols());
+    Multiply<0,false>(m,out);
+    return out;
+}
+
+/**
+ * Multiplies the transpose by a matrix or a vector with dim_ rows, \f$ J^\top m \f$.
+ */
+template <typename tDerived>
+Eigen::Matrix<tDataType,dim_,tDerived::ColsAtCompileTime> TransposeTimes(const Eigen::MatrixBase<tDerived>& m) const {
+    Eigen::Matrix<tDataType,dim_,tDerived::ColsAtCompileTime> out(static_cast<Eigen::Index>(dim_),m.cols());
+    Multiply<0,true>(m,out);
+    return out;
+}
+
+private:
+
+template <int I>
+typename std::enable_if<(I < num_blocks_)>::type ToDense(Mat& m) const {
+    constexpr int n = BlockType<I>::RowsAtCompileTime;
+    m.template block<n,n>(Offset<I>::value,Offset<I>::value) = internal::DenseBlock(Block<I>());
+    ToDense<I+1>(m);
+}
+
+template <int I>
+typename std::enable_if<(I == num_blocks_)>::type ToDense(Mat&) const {}
+
+template <int I, bool tTranspose, typename tDerived, typename tOut>
+typename std::enable_if<(I < num_blocks_)>::type Multiply(const Eigen::MatrixBase<tDerived>& m, tOut& out) const {
+    constexpr int n = BlockType<I>::RowsAtCompileTime;
+    if (tTranspose) {
+        out.template middleRows<n>(Offset<I>::value).noalias() = internal::BlockTransposeTimes(Block<I>(),m.template middleRows<n>(Offset<I>::value));
+    } else {
+        out.template middleRows<n>(Offset<I>::value).noalias() = Block<I>()*m.template middleRows<n>(Offset<I>::value);
+    }
+    Multiply<I+1,tTranspose>(m,out);
+}
+
+template <int I, bool tTranspose, typename tDerived, typename tOut>
+typename std::enable_if<(I == num_blocks_)>::type Multiply(const Eigen::MatrixBase<tDerived>&, tOut&) const {}
+
+};
+
+/**
+ * The product of the states tStates. See the description at the top of the file.
+ */
+template <typename... tStates>
+class ProductState {
+
+public:
+
+static_assert(sizeof...(tStates) > 0, "lie_groups::ProductState needs at least one state.");
+
+typedef typename std::tuple_element<0, std::tuple<tStates...>>::type::DataType DataType;
+static constexpr int num_states_ = sizeof...(tStates);
+static constexpr unsigned int dim_ = internal::DimSum<tStates::dim_...>::value;
+typedef Eigen::Matrix<DataType,dim_,1> Vec_SC;                                /**< The Cartesian space data type. */
+typedef Eigen::Matrix<DataType,dim_,dim_> Mat_SC;                             /**< The dense Cartesian space matrix data type. */
+typedef BlockDiagonal<DataType, typename tStates::Jacobian...> Jacobian;      /**< The Jacobian data type. */
+
+template <int I>
+using StateType = typename std::tuple_element<I, std::tuple<tStates...>>::type;
+
+/**
+ * The offset of the Cartesian vector of the state I in the one of the product.
+ */
+template <int I>
+struct Offset {static constexpr int value = internal::DimOffset<I, tStates::dim_...>::value;};
+
+std::tuple<tStates...> states_;  /** < The states of the product.*/
+
+/**
+ * Default constructor. Initializes every state to identity.
+ */
+ProductState() = default;
+
+/**
+ * Initializes the product with the states given.
+ */
+explicit ProductState(const tStates&... states) : states_(states...) {}
+
+/**
+ * Returns the state I.
+ */
+template <int I>
+StateType<I>& Get() {return std::get<I>(states_);}
+
+template <int I>
+const StateType<I>& Get() const {return std::get<I>(states_);}
+
+/**
+ * Returns the identity element
+ */
+static ProductState Identity() {return ProductState();}
+
+/**
+ * Returns a random element
+ */
+static ProductState Random(const DataType scalar = static_cast<DataType>(1.0)) {return ProductState(tStates::Random(scalar)...);}
+
+/**
+ * Performs the O-minus operation of every state, \f$ S_1-S_2 \f$.
+ * @param s1 The state  \f$ s_1 \f$
+ * @param s2 The state  \f$ s_2 \f$
+ * @return The data of an element of the Cartesian space
+ */
+static Vec_SC OMinus(const ProductState& s1, const ProductState& s2) {
+    Vec_SC cartesian;
+    OMinus<0>(s1,s2,cartesian);
+    return cartesian;
+}
+
+/**
+ * Performs the O-minus operation with this being S_1
+ * @param s2 The state  \f$ s_2 \f$
+ */
+Vec_SC OMinus(const ProductState& s2) const {return OMinus(*this,s2);}
+
+/**
+ * Performs the O-Plus operation of every state with its block of the Cartesian vector.
+ * @param state The state
+ * @param cartesian An element of the Cartesian space
+ * @return A state that is the result of the O-Plus operation
+ */
+static ProductState OPlus(const ProductState& state, const Vec_SC& cartesian) {
+    ProductState out;
+    OPlus<0>(state,cartesian,out);
+    return out;
+}
+
+/**
+ * Performs the O-Plus operation with this being the state.
+ * @param cartesian An element of the Cartesian space
+ */
+ProductState OPlus(const Vec_SC& cartesian) const {return OPlus(*this,cartesian);}
+
+/**
+ * Performs the O-Plus operation and sets the state to the result.
+ * @param cartesian An element of the Cartesian space
+ */
+void OPlusEQ(const Vec_SC& cartesian) {*this = OPlus(*this,cartesian);}
+
+/**
+ * Computes the right Jacobian, whose blocks are the right Jacobians of the states.
+ * @param cartesian An element of the Cartesian space
+ */
+static Jacobian Jr(const Vec_SC& cartesian) {Jacobian j; Jacobians<0,kJr>(cartesian,j); return j;}
+
+/**
+ * Computes the left Jacobian, whose blocks are the left Jacobians of the states.
+ * @param cartesian An element of the Cartesian space
+ */
+static Jacobian Jl(const Vec_SC& cartesian) {Jacobian j; Jacobians<0,kJl>(cartesian,j); return j;}
+
+/**
+ * Computes the inverse of the right Jacobian.
+ * @param cartesian An element of the Cartesian space
+ */
+static Jacobian JrInv(const Vec_SC& cartesian) {Jacobian j; Jacobians<0,kJrInv>(cartesian,j); return j;}
+
+/**
+ * Computes the inverse of the left Jacobian.
+ * @param cartesian An element of the Cartesian space
+ */
+static Jacobian JlInv(const Vec_SC& cartesian) {Jacobian j; Jacobians<0,kJlInv>(cartesian,j); return j;}
+
+/**
+ * Computes the exponential of an element in the Cartesian space
+ */
+static ProductState Exp(const Vec_SC& cartesian) {
+    ProductState state;
+    Exp<0>(cartesian,state);
+    return state;
+}
+
+/**
+ * Computes the Log of the state
+ */
+static Vec_SC Log(const ProductState& state) {
+    Vec_SC cartesian;
+    Log<0>(state,cartesian);
+    return cartesian;
+}
+
+private:
+
+enum JacobianKind {kJr, kJl, kJrInv, kJlInv};
+
+template <int I>
+using Vec = typename StateType<I>::Vec_SC;
+
+// The block of the state I of a Cartesian vector
+template <int I>
+static Vec<I> Segment(const Vec_SC& cartesian) {return cartesian.template segment<StateType<I>::dim_>(Offset<I>::value);}
+
+template <int I>
+static typename std::enable_if<(I < num_states_)>::type OMinus(const ProductState& s1, const ProductState& s2, Vec_SC& cartesian) {
+    cartesian.template segment<StateType<I>::dim_>(Offset<I>::value) = StateType<I>::OMinus(s1.template Get<I>(),s2.template Get<I>());
+    OMinus<I+1>(s1,s2,cartesian);
+}
+
+template <int I>
+static typename std::enable_if<(I == num_states_)>::type OMinus(const ProductState&, const ProductState&, Vec_SC&) {}
+
+template <int I>
+static typename std::enable_if<(I < num_states_)>::type OPlus(const ProductState& state, const Vec_SC& cartesian, ProductState& out) {
+    out.template Get<I>() = StateType<I>::OPlus(state.template Get<I>(),Segment<I>(cartesian));
+    OPlus<I+1>(state,cartesian,out);
+}
+
+template <int I>
+static typename std::enable_if<(I == num_states_)>::type OPlus(const ProductState&, const Vec_SC&, ProductState&) {}
+
+template <int I, JacobianKind tKind>
+static typename std::enable_if<(I < num_states_)>::type Jacobians(const Vec_SC& cartesian, Jacobian& j) {
+    const Vec<I> u = Segment<I>(cartesian);
+    switch (tKind) {
+        case kJr: j.template Block<I>() = StateType<I>::Jr(u); break;
+        case kJl: j.template Block<I>() = StateType<I>::Jl(u); break;
+        case kJrInv: j.template Block<I>() = StateType<I>::JrInv(u); break;
+        case kJlInv: j.template Block<I>() = StateType<I>::JlInv(u); break;
+    }
+    Jacobians<I+1,tKind>(cartesian,j);
+}
+
+template <int I, JacobianKind tKind>
+static typename std::enable_if<(I == num_states_)>::type Jacobians(const Vec_SC&, Jacobian&) {}
+
+template <int I>
+static typename std::enable_if<(I < num_states_)>::type Exp(const Vec_SC& cartesian, ProductState& state) {
+    state.template Get<I>() = StateType<I>::Exp(Segment<I>(cartesian));
+    Exp<I+1>(cartesian,state);
+}
+
+template <int I>
+static typename std::enable_if<(I == num_states_)>::type Exp(const Vec_SC&, ProductState&) {}
+
+template <int I>
+static typename std::enable_if<(I < num_states_)>::type Log(const ProductState& state, Vec_SC& cartesian) {
+    cartesian.template segment<StateType<I>::dim_>(Offset<I>::value) = StateType<I>::Log(state.template Get<I>());
+    Log<I+1>(state,cartesian);
+}
+
+template <int I>
+static typename std::enable_if<(I == num_states_)>::type Log(const ProductState&, Vec_SC&) {}
+
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_PRODUCTSTATE_
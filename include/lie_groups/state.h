@@ -10,6 +10,8 @@
 #include "lie_groups/lie_algebras/so3.h"
 #include "lie_groups/lie_algebras/se2.h"
 #include "lie_groups/lie_algebras/se3.h"
+#include "lie_groups/lie_algebras/so3q.h"
+#include "lie_groups/lie_algebras/se3a.h"
 
 // Lie groups
 #include "lie_groups/lie_groups/Rn.h"
@@ -17,35 +19,61 @@
 #include "lie_groups/lie_groups/SO3.h"
 #include "lie_groups/lie_groups/SE2.h"
 #include "lie_groups/lie_groups/SE3.h"
+#include "lie_groups/lie_groups/SO3Quat.h"
+#include "lie_groups/lie_groups/SE3Affine.h"
+#include "lie_groups/lie_groups/SE2Complex.h"
+
+#include "lie_groups/state_jacobian.h"
 
 namespace lie_groups {
 
-template <template<typename , int, int > class tG, typename tDataType = double,int tGroupDim =2, int tNumTangentSpaces = 1> 
+namespace internal {
+
+// The type of the twist of a State. It is the algebra when the algebra stores every tangent space, as rn does, and
+// otherwise the tangent spaces are stacked in a vector space.
+template <typename tAlgebra, typename tDataType, bool tStacked = (tAlgebra::size1_*tAlgebra::size2_ == tAlgebra::total_num_dim_)>
+struct StateTwist {typedef tAlgebra type;};
+
+template <typename tAlgebra, typename tDataType>
+struct StateTwist<tAlgebra,tDataType,false> {typedef rn<tDataType,tAlgebra::dim_,tAlgebra::total_num_dim_/tAlgebra::dim_> type;};
+
+} // namespace internal
+
+/**
+ * The state of an object, its pose as an element of a group and its twist as an element of the Cartesian space of the
+ * Lie algebra, followed by the derivatives of the twist when there are several tangent spaces. The group part of
+ * OPlus, OMinus and of their Jacobians uses the retraction given by the policy tRetraction, the exponential by
+ * default. See retraction.h.
+ */
+template <template<typename , int, int > class tG, typename tDataType = double,int tGroupDim =2, int tNumTangentSpaces = 1, typename tRetraction = ExpRetraction> 
 class State {
 
 public:
 static constexpr int N = tGroupDim;                              /**< The dimensions of the group. */
 static constexpr int NumTangentSpaces = tNumTangentSpaces;       /**< The number of tangent spaces to consider. For example, if the number is 1, then only velocity is considered. If the number is 2, then velocity and acceleration are considered. 
-                                                                      Not every group can support more than one tangent space; currently only RN can.*/
+                                                                      The group acts on the velocity only. The other tangent spaces are its derivatives and are stacked with it in the vector space Twist. See Propagate.*/
 
 typedef tDataType DataType;
+typedef tRetraction Retraction;                                  /**< The retraction policy of OPlus and OMinus. */
 typedef tG<tDataType,tGroupDim,tNumTangentSpaces> G;
 typedef typename G::Algebra U;
 typedef G Group;
 typedef U Algebra;
+typedef typename internal::StateTwist<U,tDataType>::type Twist;    /**< The type of the twist, the tangent spaces stacked. */
 typedef G g_type_; /** < The group type .*/
-typedef U u_type_; /** < The algebra type .*/
+typedef Twist u_type_; /** < The twist type .*/
 typedef Eigen::Matrix<tDataType,G::size1_, G::size2_> Mat_G;      /**< The group data type. */
-typedef Eigen::Matrix<tDataType,U::size1_, U::size2_> Mat_C;      /**< The Cartesian space data type. */
+typedef Eigen::Matrix<tDataType,Twist::size1_, Twist::size2_> Mat_C; /**< The twist data type. */
 typedef typename G::Base::Mat_A Mat_A;                            /**< The Lie algebra data type. */
 typedef typename G::GroupType StateType;
 // typedef Eigen::Matrix<tDataType,G::dim_ + U::total_num_dim_, G::dim_> Mat_Adj;    /**< The Adjoint data type. */
 static constexpr unsigned int dim_ = G::dim_ + U::total_num_dim_;
 typedef Eigen::Matrix<tDataType,dim_,1> Vec_SC;                   /**< The State Cartesian space data type. */
 typedef Eigen::Matrix<tDataType,dim_,dim_> Mat_SC;                /**< The State Cartesian space matrix data type. */
+typedef StateJacobian<tDataType,G::dim_,dim_> Jacobian;            /**< The Jacobian data type of Jr, Jl, JrInv and JlInv. */
 
 template<typename T>
-using StateTemplate = State<tG, T, tGroupDim, tNumTangentSpaces>;
+using StateTemplate = State<tG, T, tGroupDim, tNumTangentSpaces, tRetraction>;
 
 template< typename T1, int T2, int T3>
 using GroupTemplate = tG<T1,T2,T3>;
@@ -53,7 +81,7 @@ using GroupTemplate = tG<T1,T2,T3>;
 
 
 G g_;   /** < The pose of the object.*/
-U u_;   /** < The twist (velocity) of the object.*/
+Twist u_;   /** < The twist (velocity) of the object followed by its derivatives.*/
 
 /**
  * Default constructor. Initializes group element to identity.
@@ -63,32 +91,32 @@ State()=default;
 /**
  * Copy constructor.
  */ 
-State(const State& s) : g_(s.g_), u_(s.u_) {};
+State(const State & s) = default;
 
 /**
  * Copy assignment.
  */ 
-void operator = (const State& s){g_ = s.g_; u_ = s.u_;};
+State& operator = (const State& s) = default;
 
 /**
  * Move constructor.
  */ 
-State(const State&& s) : g_(s.g_), u_(s.u_) {};
+State(State && s) = default;
 
 /**
  * Move assignment.
  */ 
-void operator = (const State&& s){g_ = s.g_; u_ = s.u_;};
+State& operator = (State&& s) = default;
 
 /**
  * Copy constructor using group and algebra elements.
  */ 
-State(const G& g, const U& u) : g_(g), u_(u) {};
+State(const G& g, const Twist& u) : g_(g), u_(u) {};
 
 /**
  * Move constructor using group and algebra elements.
  */ 
-State(const G&& g, const U&& u) : g_(g), u_(u) {};
+State(const G&& g, const Twist&& u) : g_(g), u_(u) {};
 
 /**
 * Initializes state using the data provied. 
@@ -112,7 +140,7 @@ State(const Mat_G & g_data, const Mat_A & u_data, bool verify) : g_(g_data,verif
 /*
  * Returns the inverse of the element
  */ 
-State Inverse(){ return State(g_.Inverse(),U(-u_.data_));}
+State Inverse(){ return State(g_.Inverse(),Twist(-u_.data_));}
 /**
  * Returns the identity element
  */ 
@@ -151,7 +179,7 @@ static State Random(const DataType scalar = static_cast<DataType>(1.0)) {
  */ 
 static Vec_SC OMinus(const Mat_G& g1_data,const Mat_G& g2_data,const Mat_C & u1_data,const Mat_C & u2_data)
 { Vec_SC tmp;
-  tmp.block(0,0,G::dim_,1) = G::OMinus(g1_data,g2_data).block(0,0,G::dim_,1);
+  tmp.block(0,0,G::dim_,1) = G::template OMinus<tRetraction>(g1_data,g2_data).block(0,0,G::dim_,1);
   tmp.block(G::dim_,0,U::total_num_dim_,1) = u1_data - u2_data;
     return tmp;}
 
@@ -183,7 +211,7 @@ Vec_SC OMinus(const State& s2) const {
  */ 
 static State OPlus(const State& state, Vec_SC cartesian) {
   State tmp;
-  tmp.g_.data_ = state.g_.OPlus(cartesian.block(0,0,U::total_num_dim_,1));
+  tmp.g_.data_ = G::template OPlus<tRetraction>(state.g_.data_,GroupCartesian(cartesian));
   tmp.u_.data_ = state.u_.data_ +  cartesian.block(G::dim_,0,U::total_num_dim_,1);
   return tmp;
 }
@@ -207,61 +235,123 @@ void OPlusEQ( Vec_SC cartesian) {
 
 
 /**
- * Computes the right Jacobian of the states Lie algebra
- * @param cartesian An element in the state's Cartesian space
+ * Performs the O-Plus operation \f$ \text{state} \exp{\text{cartesian}}\f$ and computes the right Jacobians of the
+ * result with respect to the state and to the Cartesian vector. The blocks of the group are given by
+ * Group::OPlusWithJr and the blocks of the twist are the identity since it lives in a vector space.
+ * @param state The state  
+ * @param cartesian An in the Cartesian space
+ * @param jr_state The right Jacobian with respect to the state
+ * @param j_cartesian The Jacobian with respect to the Cartesian vector
+ * @return A state that is the result of the O-Plus operation
  */ 
-static Mat_SC Jr(const Vec_SC& cartesian) {
-  
-  Eigen::Matrix<DataType, Algebra::total_num_dim_,1> vec_algebra;
-  vec_algebra.setZero();
-  vec_algebra.block(0,0,Group::dim_,1) = cartesian.block(0,0,Group::dim_,1);
-  Algebra group(vec_algebra);
-  Mat_SC jacobian = Mat_SC::Identity();
-  jacobian.block(0,0,Group::dim_,Group::dim_) = group.Jr().block(0,0,Group::dim_,Group::dim_);
-  return jacobian;
+static State OPlusWithJr(const State& state, const Vec_SC& cartesian, Mat_SC& jr_state, Mat_SC& j_cartesian) {
+  State tmp;
+  typename G::Base::Mat_Jac jr_g, j_u;
+  tmp.g_.data_ = G::template OPlusWithJr<tRetraction>(state.g_.data_,GroupCartesian(cartesian),jr_g,j_u);
+  tmp.u_.data_ = state.u_.data_ +  cartesian.block(G::dim_,0,U::total_num_dim_,1);
+  jr_state.setIdentity();
+  jr_state.block(0,0,G::dim_,G::dim_) = jr_g;
+  j_cartesian.setIdentity();
+  j_cartesian.block(0,0,G::dim_,G::dim_) = j_u;
+  return tmp;
+}
 
+/**
+ * Performs the O-Plus operation \f$ \text{state} \exp{\text{cartesian}}\f$ and computes the left Jacobians of the
+ * result with respect to the state and to the Cartesian vector. See Group::OPlusWithJl.
+ * @param state The state  
+ * @param cartesian An in the Cartesian space
+ * @param jl_state The left Jacobian with respect to the state
+ * @param j_cartesian The Jacobian with respect to the Cartesian vector
+ * @return A state that is the result of the O-Plus operation
+ */ 
+static State OPlusWithJl(const State& state, const Vec_SC& cartesian, Mat_SC& jl_state, Mat_SC& j_cartesian) {
+  State tmp;
+  typename G::Base::Mat_Jac jl_g, j_u;
+  tmp.g_.data_ = G::template OPlusWithJl<tRetraction>(state.g_.data_,GroupCartesian(cartesian),jl_g,j_u);
+  tmp.u_.data_ = state.u_.data_ +  cartesian.block(G::dim_,0,U::total_num_dim_,1);
+  jl_state.setIdentity();
+  jl_state.block(0,0,G::dim_,G::dim_) = jl_g;
+  j_cartesian.setIdentity();
+  j_cartesian.block(0,0,G::dim_,G::dim_) = j_u;
+  return tmp;
+}
+
+/**
+ * Performs the O-minus operation \f$ \log(S_2^{-1}*S_1) \f$ and computes the right Jacobians of the result
+ * with respect to each state. The blocks of the group are given by Group::OMinusWithJr and the blocks 
+ * of the twist are plus and minus the identity.
+ * @param s1 The state  \f$ s_1 \f$
+ * @param s2 The state  \f$ s_2 \f$
+ * @param jr1 The right Jacobian with respect to \f$ s_1 \f$
+ * @param jr2 The right Jacobian with respect to \f$ s_2 \f$
+ * @return The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */ 
+static Vec_SC OMinusWithJr(const State& s1, const State& s2, Mat_SC& jr1, Mat_SC& jr2) {
+  Vec_SC tmp;
+  typename G::Base::Mat_Jac jr1_g, jr2_g;
+  tmp.block(0,0,G::dim_,1) = G::template OMinusWithJr<tRetraction>(s1.g_.data_,s2.g_.data_,jr1_g,jr2_g).block(0,0,G::dim_,1);
+  tmp.block(G::dim_,0,U::total_num_dim_,1) = s1.u_.data_ - s2.u_.data_;
+  jr1.setIdentity();
+  jr1.block(0,0,G::dim_,G::dim_) = jr1_g;
+  jr2 = -Mat_SC::Identity();
+  jr2.block(0,0,G::dim_,G::dim_) = jr2_g;
+  return tmp;
 }
 
 /**
- * Computes the left Jacobian of the states Lie algebra
+ * Performs the O-minus operation \f$ \log(S_2^{-1}*S_1) \f$ and computes the left Jacobians of the result
+ * with respect to each state. See Group::OMinusWithJl.
+ * @param s1 The state  \f$ s_1 \f$
+ * @param s2 The state  \f$ s_2 \f$
+ * @param jl1 The left Jacobian with respect to \f$ s_1 \f$
+ * @param jl2 The left Jacobian with respect to \f$ s_2 \f$
+ * @return The data of an element of the Cartesian space isomorphic to the Lie algebra
+ */ 
+static Vec_SC OMinusWithJl(const State& s1, const State& s2, Mat_SC& jl1, Mat_SC& jl2) {
+  Vec_SC tmp;
+  typename G::Base::Mat_Jac jl1_g, jl2_g;
+  tmp.block(0,0,G::dim_,1) = G::template OMinusWithJl<tRetraction>(s1.g_.data_,s2.g_.data_,jl1_g,jl2_g).block(0,0,G::dim_,1);
+  tmp.block(G::dim_,0,U::total_num_dim_,1) = s1.u_.data_ - s2.u_.data_;
+  jl1.setIdentity();
+  jl1.block(0,0,G::dim_,G::dim_) = jl1_g;
+  jl2 = -Mat_SC::Identity();
+  jl2.block(0,0,G::dim_,G::dim_) = jl2_g;
+  return tmp;
+}
+
+
+/**
+ * Computes the right Jacobian of the states Lie algebra, the one of the retraction. Only the block of the group is
+ * computed, the rest is the identity, see StateJacobian.
  * @param cartesian An element in the state's Cartesian space
  */ 
-static Mat_SC Jl(const Vec_SC& cartesian) {
-  Eigen::Matrix<DataType, Algebra::total_num_dim_,1> vec_algebra;
-  vec_algebra.setZero();
-  vec_algebra.block(0,0,Group::dim_,1) = cartesian.block(0,0,Group::dim_,1);
-  Algebra group(vec_algebra);
-  Mat_SC jacobian = Mat_SC::Identity();
-  jacobian.block(0,0,Group::dim_,Group::dim_) = group.Jl().block(0,0,Group::dim_,Group::dim_);
-  return jacobian;
+static Jacobian Jr(const Vec_SC& cartesian) {
+  return Jacobian(tRetraction::template Jr<Group>(GroupCartesian(cartesian)));
 }
 
 /**
- * Computes the inverse of the right Jacobian of the states Lie algebra
+ * Computes the left Jacobian of the states Lie algebra, the one of the retraction
  * @param cartesian An element in the state's Cartesian space
  */ 
-static Mat_SC JrInv(const Vec_SC& cartesian) {
-  Eigen::Matrix<DataType, Algebra::total_num_dim_,1> vec_algebra;
-  vec_algebra.setZero();
-  vec_algebra.block(0,0,Group::dim_,1) = cartesian.block(0,0,Group::dim_,1);
-  Algebra group(vec_algebra);
-  Mat_SC jacobian = Mat_SC::Identity();
-  jacobian.block(0,0,Group::dim_,Group::dim_) = group.JrInv().block(0,0,Group::dim_,Group::dim_);
-  return jacobian;
+static Jacobian Jl(const Vec_SC& cartesian) {
+  return Jacobian(tRetraction::template Jl<Group>(GroupCartesian(cartesian)));
 }
 
 /**
- * Computes the inverse of the left Jacobian of the states Lie algebra
+ * Computes the inverse of the right Jacobian of the states Lie algebra, the one of the retraction
  * @param cartesian An element in the state's Cartesian space
  */ 
-static Mat_SC JlInv(const Vec_SC& cartesian) {
-  Eigen::Matrix<DataType, Algebra::total_num_dim_,1> vec_algebra;
-  vec_algebra.setZero();
-  vec_algebra.block(0,0,Group::dim_,1) = cartesian.block(0,0,Group::dim_,1);
-  Algebra group(vec_algebra);
-  Mat_SC jacobian = Mat_SC::Identity();
-  jacobian.block(0,0,Group::dim_,Group::dim_) = group.JlInv().block(0,0,Group::dim_,Group::dim_);
-  return jacobian;
+static Jacobian JrInv(const Vec_SC& cartesian) {
+  return Jacobian(tRetraction::template JrInv<Group>(GroupCartesian(cartesian)));
+}
+
+/**
+ * Computes the inverse of the left Jacobian of the states Lie algebra, the one of the retraction
+ * @param cartesian An element in the state's Cartesian space
+ */ 
+static Jacobian JlInv(const Vec_SC& cartesian) {
+  return Jacobian(tRetraction::template JlInv<Group>(GroupCartesian(cartesian)));
 }
 
 
@@ -271,7 +361,7 @@ static Mat_SC JlInv(const Vec_SC& cartesian) {
 static State Exp(const Vec_SC& cartesian) {
 
   State state;
-  state.g_.data_ = State::Algebra::Exp(cartesian.block(0,0,State::Algebra::total_num_dim_,1));
+  state.g_.data_ = State::Algebra::Exp(GroupCartesian(cartesian));
   state.u_.data_ = cartesian.block(State::Group::dim_,0,State::Algebra::total_num_dim_,1);
   return state;
 }
@@ -281,7 +371,7 @@ static State Exp(const Vec_SC& cartesian) {
  */
 static Vec_SC Log(const State& state) {
   Vec_SC cartesian;
-  cartesian.block(0,0,State::Group::dim_,1) = State::Algebra::Log(state.g_.data_);
+  cartesian.block(0,0,State::Group::dim_,1) = State::Algebra::Log(state.g_.data_).block(0,0,State::Group::dim_,1);
   cartesian.block(State::Group::dim_,0, State::Algebra::total_num_dim_,1) = state.u_.data_;
   return cartesian;
 }
@@ -289,6 +379,76 @@ static Vec_SC Log(const State& state) {
 
 
 
+/**
+ * Propagates the state by the time dt with the last tangent space constant, e.g. with a constant acceleration when
+ * there are two tangent spaces. The tangent spaces are the twist in the body frame and its derivatives, so they are
+ * propagated exactly by their Taylor polynomials. The pose is multiplied by the exponential of the first two terms
+ * of the Magnus expansion of the polynomial twist. The result is exact when the twist commutes with its derivatives,
+ * e.g. in Rn or with a constant axis of rotation, and its error is of order dt^5 otherwise.
+ * @param state The state
+ * @param dt The time of the propagation
+ * @return The propagated state
+ */
+static State Propagate(const State& state, const tDataType dt) {
+
+  constexpr int d = G::dim_;
+  constexpr int n = tNumTangentSpaces;
+
+  // The powers of dt divided by the factorials
+  tDataType p[n+1];
+  p[0] = static_cast<tDataType>(1.0);
+  for (int ii = 1; ii <= n; ++ii) {
+    p[ii] = p[ii-1]*dt/static_cast<tDataType>(ii);
+  }
+
+  // The integral of the twist and the integral of the brackets of the twist at two times
+  typename G::Base::Mat_C omega = G::Base::Mat_C::Zero();
+  for (int ii = 0; ii < n; ++ii) {
+    omega.template head<d>() += p[ii+1]*state.u_.data_.template segment<d>(ii*d);
+  }
+  for (int ii = 0; ii < n; ++ii) {
+    U vi(TangentCartesian(state.u_.data_,ii));
+    for (int jj = ii+1; jj < n; ++jj) {
+      const tDataType c = static_cast<tDataType>(0.5)*p[ii]*p[jj]*dt*dt/static_cast<tDataType>(ii+jj+2)
+                          *(static_cast<tDataType>(1.0)/static_cast<tDataType>(ii+1) - static_cast<tDataType>(1.0)/static_cast<tDataType>(jj+1));
+      omega.template head<d>() += c*vi.Bracket(U(TangentCartesian(state.u_.data_,jj))).data_.template head<d>();
+    }
+  }
+
+  State tmp;
+  tmp.g_.data_ = G::Mult(state.g_.data_,U::Exp(omega));
+  for (int ii = 0; ii < n; ++ii) {
+    tmp.u_.data_.template segment<d>(ii*d).setZero();
+    for (int jj = ii; jj < n; ++jj) {
+      tmp.u_.data_.template segment<d>(ii*d) += p[jj-ii]*state.u_.data_.template segment<d>(jj*d);
+    }
+  }
+  return tmp;
+}
+
+/**
+ * Propagates the state by the time dt with this being the state. See the static function.
+ * @param dt The time of the propagation
+ */
+State Propagate(const tDataType dt) const {return Propagate(*this,dt);}
+
+
+private:
+
+// The Cartesian vector of the group with the tangent space ii of the twist.
+static typename G::Base::Mat_C TangentCartesian(const Mat_C& u, const int ii) {
+  typename G::Base::Mat_C v = G::Base::Mat_C::Zero();
+  v.template head<G::dim_>() = u.template segment<G::dim_>(ii*G::dim_);
+  return v;
+}
+
+// The Cartesian vector of the group with the components of the tangent spaces set to zero.
+static typename G::Base::Mat_C GroupCartesian(const Vec_SC& cartesian) {
+  typename G::Base::Mat_C u = G::Base::Mat_C::Zero();
+  u.block(0,0,G::dim_,1) = cartesian.block(0,0,G::dim_,1);
+  return u;
+}
+
 };
 
 typedef State<Rn,  double,2,1> R2_r2;
@@ -297,6 +457,9 @@ typedef State<SO2, double,1,1> SO2_so2;
 typedef State<SO3, double,3,1> SO3_so3;
 typedef State<SE2, double,3,1> SE2_se2;
 typedef State<SE3, double,6,1> SE3_se3;
+typedef State<SO3Quat, double,3,1> SO3Quat_so3q;
+typedef State<SE3Affine, double,6,1> SE3Affine_se3a;
+typedef State<SE2Complex, double,3,1> SE2Complex_se2c;
 
 }
 
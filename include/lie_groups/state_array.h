@@ -0,0 +1,196 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_STATEARRAY_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_STATEARRAY_
+
+#include <Eigen/Dense>
+
+#include "lie_groups/state.h"
+#include "lie_groups/group_array.h"
+
+namespace lie_groups {
+
+/**
+ * A container of states stored as a structure of arrays. The group elements are stored in a GroupArray
+ * and component k of the twist of every state is stored contiguously in column k of u_.
+ *
+ * States are accessed through lightweight proxies returned by operator[].
+ */
+template<typename tState>
+class StateArray {
+
+public:
+
+typedef tState State;
+typedef typename State::Group Group;
+typedef typename State::Algebra Algebra;
+typedef typename State::DataType DataType;
+typedef typename State::Mat_G Mat_G;
+typedef typename State::Mat_C Mat_C;
+typedef typename State::Vec_SC Vec_SC;
+typedef GroupArray<Group> GArray;
+
+static constexpr int dim_ = State::dim_;
+static constexpr int dim_g_ = Group::dim_;
+static constexpr int dim_u_ = Algebra::total_num_dim_;
+typedef Eigen::Matrix<DataType,Eigen::Dynamic,dim_u_> Data_U;    /** < Row i holds the twist of state i. */
+typedef Eigen::Matrix<DataType,Eigen::Dynamic,dim_> Data_SC;     /** < Row i holds the State Cartesian data of state i. */
+
+GArray g_;   /** < The poses of the states.*/
+Data_U u_;   /** < The twists of the states.*/
+
+/**
+ * Proxy to a state of a state array.
+ */
+class Reference {
+public:
+Reference(StateArray& array, Eigen::Index index) : array_(array), index_(index) {}
+
+/**
+ * Copies the referenced state into the other referenced state.
+ */
+Reference& operator = (const Reference& r) {return *this = static_cast<State>(r);}
+
+/**
+ * Sets the referenced state to the one given.
+ */
+Reference& operator = (const State& s) {
+    GArray::Scatter(array_.g_.data_,index_,s.g_.data_);
+    array_.u_.row(index_) = s.u_.data_.transpose();
+    return *this;}
+
+/**
+ * Returns a copy of the referenced state.
+ */
+operator State() const {return array_.Get(index_);}
+
+private:
+StateArray& array_;
+Eigen::Index index_;
+};
+
+/**
+ * Default constructor. Initializes an empty array.
+ */
+StateArray() = default;
+
+/**
+ * Initializes the array with size states set to identity.
+ */
+explicit StateArray(Eigen::Index size) : g_(size), u_(Data_U::Zero(size,dim_u_)) {}
+
+/**
+ * Returns the number of states.
+ */
+Eigen::Index Size() const {return g_.Size();}
+
+/**
+ * Changes the number of states. The data of the states is not initialized.
+ */
+void Resize(Eigen::Index size) {g_.Resize(size); u_.resize(size,dim_u_);}
+
+/**
+ * Sets every state to identity.
+ */
+void SetIdentity() {g_.SetIdentity(); u_.setZero();}
+
+/**
+ * Returns a proxy to state i.
+ */
+Reference operator [] (Eigen::Index i) {return Reference(*this,i);}
+
+/**
+ * Returns a copy of state i.
+ */
+State operator [] (Eigen::Index i) const {return Get(i);}
+
+/**
+ * Returns a copy of state i.
+ */
+State Get(Eigen::Index i) const {
+    State s;
+    s.g_.data_ = GArray::Gather(g_.data_,i);
+    s.u_.data_ = u_.row(i).transpose();
+    return s;}
+
+/**
+ * Performs the group operation s1*s2 on every pair of states.
+ * @param s1 The left states.
+ * @param s2 The right states.
+ * @param out The result. It can be the same array as s1 or s2.
+ */
+static void Mult(const StateArray& s1, const StateArray& s2, StateArray& out) {
+    GArray::Mult(s1.g_,s2.g_,out.g_);
+    out.u_ = s1.u_ + s2.u_;
+}
+
+/**
+ * Computes the inverse of every state.
+ * @param s The states.
+ * @param out The result. It can be the same array as s.
+ */
+static void Inverse(const StateArray& s, StateArray& out) {
+    GArray::Inverse(s.g_,out.g_);
+    out.u_ = -s.u_;
+}
+
+/**
+ * Computes the exponential of every State Cartesian element.
+ * @param cartesian The State Cartesian data.
+ * @param out The resulting states.
+ */
+static void Exp(const Data_SC& cartesian, StateArray& out) {
+    GArray::Exp(GroupCartesian(cartesian),out.g_);
+    out.u_ = cartesian.middleCols(dim_g_,dim_u_);
+}
+
+/**
+ * Computes the logarithm of every state.
+ * @param s The states.
+ * @param out The resulting State Cartesian data.
+ */
+static void Log(const StateArray& s, Data_SC& out) {
+    typename GArray::Data_C tmp;
+    GArray::Log(s.g_,tmp);
+    out.resize(s.Size(),dim_);
+    out.leftCols(dim_g_) = tmp.leftCols(dim_g_);
+    out.middleCols(dim_g_,dim_u_) = s.u_;
+}
+
+/**
+ * Performs the O-Plus operation on every state. See State::OPlus.
+ * @param s The states.
+ * @param cartesian The State Cartesian data.
+ * @param out The result. It can be the same array as s.
+ */
+static void OPlus(const StateArray& s, const Data_SC& cartesian, StateArray& out) {
+    GArray::OPlus(s.g_,GroupCartesian(cartesian),out.g_);
+    out.u_ = s.u_ + cartesian.middleCols(dim_g_,dim_u_);
+}
+
+/**
+ * Performs the O-minus operation \f$ \log(S_2^{-1}*S_1) \f$ on every pair of states. See State::OMinus.
+ * @param s1 The states \f$ S_1 \f$.
+ * @param s2 The states \f$ S_2 \f$.
+ * @param out The resulting State Cartesian data.
+ */
+static void OMinus(const StateArray& s1, const StateArray& s2, Data_SC& out) {
+    typename GArray::Data_C tmp;
+    GArray::OMinus(s1.g_,s2.g_,tmp);
+    out.resize(s1.Size(),dim_);
+    out.leftCols(dim_g_) = tmp.leftCols(dim_g_);
+    out.middleCols(dim_g_,dim_u_) = s1.u_ - s2.u_;
+}
+
+private:
+
+// The Cartesian data of the groups with the components of the tangent spaces set to zero. See State::GroupCartesian.
+static typename GArray::Data_C GroupCartesian(const Data_SC& cartesian) {
+    typename GArray::Data_C u = GArray::Data_C::Zero(cartesian.rows(),GArray::size_c_);
+    u.leftCols(dim_g_) = cartesian.leftCols(dim_g_);
+    return u;
+}
+
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_STATEARRAY_
@@ -0,0 +1,124 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_STATEJACOBIAN_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_STATEJACOBIAN_
+
+#include <Eigen/Dense>
+
+namespace lie_groups {
+
+/**
+ * A Jacobian of the Cartesian space of a State, e.g. State::Jr. Its upper left block of size tBlockDim is the
+ * Jacobian of the group and the rest of the matrix is the identity, since the twist lives in a vector space.
+ * Only the block of the group is stored, so the products cost as much as the products with the block.
+ *
+ * The Jacobian converts implicitly to the dense matrix, which allows to use it as an Eigen matrix. The member
+ * functions avoid the dense matrix.
+ */
+template <typename tDataType, int tBlockDim, int tDim>
+class StateJacobian {
+
+public:
+
+static_assert(tBlockDim <= tDim, "lie_groups::StateJacobian the block is larger than the matrix.");
+
+static constexpr int dim_ = tDim;                 /**< The number of rows and columns. */
+static constexpr int block_dim_ = tBlockDim;      /**< The number of rows and columns of the block of the group. */
+static constexpr int identity_dim_ = tDim - tBlockDim;
+enum {RowsAtCompileTime = tDim, ColsAtCompileTime = tDim};
+
+typedef Eigen::Matrix<tDataType,tBlockDim,tBlockDim> Mat_B;   /**< The block of the group data type. */
+typedef Eigen::Matrix<tDataType,tDim,tDim> Mat;               /**< The dense matrix data type. */
+
+Mat_B block_;  /** < The block of the group. */
+
+/**
+ * Default constructor. Initializes the Jacobian to the identity.
+ */
+StateJacobian() : block_(Mat_B::Identity()) {}
+
+/**
+ * Initializes the Jacobian with the block of the group.
+ */
+explicit StateJacobian(const Mat_B& block) : block_(block) {}
+
+/**
+ * Returns the identity.
+ */
+static StateJacobian Identity() {return StateJacobian();}
+
+/**
+ * Returns the dense matrix.
+ */
+Mat ToDense() const {
+    Mat m = Mat::Identity();
+    m.template topLeftCorner<tBlockDim,tBlockDim>() = block_;
+    return m;
+}
+
+/**
+ * Converts to the dense matrix.
+ */
+operator Mat() const {return ToDense();}
+
+/**
+ * Returns the transpose.
+ */
+StateJacobian Transpose() const {return StateJacobian(block_.transpose());}
+
+/**
+ * Multiplies two Jacobians of the same structure.
+ */
+StateJacobian operator * (const StateJacobian& j) const {return StateJacobian(block_*j.block_);}
+
+/**
+ * Multiplies a matrix or a vector with tDim rows on the left, \f$ J m \f$.
+ */
+template <typename tDerived>
+Eigen::Matrix<tDataType,tDim,tDerived::ColsAtCompileTime> operator * (const Eigen::MatrixBase<tDerived>& m) const {
+    Eigen::Matrix<tDataType,tDim,tDerived::ColsAtCompileTime> out(static_cast<Eigen::Index>(tDim),m.cols());
+    out.template topRows<tBlockDim>().noalias() = block_*m.template topRows<tBlockDim>();
+    out.template bottomRows<identity_dim_>() = m.template bottomRows<identity_dim_>();
+    return out;
+}
+
+/**
+ * Multiplies the transpose by a matrix or a vector with tDim rows, \f$ J^\top m \f$.
+ */
+template <typename tDerived>
+Eigen::Matrix<tDataType,tDim,tDerived::ColsAtCompileTime> TransposeTimes(const Eigen::MatrixBase<tDerived>& m) const {
+    Eigen::Matrix<tDataType,tDim,tDerived::ColsAtCompileTime> out(static_cast<Eigen::Index>(tDim),m.cols());
+    out.template topRows<tBlockDim>().noalias() = block_.transpose()*m.template topRows<tBlockDim>();
+    out.template bottomRows<identity_dim_>() = m.template bottomRows<identity_dim_>();
+    return out;
+}
+
+/**
+ * Propagates a covariance, \f$ J P J^\top \f$. Only the blocks of the covariance that involve the group change.
+ * @param cov A square matrix of size tDim
+ */
+template <typename tDerived>
+Mat Propagate(const Eigen::MatrixBase<tDerived>& cov) const {
+    Mat out;
+    const Eigen::Matrix<tDataType,tBlockDim,tDim> top = block_*cov.template topRows<tBlockDim>();
+    out.template topLeftCorner<tBlockDim,tBlockDim>().noalias() = top.template leftCols<tBlockDim>()*block_.transpose();
+    out.template topRightCorner<tBlockDim,identity_dim_>() = top.template rightCols<identity_dim_>();
+    out.template bottomLeftCorner<identity_dim_,tBlockDim>().noalias() = cov.template bottomLeftCorner<identity_dim_,tBlockDim>()*block_.transpose();
+    out.template bottomRightCorner<identity_dim_,identity_dim_>() = cov.template bottomRightCorner<identity_dim_,identity_dim_>();
+    return out;
+}
+
+};
+
+/**
+ * Multiplies a matrix or a vector with tDim columns on the right by a Jacobian, \f$ m J \f$.
+ */
+template <typename tDerived, typename tDataType, int tBlockDim, int tDim>
+Eigen::Matrix<tDataType,tDerived::RowsAtCompileTime,tDim> operator * (const Eigen::MatrixBase<tDerived>& m, const StateJacobian<tDataType,tBlockDim,tDim>& j) {
+    Eigen::Matrix<tDataType,tDerived::RowsAtCompileTime,tDim> out(m.rows(),static_cast<Eigen::Index>(tDim));
+    out.template leftCols<tBlockDim>().noalias() = m.template leftCols<tBlockDim>()*j.block_;
+    out.template rightCols<tDim-tBlockDim>() = m.template rightCols<tDim-tBlockDim>();
+    return out;
+}
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_STATEJACOBIAN_
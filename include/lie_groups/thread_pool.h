@@ -0,0 +1,169 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_THREADPOOL_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_THREADPOOL_
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lie_groups {
+
+/**
+ * A fixed set of worker threads that run the tasks of a parallel loop. The threads are created once and
+ * reused by every loop so that a parallel operation doesn't pay for thread creation.
+ * The calling thread takes part in the loop, so a pool with one thread runs everything on the calling thread.
+ * A pool runs a single loop at a time.
+ */
+class ThreadPool {
+
+public:
+
+/**
+ * Creates a pool with num_threads threads including the calling thread.
+ * @param num_threads The number of threads. If it is 0, the number of hardware threads is used.
+ */
+explicit ThreadPool(unsigned int num_threads = 0) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned int ii = 1; ii < num_threads; ++ii) {
+        workers_.emplace_back([this]() {WorkerLoop();});
+    }
+}
+
+ThreadPool(const ThreadPool&) = delete;
+ThreadPool& operator = (const ThreadPool&) = delete;
+
+/**
+ * Stops and joins the worker threads.
+ */
+~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+/**
+ * Returns the number of threads including the calling thread.
+ */
+unsigned int NumThreads() const {return static_cast<unsigned int>(workers_.size()) + 1;}
+
+/**
+ * Calls task(ii) for every ii in [0, num_tasks) and returns once all of the calls are done.
+ * The tasks are distributed dynamically among the threads. If a task throws, the tasks that haven't started
+ * are skipped and the first exception is rethrown once every thread is done.
+ * @param num_tasks The number of tasks.
+ * @param task The functor to call with the index of every task.
+ */
+void ParallelFor(Eigen::Index num_tasks, const std::function<void(Eigen::Index)>& task) {
+
+    if (num_tasks <= 0) {
+        return;
+    }
+    if (workers_.empty() || num_tasks == 1) {
+        for (Eigen::Index ii = 0; ii < num_tasks; ++ii) {
+            task(ii);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        num_tasks_ = num_tasks;
+        next_task_ = 0;
+        num_active_ = static_cast<int>(workers_.size());
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    RunTasks(task,num_tasks);
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this]() {return num_active_ == 0;});
+        task_ = nullptr;
+        std::swap(error,error_);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+private:
+
+/**
+ * Claims and runs tasks until none are left. The first exception thrown by a task is kept for ParallelFor
+ * and the remaining tasks are skipped.
+ */
+void RunTasks(const std::function<void(Eigen::Index)>& task, Eigen::Index num_tasks) {
+    try {
+        for (Eigen::Index ii = next_task_.fetch_add(1); ii < num_tasks; ii = next_task_.fetch_add(1)) {
+            task(ii);
+        }
+    } catch (...) {
+        next_task_ = num_tasks;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+            error_ = std::current_exception();
+        }
+    }
+}
+
+/**
+ * Waits for a loop, takes part in it and signals when done.
+ */
+void WorkerLoop() {
+    unsigned long seen_generation = 0;
+    while (true) {
+        const std::function<void(Eigen::Index)>* task;
+        Eigen::Index num_tasks;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&]() {return stop_ || generation_ != seen_generation;});
+            if (stop_) {
+                return;
+            }
+            seen_generation = generation_;
+            task = task_;
+            num_tasks = num_tasks_;
+        }
+
+        RunTasks(*task,num_tasks);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --num_active_;
+        }
+        done_cv_.notify_one();
+    }
+}
+
+std::vector<std::thread> workers_;
+std::mutex mutex_;
+std::condition_variable start_cv_;
+std::condition_variable done_cv_;
+const std::function<void(Eigen::Index)>* task_ = nullptr;
+Eigen::Index num_tasks_ = 0;
+std::atomic<Eigen::Index> next_task_{0};
+int num_active_ = 0;
+std::exception_ptr error_;
+unsigned long generation_ = 0;
+bool stop_ = false;
+
+};
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_THREADPOOL_
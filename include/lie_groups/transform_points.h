@@ -0,0 +1,86 @@
+#ifndef _LIEGROUPS_INCLUDE_LIEGROUPS_TRANSFORMPOINTS_
+#define _LIEGROUPS_INCLUDE_LIEGROUPS_TRANSFORMPOINTS_
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <vector>
+
+#include "lie_groups/thread_pool.h"
+
+/**
+ * Applies the action of a group element to a cloud of points on the threads of a pool. Every thread
+ * transforms a contiguous chunk of the cloud with the batch action of the group, Group::BatchAct.
+ */
+
+namespace lie_groups {
+
+constexpr Eigen::Index kTransformPointsMinChunkSize = 16384; /** < Clouds with fewer points per thread are transformed with fewer threads.*/
+
+template<typename tGroup>
+using PointVector = std::vector<typename tGroup::Point, Eigen::aligned_allocator<typename tGroup::Point>>;
+
+template<typename tGroup>
+using ActJacobianVector = std::vector<typename tGroup::ActJacobian, Eigen::aligned_allocator<typename tGroup::ActJacobian>>;
+
+namespace internal {
+
+/**
+ * Calls chunk(begin,end) for the chunks of n points in parallel.
+ */
+template<typename tChunk>
+void ParallelChunks(Eigen::Index n, ThreadPool& pool, tChunk chunk) {
+
+    const Eigen::Index num_chunks = std::max<Eigen::Index>(1, std::min<Eigen::Index>(pool.NumThreads(), n/kTransformPointsMinChunkSize));
+    const Eigen::Index chunk_size = (n + num_chunks - 1)/num_chunks;
+
+    pool.ParallelFor(num_chunks, [&](Eigen::Index c) {
+        const Eigen::Index begin = c*chunk_size;
+        const Eigen::Index end = std::min(n, begin+chunk_size);
+        if (begin < end) {
+            chunk(begin,end);
+        }
+    });
+}
+
+} // namespace internal
+
+/**
+ * Transforms a cloud of points, \f$ q_k = g p_k \f$.
+ * @param g The element of the group.
+ * @param points The points \f$ p_k \f$.
+ * @param out The transformed points \f$ q_k \f$. It can be the same vector as points.
+ * @param pool The threads the transformation is run on.
+ */
+template<typename tGroup>
+void TransformPoints(const tGroup& g, const PointVector<tGroup>& points, PointVector<tGroup>& out, ThreadPool& pool) {
+
+    const Eigen::Index n = static_cast<Eigen::Index>(points.size());
+    out.resize(n);
+    internal::ParallelChunks(n, pool, [&](Eigen::Index begin, Eigen::Index end) {
+        tGroup::BatchAct(g.data_, points.data()+begin, out.data()+begin, end-begin);
+    });
+}
+
+/**
+ * Transforms a cloud of points, \f$ q_k = g p_k \f$, and computes the Jacobians of the transformed points with
+ * respect to the element. The Jacobian with respect to every point is the rotation of the element.
+ * @param g The element of the group.
+ * @param points The points \f$ p_k \f$.
+ * @param out The transformed points \f$ q_k \f$. It can be the same vector as points.
+ * @param j_pose The Jacobians of the transformed points with respect to the element.
+ * @param pool The threads the transformation is run on.
+ */
+template<typename tGroup>
+void TransformPoints(const tGroup& g, const PointVector<tGroup>& points, PointVector<tGroup>& out, ActJacobianVector<tGroup>& j_pose, ThreadPool& pool) {
+
+    const Eigen::Index n = static_cast<Eigen::Index>(points.size());
+    out.resize(n);
+    j_pose.resize(n);
+    internal::ParallelChunks(n, pool, [&](Eigen::Index begin, Eigen::Index end) {
+        tGroup::BatchActWithJacobians(g.data_, points.data()+begin, out.data()+begin, j_pose.data()+begin, end-begin);
+    });
+}
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_INCLUDE_LIEGROUPS_TRANSFORMPOINTS_
@@ -0,0 +1,137 @@
+// Every allocation of Eigen is reported, also in the release build, so that the test can verify that AnyGroup and
+// AnyAlgebra never allocate.
+#include <stdexcept>
+#define EIGEN_RUNTIME_NO_MALLOC
+#define eigen_assert(x) do { if (!(x)) { throw std::runtime_error(#x); } } while (false)
+
+#include "gtest/gtest.h"
+
+#include <Eigen/Dense>
+#include <string>
+
+#include "lie_groups/lie_groups/any_group.h"
+
+namespace lie_groups {
+
+
+using MyTypes = ::testing::Types<Rn<double,3,1>,Rn<double,6,1>,SO2<double>,SO3<double>,SE2<double>,SE3<double>,SO3Quat<double>,SE3Affine<double>,SE2Complex<double>>;
+
+template <typename T>
+class AnyGroupTest : public testing::Test {
+public:
+typedef T type;
+};
+
+TYPED_TEST_SUITE(AnyGroupTest, MyTypes);
+
+////////////////////////////////////////////////////////////
+//                    Operations test
+////////////////////////////////////////////////////////////
+
+// Every operation gives the result of the static functions of the group.
+TYPED_TEST(AnyGroupTest, Operations) {
+
+typedef TypeParam Group;
+typedef typename Group::Algebra Algebra;
+typedef typename Group::Base::Mat_C Mat_C;
+typedef AnyGroup<double>::Mat_C AnyMat_C;
+const int dim = Group::Algebra::dim_;
+const double tol = 1e-12;
+
+for (int ii = 0; ii < 10; ++ii) {
+
+    Group g1(Group::Random()), g2(Group::Random());
+    const Mat_C u = Mat_C::Random();
+    const Mat_C v = Mat_C::Random();
+
+    Eigen::internal::set_is_malloc_allowed(false);
+
+    const AnyGroup<double> a1(g1), a2(g2);
+    const Algebra tu(u), tv(v);
+    const AnyAlgebra<double> au(tu), av(tv);
+    const AnyGroup<double> product = a1*a2;
+    const AnyGroup<double> inverse = a1.Inverse();
+    const AnyAlgebra<double> log = a1.Log();
+    const AnyGroup<double> oplus = a1.OPlus(AnyMat_C(u));
+    const AnyGroup<double> oplus_algebra = a1.OPlus(au);
+    const AnyAlgebra<double> ominus = a1.OMinus(a2);
+    const AnyGroup<double>::Mat_Jac adjoint = a1.Adjoint();
+    const AnyAlgebra<double> bracket = au.Bracket(av);
+    const AnyAlgebra<double> sum = au + av*2.0;
+    const AnyAlgebra<double> difference = au - av;
+    const AnyAlgebra<double>::Mat_Jac jr = au.Jr(), jl = au.Jl(), jr_inv = au.JrInv(), jl_inv = au.JlInv(), ad = au.Adjoint();
+    const AnyAlgebra<double>::Mat_A wedge = au.Wedge();
+
+    Eigen::internal::set_is_malloc_allowed(true);
+
+    ASSERT_FALSE(a1.Empty());
+    ASSERT_TRUE(a1.template Is<Group>());
+    ASSERT_FALSE((a1.template Is<Rn<double,2,1>>()));
+    ASSERT_EQ(a1.Dim(), dim);
+    ASSERT_EQ(AnyGroup<double>::Identity(a1.Name()).Data(), Group::Identity().data_);
+    ASSERT_EQ(a1.template Get<Group>().data_, g1.data_);
+    ASSERT_EQ(au.template Get<Algebra>().data_, u);
+
+    ASSERT_LE( (product.Data() - Group::Mult(g1.data_,g2.data_)).norm(), tol) << "Error with Mult";
+    ASSERT_LE( (inverse.Data() - Group::Inverse(g1.data_)).norm(), tol) << "Error with Inverse";
+    ASSERT_LE( (log.Data() - Algebra::Log(g1.data_)).norm(), tol) << "Error with Log";
+    ASSERT_LE( (oplus.Data() - Group::OPlus(g1.data_,u)).norm(), tol) << "Error with OPlus";
+    ASSERT_LE( (oplus_algebra.Data() - Group::OPlus(g1.data_,u)).norm(), tol) << "Error with OPlus";
+    ASSERT_LE( (ominus.Data() - Group::OMinus(g1.data_,g2.data_)).norm(), tol) << "Error with OMinus";
+    ASSERT_LE( (adjoint - g1.Adjoint().topLeftCorner(dim,dim)).norm(), tol) << "Error with Adjoint";
+
+    Algebra su(u), sv(v);
+    ASSERT_LE( (bracket.Data() - su.Bracket(sv).data_).norm(), tol) << "Error with Bracket";
+    ASSERT_LE( (sum.Data() - (u + 2.0*v)).norm(), tol) << "Error with operator +";
+    ASSERT_LE( (difference.Data() - (u - v)).norm(), tol) << "Error with operator -";
+    ASSERT_LE( (jr - su.Jr().topLeftCorner(dim,dim)).norm(), tol) << "Error with Jr";
+    ASSERT_LE( (jl - su.Jl().topLeftCorner(dim,dim)).norm(), tol) << "Error with Jl";
+    ASSERT_LE( (jr_inv - su.JrInv().topLeftCorner(dim,dim)).norm(), tol) << "Error with JrInv";
+    ASSERT_LE( (jl_inv - su.JlInv().topLeftCorner(dim,dim)).norm(), tol) << "Error with JlInv";
+    ASSERT_LE( (ad - su.Adjoint().topLeftCorner(dim,dim)).norm(), tol) << "Error with Adjoint";
+    ASSERT_LE( (wedge - Algebra::Wedge(u)).norm(), tol) << "Error with Wedge";
+    ASSERT_DOUBLE_EQ(au.Norm(), u.norm());
+}
+
+}
+
+////////////////////////////////////////////////////////////
+//                    Runtime selection test
+////////////////////////////////////////////////////////////
+
+TEST(AnyGroupTest, Identity) {
+
+for (const std::string name : {"R1", "R2", "R3", "R4", "R5", "R6", "SO2", "SO3", "SE2", "SE3", "SO3Quat", "SE3Affine", "SE2Complex"}) {
+    AnyGroup<double> g = AnyGroup<double>::Identity(name);
+    ASSERT_FALSE(g.Empty()) << name;
+    ASSERT_EQ(std::string(g.Name()), name);
+    ASSERT_LE(g.Log().Norm(), 1e-15) << name;
+    AnyGroup<double>::Mat_C u = AnyGroup<double>::Mat_C::Random(g.Dim())*0.5;
+    g = g.OPlus(u);
+    ASSERT_LE( (g.Log().Data() - u).norm(), 1e-12) << name;
+    ASSERT_LE( (g*g.Inverse()).Log().Norm(), 1e-12) << name;
+}
+
+ASSERT_TRUE(AnyGroup<double>::Identity("SE4").Empty());
+ASSERT_TRUE(AnyGroup<float>::Identity("SE3").template Is<SE3<float>>());
+
+// The operations between elements of different groups are empty
+const AnyGroup<double> se3 = AnyGroup<double>::Identity("SE3"), so3 = AnyGroup<double>::Identity("SO3");
+ASSERT_TRUE(se3.Mult(so3).Empty());
+ASSERT_TRUE(se3.OMinus(so3).Empty());
+ASSERT_TRUE(se3.OPlus(so3.Log()).Empty());
+ASSERT_TRUE((se3.Log() + so3.Log()).Empty());
+
+// Normalization
+AnyGroup<double> g(SO3<double>(SO3<double>::Random()));
+SO3<double> drifted(g.Get<SO3<double>>());
+drifted.data_ *= 1.0 + 1e-8;
+g = AnyGroup<double>(drifted);
+ASSERT_GT(g.Drift(), 1e-9);
+g.NormalizeEq();
+ASSERT_LE(g.Drift(), 1e-14);
+
+}
+
+
+} // namespace lie_groups
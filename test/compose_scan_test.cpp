@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include <Eigen/Dense>
+#include <stdexcept>
+#include <vector>
+
+#include "lie_groups/state.h"
+#include "lie_groups/compose_scan.h"
+
+namespace lie_groups {
+
+
+using MyTypes = ::testing::Types<Rn<double,3,1>,SO2<double>,SO3<double>,SE2<double>,SE3<double>,SE3<float>>;
+
+template <typename T>
+class ComposeScanTest : public testing::Test {
+public:
+typedef T type;
+};
+
+TYPED_TEST_SUITE(ComposeScanTest, MyTypes);
+
+template<typename tDataType>
+double Tolerance() {return std::is_same<tDataType,float>::value ? 1e-3 : 1e-8;}
+
+////////////////////////////////////////////////////////////
+//                  Thread pool test
+////////////////////////////////////////////////////////////
+
+TEST(ThreadPoolTest, ParallelFor) {
+
+for (unsigned int num_threads : {1u, 2u, 4u}) {
+    ThreadPool pool(num_threads);
+    ASSERT_EQ(pool.NumThreads(), num_threads);
+
+    // Every task runs exactly once and the pool can be reused.
+    for (int rr = 0; rr < 10; ++rr) {
+        std::vector<int> counts(1000, 0);
+        pool.ParallelFor(static_cast<Eigen::Index>(counts.size()), [&](Eigen::Index ii) {counts[ii] += 1;});
+        for (int count : counts) {
+            ASSERT_EQ(count, 1);
+        }
+    }
+    pool.ParallelFor(0, [](Eigen::Index) {FAIL();});
+
+    // An exception thrown by a task is rethrown on the calling thread and the pool stays usable.
+    ASSERT_THROW(pool.ParallelFor(1000, [](Eigen::Index ii) {if (ii == 500) {throw std::runtime_error("task");}}), std::runtime_error);
+    std::vector<int> counts(1000, 0);
+    pool.ParallelFor(static_cast<Eigen::Index>(counts.size()), [&](Eigen::Index ii) {counts[ii] += 1;});
+    for (int count : counts) {
+        ASSERT_EQ(count, 1);
+    }
+}
+
+}
+
+////////////////////////////////////////////////////////////
+//                  Compose scan test
+////////////////////////////////////////////////////////////
+
+TYPED_TEST(ComposeScanTest, ComposeAndInverse) {
+
+typedef TypeParam Group;
+typedef typename Group::Base::Mat_C Mat_C;
+const double tol = Tolerance<typename Group::Base::DataType>();
+
+ThreadPool pool(4);
+Group start(Group::Random());
+
+// The chains are split in a single chunk, several chunks and chunks of unequal sizes.
+for (Eigen::Index n : {Eigen::Index(0), Eigen::Index(5), 4*kComposeScanMinChunkSize + 13}) {
+
+    GroupVector<Group> increments(n), poses, poses_cartesian;
+    CartesianVector<Group> u(n), u_recovered;
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        u[ii] = Mat_C::Random()*static_cast<typename Group::Base::DataType>(0.1);
+        increments[ii].data_ = Group::Algebra::Exp(u[ii]);
+    }
+
+    ComposeScan(start,increments,poses,pool);
+    ComposeScan(start,u,poses_cartesian,pool);
+    InverseComposeScan(start,poses,u_recovered,pool);
+    ASSERT_EQ(static_cast<Eigen::Index>(poses.size()), n);
+    ASSERT_EQ(static_cast<Eigen::Index>(u_recovered.size()), n);
+
+    // Serial composition
+    Group pose = start;
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        pose.data_ = Group::Mult(pose.data_,increments[ii].data_);
+        ASSERT_LE( (poses[ii].data_ - pose.data_).norm(), tol) << "Error with ComposeScan at " << ii;
+        ASSERT_LE( (poses_cartesian[ii].data_ - pose.data_).norm(), tol) << "Error with ComposeScan of Cartesian increments at " << ii;
+        ASSERT_LE( (u_recovered[ii] - u[ii]).norm(), tol) << "Error with InverseComposeScan at " << ii;
+    }
+}
+
+}
+
+
+} // namespace lie_groups
@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+
+#include <Eigen/Dense>
+#include <vector>
+
+#include "lie_groups/state.h"
+#include "lie_groups/composition_index.h"
+
+namespace lie_groups {
+
+
+using MyTypes = ::testing::Types<Rn<double,3,1>,SO2<double>,SO3<double>,SE2<double>,SE3<double>>;
+
+template <typename T>
+class CompositionIndexTest : public testing::Test {
+public:
+typedef T type;
+};
+
+TYPED_TEST_SUITE(CompositionIndexTest, MyTypes);
+
+// Computes p_i^{-1} p_j by composing the increments one at a time.
+template<typename tGroup>
+typename tGroup::Base::Mat_G SerialBetween(const GroupVector<tGroup>& increments, int i, int j) {
+    typename tGroup::Base::Mat_G m = tGroup().data_;
+    for (int k = std::min(i,j)+1; k <= std::max(i,j); ++k) {
+        m = tGroup::Mult(m,increments[k].data_);
+    }
+    return i <= j ? m : tGroup::Inverse(m);
+}
+
+////////////////////////////////////////////////////////////
+//                  Between and update test
+////////////////////////////////////////////////////////////
+
+TYPED_TEST(CompositionIndexTest, BetweenAndUpdate) {
+
+typedef TypeParam Group;
+const double tol = 1e-10;
+
+// The size is not a power of two so that the padding is tested.
+const int n = 37;
+GroupVector<Group> increments(n);
+for (int ii = 0; ii < n; ++ii) {
+    increments[ii].data_ = Group::Random();
+}
+
+CompositionIndex<Group> index(increments);
+ASSERT_EQ(index.Size(), n);
+
+for (int ii = 0; ii < n; ++ii) {
+    ASSERT_EQ(index.Increment(ii).data_, increments[ii].data_);
+    for (int jj = 0; jj < n; ++jj) {
+        ASSERT_LE( (index.Between(ii,jj).data_ - SerialBetween(increments,ii,jj)).norm(), tol) << "Error with Between(" << ii << "," << jj << ")";
+    }
+}
+
+ASSERT_LE( (index.Product(3,3).data_ - Group().data_).norm(), tol) << "The product of an empty range must be the identity";
+ASSERT_LE( (index.Product(0,n).data_ - SerialBetween(increments,-1,n-1)).norm(), tol) << "Error with the product of the whole chain";
+
+// Updates
+for (int ii : {0, 17, n-1}) {
+    increments[ii].data_ = Group::Random();
+    index.Update(ii,increments[ii]);
+}
+for (int ii = 0; ii < n; ++ii) {
+    for (int jj = 0; jj < n; ++jj) {
+        ASSERT_LE( (index.Between(ii,jj).data_ - SerialBetween(increments,ii,jj)).norm(), tol) << "Error with Between(" << ii << "," << jj << ") after an update";
+    }
+}
+
+// A chain with a single increment
+CompositionIndex<Group> single(GroupVector<Group>(1,increments[0]));
+ASSERT_LE( (single.Product(0,1).data_ - increments[0].data_).norm(), tol);
+ASSERT_LE( (single.Between(0,0).data_ - Group().data_).norm(), tol);
+
+}
+
+
+} // namespace lie_groups
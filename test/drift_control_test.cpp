@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+
+#include <Eigen/Dense>
+
+#include "lie_groups/state.h"
+#include "lie_groups/drift_control.h"
+
+namespace lie_groups {
+
+
+using MyTypes = ::testing::Types<Rn<double,3,1>,SO2<double>,SO3<double>,SE2<double>,SE3<double>,SO3Quat<double>,SE3Affine<double>,SE2Complex<double>,SO3<float>,SE3<float>>;
+
+template <typename T>
+class DriftControlTest : public testing::Test {
+public:
+typedef T type;
+};
+
+TYPED_TEST_SUITE(DriftControlTest, MyTypes);
+
+template<typename tDataType>
+double Tolerance() {return std::is_same<tDataType,float>::value ? 1e-5 : 1e-12;}
+
+// Adds a perturbation of the given size to every entry of the data except the constant ones of the homogeneous
+// matrices, which Normalize resets.
+template<typename tGroup>
+typename tGroup::Base::Mat_G Perturb(const typename tGroup::Base::Mat_G& data, const double scale) {
+    typedef typename tGroup::Base::Mat_G Mat_G;
+    typedef typename tGroup::Base::DataType DataType;
+    return data + Mat_G::Random()*static_cast<DataType>(scale);
+}
+
+////////////////////////////////////////////////////////////
+//                    Normalization test
+////////////////////////////////////////////////////////////
+
+TYPED_TEST(DriftControlTest, Normalize) {
+
+typedef TypeParam Group;
+typedef typename Group::Base::Mat_G Mat_G;
+const double tol = Tolerance<typename Group::Base::DataType>();
+
+for (int ii = 0; ii < 20; ++ii) {
+
+    const Group g(Group::Random(3));
+    ASSERT_LE(Group::Drift(g.data_), 10*tol);
+
+    // An element of the group is kept
+    ASSERT_LE( (Group::template Normalize<PolarNormalization>(g.data_) - g.data_).norm(), 10*tol);
+    ASSERT_LE( (Group::template Normalize<QuaternionNormalization>(g.data_) - g.data_).norm(), 10*tol);
+    ASSERT_LE( (Group::template Normalize<SVDNormalization>(g.data_) - g.data_).norm(), 10*tol);
+
+    // A small drift is removed by every policy
+    const double scale = std::is_same<typename Group::Base::DataType,float>::value ? 1e-4 : 1e-7;
+    const Mat_G drifted = Perturb<Group>(g.data_,scale);
+    const Mat_G polar = Group::template Normalize<PolarNormalization>(drifted);
+    const Mat_G quaternion = Group::template Normalize<QuaternionNormalization>(drifted);
+    const Mat_G svd = Group::template Normalize<SVDNormalization>(drifted);
+    ASSERT_LE(Group::Drift(polar), 10*tol) << "Error with PolarNormalization";
+    ASSERT_LE(Group::Drift(quaternion), 10*tol) << "Error with QuaternionNormalization";
+    ASSERT_LE(Group::Drift(svd), 10*tol) << "Error with SVDNormalization";
+    ASSERT_TRUE(Group::isElement(polar));
+    ASSERT_TRUE(Group::isElement(quaternion));
+    ASSERT_TRUE(Group::isElement(svd));
+    ASSERT_LE( (polar - g.data_).norm(), 100*scale);
+    ASSERT_LE( (quaternion - g.data_).norm(), 100*scale);
+    ASSERT_LE( (svd - g.data_).norm(), 100*scale);
+
+    // The polar step is the first order of the closest rotation
+    ASSERT_LE( (polar - svd).norm(), 10*scale*scale + 10*tol);
+
+    // The exact fallback handles a large drift
+    const Mat_G large = Perturb<Group>(g.data_,0.05);
+    ASSERT_LE(Group::Drift(Group::template Normalize<SVDNormalization>(large)), 10*tol) << "Error with SVDNormalization";
+
+    // The member function
+    Group h(drifted);
+    h.NormalizeEq();
+    ASSERT_LE( (h.data_ - polar).norm(), tol);
+}
+
+}
+
+////////////////////////////////////////////////////////////
+//                    Drift control test
+////////////////////////////////////////////////////////////
+
+TYPED_TEST(DriftControlTest, Policy) {
+
+typedef TypeParam Group;
+typedef typename Group::Base::Mat_G Mat_G;
+typedef typename Group::Base::DataType DataType;
+const double tol = Tolerance<DataType>();
+const double scale = std::is_same<DataType,float>::value ? 1e-4 : 1e-7;
+const bool is_rn = Group::Drift(Perturb<Group>(Group::Random(),1)) == 0;
+
+// Every period compositions with a zero threshold. The identity has no drift so it is not normalized.
+DriftControl<Group> every(4);
+Group g(Group::Random());
+Group identity(Mat_G(Group::Algebra::Exp(Group::Base::Mat_C::Zero())));
+for (int ii = 1; ii <= 12; ++ii) {
+    g.data_ = Perturb<Group>(g.data_,scale);
+    ASSERT_EQ(every.Update(g), ii % 4 == 0 && !is_rn) << ii;
+    if (ii % 4 == 0) {
+        ASSERT_LE(Group::Drift(g.data_), 10*tol);
+    }
+}
+ASSERT_EQ(every.NumNormalizations(), is_rn ? 0u : 3u);
+
+// On a drift threshold checked after every composition
+DriftControl<Group,QuaternionNormalization> threshold(1,static_cast<DataType>(10*scale));
+Group h(Group::Random());
+int num_normalizations = 0;
+for (int ii = 0; ii < 200; ++ii) {
+    threshold.MultEq(h,identity);
+    h.data_ = Perturb<Group>(h.data_,scale);
+    const DataType drift = Group::Drift(h.data_);
+    const bool normalized = threshold.Update(h);
+    ASSERT_EQ(normalized, drift > static_cast<DataType>(10*scale));
+    num_normalizations += normalized ? 1 : 0;
+    ASSERT_LE(Group::Drift(h.data_), 10*scale);
+}
+if (!is_rn) {
+    ASSERT_GT(num_normalizations, 0);
+}
+
+// A drift above the fallback threshold is removed exactly
+DriftControl<Group> fallback(1);
+Group f(Perturb<Group>(Group::Random(),0.05));
+fallback.Update(f);
+ASSERT_LE(Group::Drift(f.data_), 10*tol);
+
+// A long chain of compositions stays on the group
+DriftControl<Group> chain;
+Group pose(Group::Random()), reference(pose);
+for (int ii = 0; ii < 10000; ++ii) {
+    const typename Group::Base::Mat_C u = Group::Base::Mat_C::Random()*static_cast<DataType>(0.1);
+    chain.OPlusEq(pose,u);
+    reference.OPlusEq(u);
+}
+ASSERT_LE(Group::Drift(pose.data_), chain.Period()*10*tol);
+ASSERT_LE( (pose.data_ - reference.data_).norm(), chain.Period()*100*tol);
+
+}
+
+
+} // namespace lie_groups
@@ -0,0 +1,120 @@
+#ifndef _LIEGROUPS_TEST_LIEALGEBRAS_ALGEBRATESTHELPERS_
+#define _LIEGROUPS_TEST_LIEALGEBRAS_ALGEBRATESTHELPERS_
+
+#include <Eigen/Dense>
+#include <type_traits>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace lie_groups {
+
+constexpr double kFiniteDifferenceStep = 1e-6;  /** < The step of the central differences of the numerical Jacobians. */
+
+// The group operations on the data returned by Exp. The exponential of rn is a vector and its group operation is addition.
+template<typename tDataType, int tRows>
+Eigen::Matrix<tDataType,tRows,1> GroupMult(const Eigen::Matrix<tDataType,tRows,1>& g1, const Eigen::Matrix<tDataType,tRows,1>& g2) {return g1 + g2;}
+
+template<typename tDataType, int tRows>
+Eigen::Matrix<tDataType,tRows,tRows> GroupMult(const Eigen::Matrix<tDataType,tRows,tRows>& g1, const Eigen::Matrix<tDataType,tRows,tRows>& g2) {return g1*g2;}
+
+template<typename tDataType, int tRows>
+Eigen::Matrix<tDataType,tRows,1> GroupInverse(const Eigen::Matrix<tDataType,tRows,1>& g) {return -g;}
+
+template<typename tDataType, int tRows>
+Eigen::Matrix<tDataType,tRows,tRows> GroupInverse(const Eigen::Matrix<tDataType,tRows,tRows>& g) {return g.inverse();}
+
+/**
+ * Checks ExpWithJl and ExpWithJr at v. The exponential must match Exp and the Jacobians must match the central
+ * differences \f$ \log(\exp(v)^{-1}\exp(v+h e_k))/h \f$ and \f$ \log(\exp(v+h e_k)\exp(v)^{-1})/h \f$, which don't
+ * share any code with the closed forms and their Taylor series.
+ */
+template<typename tAlgebra, typename tVec_C>
+void TestExpWithJacobians(const tVec_C& v) {
+
+    typedef typename std::decay<decltype(tAlgebra::Exp(std::declval<tVec_C>()))>::type Mat_G;
+    typedef typename std::decay<decltype(std::declval<tAlgebra&>().Jl())>::type Mat_J;
+    typedef Eigen::Matrix<typename tVec_C::Scalar,tVec_C::RowsAtCompileTime,tVec_C::RowsAtCompileTime> Mat_JC;
+    const double h = kFiniteDifferenceStep;
+
+    const Mat_G g = tAlgebra::Exp(v);
+    const Mat_G g_inv = GroupInverse(g);
+    Mat_J jl, jr;
+    Mat_JC jl_numerical, jr_numerical;
+    const Mat_G g_l = tAlgebra::ExpWithJl(v,jl);
+    const Mat_G g_r = tAlgebra::ExpWithJr(v,jr);
+
+    for (int k = 0; k < v.rows(); ++k) {
+        tVec_C d = tVec_C::Zero();
+        d(k) = h;
+        const Mat_G g_plus = tAlgebra::Exp(tVec_C(v + d));
+        const Mat_G g_minus = tAlgebra::Exp(tVec_C(v - d));
+        jr_numerical.col(k) = (tAlgebra::Log(GroupMult(g_inv,g_plus)) - tAlgebra::Log(GroupMult(g_inv,g_minus)))/(2*h);
+        jl_numerical.col(k) = (tAlgebra::Log(GroupMult(g_plus,g_inv)) - tAlgebra::Log(GroupMult(g_minus,g_inv)))/(2*h);
+    }
+
+    ASSERT_LE( (g_l - g).norm(), 1e-12) << "Error with the exponential of ExpWithJl at " << v.transpose();
+    ASSERT_LE( (g_r - g).norm(), 1e-12) << "Error with the exponential of ExpWithJr at " << v.transpose();
+    // The Jacobians of so2 are returned as 2x2 identities, so only the block of the Cartesian space is compared.
+    ASSERT_LE( (jl.topLeftCorner(v.rows(),v.rows()) - jl_numerical).norm(), 1e-8) << "Error with the left Jacobian of ExpWithJl at " << v.transpose();
+    ASSERT_LE( (jr.topLeftCorner(v.rows(),v.rows()) - jr_numerical).norm(), 1e-8) << "Error with the right Jacobian of ExpWithJr at " << v.transpose();
+}
+
+/**
+ * Checks LogWithJlInv and LogWithJrInv at the element \f$ g = \exp(v) \f$. The logarithm must match Log and the
+ * Jacobian inverses must match the central differences \f$ \log(\exp(h e_k) g)/h \f$ and \f$ \log(g \exp(h e_k))/h \f$.
+ */
+template<typename tAlgebra, typename tVec_C>
+void TestLogWithJacobians(const tVec_C& v) {
+
+    typedef typename std::decay<decltype(tAlgebra::Exp(std::declval<tVec_C>()))>::type Mat_G;
+    typedef typename std::decay<decltype(std::declval<tAlgebra&>().JlInv())>::type Mat_J;
+    typedef Eigen::Matrix<typename tVec_C::Scalar,tVec_C::RowsAtCompileTime,tVec_C::RowsAtCompileTime> Mat_JC;
+    const double h = kFiniteDifferenceStep;
+
+    const Mat_G g = tAlgebra::Exp(v);
+    const tVec_C u = tAlgebra::Log(g);
+    Mat_J jl_inv, jr_inv;
+    Mat_JC jl_inv_numerical, jr_inv_numerical;
+    const tVec_C u_l = tAlgebra::LogWithJlInv(g,jl_inv);
+    const tVec_C u_r = tAlgebra::LogWithJrInv(g,jr_inv);
+
+    for (int k = 0; k < v.rows(); ++k) {
+        tVec_C d = tVec_C::Zero();
+        d(k) = h;
+        const Mat_G g_plus = tAlgebra::Exp(d);
+        const Mat_G g_minus = tAlgebra::Exp(tVec_C(-d));
+        jl_inv_numerical.col(k) = (tAlgebra::Log(GroupMult(g_plus,g)) - tAlgebra::Log(GroupMult(g_minus,g)))/(2*h);
+        jr_inv_numerical.col(k) = (tAlgebra::Log(GroupMult(g,g_plus)) - tAlgebra::Log(GroupMult(g,g_minus)))/(2*h);
+    }
+
+    ASSERT_LE( (u_l - u).norm(), 1e-12) << "Error with the logarithm of LogWithJlInv at " << v.transpose();
+    ASSERT_LE( (u_r - u).norm(), 1e-12) << "Error with the logarithm of LogWithJrInv at " << v.transpose();
+    ASSERT_LE( (jl_inv.topLeftCorner(v.rows(),v.rows()) - jl_inv_numerical).norm(), 1e-8) << "Error with the left Jacobian inverse of LogWithJlInv at " << v.transpose();
+    ASSERT_LE( (jr_inv.topLeftCorner(v.rows(),v.rows()) - jr_inv_numerical).norm(), 1e-8) << "Error with the right Jacobian inverse of LogWithJrInv at " << v.transpose();
+}
+
+/**
+ * Checks that the float instantiation of the Lie algebra agrees with the double one at data to about the float epsilon.
+ * Close to the identity the closed forms cancel and the float thresholds swap them for their Taylor series, so
+ * the callers sample angles across every threshold.
+ */
+template<typename tAlgebra, typename tAlgebraFloat, typename tVec_C>
+void TestFloatPrecision(const tVec_C& data) {
+
+    typedef Eigen::Matrix<float,tVec_C::RowsAtCompileTime,1> Vec_Cf;
+    const Vec_Cf data_f = data.template cast<float>();
+    tAlgebra u(data);
+    tAlgebraFloat u_f(data_f);
+
+    ASSERT_LE( (tAlgebraFloat::Exp(data_f).template cast<double>() - tAlgebra::Exp(data)).norm(), 1e-5) << "Error with the float exponential at " << data.transpose();
+    ASSERT_LE( (tAlgebraFloat::Log(tAlgebra::Exp(data).template cast<float>()).template cast<double>() - data).norm(), 1e-5) << "Error with the float logarithm at " << data.transpose();
+    ASSERT_LE( (u_f.Jl().template cast<double>() - u.Jl()).norm(), 1e-5) << "Error with the float left Jacobian at " << data.transpose();
+    ASSERT_LE( (u_f.Jr().template cast<double>() - u.Jr()).norm(), 1e-5) << "Error with the float right Jacobian at " << data.transpose();
+    ASSERT_LE( (u_f.JlInv().template cast<double>() - u.JlInv()).norm(), 1e-5) << "Error with the float left Jacobian inverse at " << data.transpose();
+    ASSERT_LE( (u_f.JrInv().template cast<double>() - u.JrInv()).norm(), 1e-5) << "Error with the float right Jacobian inverse at " << data.transpose();
+}
+
+} // namespace lie_groups
+
+#endif // _LIEGROUPS_TEST_LIEALGEBRAS_ALGEBRATESTHELPERS_
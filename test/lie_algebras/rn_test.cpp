@@ -3,6 +3,7 @@
 #include "gtest/gtest.h"
 
 #include "lie_groups/lie_algebras/rn.h"
+#include "algebra_test_helpers.h"
 
 namespace lie_groups {
 
@@ -160,4 +161,28 @@ ASSERT_EQ((u1.JrInv(u2)).data_,u2.data_) << "Error with right Jacobian inverse";
 }
 
 
+// The fused exponential and Jacobian functions near the identity element and away from it. See TestExpWithJacobians.
+TEST(rnTest, ExpWithJacobianTest) {
+
+typedef Eigen::Matrix<double,3,1> Vec_C;
+
+for (double scale : {1e-9, 1.0}) {
+    ASSERT_NO_FATAL_FAILURE((TestExpWithJacobians<rn<double,3>>(Vec_C(Vec_C::Random()*scale))));
+}
+
+}
+
+
+// The fused logarithm and Jacobian inverse functions near the identity element and away from it. See TestLogWithJacobians.
+TEST(rnTest, LogWithJacobianTest) {
+
+typedef Eigen::Matrix<double,3,1> Vec_C;
+
+for (double scale : {1e-9, 1.0}) {
+    ASSERT_NO_FATAL_FAILURE((TestLogWithJacobians<rn<double,3>>(Vec_C(Vec_C::Random()*scale))));
+}
+
+}
+
+
 }
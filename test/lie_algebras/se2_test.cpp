@@ -1,6 +1,8 @@
 #include <Eigen/Dense>
+#include <cstring>
 
 #include "lie_groups/lie_algebras/se2.h"
+#include "algebra_test_helpers.h"
 #include "gtest/gtest.h"
 
 namespace lie_groups {
@@ -14,8 +16,8 @@ se2<dataType> u1;
 Vec3d Identity = Vec3d::Zero();
 ASSERT_EQ(u1.data_, Identity ) << "Element not initialized to identity. i.e. zero.";
 u1.data_.setRandom();
-ASSERT_EQ(u1.data_.block(0,0,2,1),u1.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u1.data_.block(2,0,1,1),u1.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u1.data_.block(0,0,2,1),u1.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u1.data_.block(2,0,1,1),u1.th()) << "Angular velocity view not set properly.";
 
 
 
@@ -23,8 +25,8 @@ ASSERT_EQ(u1.data_.block(2,0,1,1),u1.th_) << "Angular velocity map not set prope
 Vec3d v = Vec3d::Random();
 se2<dataType> u2(v);
 ASSERT_EQ(u2.data_,v) << "Error with the assignment constructor";
-ASSERT_EQ(u2.data_.block(0,0,2,1),u2.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u2.data_.block(2,0,1,1),u2.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u2.data_.block(0,0,2,1),u2.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u2.data_.block(2,0,1,1),u2.th()) << "Angular velocity view not set properly.";
 
 // assignment constructor invaid element
 Mat3d V1 = Mat3d::Random();
@@ -33,8 +35,8 @@ if (V1.norm() == 0) // If the zero matrix
     V1(0,0) = 1;
 se2<dataType> u3(V1,true);
 ASSERT_EQ(u3.data_, Identity) << "Error with the assignment constructor";
-ASSERT_EQ(u3.data_.block(0,0,2,1),u3.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u3.data_.block(2,0,1,1),u3.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u3.data_.block(0,0,2,1),u3.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u3.data_.block(2,0,1,1),u3.th()) << "Angular velocity view not set properly.";
 
 
 // assignment constructor valid element
@@ -44,15 +46,23 @@ V2 << 0, -4, 5, 4, 0, 6, 0, 0, 0;
 v2 << 5, 6, 4;
 se2<dataType> u4(V2,true);
 ASSERT_EQ(u4.data_,v2) << "Error with the assignment constructor";
-ASSERT_EQ(u4.data_.block(0,0,2,1),u4.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u4.data_.block(2,0,1,1),u4.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u4.data_.block(0,0,2,1),u4.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u4.data_.block(2,0,1,1),u4.th()) << "Angular velocity view not set properly.";
 
 
 // copy constructor
 se2<dataType> u5(u4);
 ASSERT_EQ(u5.data_,u4.data_) << "Error with the copy constructor";
-ASSERT_EQ(u5.data_.block(0,0,2,1),u5.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u5.data_.block(2,0,1,1),u5.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u5.data_.block(0,0,2,1),u5.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u5.data_.block(2,0,1,1),u5.th()) << "Angular velocity view not set properly.";
+
+// The element only stores its data so it can be copied bitwise
+ASSERT_EQ(sizeof(se2<dataType>), sizeof(Vec3d)) << "The element stores more than its data.";
+se2<dataType> u7;
+std::memcpy(static_cast<void*>(&u7), static_cast<const void*>(&u4), sizeof(se2<dataType>));
+ASSERT_EQ(u7.data_,v2) << "Bitwise copy error";
+ASSERT_EQ(u7.data_.block(0,0,2,1),u7.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u7.data_.block(2,0,1,1),u7.th()) << "Angular velocity view not set properly.";
 
 
 // identity function test
@@ -79,12 +89,12 @@ se2<dataType> u4(Vec3d::Random());
 
 // Wedge test
 Mat3d m2;
-m2 << 0, -u3.th_(0), u3.p_(0), u3.th_(0), 0, u3.p_(1), 0,0,0;
+m2 << 0, -u3.th()(0), u3.p()(0), u3.th()(0), 0, u3.p()(1), 0,0,0;
 ASSERT_EQ(u3.Wedge(),m2) << "Error with wedge function";
 
 // Adjoint test
 Mat3d m3;
-m3  << 0, -u3.th_(0), u3.p_(1), u3.th_(0), 0, -u3.p_(0), 0,0,0;
+m3  << 0, -u3.th()(0), u3.p()(1), u3.th()(0), 0, -u3.p()(0), 0,0,0;
 ASSERT_EQ(u3.Adjoint(),m3) << "Error with adjoint test"; 
 
 // Bracket and adjoint test
@@ -215,4 +225,130 @@ ASSERT_LE( ((u1.JrInv(u3)).data_-u1.JrInv()*u3.data_).norm(), 1e-8) << "Error wi
 }
 
 
+// The fused exponential and Jacobian functions near the identity element, on both sides of the threshold of the
+// Taylor series and far from the identity. See TestExpWithJacobians.
+TEST(se2Test, ExpWithJacobianTest) {
+
+typedef Eigen::Matrix<double,3,1> Vec_C;
+const double threshold = ScalarTraits<double>::series_threshold_;
+
+for (double th : {1e-9, -0.99*threshold, 1.01*threshold, 1.0, -3.0}) {
+    Vec_C v = Vec_C::Random();
+    v(2) = th;
+    ASSERT_NO_FATAL_FAILURE(TestExpWithJacobians<se2<double>>(v));
+}
+
+}
+
+
+// The fused logarithm and Jacobian inverse functions near the identity element, on both sides of the threshold of the
+// Taylor series and far from the identity. See TestLogWithJacobians.
+TEST(se2Test, LogWithJacobianTest) {
+
+typedef Eigen::Matrix<double,3,1> Vec_C;
+const double threshold = ScalarTraits<double>::series_threshold_;
+
+for (double th : {1e-9, -0.99*threshold, 1.01*threshold, 1.0, -3.0}) {
+    Vec_C v = Vec_C::Random();
+    v(2) = th;
+    ASSERT_NO_FATAL_FAILURE(TestLogWithJacobians<se2<double>>(v));
+}
+
+}
+
+
+// The batch kernels must match the scalar functions for every branch. The number of elements
+// is not a multiple of the packet size so that the scalar remainder is tested.
+template<typename tDataType>
+void TestBatchExpLog(double tol) {
+
+typedef Eigen::Matrix<tDataType,3,1> Vec_C;
+typedef Eigen::Matrix<tDataType,3,3> Mat_G;
+typedef Eigen::Matrix<tDataType,Eigen::Dynamic,3> Data_C;
+typedef Eigen::Matrix<tDataType,Eigen::Dynamic,9> Data_G;
+
+const int num_elements = 103;
+const double angles[] = {0, 1e-9, -1e-4, 0.5*kse2_batch_threshold_, -2.0*kse2_batch_threshold_, 1.0, 2.0, -3.0};
+Data_C u(num_elements,3), log(num_elements,3);
+Data_G g(num_elements,9);
+for (int ii = 0; ii < num_elements; ++ii) {
+    u.row(ii) = Vec_C::Random().transpose();
+    u(ii,2) = static_cast<tDataType>(angles[ii%8]);
+}
+
+const tDataType* u_cols[3] = {u.col(0).data(), u.col(1).data(), u.col(2).data()};
+tDataType* log_cols[3] = {log.col(0).data(), log.col(1).data(), log.col(2).data()};
+const tDataType* g_in_cols[9];
+tDataType* g_cols[9];
+for (int k = 0; k < 9; ++k) {
+    g_cols[k] = g.col(k).data();
+    g_in_cols[k] = g_cols[k];
+}
+
+se2<tDataType>::BatchExp(u_cols,g_cols,num_elements);
+se2<tDataType>::BatchLog(g_in_cols,log_cols,num_elements);
+
+for (int ii = 0; ii < num_elements; ++ii) {
+    Vec_C v = u.row(ii).transpose();
+    Mat_G g_batch = Eigen::Map<const Mat_G>(g.row(ii).eval().data());
+    ASSERT_LE( (g_batch - se2<tDataType>::Exp(v)).norm(), tol) << "Error with BatchExp";
+    ASSERT_LE( (log.row(ii).transpose() - v).norm(), tol) << "Error with BatchLog";
+}
+
+}
+
+TEST(se2Test, BatchExpLogTest) {
+TestBatchExpLog<double>(1e-12);
+TestBatchExpLog<float>(1e-5);
+}
+
+// The matrix-free Jacobians must match the matrices. The matrices are only compared away
+// from the small angle branches, close to the identity only the inverses are checked.
+TEST(se2Test, ApplyJacobianTest) {
+
+typedef double DataType;
+typedef Eigen::Matrix<DataType,3,1> Vec_C;
+typedef Eigen::Matrix<DataType,3,3> Mat_J;
+
+const double threshold = ScalarTraits<double>::series_threshold_;
+const double scales[] = {0.0, 1e-9, 1e-3, 0.5*threshold, 2.0*threshold, 1.0, 3.0};
+for (double scale : scales) {
+    Vec_C data = Vec_C::Random();
+    data(2) = scale;
+    Vec_C v = Vec_C::Random();
+    se2<DataType> u(data);
+
+    if (scale > 2e-3) {
+        Mat_J jl = u.Jl(), jr = u.Jr(), jl_inv = u.JlInv(), jr_inv = u.JrInv();
+        ASSERT_LE( (se2<DataType>::ApplyJl(data,v) - jl*v).norm(), 1e-10) << "Error with ApplyJl at " << scale;
+        ASSERT_LE( (se2<DataType>::ApplyJr(data,v) - jr*v).norm(), 1e-10) << "Error with ApplyJr at " << scale;
+        ASSERT_LE( (se2<DataType>::ApplyJlInv(data,v) - jl_inv*v).norm(), 1e-10) << "Error with ApplyJlInv at " << scale;
+        ASSERT_LE( (se2<DataType>::ApplyJrInv(data,v) - jr_inv*v).norm(), 1e-10) << "Error with ApplyJrInv at " << scale;
+    }
+
+    ASSERT_LE( (se2<DataType>::ApplyJlInv(data,se2<DataType>::ApplyJl(data,v)) - v).norm(), 1e-12) << "Error with the left Jacobian inverse at " << scale;
+    ASSERT_LE( (se2<DataType>::ApplyJrInv(data,se2<DataType>::ApplyJr(data,v)) - v).norm(), 1e-12) << "Error with the right Jacobian inverse at " << scale;
+
+    // Jr(data) = Jl(-data)
+    ASSERT_LE( (se2<DataType>::ApplyJr(data,v) - se2<DataType>::ApplyJl(-data,v)).norm(), 1e-12) << "Error with ApplyJr at " << scale;
+}
+
+}
+
+// The float instantiation at angles across the thresholds of the Taylor series. See TestFloatPrecision.
+TEST(se2Test, FloatPrecisionTest) {
+
+typedef Eigen::Matrix<double,3,1> Vec_C;
+
+const double scales[] = {0.0, 1e-7, 1e-5, 1e-3, 1e-2, 3e-2, 0.1, 0.3, 1.0, 2.5};
+for (double scale : scales) {
+    for (int ii = 0; ii < 20; ++ii) {
+        Vec_C data = Vec_C::Random();
+        data(2) = ii%2 ? scale : -scale;
+        ASSERT_NO_FATAL_FAILURE((TestFloatPrecision<se2<double>,se2<float>>(data)));
+    }
+}
+
+}
+
 }
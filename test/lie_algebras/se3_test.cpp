@@ -1,6 +1,8 @@
 #include <Eigen/Dense>
+#include <cstring>
 
 #include "lie_groups/lie_algebras/se3.h"
+#include "algebra_test_helpers.h"
 #include "gtest/gtest.h"
 
 namespace lie_groups {
@@ -17,8 +19,8 @@ se3<DataType> u1;
 Vec6d Identity = Vec6d::Zero();
 ASSERT_EQ(u1.data_, Identity ) << "Element not initialized to identity. i.e. zero.";
 u1.data_.setRandom();
-ASSERT_EQ(u1.data_.block(0,0,3,1),u1.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u1.data_.block(3,0,3,1),u1.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u1.data_.block(0,0,3,1),u1.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u1.data_.block(3,0,3,1),u1.th()) << "Angular velocity view not set properly.";
 
 
 
@@ -26,8 +28,8 @@ ASSERT_EQ(u1.data_.block(3,0,3,1),u1.th_) << "Angular velocity map not set prope
 Vec6d v = Vec6d::Random();
 se3<DataType> u2(v);
 ASSERT_EQ(u2.data_,v) << "Error with the assignment constructor";
-ASSERT_EQ(u2.data_.block(0,0,3,1),u2.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u2.data_.block(3,0,3,1),u2.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u2.data_.block(0,0,3,1),u2.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u2.data_.block(3,0,3,1),u2.th()) << "Angular velocity view not set properly.";
 
 // assignment constructor invaid element
 Mat4d V1;
@@ -37,8 +39,8 @@ if (V1.norm() == 0) // If the zero matrix
     V1(0,0) = 1;
 se3<DataType> u3(V1,true);
 ASSERT_EQ(u3.data_, Identity) << "Error with the assignment constructor";
-ASSERT_EQ(u3.data_.block(0,0,3,1),u3.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u3.data_.block(3,0,3,1),u3.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u3.data_.block(0,0,3,1),u3.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u3.data_.block(3,0,3,1),u3.th()) << "Angular velocity view not set properly.";
 
 
 // assignment constructor valid element
@@ -48,15 +50,23 @@ V2 << 0, -1, 2, 4, 1, 0, -3, 5, -2, 3, 0, 6,0,0,0,0;
 v2 << 4,5,6,3,2,1;
 se3<DataType> u4(V2,true);
 ASSERT_EQ(u4.data_,v2) << "Error with the assignment constructor";
-ASSERT_EQ(u4.data_.block(0,0,3,1),u4.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u4.data_.block(3,0,3,1),u4.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u4.data_.block(0,0,3,1),u4.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u4.data_.block(3,0,3,1),u4.th()) << "Angular velocity view not set properly.";
 
 
 // copy constructor
 se3<DataType> u5(u4);
 ASSERT_EQ(u5.data_,u4.data_) << "Error with the copy constructor";
-ASSERT_EQ(u5.data_.block(0,0,3,1),u5.p_) << "Translational velocity map not set properly.";
-ASSERT_EQ(u5.data_.block(3,0,3,1),u5.th_) << "Angular velocity map not set properly.";
+ASSERT_EQ(u5.data_.block(0,0,3,1),u5.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u5.data_.block(3,0,3,1),u5.th()) << "Angular velocity view not set properly.";
+
+// The element only stores its data so it can be copied bitwise
+ASSERT_EQ(sizeof(se3<DataType>), sizeof(Vec6d)) << "The element stores more than its data.";
+se3<DataType> u7;
+std::memcpy(static_cast<void*>(&u7), static_cast<const void*>(&u4), sizeof(se3<DataType>));
+ASSERT_EQ(u7.data_,v2) << "Bitwise copy error";
+ASSERT_EQ(u7.data_.block(0,0,3,1),u7.p()) << "Translational velocity view not set properly.";
+ASSERT_EQ(u7.data_.block(3,0,3,1),u7.th()) << "Angular velocity view not set properly.";
 
 
 // identity function test
@@ -101,9 +111,9 @@ ASSERT_EQ(m2,se3<DataType>::SSM(x));
 // Adjoint test
 
 Mat6d m3 = Mat6d::Zero();
-m3.block(0,0,3,3) = se3<DataType>::SSM(u2.th_);
-m3.block(3,3,3,3) = se3<DataType>::SSM(u2.th_);
-m3.block(0,3,3,3) = se3<DataType>::SSM(u2.p_);
+m3.block(0,0,3,3) = se3<DataType>::SSM(u2.th());
+m3.block(3,3,3,3) = se3<DataType>::SSM(u2.th());
+m3.block(0,3,3,3) = se3<DataType>::SSM(u2.p());
 ASSERT_EQ(u2.Adjoint(),m3) << "Error with adjoint test"; 
 
 // Bracket and adjoint test
@@ -253,4 +263,102 @@ ASSERT_LE( ((u1.JrInv(u3)).data_-u1.JrInv()*u3.data_).norm(), kse3_threshold_) <
 }
 
 
+// The fused exponential and Jacobian functions near the identity element, on both sides of the threshold of the
+// Taylor series and far from the identity. See TestExpWithJacobians.
+TEST(se3Test, ExpWithJacobianTest) {
+
+typedef Eigen::Matrix<double,6,1> Vec_C;
+const double threshold = ScalarTraits<double>::series_threshold_;
+
+for (double th : {1e-9, 0.99*threshold, 1.01*threshold, 1.0, 3.0}) {
+    Vec_C v = Vec_C::Random();
+    v.block<3,1>(3,0) = v.block<3,1>(3,0).normalized()*th;
+    ASSERT_NO_FATAL_FAILURE(TestExpWithJacobians<se3<double>>(v));
+}
+
+}
+
+
+// The fused logarithm and Jacobian inverse functions near the identity element, on both sides of the threshold of the
+// Taylor series and far from the identity. See TestLogWithJacobians.
+TEST(se3Test, LogWithJacobianTest) {
+
+typedef Eigen::Matrix<double,6,1> Vec_C;
+const double threshold = ScalarTraits<double>::series_threshold_;
+
+for (double th : {1e-9, 0.99*threshold, 1.01*threshold, 1.0, 3.0}) {
+    Vec_C v = Vec_C::Random();
+    v.block<3,1>(3,0) = v.block<3,1>(3,0).normalized()*th;
+    ASSERT_NO_FATAL_FAILURE(TestLogWithJacobians<se3<double>>(v));
+}
+
+}
+
+// The matrix-free Jacobians must match the matrices. The matrices are only compared away
+// from the small angle branches, close to the identity only the inverses are checked.
+TEST(se3Test, ApplyJacobianTest) {
+
+typedef double DataType;
+typedef Eigen::Matrix<DataType,6,1> Vec_C;
+typedef Eigen::Matrix<DataType,6,6> Mat_J;
+
+const double threshold = ScalarTraits<double>::series_threshold_;
+const double scales[] = {0.0, 1e-9, 1e-3, 0.5*threshold, 2.0*threshold, 1.0, 3.0};
+for (double scale : scales) {
+    Vec_C data = Vec_C::Random();
+    data.block<3,1>(3,0) = data.block<3,1>(3,0).normalized()*scale;
+    Vec_C v = Vec_C::Random();
+    se3<DataType> u(data);
+
+    if (scale > 2e-3) {
+        Mat_J jl = u.Jl(), jr = u.Jr(), jl_inv = u.JlInv(), jr_inv = u.JrInv();
+        ASSERT_LE( (se3<DataType>::ApplyJl(data,v) - jl*v).norm(), 1e-10) << "Error with ApplyJl at " << scale;
+        ASSERT_LE( (se3<DataType>::ApplyJr(data,v) - jr*v).norm(), 1e-10) << "Error with ApplyJr at " << scale;
+        ASSERT_LE( (se3<DataType>::ApplyJlInv(data,v) - jl_inv*v).norm(), 1e-10) << "Error with ApplyJlInv at " << scale;
+        ASSERT_LE( (se3<DataType>::ApplyJrInv(data,v) - jr_inv*v).norm(), 1e-10) << "Error with ApplyJrInv at " << scale;
+    }
+
+    ASSERT_LE( (se3<DataType>::ApplyJlInv(data,se3<DataType>::ApplyJl(data,v)) - v).norm(), 1e-12) << "Error with the left Jacobian inverse at " << scale;
+    ASSERT_LE( (se3<DataType>::ApplyJrInv(data,se3<DataType>::ApplyJr(data,v)) - v).norm(), 1e-12) << "Error with the right Jacobian inverse at " << scale;
+
+    // Jr(data) = Jl(-data)
+    ASSERT_LE( (se3<DataType>::ApplyJr(data,v) - se3<DataType>::ApplyJl(-data,v)).norm(), 1e-12) << "Error with ApplyJr at " << scale;
+}
+
+}
+
+// The float instantiation at angles across the thresholds of the Taylor series. See TestFloatPrecision.
+TEST(se3Test, FloatPrecisionTest) {
+
+typedef Eigen::Matrix<double,6,1> Vec_C;
+
+const double scales[] = {0.0, 1e-7, 1e-5, 1e-3, 1e-2, 3e-2, 0.1, 0.3, 1.0, 2.5};
+for (double scale : scales) {
+    for (int ii = 0; ii < 20; ++ii) {
+        Vec_C data = Vec_C::Random();
+        data.block<3,1>(3,0) = data.block<3,1>(3,0).normalized()*scale;
+        ASSERT_NO_FATAL_FAILURE((TestFloatPrecision<se3<double>,se3<float>>(data)));
+    }
+}
+
+}
+
+// The logarithm must stay finite and accurate up to an angle of pi
+TEST(se3Test, LogNearPiTest) {
+
+typedef double DataType;
+typedef Eigen::Matrix<DataType,6,1> Vec6d;
+
+const double offsets[] = {1e-12, 1e-9, 1e-6, 1e-3};
+for (double offset : offsets) {
+    Vec6d data = Vec6d::Random();
+    data.block<3,1>(3,0) = data.block<3,1>(3,0).normalized()*(M_PI - offset);
+    const Vec6d u = se3<DataType>::Log(se3<DataType>::Exp(data));
+
+    ASSERT_TRUE(u.allFinite()) << "The logarithm isn't finite at pi minus " << offset;
+    ASSERT_LE( (se3<DataType>::Exp(u) - se3<DataType>::Exp(data)).norm(), 1e-11) << "Error with the logarithm at pi minus " << offset;
+}
+
+}
+
 }
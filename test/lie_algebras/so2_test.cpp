@@ -1,6 +1,7 @@
 #include <Eigen/Dense>
 
 #include "lie_groups/lie_algebras/so2.h"
+#include "algebra_test_helpers.h"
 #include "gtest/gtest.h"
 
 namespace lie_groups {
@@ -159,4 +160,74 @@ ASSERT_EQ((u1.JrInv(u2)).data_,u2.data_) << "Error with right Jacobian inverse";
 }
 
 
+// The fused exponential and Jacobian functions near the identity element, on both sides of the threshold of the
+// Taylor series and far from the identity. See TestExpWithJacobians.
+TEST(so2Test, ExpWithJacobianTest) {
+
+typedef Eigen::Matrix<double,1,1> Vec_C;
+const double threshold = ScalarTraits<double>::series_threshold_;
+
+for (double th : {1e-9, -0.99*threshold, 1.01*threshold, 1.0, -3.0}) {
+    ASSERT_NO_FATAL_FAILURE(TestExpWithJacobians<so2<double>>(Vec_C(th)));
+}
+
+}
+
+
+// The fused logarithm and Jacobian inverse functions near the identity element, on both sides of the threshold of the
+// Taylor series and far from the identity. See TestLogWithJacobians.
+TEST(so2Test, LogWithJacobianTest) {
+
+typedef Eigen::Matrix<double,1,1> Vec_C;
+const double threshold = ScalarTraits<double>::series_threshold_;
+
+for (double th : {1e-9, -0.99*threshold, 1.01*threshold, 1.0, -3.0}) {
+    ASSERT_NO_FATAL_FAILURE(TestLogWithJacobians<so2<double>>(Vec_C(th)));
+}
+
+}
+
+
+// The batch kernels must match the scalar functions over the whole range of angles. The number of elements
+// is not a multiple of the packet size so that the scalar remainder is tested.
+template<typename tDataType>
+void TestBatchExpLog(double tol) {
+
+typedef Eigen::Matrix<tDataType,1,1> Vec_C;
+typedef Eigen::Matrix<tDataType,2,2> Mat_G;
+typedef Eigen::Matrix<tDataType,Eigen::Dynamic,1> Data_C;
+typedef Eigen::Matrix<tDataType,Eigen::Dynamic,4> Data_G;
+
+const int num_elements = 103;
+Data_C u = Data_C::Random(num_elements)*static_cast<tDataType>(3.1);
+u(0) = 0;
+Data_C log(num_elements);
+Data_G g(num_elements,4);
+
+const tDataType* u_cols[1] = {u.data()};
+tDataType* log_cols[1] = {log.data()};
+const tDataType* g_in_cols[4];
+tDataType* g_cols[4];
+for (int k = 0; k < 4; ++k) {
+    g_cols[k] = g.col(k).data();
+    g_in_cols[k] = g_cols[k];
+}
+
+so2<tDataType>::BatchExp(u_cols,g_cols,num_elements);
+so2<tDataType>::BatchLog(g_in_cols,log_cols,num_elements);
+
+for (int ii = 0; ii < num_elements; ++ii) {
+    Vec_C v = u.row(ii);
+    Mat_G g_batch = Eigen::Map<const Mat_G>(g.row(ii).eval().data());
+    ASSERT_LE( (g_batch - so2<tDataType>::Exp(v)).norm(), tol) << "Error with BatchExp";
+    ASSERT_LE( std::abs(log(ii) - u(ii)), tol) << "Error with BatchLog";
+}
+
+}
+
+TEST(so2Test, BatchExpLogTest) {
+TestBatchExpLog<double>(1e-12);
+TestBatchExpLog<float>(1e-5);
+}
+
 }
@@ -1,6 +1,7 @@
 #include <Eigen/Dense>
 
 #include "lie_groups/lie_algebras/so3.h"
+#include "algebra_test_helpers.h"
 #include "gtest/gtest.h"
 
 namespace lie_groups {
@@ -205,4 +206,155 @@ ASSERT_LE( ((u1.JrInv(u3)).data_-u1.JrInv()*u3.data_).norm(), 1e-8) << "Error wi
 }
 
 
+// The fused exponential and Jacobian functions near the identity element, on both sides of the threshold of the
+// Taylor series and far from the identity. See TestExpWithJacobians.
+TEST(so3Test, ExpWithJacobianTest) {
+
+typedef Eigen::Matrix<double,3,1> Vec_C;
+const double threshold = ScalarTraits<double>::series_threshold_;
+
+for (double th : {1e-9, 0.99*threshold, 1.01*threshold, 1.0, 3.0}) {
+    ASSERT_NO_FATAL_FAILURE(TestExpWithJacobians<so3<double>>(Vec_C(Vec_C::Random().normalized()*th)));
+}
+
+}
+
+
+// The fused logarithm and Jacobian inverse functions near the identity element, on both sides of the threshold of the
+// Taylor series and far from the identity. See TestLogWithJacobians.
+TEST(so3Test, LogWithJacobianTest) {
+
+typedef Eigen::Matrix<double,3,1> Vec_C;
+const double threshold = ScalarTraits<double>::series_threshold_;
+
+for (double th : {1e-9, 0.99*threshold, 1.01*threshold, 1.0, 3.0}) {
+    ASSERT_NO_FATAL_FAILURE(TestLogWithJacobians<so3<double>>(Vec_C(Vec_C::Random().normalized()*th)));
+}
+
+}
+
+
+// The batch kernels must match the scalar functions for every branch. The number of elements
+// is not a multiple of the packet size so that the scalar remainder is tested.
+template<typename tDataType>
+void TestBatchExpLog(double tol) {
+
+typedef Eigen::Matrix<tDataType,3,1> Vec_C;
+typedef Eigen::Matrix<tDataType,3,3> Mat_G;
+typedef Eigen::Matrix<tDataType,Eigen::Dynamic,3> Data_C;
+typedef Eigen::Matrix<tDataType,Eigen::Dynamic,9> Data_G;
+
+const int num_elements = 103;
+const double scales[] = {0, 1e-9, 1e-4, 0.5*kso3_batch_threshold_, 2.0*kso3_batch_threshold_, 1.0, 3.0};
+Data_C u(num_elements,3), log(num_elements,3);
+Data_G g(num_elements,9);
+for (int ii = 0; ii < num_elements; ++ii) {
+    u.row(ii) = Vec_C::Random().normalized().transpose()*static_cast<tDataType>(scales[ii%7]);
+}
+
+const tDataType* u_cols[3] = {u.col(0).data(), u.col(1).data(), u.col(2).data()};
+tDataType* log_cols[3] = {log.col(0).data(), log.col(1).data(), log.col(2).data()};
+const tDataType* g_in_cols[9];
+tDataType* g_cols[9];
+for (int k = 0; k < 9; ++k) {
+    g_cols[k] = g.col(k).data();
+    g_in_cols[k] = g_cols[k];
+}
+
+so3<tDataType>::BatchExp(u_cols,g_cols,num_elements);
+so3<tDataType>::BatchLog(g_in_cols,log_cols,num_elements);
+
+for (int ii = 0; ii < num_elements; ++ii) {
+    Vec_C v = u.row(ii).transpose();
+    Mat_G g_batch = Eigen::Map<const Mat_G>(g.row(ii).eval().data());
+    ASSERT_LE( (g_batch - so3<tDataType>::Exp(v)).norm(), tol) << "Error with BatchExp";
+    ASSERT_LE( (log.row(ii).transpose() - v).norm(), tol) << "Error with BatchLog";
+}
+
+}
+
+TEST(so3Test, BatchExpLogTest) {
+TestBatchExpLog<double>(1e-12);
+TestBatchExpLog<float>(1e-5);
+}
+
+// The matrix-free Jacobians must match the matrices. The matrices are only compared away
+// from the small angle branches, close to the identity only the inverses are checked.
+TEST(so3Test, ApplyJacobianTest) {
+
+typedef double DataType;
+typedef Eigen::Matrix<DataType,3,1> Vec_C;
+typedef Eigen::Matrix<DataType,3,3> Mat_J;
+
+const double threshold = ScalarTraits<double>::series_threshold_;
+const double scales[] = {0.0, 1e-9, 1e-3, 0.5*threshold, 2.0*threshold, 1.0, 3.0};
+for (double scale : scales) {
+    Vec_C data = Vec_C::Random();
+    data = data.normalized()*scale;
+    Vec_C v = Vec_C::Random();
+    so3<DataType> u(data);
+
+    if (scale > 2e-3) {
+        Mat_J jl = u.Jl(), jr = u.Jr(), jl_inv = u.JlInv(), jr_inv = u.JrInv();
+        ASSERT_LE( (so3<DataType>::ApplyJl(data,v) - jl*v).norm(), 1e-10) << "Error with ApplyJl at " << scale;
+        ASSERT_LE( (so3<DataType>::ApplyJr(data,v) - jr*v).norm(), 1e-10) << "Error with ApplyJr at " << scale;
+        ASSERT_LE( (so3<DataType>::ApplyJlInv(data,v) - jl_inv*v).norm(), 1e-10) << "Error with ApplyJlInv at " << scale;
+        ASSERT_LE( (so3<DataType>::ApplyJrInv(data,v) - jr_inv*v).norm(), 1e-10) << "Error with ApplyJrInv at " << scale;
+    }
+
+    ASSERT_LE( (so3<DataType>::ApplyJlInv(data,so3<DataType>::ApplyJl(data,v)) - v).norm(), 1e-12) << "Error with the left Jacobian inverse at " << scale;
+    ASSERT_LE( (so3<DataType>::ApplyJrInv(data,so3<DataType>::ApplyJr(data,v)) - v).norm(), 1e-12) << "Error with the right Jacobian inverse at " << scale;
+
+    // Jr(data) = Jl(-data)
+    ASSERT_LE( (so3<DataType>::ApplyJr(data,v) - so3<DataType>::ApplyJl(-data,v)).norm(), 1e-12) << "Error with ApplyJr at " << scale;
+}
+
+}
+
+// The float instantiation at angles across the thresholds of the Taylor series. See TestFloatPrecision.
+TEST(so3Test, FloatPrecisionTest) {
+
+typedef Eigen::Matrix<double,3,1> Vec_C;
+
+const double scales[] = {0.0, 1e-7, 1e-5, 1e-3, 1e-2, 3e-2, 0.1, 0.3, 1.0, 2.5};
+for (double scale : scales) {
+    for (int ii = 0; ii < 20; ++ii) {
+        Vec_C data = Vec_C::Random();
+        data = data.normalized()*scale;
+        ASSERT_NO_FATAL_FAILURE((TestFloatPrecision<so3<double>,so3<float>>(data)));
+    }
+}
+
+}
+
+// The logarithm must recover the angle and the axis up to pi, where the arc cosine of the trace is ill conditioned
+// and the skew symmetric part vanishes.
+TEST(so3Test, LogNearPiTest) {
+
+typedef double DataType;
+typedef Eigen::Matrix<DataType,3,1> Vec3d;
+typedef Eigen::Matrix<DataType,3,3> Mat3d;
+
+const double offsets[] = {0.0, 1e-12, 1e-9, 1e-6, 1e-3, 1e-1};
+for (double offset : offsets) {
+    for (int ii = 0; ii < 20; ++ii) {
+        const Vec3d data = Vec3d::Random().normalized()*(M_PI - offset);
+        const Mat3d R = so3<DataType>::Exp(data);
+        DataType th, sin_th, cos_th;
+        const Vec3d u = so3<DataType>::Log(R,th,sin_th,cos_th);
+
+        ASSERT_TRUE(u.allFinite()) << "The logarithm isn't finite at pi minus " << offset;
+        ASSERT_LE( std::abs(th - data.norm()), 1e-12) << "Error with the angle at pi minus " << offset;
+        ASSERT_LE( std::abs(sin_th - std::sin(th)), 1e-15) << "Error with the sine at pi minus " << offset;
+        ASSERT_LE( std::abs(cos_th - std::cos(th)), 1e-15) << "Error with the cosine at pi minus " << offset;
+        ASSERT_LE( (so3<DataType>::Exp(u) - R).norm(), 1e-12) << "Error with the logarithm at pi minus " << offset;
+        // At pi the logarithm is only defined up to its sign
+        if (offset > 0.0) {
+            ASSERT_LE( (u - data).norm(), 1e-12/offset + 1e-12) << "Error with the logarithm at pi minus " << offset;
+        }
+    }
+}
+
+}
+
 }
@@ -0,0 +1,202 @@
+#include "lie_groups/lie_groups/SE2Complex.h"
+#include "lie_groups/state.h"
+#include "lie_groups/group_array.h"
+#include "gtest/gtest.h"
+#include <Eigen/Dense>
+
+
+namespace lie_groups {
+
+////////////////////////////////////////////////////////////////////////
+
+// Test the constructors and the conversions to and from SE2
+TEST(SE2ComplexTest, Constructors) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
+
+Vec4d identity(1,0,0,0);
+
+// Valid element
+Vec4d data1 = SE2Complex<tDataType>::Random();
+
+// Invalid element
+Vec4d data2 = Vec4d::Ones();
+
+SE2Complex<tDataType> g1;
+SE2Complex<tDataType> g2(data1,true);
+SE2Complex<tDataType> g3(data2,true);
+SE2Complex<tDataType> g4(g2);
+SE2Complex<tDataType> g5(data2);
+
+ASSERT_EQ(g1.data_,identity) << "Default constructor not set to identity";
+ASSERT_EQ(g2.data_,data1) << "Assignment constructor error";
+ASSERT_EQ(g3.data_,identity) << "Assignment constructor error: Invalid element not excepted. Should set element to identity.";
+ASSERT_EQ(g4.data_,data1) << "Copy constructor error";
+ASSERT_EQ(g5.data_,data2) << "Assignment constructor error";
+
+// Conversions
+SE2<tDataType> h = g2.ToSE2();
+ASSERT_TRUE(SE2<tDataType>::isElement(h.data_));
+ASSERT_EQ(SE2Complex<tDataType>(h).data_, data1);
+ASSERT_EQ(g2.Matrix(), h.data_);
+ASSERT_EQ(g2.R(), h.R());
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Test the exponential and logarithm against the ones of se2
+TEST(SE2ComplexTest, ExpLog) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
+
+for (tDataType th : {0.0, 1e-12, -1e-7, 1e-3, 1.0, -2.0, 3.0, 3.14159}) {
+    Vec3d u = Vec3d::Random();
+    u(2) = th;
+    Vec4d g = se2c<tDataType>::Exp(u);
+    ASSERT_LE( (se2c<tDataType>::Homogeneous(g) - se2<tDataType>::Exp(u)).norm(), 1e-14) << "Error with the exponential. Angle: " << th;
+    ASSERT_LE( (se2c<tDataType>::Log(g) - u).norm(), 1e-13) << "Error with the logarithm. Angle: " << th;
+}
+
+// Jacobians
+Vec3d u = Vec3d::Random();
+Eigen::Matrix<tDataType,3,3> jl, jr, jl_inv, jr_inv;
+se2c<tDataType>::ExpWithJl(u,jl);
+se2c<tDataType>::ExpWithJr(u,jr);
+se2c<tDataType>::LogWithJlInv(se2c<tDataType>::Exp(u),jl_inv);
+se2c<tDataType>::LogWithJrInv(se2c<tDataType>::Exp(u),jr_inv);
+se2<tDataType> v(u);
+ASSERT_LE( (jl - v.Jl()).norm(), 1e-12);
+ASSERT_LE( (jr - v.Jr()).norm(), 1e-12);
+ASSERT_LE( (jl_inv - v.JlInv()).norm(), 1e-12);
+ASSERT_LE( (jr_inv - v.JrInv()).norm(), 1e-12);
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Test the Inverse, Adjoint, Identity, Log, action and operators against SE2
+TEST(SE2ComplexTest, IAILO) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,2,1> Vec2d;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+
+SE2Complex<tDataType> g1(SE2Complex<tDataType>::Random());
+SE2Complex<tDataType> g2(SE2Complex<tDataType>::Random());
+SE2<tDataType> h1 = g1.ToSE2();
+SE2<tDataType> h2 = g2.ToSE2();
+SE2Complex<tDataType> g3 = g1*g2;
+
+ASSERT_LE( (g1.Inverse().Matrix() - h1.Inverse().data_).norm(), 1e-12) << " Error with the inverse operation ";
+ASSERT_EQ( SE2Complex<tDataType>::Identity().Matrix(), SE2<tDataType>::Identity().data_) << "Error with identity function ";
+ASSERT_LE( (g2.Adjoint() - h2.Adjoint()).norm(), 1e-12) << "Error with the Adjoint operation";
+ASSERT_LE( (g3.Matrix() - h1.data_*h2.data_).norm(), 1e-12) << "Error with the group operator";
+ASSERT_LE( (g1.Log() - h1.Log()).norm(), 1e-12) << "Error with the log function";
+
+Vec3d v = Vec3d::Random();
+ASSERT_LE( (g1.AdjointAct(v) - h1.AdjointAct(v)).norm(), 1e-12) << "Error with AdjointAct";
+ASSERT_LE( (g1.AdjointInvAct(v) - h1.AdjointInvAct(v)).norm(), 1e-12) << "Error with AdjointInvAct";
+
+Vec2d p = Vec2d::Random();
+ASSERT_LE( (g1.Act(p) - h1.Act(p)).norm(), 1e-12) << "Error with the group action";
+typename SE2Complex<tDataType>::ActJacobian j_pose, j_pose_se2;
+Eigen::Matrix<tDataType,2,2> j_point, j_point_se2;
+SE2Complex<tDataType>::ActWithJacobians(g1.data_,p,j_pose,j_point);
+SE2<tDataType>::ActWithJacobians(h1.data_,p,j_pose_se2,j_point_se2);
+ASSERT_LE( (j_pose - j_pose_se2).norm(), 1e-12) << "Error with the Jacobians of the group action";
+ASSERT_LE( (j_point - j_point_se2).norm(), 1e-12) << "Error with the Jacobians of the group action";
+
+// Batch action, in place
+std::vector<Vec2d, Eigen::aligned_allocator<Vec2d>> points(kBatchActBlockSize+5), out;
+for (Vec2d& q : points) {
+    q.setRandom();
+}
+out = points;
+SE2Complex<tDataType>::BatchAct(g1.data_,out.data(),out.data(),static_cast<Eigen::Index>(out.size()));
+for (size_t ii = 0; ii < points.size(); ++ii) {
+    ASSERT_LE( (out[ii] - h1.Act(points[ii])).norm(), 1e-12) << "Error with the batch group action";
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Tests the OPlus and OMinus functions, their Jacobians and the state
+TEST(SE2ComplexTest, BoxPlus) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,3,3> Mat3d;
+
+SE2Complex<tDataType> g1(SE2Complex<tDataType>::Random());
+SE2Complex<tDataType> g2(SE2Complex<tDataType>::Random());
+Vec3d u = Vec3d::Random();
+
+ASSERT_LE( (SE2Complex<tDataType>(g1.OPlus(u)).Matrix() - SE2<tDataType>::OPlus(g1.Matrix(),u)).norm(), 1e-12) << "Error with the OPlus function";
+ASSERT_LE( (g1.OMinus(g2.data_) - SE2<tDataType>::OMinus(g1.Matrix(),g2.Matrix())).norm(), 1e-12) << "Error with the OMinus function";
+ASSERT_LE( (g1.BoxMinus(g2).data_ - g1.OMinus(g2.data_)).norm(), 1e-12) << "Error with the BoxMinus function";
+ASSERT_LE( (g1.BoxPlus(se2c<tDataType>(u)).data_ - g1.OPlus(u)).norm(), 1e-12) << "Error with the BoxPlus function";
+
+Mat3d j1, j2, j1_se2, j2_se2;
+SE2Complex<tDataType>::OMinusWithJr(g1.data_,g2.data_,j1,j2);
+SE2<tDataType>::OMinusWithJr(g1.Matrix(),g2.Matrix(),j1_se2,j2_se2);
+ASSERT_LE( (j1 - j1_se2).norm(), 1e-12) << "Error with the Jacobians of OMinus";
+ASSERT_LE( (j2 - j2_se2).norm(), 1e-12) << "Error with the Jacobians of OMinus";
+SE2Complex<tDataType>::OPlusWithJr(g1.data_,u,j1,j2);
+SE2<tDataType>::OPlusWithJr(g1.Matrix(),u,j1_se2,j2_se2);
+ASSERT_LE( (j1 - j1_se2).norm(), 1e-12) << "Error with the Jacobians of OPlus";
+ASSERT_LE( (j2 - j2_se2).norm(), 1e-12) << "Error with the Jacobians of OPlus";
+
+// State
+SE2Complex_se2c s1 = SE2Complex_se2c::Random();
+SE2Complex_se2c s2 = SE2Complex_se2c::Random();
+SE2Complex_se2c s3 = s2.OPlus(SE2Complex_se2c::OMinus(s1,s2));
+ASSERT_LE( SE2Complex_se2c::OMinus(s3,s1).norm(), 1e-12) << "Error with the state";
+ASSERT_LE( (SE2Complex_se2c::Log(SE2Complex_se2c::Exp(SE2Complex_se2c::Log(s1))) - SE2Complex_se2c::Log(s1)).norm(), 1e-12) << "Error with the state";
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Tests the batch operations of a group array against the ones of the group
+TEST(SE2ComplexTest, GroupArray) {
+
+typedef double tDataType;
+typedef SE2Complex<tDataType> G;
+typedef GroupArray<G> Array;
+const int num_elements = 37;
+
+Array g1(num_elements), g2(num_elements), out;
+typename Array::Data_C u(num_elements,3), log, diff;
+for (int ii = 0; ii < num_elements; ++ii) {
+    g1[ii] = G::Random();
+    g2[ii] = G::Random();
+    u.row(ii) = Eigen::Matrix<tDataType,1,3>::Random();
+}
+
+Array::Exp(u,out);
+Array::Log(out,log);
+for (int ii = 0; ii < num_elements; ++ii) {
+    ASSERT_LE( (out[ii].data() - se2c<tDataType>::Exp(u.row(ii).transpose())).norm(), 1e-12) << "Error with Exp";
+    ASSERT_LE( (log.row(ii) - u.row(ii)).norm(), 1e-12) << "Error with Log";
+}
+
+Array::Mult(g1,g2,out);
+for (int ii = 0; ii < num_elements; ++ii) {
+    ASSERT_LE( (out[ii].data() - G::Mult(g1[ii].data(),g2[ii].data())).norm(), 1e-12) << "Error with Mult";
+}
+
+Array::OPlus(g1,u,out);
+Array::OMinus(out,g1,diff);
+for (int ii = 0; ii < num_elements; ++ii) {
+    ASSERT_LE( (out[ii].data() - G::OPlus(g1[ii].data(),u.row(ii).transpose())).norm(), 1e-12) << "Error with OPlus";
+    ASSERT_LE( (diff.row(ii) - u.row(ii)).norm(), 1e-12) << "Error with OMinus";
+}
+
+}
+
+}
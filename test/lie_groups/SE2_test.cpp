@@ -1,6 +1,8 @@
 #include "lie_groups/lie_groups/SE2.h"
+#include "lie_groups/group_array.h"
 #include "gtest/gtest.h"
 #include <Eigen/Dense>
+#include <cstring>
 
 
 namespace lie_groups {
@@ -52,29 +54,37 @@ SE2<tDataType> g4(g2);
 SE2<tDataType> g5(data2);
 
 ASSERT_EQ(g1.data_,Identity) << "Default constructor not set to identity";
-ASSERT_EQ(g1.data_.block(0,2,2,1),g1.t_) << "Translational velocity map not set properly.";
-ASSERT_EQ(g1.data_.block(0,0,2,2),g1.R_) << "Angular velocity map not set properly.";
+ASSERT_EQ(g1.data_.block(0,2,2,1),g1.t()) << "Translational velocity view not set properly.";
+ASSERT_EQ(g1.data_.block(0,0,2,2),g1.R()) << "Angular velocity view not set properly.";
 
 
 
 ASSERT_EQ(g2.data_,data1) << "Assignment constructor error";
-ASSERT_EQ(g2.data_.block(0,2,2,1),g2.t_) << "Translational velocity map not set properly.";
-ASSERT_EQ(g2.data_.block(0,0,2,2),g2.R_) << "Angular velocity map not set properly.";
+ASSERT_EQ(g2.data_.block(0,2,2,1),g2.t()) << "Translational velocity view not set properly.";
+ASSERT_EQ(g2.data_.block(0,0,2,2),g2.R()) << "Angular velocity view not set properly.";
 
 
 
 ASSERT_EQ(g3.data_,Identity) << "Copy constructor constructor error";
-ASSERT_EQ(g3.data_.block(0,2,2,1),g3.t_) << "Translational velocity map not set properly.";
-ASSERT_EQ(g3.data_.block(0,0,2,2),g3.R_) << "Angular velocity map not set properly.";
+ASSERT_EQ(g3.data_.block(0,2,2,1),g3.t()) << "Translational velocity view not set properly.";
+ASSERT_EQ(g3.data_.block(0,0,2,2),g3.R()) << "Angular velocity view not set properly.";
 
 ASSERT_EQ(g4.data_,data1) << "Assignment constructor error: Invalid element not excepted. Should set element to identity.";
-ASSERT_EQ(g4.data_.block(0,2,2,1),g4.t_) << "Translational velocity map not set properly.";
-ASSERT_EQ(g4.data_.block(0,0,2,2),g4.R_) << "Angular velocity map not set properly.";
+ASSERT_EQ(g4.data_.block(0,2,2,1),g4.t()) << "Translational velocity view not set properly.";
+ASSERT_EQ(g4.data_.block(0,0,2,2),g4.R()) << "Angular velocity view not set properly.";
 
 
 ASSERT_EQ(g5.data_,data2) << "Assignment constructor error";
-ASSERT_EQ(g5.data_.block(0,2,2,1),g5.t_) << "Translational velocity map not set properly.";
-ASSERT_EQ(g5.data_.block(0,0,2,2),g5.R_) << "Angular velocity map not set properly.";
+ASSERT_EQ(g5.data_.block(0,2,2,1),g5.t()) << "Translational velocity view not set properly.";
+ASSERT_EQ(g5.data_.block(0,0,2,2),g5.R()) << "Angular velocity view not set properly.";
+
+// The element only stores its data so it can be copied bitwise
+ASSERT_EQ(sizeof(SE2<tDataType>), sizeof(Mat3d)) << "The element stores more than its data.";
+SE2<tDataType> g6;
+std::memcpy(static_cast<void*>(&g6), static_cast<const void*>(&g2), sizeof(SE2<tDataType>));
+ASSERT_EQ(g6.data_,data1) << "Bitwise copy error";
+ASSERT_EQ(g6.data_.block(0,2,2,1),g6.t()) << "Translational velocity view not set properly.";
+ASSERT_EQ(g6.data_.block(0,0,2,2),g6.R()) << "Angular velocity view not set properly.";
 
 
 }
@@ -172,4 +182,66 @@ ASSERT_LE( (g5.BoxMinus(g4).data_- th2).norm(), kSE2_threshold_) << "Error with
 
 }
 
+////////////////////////////////////////////////////////////////////////
+
+// The matrix-free adjoint functions must match the adjoint matrix. The number of elements
+// of the batch is not a multiple of the packet size so that the scalar remainder is tested.
+template<typename tDataType>
+void TestAdjointAct(double tol) {
+
+typedef SE2<tDataType> Group;
+typedef Eigen::Matrix<tDataType,3,1> Vec_C;
+typedef Eigen::Matrix<tDataType,3,3> Mat_Adj;
+typedef GroupArray<Group> Array;
+
+const int num_elements = 37;
+Array g(num_elements);
+typename Array::Data_C v(num_elements,3), act, inv_act;
+typename Array::Data_Cov cov(num_elements,3*3), cov_out;
+for (int ii = 0; ii < num_elements; ++ii) {
+    g[ii] = Group::Random(static_cast<tDataType>(2.0));
+    v.row(ii) = Vec_C::Random().transpose();
+    Mat_Adj l = Mat_Adj::Random();
+    Mat_Adj p = l*l.transpose();
+    cov.row(ii) = Eigen::Map<const Eigen::Matrix<tDataType,1,3*3>>(p.data());
+}
+
+Array::AdjointAct(g,v,act);
+Array::AdjointInvAct(g,v,inv_act);
+Array::AdjointTransformCovariance(g,cov,cov_out);
+
+for (int ii = 0; ii < num_elements; ++ii) {
+    Group h = g[ii];
+    Mat_Adj adj = h.Adjoint();
+    Vec_C vi = v.row(ii).transpose();
+    Mat_Adj p = Eigen::Map<const Mat_Adj>(cov.row(ii).eval().data());
+
+    ASSERT_LE( (h.AdjointAct(vi) - adj*vi).norm(), tol) << "Error with AdjointAct";
+    ASSERT_LE( (h.AdjointInvAct(vi) - adj.inverse()*vi).norm(), tol) << "Error with AdjointInvAct";
+    ASSERT_LE( (h.AdjointTransformCovariance(p) - adj*p*adj.transpose()).norm(), tol*p.norm()) << "Error with AdjointTransformCovariance";
+
+    ASSERT_LE( (act.row(ii).transpose() - adj*vi).norm(), tol) << "Error with the batch AdjointAct";
+    ASSERT_LE( (inv_act.row(ii).transpose() - adj.inverse()*vi).norm(), tol) << "Error with the batch AdjointInvAct";
+    Mat_Adj p_out = Eigen::Map<const Mat_Adj>(cov_out.row(ii).eval().data());
+    ASSERT_LE( (p_out - adj*p*adj.transpose()).norm(), tol*p.norm()) << "Error with the batch AdjointTransformCovariance";
+}
+
+// The output can alias the input
+Array::AdjointAct(g,v,v);
+ASSERT_LE( (v - act).norm(), tol) << "Error with the batch AdjointAct in place";
+
+}
+
+TEST(SE2Test, AdjointActTest) {
+TestAdjointAct<double>(1e-10);
+TestAdjointAct<float>(1e-4);
+
+// The adjoint of the algebra
+typedef Eigen::Matrix<double,3,1> Vec_C;
+se2<double> u(Vec_C::Random());
+Vec_C v = Vec_C::Random();
+ASSERT_LE( (se2<double>::AdjointAct(u.data_,v) - u.Adjoint()*v).norm(), 1e-12) << "Error with the adjoint of the algebra";
+ASSERT_LE( (u.Bracket(se2<double>(v)).data_ - u.Adjoint()*v).norm(), 1e-12) << "Error with the Lie bracket";
+}
+
 } // namespace lie_groups
\ No newline at end of file
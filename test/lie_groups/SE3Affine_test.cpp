@@ -0,0 +1,134 @@
+#include "lie_groups/lie_groups/SE3Affine.h"
+#include "lie_groups/state.h"
+#include "gtest/gtest.h"
+#include <Eigen/Dense>
+
+
+namespace lie_groups {
+
+////////////////////////////////////////////////////////////////////////
+
+// Test the constructors and the conversions to and from SE3
+TEST(SE3AffineTest, Constructors) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,3,4> Mat34d;
+
+Mat34d identity = Mat34d::Identity();
+
+// Valid element
+Mat34d data1 = SE3Affine<tDataType>::Random();
+
+// Invalid element
+Mat34d data2 = Mat34d::Ones();
+
+SE3Affine<tDataType> g1;
+SE3Affine<tDataType> g2(data1,true);
+SE3Affine<tDataType> g3(data2,true);
+SE3Affine<tDataType> g4(g2);
+SE3Affine<tDataType> g5(data2);
+
+ASSERT_EQ(g1.data_,identity) << "Default constructor not set to identity";
+ASSERT_EQ(g2.data_,data1) << "Assignment constructor error";
+ASSERT_EQ(g3.data_,identity) << "Assignment constructor error: Invalid element not excepted. Should set element to identity.";
+ASSERT_EQ(g4.data_,data1) << "Copy constructor error";
+ASSERT_EQ(g5.data_,data2) << "Assignment constructor error";
+
+// Conversions
+SE3<tDataType> h = g2.ToSE3();
+ASSERT_TRUE(SE3<tDataType>::isElement(h.data_));
+ASSERT_EQ(h.data_.template topRows<3>(), data1);
+ASSERT_EQ(SE3Affine<tDataType>(h).data_, data1);
+ASSERT_EQ(g2.Matrix(), h.data_);
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Test the Inverse, Adjoint, Identity, Log, action and operators against SE3
+TEST(SE3AffineTest, IAILO) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,6,1> Vec6d;
+
+SE3Affine<tDataType> g1(SE3Affine<tDataType>::Random());
+SE3Affine<tDataType> g2(SE3Affine<tDataType>::Random());
+SE3<tDataType> h1 = g1.ToSE3();
+SE3<tDataType> h2 = g2.ToSE3();
+SE3Affine<tDataType> g3 = g1*g2;
+
+ASSERT_LE( (g1.Inverse().Matrix() - h1.Inverse().data_).norm(), 1e-12) << " Error with the inverse operation ";
+ASSERT_EQ( SE3Affine<tDataType>::Identity().Matrix(), SE3<tDataType>::Identity().data_) << "Error with identity function ";
+ASSERT_LE( (g2.Adjoint() - h2.Adjoint()).norm(), 1e-12) << "Error with the Adjoint operation";
+ASSERT_LE( (g3.Matrix() - h1.data_*h2.data_).norm(), 1e-12) << "Error with the group operator";
+ASSERT_LE( (g1.Log() - h1.Log()).norm(), 1e-12) << "Error with the log function";
+ASSERT_LE( (se3a<tDataType>::Homogeneous(se3a<tDataType>::Exp(g1.Log())) - h1.data_).norm(), 1e-12) << "Error with the exponential";
+
+Vec6d v = Vec6d::Random();
+ASSERT_LE( (g1.AdjointAct(v) - h1.AdjointAct(v)).norm(), 1e-12) << "Error with AdjointAct";
+ASSERT_LE( (g1.AdjointInvAct(v) - h1.AdjointInvAct(v)).norm(), 1e-12) << "Error with AdjointInvAct";
+Eigen::Matrix<tDataType,6,6> cov = Eigen::Matrix<tDataType,6,6>::Random();
+cov = cov*cov.transpose();
+ASSERT_LE( (g1.AdjointTransformCovariance(cov) - h1.AdjointTransformCovariance(cov)).norm(), 1e-12) << "Error with AdjointTransformCovariance";
+
+Vec3d p = Vec3d::Random();
+ASSERT_LE( (g1.Act(p) - h1.Act(p)).norm(), 1e-12) << "Error with the group action";
+typename SE3Affine<tDataType>::ActJacobian j_pose, j_pose_se3;
+Eigen::Matrix<tDataType,3,3> j_point, j_point_se3;
+SE3Affine<tDataType>::ActWithJacobians(g1.data_,p,j_pose,j_point);
+SE3<tDataType>::ActWithJacobians(h1.data_,p,j_pose_se3,j_point_se3);
+ASSERT_LE( (j_pose - j_pose_se3).norm(), 1e-12) << "Error with the Jacobians of the group action";
+ASSERT_LE( (j_point - j_point_se3).norm(), 1e-12) << "Error with the Jacobians of the group action";
+
+// Batch action, in place
+std::vector<Vec3d, Eigen::aligned_allocator<Vec3d>> points(kBatchActBlockSize+5), out;
+for (Vec3d& q : points) {
+    q.setRandom();
+}
+out = points;
+SE3Affine<tDataType>::BatchAct(g1.data_,out.data(),out.data(),static_cast<Eigen::Index>(out.size()));
+for (size_t ii = 0; ii < points.size(); ++ii) {
+    ASSERT_LE( (out[ii] - h1.Act(points[ii])).norm(), 1e-12) << "Error with the batch group action";
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Tests the OPlus and OMinus functions, their Jacobians and the state
+TEST(SE3AffineTest, BoxPlus) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,6,1> Vec6d;
+typedef Eigen::Matrix<tDataType,6,6> Mat6d;
+
+SE3Affine<tDataType> g1(SE3Affine<tDataType>::Random());
+SE3Affine<tDataType> g2(SE3Affine<tDataType>::Random());
+Vec6d u = Vec6d::Random();
+
+ASSERT_LE( (SE3Affine<tDataType>(g1.OPlus(u)).Matrix() - SE3<tDataType>::OPlus(g1.Matrix(),u)).norm(), 1e-12) << "Error with the OPlus function";
+ASSERT_LE( (g1.OMinus(g2.data_) - SE3<tDataType>::OMinus(g1.Matrix(),g2.Matrix())).norm(), 1e-12) << "Error with the OMinus function";
+ASSERT_LE( (g1.BoxMinus(g2).data_ - g1.OMinus(g2.data_)).norm(), 1e-12) << "Error with the BoxMinus function";
+ASSERT_LE( (g1.BoxPlus(se3a<tDataType>(u)).data_ - g1.OPlus(u)).norm(), 1e-12) << "Error with the BoxPlus function";
+
+Mat6d j1, j2, j1_se3, j2_se3;
+SE3Affine<tDataType>::OMinusWithJr(g1.data_,g2.data_,j1,j2);
+SE3<tDataType>::OMinusWithJr(g1.Matrix(),g2.Matrix(),j1_se3,j2_se3);
+ASSERT_LE( (j1 - j1_se3).norm(), 1e-12) << "Error with the Jacobians of OMinus";
+ASSERT_LE( (j2 - j2_se3).norm(), 1e-12) << "Error with the Jacobians of OMinus";
+SE3Affine<tDataType>::OPlusWithJr(g1.data_,u,j1,j2);
+SE3<tDataType>::OPlusWithJr(g1.Matrix(),u,j1_se3,j2_se3);
+ASSERT_LE( (j1 - j1_se3).norm(), 1e-12) << "Error with the Jacobians of OPlus";
+ASSERT_LE( (j2 - j2_se3).norm(), 1e-12) << "Error with the Jacobians of OPlus";
+
+// State
+SE3Affine_se3a s1 = SE3Affine_se3a::Random();
+SE3Affine_se3a s2 = SE3Affine_se3a::Random();
+SE3Affine_se3a s3 = s2.OPlus(SE3Affine_se3a::OMinus(s1,s2));
+ASSERT_LE( SE3Affine_se3a::OMinus(s3,s1).norm(), 1e-12) << "Error with the state";
+ASSERT_LE( (SE3Affine_se3a::Log(SE3Affine_se3a::Exp(SE3Affine_se3a::Log(s1))) - SE3Affine_se3a::Log(s1)).norm(), 1e-12) << "Error with the state";
+
+}
+
+}
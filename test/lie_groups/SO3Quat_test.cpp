@@ -0,0 +1,181 @@
+#include "lie_groups/lie_groups/SO3Quat.h"
+#include "lie_groups/state.h"
+#include "lie_groups/group_array.h"
+#include "gtest/gtest.h"
+#include <Eigen/Dense>
+
+
+namespace lie_groups {
+
+////////////////////////////////////////////////////////////////////////
+
+// Test the constructors and the conversions to and from SO3
+TEST(SO3QuatTest, Constructors) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
+
+Vec4d identity(0,0,0,1);
+
+// Valid element
+Vec4d data1 = SO3Quat<tDataType>::Random();
+
+// Invalid element
+Vec4d data2(1,1,1,1);
+
+SO3Quat<tDataType> g1;
+SO3Quat<tDataType> g2(data1,true);
+SO3Quat<tDataType> g3(data2,true);
+SO3Quat<tDataType> g4(g2);
+SO3Quat<tDataType> g5(data2);
+
+ASSERT_EQ(g1.data_,identity) << "Default constructor not set to identity";
+ASSERT_EQ(g2.data_,data1) << "Assignment constructor error";
+ASSERT_EQ(g3.data_,identity) << "Assignment constructor error: Invalid element not excepted. Should set element to identity.";
+ASSERT_EQ(g4.data_,data1) << "Copy constructor error";
+ASSERT_EQ(g5.data_,data2) << "Assignment constructor error";
+
+// Conversions. q and -q are the same rotation.
+SO3<tDataType> r = g2.ToSO3();
+ASSERT_TRUE(SO3<tDataType>::isElement(r.data_));
+SO3Quat<tDataType> g6(r);
+ASSERT_LE( std::min((g6.data_ - data1).norm(), (g6.data_ + data1).norm()), 1e-12) << "Error with the conversions to and from SO3";
+ASSERT_LE( (SO3Quat<tDataType>::ToRotationMatrix(data1) - so3<tDataType>::Exp(so3q<tDataType>::Log(data1))).norm(), 1e-12) << "Error with the rotation matrix";
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Test the exponential and logarithm against the ones of so3
+TEST(SO3QuatTest, ExpLog) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
+
+for (tDataType scale : {0.0, 1e-12, 1e-7, 1e-3, 1.0, 3.0, 3.14159}) {
+    Vec3d u = Vec3d::Random().normalized()*scale;
+    Vec4d q = so3q<tDataType>::Exp(u);
+    ASSERT_LE( std::abs(q.norm() - 1.0), 1e-15) << "The exponential isn't a unit quaternion. Scale: " << scale;
+    ASSERT_LE( (SO3Quat<tDataType>::ToRotationMatrix(q) - so3<tDataType>::Exp(u)).norm(), 1e-14) << "Error with the exponential. Scale: " << scale;
+    ASSERT_LE( (so3q<tDataType>::Log(q) - u).norm(), 1e-14) << "Error with the logarithm. Scale: " << scale;
+    ASSERT_LE( (so3q<tDataType>::Log(-q) - u).norm(), 1e-14) << "Error with the logarithm of the negated quaternion. Scale: " << scale;
+}
+
+// Jacobians
+Vec3d u = Vec3d::Random();
+Eigen::Matrix<tDataType,3,3> jl, jr, jl_inv, jr_inv;
+so3q<tDataType>::ExpWithJl(u,jl);
+so3q<tDataType>::ExpWithJr(u,jr);
+so3q<tDataType>::LogWithJlInv(so3q<tDataType>::Exp(u),jl_inv);
+so3q<tDataType>::LogWithJrInv(so3q<tDataType>::Exp(u),jr_inv);
+so3<tDataType> v(u);
+ASSERT_LE( (jl - v.Jl()).norm(), 1e-12);
+ASSERT_LE( (jr - v.Jr()).norm(), 1e-12);
+ASSERT_LE( (jl_inv - v.JlInv()).norm(), 1e-12);
+ASSERT_LE( (jr_inv - v.JrInv()).norm(), 1e-12);
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Test the Inverse, Adjoint, Identity, action and operators against SO3
+TEST(SO3QuatTest, IAILO) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,4,1> Vec4d;
+
+SO3Quat<tDataType> g1(SO3Quat<tDataType>::Random());
+SO3Quat<tDataType> g2(SO3Quat<tDataType>::Random());
+SO3<tDataType> r1 = g1.ToSO3();
+SO3<tDataType> r2 = g2.ToSO3();
+SO3Quat<tDataType> g3 = g1*g2;
+
+ASSERT_LE( (g1.Inverse().ToSO3().data_ - r1.Inverse().data_).norm(), 1e-12) << " Error with the inverse operation ";
+ASSERT_EQ( SO3Quat<tDataType>::Identity().data_, Vec4d(0,0,0,1)) << "Error with identity function ";
+ASSERT_LE( (g2.Adjoint() - r2.data_).norm(), 1e-12) << "Error with the Adjoint operation";
+ASSERT_LE( (g3.ToSO3().data_ - r1.data_*r2.data_).norm(), 1e-12) << "Error with the group operator";
+ASSERT_LE( (g1.Log() - r1.Log()).norm(), 1e-12) << "Error with the log function";
+
+Vec3d p = Vec3d::Random();
+ASSERT_LE( (g1.Act(p) - r1.Act(p)).norm(), 1e-12) << "Error with the group action";
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Tests the OPlus and OMinus functions, their Jacobians and the state
+TEST(SO3QuatTest, BoxPlus) {
+
+typedef double tDataType;
+typedef Eigen::Matrix<tDataType,3,1> Vec3d;
+typedef Eigen::Matrix<tDataType,3,3> Mat3d;
+
+SO3Quat<tDataType> g1(SO3Quat<tDataType>::Random());
+SO3Quat<tDataType> g2(SO3Quat<tDataType>::Random());
+Vec3d u = Vec3d::Random();
+
+ASSERT_LE( (SO3Quat<tDataType>(g1.OPlus(u)).ToSO3().data_ - SO3<tDataType>::OPlus(g1.ToSO3().data_,u)).norm(), 1e-12) << "Error with the OPlus function";
+ASSERT_LE( (g1.OMinus(g2.data_) - SO3<tDataType>::OMinus(g1.ToSO3().data_,g2.ToSO3().data_)).norm(), 1e-12) << "Error with the OMinus function";
+ASSERT_LE( (g1.BoxMinus(g2).data_ - g1.OMinus(g2.data_)).norm(), 1e-12) << "Error with the BoxMinus function";
+
+Mat3d j1, j2, j1_so3, j2_so3;
+SO3Quat<tDataType>::OMinusWithJr(g1.data_,g2.data_,j1,j2);
+SO3<tDataType>::OMinusWithJr(g1.ToSO3().data_,g2.ToSO3().data_,j1_so3,j2_so3);
+ASSERT_LE( (j1 - j1_so3).norm(), 1e-12) << "Error with the Jacobians of OMinus";
+ASSERT_LE( (j2 - j2_so3).norm(), 1e-12) << "Error with the Jacobians of OMinus";
+SO3Quat<tDataType>::OPlusWithJr(g1.data_,u,j1,j2);
+SO3<tDataType>::OPlusWithJr(g1.ToSO3().data_,u,j1_so3,j2_so3);
+ASSERT_LE( (j1 - j1_so3).norm(), 1e-12) << "Error with the Jacobians of OPlus";
+ASSERT_LE( (j2 - j2_so3).norm(), 1e-12) << "Error with the Jacobians of OPlus";
+
+// State
+SO3Quat_so3q s1 = SO3Quat_so3q::Random();
+SO3Quat_so3q s2 = SO3Quat_so3q::Random();
+SO3Quat_so3q s3 = s2.OPlus(SO3Quat_so3q::OMinus(s1,s2));
+ASSERT_LE( SO3Quat_so3q::OMinus(s3,s1).norm(), 1e-12) << "Error with the state";
+ASSERT_LE( (SO3Quat_so3q::Log(SO3Quat_so3q::Exp(SO3Quat_so3q::Log(s1))) - SO3Quat_so3q::Log(s1)).norm(), 1e-12) << "Error with the state";
+
+}
+
+////////////////////////////////////////////////////////////////////////
+
+// Tests the batch operations of a group array against the ones of the group
+TEST(SO3QuatTest, GroupArray) {
+
+typedef double tDataType;
+typedef SO3Quat<tDataType> G;
+typedef GroupArray<G> Array;
+const int num_elements = 37;
+
+Array g1(num_elements), g2(num_elements), out;
+typename Array::Data_C u(num_elements,3), log, diff;
+for (int ii = 0; ii < num_elements; ++ii) {
+    g1[ii] = G::Random();
+    g2[ii] = G::Random();
+    u.row(ii) = Eigen::Matrix<tDataType,1,3>::Random();
+}
+
+Array::Exp(u,out);
+Array::Log(out,log);
+for (int ii = 0; ii < num_elements; ++ii) {
+    ASSERT_LE( (out[ii].data() - so3q<tDataType>::Exp(u.row(ii).transpose())).norm(), 1e-12) << "Error with Exp";
+    ASSERT_LE( (log.row(ii) - u.row(ii)).norm(), 1e-12) << "Error with Log";
+}
+
+Array::Mult(g1,g2,out);
+for (int ii = 0; ii < num_elements; ++ii) {
+    ASSERT_LE( (out[ii].data() - G::Mult(g1[ii].data(),g2[ii].data())).norm(), 1e-12) << "Error with Mult";
+}
+
+Array::OPlus(g1,u,out);
+Array::OMinus(out,g1,diff);
+for (int ii = 0; ii < num_elements; ++ii) {
+    ASSERT_LE( (out[ii].data() - G::OPlus(g1[ii].data(),u.row(ii).transpose())).norm(), 1e-12) << "Error with OPlus";
+    ASSERT_LE( (diff.row(ii) - u.row(ii)).norm(), 1e-12) << "Error with OMinus";
+}
+
+}
+
+}
@@ -84,7 +84,7 @@ ASSERT_LE( ((g1.Inverse()).data_ - g1.data_.inverse()).norm(), kSO3_threshold_)
 ASSERT_EQ( SO3<tDataType>::Identity().data_, Identity  ) << "Error with identity function ";
 ASSERT_EQ( g2.Adjoint(),  g2.data_) << "Error with the Adjoint operation";
 
-ASSERT_DOUBLE_EQ(th(0), g3.Log()(0)) << "Error with the log function";
+ASSERT_FLOAT_EQ(th(0), g3.Log()(0)) << "Error with the log function";
 
 ASSERT_EQ(g4.data_, g1.data_) << "Error with assignmet operator";
 
@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+
+#include <Eigen/Dense>
+
+#include "lie_groups/product_state.h"
+
+namespace lie_groups {
+
+
+using MyTypes = ::testing::Types<ProductState<SE3_se3,R3_r3>, ProductState<SO3_so3,R3_r3,R3_r3>, ProductState<SE2_se2>, ProductState<SO2_so2,SE3_se3,R2_r2>, ProductState<State<SE3,double,6,2>,R3_r3>>;
+
+template <typename T>
+class ProductStateTest : public testing::Test {
+public:
+typedef T type;
+};
+
+TYPED_TEST_SUITE(ProductStateTest, MyTypes);
+
+static_assert(ProductState<SE3_se3,R3_r3,SO2_so2>::dim_ == 12 + 6 + 2, "The dimension of a product is the sum of the dimensions");
+static_assert(ProductState<SE3_se3,R3_r3,SO2_so2>::Offset<0>::value == 0, "Error with the offsets of a product");
+static_assert(ProductState<SE3_se3,R3_r3,SO2_so2>::Offset<1>::value == 12, "Error with the offsets of a product");
+static_assert(ProductState<SE3_se3,R3_r3,SO2_so2>::Offset<2>::value == 18, "Error with the offsets of a product");
+
+// The dense matrix of the Jacobian of a product is the block diagonal matrix of the Jacobians of the states.
+template <int I, typename tProduct, typename tFunction>
+typename std::enable_if<(I == tProduct::num_states_)>::type ExpectedJacobian(const typename tProduct::Vec_SC&, typename tProduct::Mat_SC&, tFunction) {}
+
+template <int I, typename tProduct, typename tFunction>
+typename std::enable_if<(I < tProduct::num_states_)>::type ExpectedJacobian(const typename tProduct::Vec_SC& cartesian, typename tProduct::Mat_SC& m, tFunction f) {
+    typedef typename tProduct::template StateType<I> S;
+    const typename S::Vec_SC u = cartesian.template segment<S::dim_>(tProduct::template Offset<I>::value);
+    m.template block<S::dim_,S::dim_>(tProduct::template Offset<I>::value,tProduct::template Offset<I>::value) = f(S(),u);
+    ExpectedJacobian<I+1,tProduct>(cartesian,m,f);
+}
+
+struct JrOf {template <typename S> typename S::Mat_SC operator()(const S&, const typename S::Vec_SC& u) const {return S::Jr(u);}};
+struct JlOf {template <typename S> typename S::Mat_SC operator()(const S&, const typename S::Vec_SC& u) const {return S::Jl(u);}};
+struct JrInvOf {template <typename S> typename S::Mat_SC operator()(const S&, const typename S::Vec_SC& u) const {return S::JrInv(u);}};
+struct JlInvOf {template <typename S> typename S::Mat_SC operator()(const S&, const typename S::Vec_SC& u) const {return S::JlInv(u);}};
+
+////////////////////////////////////////////////////////////
+//                    Operations test
+////////////////////////////////////////////////////////////
+
+TYPED_TEST(ProductStateTest, Operations) {
+
+typedef TypeParam P;
+typedef typename P::Vec_SC Vec_SC;
+typedef typename P::Mat_SC Mat_SC;
+typedef typename P::template StateType<0> S0;
+const double tol = 1e-10;
+
+for (int ii = 0; ii < 20; ++ii) {
+
+    const P s1 = P::Random();
+    const Vec_SC tau = Vec_SC::Random();
+
+    // The first state is computed with its own block of the Cartesian vector
+    const P s2 = s1.OPlus(tau);
+    const typename S0::Vec_SC tau0 = tau.template head<S0::dim_>();
+    ASSERT_LE( (s2.template Get<0>().g_.data_ - S0::OPlus(s1.template Get<0>(),tau0).g_.data_).norm(), tol) << "Error with OPlus";
+    ASSERT_LE( (s2.template Get<0>().u_.data_ - S0::OPlus(s1.template Get<0>(),tau0).u_.data_).norm(), tol) << "Error with OPlus";
+    ASSERT_LE( (P::OMinus(s2,s1) - tau).norm(), tol) << "Error with OMinus";
+    ASSERT_LE( (s2.OMinus(s1) - tau).norm(), tol) << "Error with OMinus";
+
+    P s3 = s1;
+    s3.OPlusEQ(tau);
+    ASSERT_LE( s3.OMinus(s2).norm(), tol) << "Error with OPlusEQ";
+
+    // Log is the inverse of Exp and it agrees with the state of the first component
+    const Vec_SC u = Vec_SC::Random()*0.5;
+    ASSERT_LE( (P::Log(P::Exp(u)) - u).norm(), tol) << "Error with Exp or Log";
+    ASSERT_LE( (P::Log(s1).template head<S0::dim_>() - S0::Log(s1.template Get<0>())).norm(), tol) << "Error with Log";
+    ASSERT_LE( P::OMinus(P::Identity(),P::Exp(Vec_SC::Zero())).norm(), tol) << "Error with Identity";
+
+    // The Jacobians
+    Mat_SC expected = Mat_SC::Zero();
+    ExpectedJacobian<0,P>(tau,expected,JrOf());
+    ASSERT_LE( (P::Jr(tau).ToDense() - expected).norm(), tol) << "Error with Jr";
+    expected.setZero();
+    ExpectedJacobian<0,P>(tau,expected,JlOf());
+    ASSERT_LE( (P::Jl(tau).ToDense() - expected).norm(), tol) << "Error with Jl";
+    expected.setZero();
+    ExpectedJacobian<0,P>(tau,expected,JrInvOf());
+    ASSERT_LE( (P::JrInv(tau).ToDense() - expected).norm(), tol) << "Error with JrInv";
+    expected.setZero();
+    ExpectedJacobian<0,P>(tau,expected,JlInvOf());
+    ASSERT_LE( (P::JlInv(tau).ToDense() - expected).norm(), tol) << "Error with JlInv";
+    ASSERT_LE( (P::JrInv(tau).ToDense()*P::Jr(tau).ToDense() - Mat_SC::Identity()).norm(), tol) << "Error with JrInv";
+
+    // The products with the block diagonal Jacobian
+    const typename P::Jacobian jr = P::Jr(tau);
+    const Mat_SC dense = jr.ToDense();
+    const Mat_SC m = Mat_SC::Random();
+    const Eigen::Matrix<double,P::dim_,3> n = Eigen::Matrix<double,P::dim_,3>::Random();
+    const Eigen::MatrixXd d = Eigen::MatrixXd::Random(P::dim_,2);
+    ASSERT_LE( (jr*tau - dense*tau).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (jr*m - dense*m).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (jr*n - dense*n).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (jr*d - dense*d).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (jr.TransposeTimes(m) - dense.transpose()*m).norm(), tol) << "Error with TransposeTimes";
+    ASSERT_LE( (jr.TransposeTimes(d) - dense.transpose()*d).norm(), tol) << "Error with TransposeTimes";
+}
+
+}
+
+
+} // namespace lie_groups
@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+
+#include <Eigen/Dense>
+#include <vector>
+
+#include "lie_groups/state_array.h"
+
+namespace lie_groups {
+
+
+using MyTypes = ::testing::Types<State<Rn,double,2,2>,State<Rn,double,3,3>,R2_r2,R3_r3,SO2_so2,SO3_so3,SE2_se2,SE3_se3,State<SE3,float,6,1>,State<SO3,double,3,2>,State<SE3,double,6,2>>;
+
+// Tests both the group array and the state array
+template <typename T>
+class StateArrayTest : public testing::Test {
+public:
+typedef T type;
+};
+
+TYPED_TEST_SUITE(StateArrayTest, MyTypes);
+
+// The number of elements is not a multiple of the block size so that the remainder is tested.
+constexpr int kNumElements = 2*kGroupArrayBlockSize + 7;
+
+template<typename tDataType>
+double Tolerance() {return std::is_same<tDataType,float>::value ? 1e-4 : 1e-10;}
+
+////////////////////////////////////////////////////////////
+//                  Constructor and proxy test
+////////////////////////////////////////////////////////////
+
+TYPED_TEST(StateArrayTest, ConstructorsAndProxies) {
+
+typedef typename TypeParam::Group Group;
+typedef GroupArray<Group> GArray;
+typedef StateArray<TypeParam> SArray;
+
+GArray g_array(kNumElements);
+SArray s_array(kNumElements);
+ASSERT_EQ(g_array.Size(), kNumElements);
+ASSERT_EQ(s_array.Size(), kNumElements);
+
+for (int ii = 0; ii < kNumElements; ++ii) {
+    ASSERT_EQ(g_array[ii].data(), Group().data_);
+    ASSERT_EQ(static_cast<TypeParam>(s_array[ii]).g_.data_, Group().data_);
+    ASSERT_EQ(static_cast<TypeParam>(s_array[ii]).u_.data_, TypeParam::Mat_C::Zero());
+}
+
+// Write through the proxies and read back
+std::vector<TypeParam, Eigen::aligned_allocator<TypeParam>> states(kNumElements);
+for (int ii = 0; ii < kNumElements; ++ii) {
+    states[ii] = TypeParam::Random();
+    g_array[ii] = states[ii].g_;
+    s_array[ii] = states[ii];
+}
+
+for (int ii = 0; ii < kNumElements; ++ii) {
+    Group g = g_array[ii];
+    TypeParam s = s_array[ii];
+    ASSERT_EQ(g.data_, states[ii].g_.data_);
+    ASSERT_EQ(s.g_.data_, states[ii].g_.data_);
+    ASSERT_EQ(s.u_.data_, states[ii].u_.data_);
+}
+
+// Proxy to proxy assignment copies the element
+g_array[0] = g_array[1];
+s_array[0] = s_array[1];
+ASSERT_EQ(g_array[0].data(), states[1].g_.data_);
+ASSERT_EQ(s_array.Get(0).u_.data_, states[1].u_.data_);
+
+}
+
+////////////////////////////////////////////////////////////
+//                     Batch operations test
+////////////////////////////////////////////////////////////
+
+TYPED_TEST(StateArrayTest, BatchOperations) {
+
+typedef typename TypeParam::DataType DataType;
+typedef StateArray<TypeParam> SArray;
+const double tol = Tolerance<DataType>();
+
+SArray s1(kNumElements), s2(kNumElements), out;
+typename SArray::Data_SC cartesian;
+cartesian.resize(kNumElements,TypeParam::dim_);
+std::vector<TypeParam, Eigen::aligned_allocator<TypeParam>> states1(kNumElements), states2(kNumElements);
+for (int ii = 0; ii < kNumElements; ++ii) {
+    states1[ii] = TypeParam::Random();
+    states2[ii] = TypeParam::Random();
+    s1[ii] = states1[ii];
+    s2[ii] = states2[ii];
+    cartesian.row(ii) = TypeParam::Log(states2[ii]).transpose();
+}
+
+// Mult
+SArray::Mult(s1,s2,out);
+for (int ii = 0; ii < kNumElements; ++ii) {
+    TypeParam s = states1[ii]*states2[ii];
+    ASSERT_LE( (out.Get(ii).g_.data_ - s.g_.data_).norm(), tol);
+    ASSERT_LE( (out.Get(ii).u_.data_ - s.u_.data_).norm(), tol);
+}
+
+// Mult in place
+out = s1;
+SArray::Mult(out,s2,out);
+for (int ii = 0; ii < kNumElements; ++ii) {
+    TypeParam s = states1[ii]*states2[ii];
+    ASSERT_LE( (out.Get(ii).g_.data_ - s.g_.data_).norm(), tol);
+}
+
+// Inverse
+SArray::Inverse(s1,out);
+for (int ii = 0; ii < kNumElements; ++ii) {
+    TypeParam s = states1[ii].Inverse();
+    ASSERT_LE( (out.Get(ii).g_.data_ - s.g_.data_).norm(), tol);
+    ASSERT_LE( (out.Get(ii).u_.data_ - s.u_.data_).norm(), tol);
+}
+
+// Exp and Log
+typename SArray::Data_SC log;
+SArray::Exp(cartesian,out);
+SArray::Log(out,log);
+for (int ii = 0; ii < kNumElements; ++ii) {
+    TypeParam s = TypeParam::Exp(cartesian.row(ii).transpose());
+    ASSERT_LE( (out.Get(ii).g_.data_ - s.g_.data_).norm(), tol);
+    ASSERT_LE( (out.Get(ii).u_.data_ - s.u_.data_).norm(), tol);
+    ASSERT_LE( (log.row(ii).transpose() - TypeParam::Log(s)).norm(), tol);
+}
+
+// OPlus
+SArray::OPlus(s1,cartesian,out);
+for (int ii = 0; ii < kNumElements; ++ii) {
+    TypeParam s = states1[ii].OPlus(cartesian.row(ii).transpose());
+    ASSERT_LE( (out.Get(ii).g_.data_ - s.g_.data_).norm(), tol);
+    ASSERT_LE( (out.Get(ii).u_.data_ - s.u_.data_).norm(), tol);
+}
+
+// OMinus
+typename SArray::Data_SC diff;
+SArray::OMinus(s1,s2,diff);
+for (int ii = 0; ii < kNumElements; ++ii) {
+    ASSERT_LE( (diff.row(ii).transpose() - TypeParam::OMinus(states1[ii],states2[ii])).norm(), tol);
+}
+
+}
+
+
+} // namespace lie_groups
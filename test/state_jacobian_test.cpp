@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+
+#include <Eigen/Dense>
+
+#include "lie_groups/state.h"
+
+namespace lie_groups {
+
+
+using MyTypes = ::testing::Types<R2_r2, R3_r3, SO2_so2, SO3_so3, SE2_se2, SE3_se3, SO3Quat_so3q, SE3Affine_se3a, SE2Complex_se2c, State<SE3,double,6,1,CayleyRetraction>>;
+
+template <typename T>
+class StateJacobianTest : public testing::Test {
+public:
+typedef T type;
+};
+
+TYPED_TEST_SUITE(StateJacobianTest, MyTypes);
+
+////////////////////////////////////////////////////////////
+//                    Operations test
+////////////////////////////////////////////////////////////
+
+// Every operation gives the result of the dense matrix.
+TYPED_TEST(StateJacobianTest, Operations) {
+
+typedef TypeParam S;
+typedef typename S::Vec_SC Vec_SC;
+typedef typename S::Mat_SC Mat_SC;
+typedef typename S::Jacobian Jacobian;
+typedef typename S::Retraction R;
+typedef typename S::Group G;
+const int dim = G::dim_;
+const double tol = 1e-12;
+
+for (int ii = 0; ii < 10; ++ii) {
+
+    const Vec_SC tau = Vec_SC::Random()*0.5;
+    typename G::Base::Mat_C u = G::Base::Mat_C::Zero();
+    u.block(0,0,dim,1) = tau.block(0,0,dim,1);
+
+    // The dense matrices are the block of the group on the identity
+    Mat_SC expected = Mat_SC::Identity();
+    expected.block(0,0,dim,dim) = R::template Jr<G>(u);
+    const Jacobian jr = S::Jr(tau);
+    const Mat_SC dense = jr.ToDense();
+    ASSERT_LE( (dense - expected).norm(), tol) << "Error with Jr";
+    expected.block(0,0,dim,dim) = R::template Jl<G>(u);
+    ASSERT_LE( (S::Jl(tau).ToDense() - expected).norm(), tol) << "Error with Jl";
+    expected.block(0,0,dim,dim) = R::template JrInv<G>(u);
+    ASSERT_LE( (S::JrInv(tau).ToDense() - expected).norm(), tol) << "Error with JrInv";
+    expected.block(0,0,dim,dim) = R::template JlInv<G>(u);
+    ASSERT_LE( (S::JlInv(tau).ToDense() - expected).norm(), tol) << "Error with JlInv";
+    ASSERT_LE( ((S::JrInv(tau)*jr).ToDense() - Mat_SC::Identity()).norm(), tol) << "Error with the product of Jacobians";
+
+    // The products
+    const Mat_SC m = Mat_SC::Random();
+    const Eigen::Matrix<double,S::dim_,4> n = Eigen::Matrix<double,S::dim_,4>::Random();
+    const Eigen::Matrix<double,2,S::dim_> r = Eigen::Matrix<double,2,S::dim_>::Random();
+    const Eigen::MatrixXd d = Eigen::MatrixXd::Random(S::dim_,3);
+    const Mat_SC cov = m*m.transpose();
+    const Mat_SC converted = jr;
+    ASSERT_EQ(converted, dense);
+    ASSERT_LE( (jr*tau - dense*tau).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (jr*m - dense*m).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (jr*n - dense*n).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (jr*d - dense*d).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (m*jr - m*dense).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (r*jr - r*dense).norm(), tol) << "Error with operator *";
+    ASSERT_LE( (jr.TransposeTimes(n) - dense.transpose()*n).norm(), tol) << "Error with TransposeTimes";
+    ASSERT_LE( (jr.TransposeTimes(d) - dense.transpose()*d).norm(), tol) << "Error with TransposeTimes";
+    ASSERT_LE( (jr.Transpose().ToDense() - dense.transpose()).norm(), tol) << "Error with Transpose";
+    ASSERT_LE( (jr.Propagate(cov) - dense*cov*dense.transpose()).norm(), tol) << "Error with Propagate";
+    ASSERT_LE( (Jacobian::Identity().ToDense() - Mat_SC::Identity()).norm(), tol) << "Error with Identity";
+}
+
+}
+
+
+} // namespace lie_groups
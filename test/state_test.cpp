@@ -38,6 +38,28 @@ class BoxOTest : public testing::Test {
 
 TYPED_TEST_SUITE(BoxOTest, MyTypes);
 
+// Used to test the Jacobians of the operations of the group and the state
+template <typename T>
+class OperationJacobianTest : public testing::Test {
+    public:
+    typedef T type;
+};
+
+TYPED_TEST_SUITE(OperationJacobianTest, MyTypes);
+
+// Used to test the states with a retraction other than the exponential
+using RetractionTypes = ::testing::Types<State<Rn,double,3,2,CayleyRetraction>,State<SO2,double,1,1,FirstOrderRetraction>,State<SO3,double,3,1,CayleyRetraction>,State<SO3,double,3,1,FirstOrderRetraction>,
+                                         State<SE2,double,3,1,CayleyRetraction>,State<SE3,double,6,1,FirstOrderRetraction>,State<SO3Quat,double,3,1,FirstOrderRetraction>,
+                                         State<SE3Affine,double,6,1,CayleyRetraction>,State<SE2Complex,double,3,1,FirstOrderRetraction>>;
+
+template <typename T>
+class RetractionTest : public testing::Test {
+    public:
+    typedef T type;
+};
+
+TYPED_TEST_SUITE(RetractionTest, RetractionTypes);
+
 ////////////////////////////////////////////////////////////
 //                        Constructor test
 ////////////////////////////////////////////////////////////
@@ -51,7 +73,7 @@ if(TypeParam::g_type_::size2_ == 1) {
     ASSERT_EQ(state.g_.data_, TypeParam::Mat_G::Zero());
     ASSERT_EQ(state.u_.data_, TypeParam::Mat_C::Zero());
 } else {
-    ASSERT_EQ(state.g_.data_, TypeParam::Mat_G::Identity());
+    ASSERT_EQ(state.g_.data_, typename TypeParam::Mat_G(TypeParam::Mat_G::Identity()));
     ASSERT_EQ(state.u_.data_, TypeParam::Mat_C::Zero());
 
 }
@@ -97,10 +119,10 @@ if(TypeParam::g_type_::size2_ != 1) { // Test invalid entries
     a.setOnes();
     c.setRandom();
     TypeParam state_invalid1(set,g,c);
-    ASSERT_EQ(state_invalid1.g_.data_,TypeParam::Mat_G::Identity());
+    ASSERT_EQ(state_invalid1.g_.data_,typename TypeParam::Mat_G(TypeParam::Mat_G::Identity()));
     ASSERT_EQ(state_invalid1.u_.data_,c);
     TypeParam state_invalid2(g,a,set);
-    ASSERT_EQ(state_invalid2.g_.data_,TypeParam::Mat_G::Identity());
+    ASSERT_EQ(state_invalid2.g_.data_,typename TypeParam::Mat_G(TypeParam::Mat_G::Identity()));
     ASSERT_EQ(state_invalid2.u_.data_,TypeParam::Mat_C::Zero());
     // ASSERT_FALSE(set);
     
@@ -153,7 +175,7 @@ if(TypeParam::g_type_::size2_ == 1) {
     ASSERT_EQ(state.g_.data_, TypeParam::Mat_G::Zero());
     ASSERT_EQ(state.u_.data_, TypeParam::Mat_C::Zero());
 } else {
-    ASSERT_EQ(state.g_.data_, TypeParam::Mat_G::Identity());
+    ASSERT_EQ(state.g_.data_, typename TypeParam::Mat_G(TypeParam::Mat_G::Identity()));
     ASSERT_EQ(state.u_.data_, TypeParam::Mat_C::Zero());
 
 }
@@ -255,9 +277,202 @@ ASSERT_LT( (Jl_inv - jacobian.inverse()).norm(), 1e-5);
 }
 
 
+////////////////////////////////////////////////////////////
+//            Jacobians of the group operations
+////////////////////////////////////////////////////////////
 
+// The numeric right and left Jacobians of a function of an element of the group. A perturbation of the
+// element is mapped to a perturbation of the result in the Cartesian space.
+template<typename tGroup, typename tFunction>
+typename tGroup::Base::Mat_Jac NumericJacobian(tFunction f, const typename tGroup::Base::Mat_G& g_data, bool left) {
+    typedef typename tGroup::Base::Mat_C Mat_C;
+    typename tGroup::Base::Mat_Jac jacobian;
+    const int dim = tGroup::Base::Mat_Jac::RowsAtCompileTime;
+    const double dt = 1e-6;
+    for (int ii = 0; ii < dim; ++ii) {
+        Mat_C u = Mat_C::Zero();
+        u(ii) = dt;
+        Mat_C plus, minus;
+        if (left) {
+            plus = tGroup::Algebra::Log(tGroup::Mult(f(tGroup::Mult(tGroup::Algebra::Exp(u),g_data)),tGroup::Inverse(f(g_data))));
+            minus = tGroup::Algebra::Log(tGroup::Mult(f(tGroup::Mult(tGroup::Algebra::Exp(-u),g_data)),tGroup::Inverse(f(g_data))));
+        } else {
+            plus = tGroup::OMinus(f(tGroup::OPlus(g_data,u)),f(g_data));
+            minus = tGroup::OMinus(f(tGroup::OPlus(g_data,-u)),f(g_data));
+        }
+        jacobian.col(ii) = (plus-minus).block(0,0,dim,1)/(2*dt);
+    }
+    return jacobian;
+}
+
+TYPED_TEST(OperationJacobianTest, Group) {
+
+typedef typename TypeParam::Group G;
+typedef typename G::Base::Mat_G Mat_G;
+typedef typename G::Base::Mat_C Mat_C;
+typedef typename G::Base::Mat_Jac Mat_Jac;
+const int dim = Mat_Jac::RowsAtCompileTime;
+const double tol = 1e-6;
+
+const Mat_G g1 = G::Random();
+const Mat_G g2 = G::Random();
+Mat_C u = Mat_C::Zero();
+u.block(0,0,dim,1) = Mat_C::Random().block(0,0,dim,1);
+Mat_Jac j1, j2;
+
+for (bool left : {false, true}) {
+
+    // Mult
+    Mat_G m = left ? G::MultWithJl(g1,g2,j1,j2) : G::MultWithJr(g1,g2,j1,j2);
+    ASSERT_LE( (m - G::Mult(g1,g2)).norm(), 1e-10);
+    ASSERT_LE( (j1 - NumericJacobian<G>([&](const Mat_G& g){return G::Mult(g,g2);},g1,left)).norm(), tol) << "Error with the Jacobian of Mult. Left: " << left;
+    ASSERT_LE( (j2 - NumericJacobian<G>([&](const Mat_G& g){return G::Mult(g1,g);},g2,left)).norm(), tol) << "Error with the Jacobian of Mult. Left: " << left;
+
+    // Inverse
+    m = left ? G::InverseWithJl(g1,j1) : G::InverseWithJr(g1,j1);
+    ASSERT_LE( (m - G::Inverse(g1)).norm(), 1e-10);
+    ASSERT_LE( (j1 - NumericJacobian<G>([&](const Mat_G& g){return G::Inverse(g);},g1,left)).norm(), tol) << "Error with the Jacobian of Inverse. Left: " << left;
+
+    // OPlus. The Jacobian with respect to the Cartesian vector is taken with the left or right perturbation of the result.
+    m = left ? G::OPlusWithJl(g1,u,j1,j2) : G::OPlusWithJr(g1,u,j1,j2);
+    ASSERT_LE( (m - G::OPlus(g1,u)).norm(), 1e-10);
+    ASSERT_LE( (j1 - NumericJacobian<G>([&](const Mat_G& g){return G::OPlus(g,u);},g1,left)).norm(), tol) << "Error with the Jacobian of OPlus. Left: " << left;
+    for (int ii = 0; ii < dim; ++ii) {
+        Mat_C du = Mat_C::Zero();
+        du(ii) = 1e-6;
+        Mat_C diff = left ? Mat_C(G::Algebra::Log(G::Mult(G::OPlus(g1,u+du),G::Inverse(G::OPlus(g1,u-du))))) : G::OMinus(G::OPlus(g1,u+du),G::OPlus(g1,u-du));
+        ASSERT_LE( (j2.col(ii) - diff.block(0,0,dim,1)/2e-6).norm(), tol) << "Error with the Jacobian of OPlus with respect to the vector. Left: " << left;
+    }
+
+    // OMinus. The result is in the Cartesian space so it is perturbed additively.
+    Mat_C v = left ? G::OMinusWithJl(g1,g2,j1,j2) : G::OMinusWithJr(g1,g2,j1,j2);
+    ASSERT_LE( (v - G::OMinus(g1,g2)).norm(), 1e-10);
+    for (int ii = 0; ii < dim; ++ii) {
+        Mat_C du = Mat_C::Zero();
+        du(ii) = 1e-6;
+        const Mat_G g1_plus  = left ? G::Mult(G::Algebra::Exp(du),g1)  : G::OPlus(g1,du);
+        const Mat_G g1_minus = left ? G::Mult(G::Algebra::Exp(-du),g1) : G::OPlus(g1,-du);
+        const Mat_G g2_plus  = left ? G::Mult(G::Algebra::Exp(du),g2)  : G::OPlus(g2,du);
+        const Mat_G g2_minus = left ? G::Mult(G::Algebra::Exp(-du),g2) : G::OPlus(g2,-du);
+        ASSERT_LE( (j1.col(ii) - (G::OMinus(g1_plus,g2) - G::OMinus(g1_minus,g2)).block(0,0,dim,1)/2e-6).norm(), tol) << "Error with the Jacobian of OMinus. Left: " << left;
+        ASSERT_LE( (j2.col(ii) - (G::OMinus(g1,g2_plus) - G::OMinus(g1,g2_minus)).block(0,0,dim,1)/2e-6).norm(), tol) << "Error with the Jacobian of OMinus. Left: " << left;
+    }
+}
+
+}
+
+TYPED_TEST(OperationJacobianTest, State) {
+
+typedef typename TypeParam::Group G;
+typedef typename G::Base::Mat_Jac Mat_Jac;
+typedef typename TypeParam::Vec_SC Vec_SC;
+typedef typename TypeParam::Mat_SC Mat_SC;
+const int dim = Mat_Jac::RowsAtCompileTime;
+const double tol = 1e-10;
+
+TypeParam s1 = TypeParam::Random();
+TypeParam s2 = TypeParam::Random();
+Vec_SC tau = Vec_SC::Random();
+Mat_SC j1, j2;
+Mat_Jac jg1, jg2;
+typename G::Base::Mat_C u = G::Base::Mat_C::Zero();
+u.block(0,0,dim,1) = tau.block(0,0,dim,1);
+
+// The group blocks come from the group and the blocks of the twist are constant.
+for (bool left : {false, true}) {
+
+    TypeParam s = left ? TypeParam::OPlusWithJl(s1,tau,j1,j2) : TypeParam::OPlusWithJr(s1,tau,j1,j2);
+    ASSERT_LE( (s.g_.data_ - s1.OPlus(tau).g_.data_).norm(), tol);
+    ASSERT_LE( (s.u_.data_ - s1.OPlus(tau).u_.data_).norm(), tol);
+    left ? G::OPlusWithJl(s1.g_.data_,u,jg1,jg2) : G::OPlusWithJr(s1.g_.data_,u,jg1,jg2);
+    Mat_SC expected1 = Mat_SC::Identity(), expected2 = Mat_SC::Identity();
+    expected1.block(0,0,dim,dim) = jg1;
+    expected2.block(0,0,dim,dim) = jg2;
+    ASSERT_LE( (j1 - expected1).norm(), tol);
+    ASSERT_LE( (j2 - expected2).norm(), tol);
+
+    Vec_SC v = left ? TypeParam::OMinusWithJl(s1,s2,j1,j2) : TypeParam::OMinusWithJr(s1,s2,j1,j2);
+    ASSERT_LE( (v - TypeParam::OMinus(s1,s2)).norm(), tol);
+    left ? G::OMinusWithJl(s1.g_.data_,s2.g_.data_,jg1,jg2) : G::OMinusWithJr(s1.g_.data_,s2.g_.data_,jg1,jg2);
+    expected2 = -Mat_SC::Identity();
+    expected1.block(0,0,dim,dim) = jg1;
+    expected2.block(0,0,dim,dim) = jg2;
+    ASSERT_LE( (j1 - expected1).norm(), tol);
+    ASSERT_LE( (j2 - expected2).norm(), tol);
+}
 
+}
 
+////////////////////////////////////////////////////////////
+//                    Retraction test
+////////////////////////////////////////////////////////////
 
+// The group part of OPlus and OMinus uses the retraction and the Jacobians are the ones of the retraction. They are
+// compared to the numeric ones with the perturbations of the exponential.
+TYPED_TEST(RetractionTest, Retraction) {
+
+typedef typename TypeParam::Group G;
+typedef typename TypeParam::Retraction R;
+typedef typename G::Base::Mat_G Mat_G;
+typedef typename G::Base::Mat_C Mat_C;
+typedef typename TypeParam::Vec_SC Vec_SC;
+typedef typename TypeParam::Mat_SC Mat_SC;
+const int dim = G::dim_;
+const double dt = 1e-6;
+const double tol = 1e-6;
+
+// The inverse of the first order retraction is limited to rotations of less than pi/2
+TypeParam s1 = TypeParam::Random();
+TypeParam s2 = s1.OPlus(Vec_SC(Vec_SC::Random()*0.5));
+Vec_SC tau = Vec_SC::Random()*0.5;
+Mat_C u = Mat_C::Zero();
+u.block(0,0,dim,1) = tau.block(0,0,dim,1);
+
+TypeParam s3 = s1.OPlus(tau);
+ASSERT_LE( (s3.g_.data_ - G::Mult(s1.g_.data_,R::template Retract<G>(u))).norm(), 1e-12) << "Error with OPlus";
+ASSERT_LE( (s3.u_.data_ - s1.u_.data_ - tau.block(dim,0,TypeParam::Algebra::total_num_dim_,1)).norm(), 1e-12) << "Error with OPlus";
+ASSERT_LE( (TypeParam::OMinus(s3,s1) - tau).norm(), 1e-12) << "Error with OMinus";
+
+// The Jacobians of the state
+Mat_SC jr = TypeParam::Jr(tau), jl = TypeParam::Jl(tau);
+Mat_SC jr_numeric = Mat_SC::Identity(), jl_numeric = Mat_SC::Identity();
+const Mat_G g = R::template Retract<G>(u);
+for (int ii = 0; ii < dim; ++ii) {
+    Mat_C du = Mat_C::Zero();
+    du(ii) = dt;
+    const Mat_G plus = R::template Retract<G>(u+du);
+    const Mat_G minus = R::template Retract<G>(u-du);
+    jr_numeric.block(0,ii,dim,1) = (G::Algebra::Log(G::Mult(G::Inverse(g),plus)) - G::Algebra::Log(G::Mult(G::Inverse(g),minus))).block(0,0,dim,1)/(2*dt);
+    jl_numeric.block(0,ii,dim,1) = (G::Algebra::Log(G::Mult(plus,G::Inverse(g))) - G::Algebra::Log(G::Mult(minus,G::Inverse(g)))).block(0,0,dim,1)/(2*dt);
+}
+ASSERT_LE( (jr - jr_numeric).norm(), tol) << "Error with Jr";
+ASSERT_LE( (jl - jl_numeric).norm(), tol) << "Error with Jl";
+ASSERT_LE( (TypeParam::JrInv(tau)*jr - Mat_SC::Identity()).norm(), 1e-12) << "Error with JrInv";
+ASSERT_LE( (TypeParam::JlInv(tau)*jl - Mat_SC::Identity()).norm(), 1e-12) << "Error with JlInv";
+
+// The Jacobians of OPlus and OMinus
+Mat_SC j1, j2;
+TypeParam s = TypeParam::OPlusWithJr(s1,tau,j1,j2);
+ASSERT_LE( (s.g_.data_ - s3.g_.data_).norm(), 1e-12);
+ASSERT_LE( (j2 - jr).norm(), 1e-12) << "Error with the Jacobian of OPlus with respect to the vector";
+s = TypeParam::OPlusWithJl(s1,tau,j1,j2);
+ASSERT_LE( (s.g_.data_ - s3.g_.data_).norm(), 1e-12);
+ASSERT_LE( (j2.block(0,0,dim,dim) - G(s1.g_.data_).Adjoint()*jl.block(0,0,dim,dim)).norm(), 1e-12) << "Error with the Jacobian of OPlus with respect to the vector";
+
+Vec_SC v = TypeParam::OMinusWithJr(s2,s1,j1,j2);
+ASSERT_LE( (v - TypeParam::OMinus(s2,s1)).norm(), 1e-12);
+for (int ii = 0; ii < dim; ++ii) {
+    Mat_C du = Mat_C::Zero();
+    du(ii) = dt;
+    TypeParam s2_plus = s2, s2_minus = s2, s1_plus = s1, s1_minus = s1;
+    s2_plus.g_.data_ = G::OPlus(s2.g_.data_,du);
+    s2_minus.g_.data_ = G::OPlus(s2.g_.data_,-du);
+    s1_plus.g_.data_ = G::OPlus(s1.g_.data_,du);
+    s1_minus.g_.data_ = G::OPlus(s1.g_.data_,-du);
+    ASSERT_LE( (j1.col(ii) - (TypeParam::OMinus(s2_plus,s1) - TypeParam::OMinus(s2_minus,s1))/(2*dt)).norm(), tol) << "Error with the Jacobian of OMinus";
+    ASSERT_LE( (j2.col(ii) - (TypeParam::OMinus(s2,s1_plus) - TypeParam::OMinus(s2,s1_minus))/(2*dt)).norm(), tol) << "Error with the Jacobian of OMinus";
+}
+
+}
 
 } // namespace lie_groups
\ No newline at end of file
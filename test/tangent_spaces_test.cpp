@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+
+#include <Eigen/Dense>
+
+#include "lie_groups/state.h"
+
+namespace lie_groups {
+
+
+using MyTypes = ::testing::Types<State<SO3,double,3,2>, State<SE3,double,6,2>, State<SE2,double,3,2>, State<SE2,double,3,3>, State<Rn,double,3,2>, SE3_se3>;
+
+template <typename T>
+class TangentSpacesTest : public testing::Test {
+public:
+typedef T type;
+};
+
+TYPED_TEST_SUITE(TangentSpacesTest, MyTypes);
+
+static_assert(State<SE3,double,6,2>::dim_ == 18, "The state stacks the pose, the twist and the acceleration");
+static_assert(State<SE2,double,3,3>::Mat_C::RowsAtCompileTime == 9, "The twist stacks the tangent spaces");
+
+// The twist at the time t, the sum of the tangent spaces times t^i/i!.
+template <typename tState>
+typename tState::Group::Base::Mat_C Twist(const tState& state, const double t) {
+    constexpr int d = tState::Group::dim_;
+    typename tState::Group::Base::Mat_C v = tState::Group::Base::Mat_C::Zero();
+    double c = 1.0;
+    for (int ii = 0; ii < tState::NumTangentSpaces; ++ii) {
+        v.template head<d>() += c*state.u_.data_.template segment<d>(ii*d);
+        c *= t/static_cast<double>(ii+1);
+    }
+    return v;
+}
+
+////////////////////////////////////////////////////////////
+//                    Operations test
+////////////////////////////////////////////////////////////
+
+// OPlus, OMinus and the Jacobians cover the stacked twist.
+TYPED_TEST(TangentSpacesTest, Operations) {
+
+typedef TypeParam S;
+typedef typename S::Vec_SC Vec_SC;
+typedef typename S::Mat_SC Mat_SC;
+const double tol = 1e-12;
+const double dt = 1e-6;
+
+for (int ii = 0; ii < 10; ++ii) {
+
+    const S s1 = S::Random();
+    const Vec_SC tau = Vec_SC::Random()*0.5;
+    const S s2 = s1.OPlus(tau);
+    ASSERT_LE( (S::OMinus(s2,s1) - tau).norm(), tol) << "Error with OMinus";
+    ASSERT_LE( (s2.u_.data_ - s1.u_.data_ - tau.template tail<S::Mat_C::RowsAtCompileTime>()).norm(), tol) << "Error with OPlus";
+    ASSERT_LE( (S::Log(S::Exp(tau)) - tau).norm(), tol) << "Error with Exp or Log";
+
+    Mat_SC jr_numeric;
+    for (int jj = 0; jj < static_cast<int>(S::dim_); ++jj) {
+        Vec_SC d = Vec_SC::Zero();
+        d(jj) = dt;
+        jr_numeric.col(jj) = (S::OMinus(s1.OPlus(tau+d),s2) - S::OMinus(s1.OPlus(tau-d),s2))/(2*dt);
+    }
+    ASSERT_LE( (S::Jr(tau).ToDense() - jr_numeric).norm(), 1e-8) << "Error with Jr";
+}
+
+}
+
+////////////////////////////////////////////////////////////
+//                    Propagation test
+////////////////////////////////////////////////////////////
+
+// The propagation agrees with the integration of the twist in small steps.
+TYPED_TEST(TangentSpacesTest, Propagate) {
+
+typedef TypeParam S;
+typedef typename S::Group G;
+typedef typename S::Algebra U;
+constexpr int d = G::dim_;
+const double dt = 0.1;
+const int num_steps = 20000;
+
+for (int ii = 0; ii < 5; ++ii) {
+
+    const S s = S::Random(0.5);
+    const S propagated = s.Propagate(dt);
+
+    typename S::Mat_G g = s.g_.data_;
+    const double step = dt/num_steps;
+    for (int jj = 0; jj < num_steps; ++jj) {
+        g = G::Mult(g,U::Exp(Twist(s,(jj+0.5)*step)*step));
+    }
+    // The error of the two terms of the Magnus expansion is of order dt^5
+    ASSERT_LE( G::OMinus(propagated.g_.data_,g).norm(), 2e-8) << "Error with the pose";
+
+    // The tangent spaces follow their Taylor polynomials
+    for (int jj = 0; jj < S::NumTangentSpaces; ++jj) {
+        S shifted;
+        for (int kk = jj; kk < S::NumTangentSpaces; ++kk) {
+            shifted.u_.data_.template segment<d>((kk-jj)*d) = s.u_.data_.template segment<d>(kk*d);
+        }
+        ASSERT_LE( (propagated.u_.data_.template segment<d>(jj*d) - Twist(shifted,dt).template head<d>()).norm(), 1e-14) << "Error with the tangent space " << jj;
+    }
+    ASSERT_LE( (propagated.u_.data_.template tail<d>() - s.u_.data_.template tail<d>()).norm(), 1e-15) << "The last tangent space is constant";
+}
+
+// The propagation is exact when the twist commutes with its derivatives.
+S s = S::Random();
+for (int jj = 1; jj < S::NumTangentSpaces; ++jj) {
+    s.u_.data_.template segment<d>(jj*d) = s.u_.data_.template head<d>()*(jj+1.0);
+}
+typename G::Base::Mat_C omega = G::Base::Mat_C::Zero();
+for (int jj = 0; jj < num_steps; ++jj) {
+    omega += Twist(s,(jj+0.5)*dt/num_steps)*(dt/num_steps);
+}
+ASSERT_LE( G::OMinus(s.Propagate(dt).g_.data_,G::Mult(s.g_.data_,U::Exp(omega))).norm(), 1e-11) << "Error with commuting derivatives";
+
+}
+
+
+} // namespace lie_groups
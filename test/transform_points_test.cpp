@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+
+#include <Eigen/Dense>
+#include <vector>
+
+#include "lie_groups/state.h"
+#include "lie_groups/transform_points.h"
+
+namespace lie_groups {
+
+
+using MyTypes = ::testing::Types<SO2<double>,SO3<double>,SE2<double>,SE3<double>,SE3<float>>;
+
+template <typename T>
+class TransformPointsTest : public testing::Test {
+public:
+typedef T type;
+};
+
+TYPED_TEST_SUITE(TransformPointsTest, MyTypes);
+
+template<typename tDataType>
+double Tolerance() {return std::is_same<tDataType,float>::value ? 1e-4 : 1e-10;}
+
+// Homogenizes the point and multiplies it by the data of the element.
+template<typename tGroup>
+typename tGroup::Point HomogeneousAct(const tGroup& g, const typename tGroup::Point& p) {
+    const int d = tGroup::Point::RowsAtCompileTime;
+    if (tGroup::Base::Mat_G::RowsAtCompileTime == d) {
+        return g.data_.template topLeftCorner<d,d>()*p;
+    }
+    return g.data_.template topLeftCorner<d,d>()*p + g.data_.template topRightCorner<d,1>();
+}
+
+////////////////////////////////////////////////////////////
+//                  Act test
+////////////////////////////////////////////////////////////
+
+TYPED_TEST(TransformPointsTest, ActWithJacobians) {
+
+typedef TypeParam Group;
+typedef typename Group::Point Point;
+typedef typename Group::Base::Mat_C Mat_C;
+typedef typename Group::Base::DataType DataType;
+const double tol = Tolerance<DataType>();
+
+Group g(Group::Random());
+Point p = Point::Random();
+ASSERT_LE( (g.Act(p) - HomogeneousAct(g,p)).norm(), tol) << "Error with Act";
+
+typename Group::ActJacobian j_pose;
+Eigen::Matrix<DataType,Point::RowsAtCompileTime,Point::RowsAtCompileTime> j_point;
+ASSERT_LE( (Group::ActWithJacobians(g.data_,p,j_pose,j_point) - g.Act(p)).norm(), tol) << "Error with ActWithJacobians";
+
+// Central differences of the action with the element perturbed on the right and the point perturbed
+if (std::is_same<DataType,double>::value) {
+    const DataType dt = static_cast<DataType>(1e-6);
+    for (int ii = 0; ii < Mat_C::RowsAtCompileTime; ++ii) {
+        Mat_C u = Mat_C::Zero();
+        u(ii) = dt;
+        Group g_plus(Group::OPlus(g.data_,u));
+        Group g_minus(Group::OPlus(g.data_,-u));
+        ASSERT_LE( ((g_plus.Act(p) - g_minus.Act(p))/(2*dt) - j_pose.col(ii)).norm(), 1e-8) << "Error with the Jacobian with respect to the element";
+    }
+    for (int ii = 0; ii < Point::RowsAtCompileTime; ++ii) {
+        Point dp = Point::Zero();
+        dp(ii) = dt;
+        ASSERT_LE( ((g.Act(p+dp) - g.Act(p-dp))/(2*dt) - j_point.col(ii)).norm(), 1e-8) << "Error with the Jacobian with respect to the point";
+    }
+}
+
+}
+
+////////////////////////////////////////////////////////////
+//                  Transform points test
+////////////////////////////////////////////////////////////
+
+TYPED_TEST(TransformPointsTest, TransformPoints) {
+
+typedef TypeParam Group;
+typedef typename Group::Point Point;
+const double tol = Tolerance<typename Group::Base::DataType>();
+
+ThreadPool pool(4);
+Group g(Group::Random());
+
+// The clouds are split in a single chunk, several chunks and a size that isn't a multiple of the block size.
+for (Eigen::Index n : {Eigen::Index(0), Eigen::Index(kBatchActBlockSize+3), 4*kTransformPointsMinChunkSize + 13}) {
+
+    PointVector<Group> points(n), out, in_place;
+    ActJacobianVector<Group> j_pose;
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        points[ii] = Point::Random();
+    }
+
+    TransformPoints(g,points,out,pool);
+    ASSERT_EQ(static_cast<Eigen::Index>(out.size()), n);
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        ASSERT_LE( (out[ii] - g.Act(points[ii])).norm(), tol) << "Error with TransformPoints at " << ii;
+    }
+
+    in_place = points;
+    TransformPoints(g,in_place,in_place,j_pose,pool);
+    ASSERT_EQ(static_cast<Eigen::Index>(j_pose.size()), n);
+    for (Eigen::Index ii = 0; ii < n; ++ii) {
+        typename Group::ActJacobian j;
+        Eigen::Matrix<typename Group::Base::DataType,Point::RowsAtCompileTime,Point::RowsAtCompileTime> j_point;
+        Group::ActWithJacobians(g.data_,points[ii],j,j_point);
+        ASSERT_LE( (in_place[ii] - out[ii]).norm(), tol) << "Error with TransformPoints in place at " << ii;
+        ASSERT_LE( (j_pose[ii] - j).norm(), tol) << "Error with the Jacobians of TransformPoints at " << ii;
+    }
+}
+
+}
+
+
+} // namespace lie_groups